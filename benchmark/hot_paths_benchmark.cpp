@@ -0,0 +1,455 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Google Benchmark suite of the packet handling and accumulation hot paths. Packets are crafted by
+// provizio_radar_simulator, so points are realistic (mostly static, as seen from a moving vehicle).
+//
+// Usage: provizio_radar_api_core_hot_paths_benchmark [--benchmark_filter=regex] [--benchmark_out=file.json] ..., or
+// build the provizio_radar_api_core_benchmark_json target to write the results of all of them to JSON
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "provizio/radar_api/radar_point_cloud.h"
+#include "provizio/radar_api/radar_points_accumulation.h"
+#include "provizio/radar_api/radar_points_accumulation_filters.h"
+#include "provizio/radar_api/radar_simulator.h"
+#include "provizio/util.h"
+
+#ifndef PROVIZIO__BENCHMARK_LIBRARY_VERSION
+#define PROVIZIO__BENCHMARK_LIBRARY_VERSION "unknown"
+#endif // PROVIZIO__BENCHMARK_LIBRARY_VERSION
+
+namespace
+{
+    constexpr std::uint16_t num_points_per_frame = PROVIZIO__RADAR_SIMULATOR_DEFAULT_POINTS_PER_FRAME;
+    constexpr std::size_t num_radars = provizio_radar_position_rear_center + 1;
+    constexpr std::size_t num_accumulated_point_clouds = 10;
+    constexpr std::uint64_t frame_interval_ns = 100000000ULL; // 10 frames per second
+    constexpr float ego_velocity_m_s = 15.0F;                 // As emulated by provizio_radar_simulator
+
+#pragma pack(push, 1)
+    // Protocol v1 points have no ground_relative_radial_velocity_m_s
+    struct radar_point_protocol_v1
+    {
+        float x_meters;
+        float y_meters;
+        float z_meters;
+        float radar_relative_radial_velocity_m_s;
+        float signal_to_noise_ratio;
+    };
+#pragma pack(pop)
+
+    struct packet_record
+    {
+        provizio_radar_point_cloud_packet packet;
+        std::size_t packet_size;
+    };
+
+    std::int32_t store_packet(const provizio_radar_point_cloud_packet *packet, std::size_t packet_size,
+                              void *user_data)
+    {
+        auto &packets = *static_cast<std::vector<packet_record> *>(user_data);
+        packets.emplace_back();
+        std::memcpy(&packets.back().packet, packet, packet_size);
+        packets.back().packet_size = packet_size;
+        return 0;
+    }
+
+    // Makes packets of a single frame of radars 0 to radars_count - 1, interleaved as sent by the radars
+    std::vector<packet_record> make_frame_packets(std::size_t radars_count)
+    {
+        provizio_radar_simulator_options options;
+        provizio_radar_simulator_options_init(&options);
+        options.num_radars = radars_count;
+        for (std::size_t i = 0; i < radars_count; ++i)
+        {
+            options.radar_position_ids[i] = static_cast<std::uint16_t>(i);
+        }
+        options.num_points_per_frame = num_points_per_frame;
+
+        provizio_radar_simulator simulator;
+        std::vector<packet_record> packets;
+        if (provizio_radar_simulator_init(&options, &simulator) != 0 ||
+            provizio_radar_simulator_make_frame(&simulator, &store_packet, &packets) != 0)
+        {
+            throw std::runtime_error{"Failed to make a frame"};
+        }
+
+        return packets;
+    }
+
+    // Converts packets to protocol v1, i.e. drops ground_relative_radial_velocity_m_s of all points
+    void convert_to_protocol_v1(std::vector<packet_record> &packets)
+    {
+        for (auto &record : packets)
+        {
+            const std::uint16_t num_points =
+                provizio_get_protocol_field_uint16_t(&record.packet.header.num_points_in_packet);
+            auto *points_v1 = reinterpret_cast<radar_point_protocol_v1 *>(record.packet.radar_points);
+            for (std::uint16_t i = 0; i < num_points; ++i)
+            {
+                // Protocol fields are copied as is, as both versions use the same byte order
+                std::memmove(&points_v1[i], &record.packet.radar_points[i], sizeof(radar_point_protocol_v1));
+            }
+
+            provizio_set_protocol_field_uint16_t(&record.packet.header.protocol_header.protocol_version, 1);
+            record.packet_size = provizio_radar_point_cloud_packet_size(&record.packet.header);
+        }
+    }
+
+    void set_frame_index(std::vector<packet_record> &packets, std::uint32_t frame_index)
+    {
+        for (auto &record : packets)
+        {
+            provizio_set_protocol_field_uint32_t(&record.packet.header.frame_index, frame_index);
+        }
+    }
+
+    void count_point_cloud(const provizio_radar_point_cloud *point_cloud,
+                           provizio_radar_point_cloud_api_context *context)
+    {
+        (void)point_cloud;
+        ++*static_cast<std::uint64_t *>(context->user_data);
+    }
+
+    // Makes a complete point cloud of a single radar
+    std::unique_ptr<provizio_radar_point_cloud> make_point_cloud()
+    {
+        std::unique_ptr<provizio_radar_point_cloud> point_cloud{new provizio_radar_point_cloud};
+        std::memset(point_cloud.get(), 0, sizeof(provizio_radar_point_cloud));
+        point_cloud->radar_position_id = provizio_radar_position_front_center;
+        point_cloud->radar_range = provizio_radar_range_medium;
+        point_cloud->num_points_expected = num_points_per_frame;
+
+        for (const auto &record : make_frame_packets(1))
+        {
+            if (provizio_get_radar_point_cloud_packet_points(
+                    &record.packet, &point_cloud->radar_points[point_cloud->num_points_received]) != 0)
+            {
+                throw std::runtime_error{"Failed to get packet points"};
+            }
+            point_cloud->num_points_received = static_cast<std::uint16_t>(
+                point_cloud->num_points_received +
+                provizio_get_protocol_field_uint16_t(&record.packet.header.num_points_in_packet));
+        }
+
+        return point_cloud;
+    }
+
+    // Fix of a radar looking east (along the road) after the specified number of frames, moving forward
+    provizio_enu_fix make_fix(std::uint32_t frame_index)
+    {
+        provizio_enu_fix fix;
+        provizio_quaternion_set_identity(&fix.orientation);
+        fix.position.east_meters = ego_velocity_m_s * static_cast<float>(frame_index * frame_interval_ns) / 1e9F;
+        fix.position.north_meters = 0.0F;
+        fix.position.up_meters = 0.0F;
+        return fix;
+    }
+
+    // Accumulation history fully filled with point clouds of a moving radar
+    struct accumulation_fixture
+    {
+        std::unique_ptr<provizio_radar_point_cloud> point_cloud{make_point_cloud()};
+        std::vector<provizio_accumulated_radar_point_cloud> accumulated_point_clouds{num_accumulated_point_clouds};
+        provizio_accumulated_radar_point_cloud_iterator newest{};
+        provizio_enu_fix current_fix{};
+        std::uint32_t frame_index = 0;
+
+        accumulation_fixture()
+        {
+            provizio_accumulated_radar_point_clouds_init(accumulated_point_clouds.data(),
+                                                         accumulated_point_clouds.size());
+            for (std::size_t i = 0; i < num_accumulated_point_clouds; ++i)
+            {
+                accumulate(nullptr);
+            }
+        }
+
+        void accumulate(provizio_radar_points_accumulation_filter filter)
+        {
+            point_cloud->frame_index = frame_index;
+            point_cloud->timestamp = frame_index * frame_interval_ns;
+            current_fix = make_fix(frame_index++);
+            newest = provizio_accumulate_radar_point_cloud(point_cloud.get(), &current_fix,
+                                                           accumulated_point_clouds.data(),
+                                                           accumulated_point_clouds.size(), filter, nullptr);
+        }
+
+        std::size_t num_points() const
+        {
+            return provizio_accumulated_radar_points_count(accumulated_point_clouds.data(),
+                                                           accumulated_point_clouds.size());
+        }
+    };
+
+    void handle_frames(benchmark::State &state, std::vector<packet_record> &packets)
+    {
+        std::unique_ptr<provizio_radar_point_cloud_api_context> context{new provizio_radar_point_cloud_api_context};
+        std::uint64_t num_point_clouds = 0;
+        provizio_radar_point_cloud_api_context_init(&count_point_cloud, &num_point_clouds, context.get());
+
+        std::uint32_t frame_index = 0;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            set_frame_index(packets, frame_index++);
+            state.ResumeTiming();
+
+            for (auto &record : packets)
+            {
+                benchmark::DoNotOptimize(
+                    provizio_handle_radar_point_cloud_packet(context.get(), &record.packet, record.packet_size));
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * num_points_per_frame);
+        state.counters["point_clouds"] = static_cast<double>(num_point_clouds);
+    }
+} // namespace
+
+// Handles all packets of a frame of a single radar, protocol v2 (current)
+static void BM_HandleRadarPointCloudPacketV2(benchmark::State &state)
+{
+    auto packets = make_frame_packets(1);
+    handle_frames(state, packets);
+}
+BENCHMARK(BM_HandleRadarPointCloudPacketV2);
+
+// Handles all packets of a frame of a single radar, protocol v1 (points spread on handling)
+static void BM_HandleRadarPointCloudPacketV1(benchmark::State &state)
+{
+    auto packets = make_frame_packets(1);
+    convert_to_protocol_v1(packets);
+    handle_frames(state, packets);
+}
+BENCHMARK(BM_HandleRadarPointCloudPacketV1);
+
+// Converts all points of a full packet from the network byte order, as done on handling every packet (byte-swapped on
+// little-endian hosts, using SIMD when available)
+static void BM_GetProtocolFieldsFloat(benchmark::State &state)
+{
+    const auto packets = make_frame_packets(1);
+    const auto &packet = packets.front().packet;
+    const std::size_t num_floats = provizio_get_protocol_field_uint16_t(&packet.header.num_points_in_packet) *
+                                   sizeof(provizio_radar_point) / sizeof(float);
+    std::vector<float> out_floats(num_floats);
+
+    for (auto _ : state)
+    {
+        provizio_get_protocol_fields_float(packet.radar_points, out_floats.data(), num_floats);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * num_floats * sizeof(float)));
+}
+BENCHMARK(BM_GetProtocolFieldsFloat);
+
+// Handles interleaved packets of a frame of all radars by multiple contexts, looked up linearly (0) or using a
+// dispatch table (1)
+static void BM_HandleRadarsPointCloudPacket(benchmark::State &state)
+{
+    auto packets = make_frame_packets(num_radars);
+    std::unique_ptr<provizio_radar_point_cloud_api_context[]> contexts{
+        new provizio_radar_point_cloud_api_context[num_radars]};
+    std::uint64_t num_point_clouds = 0;
+    provizio_radar_point_cloud_api_contexts_init(&count_point_cloud, &num_point_clouds, contexts.get(), num_radars);
+    std::unique_ptr<provizio_radar_api_contexts_dispatch_table> dispatch_table{
+        new provizio_radar_api_contexts_dispatch_table}; // 128KB, so it's better not to keep it on stack
+    if (state.range(0) != 0)
+    {
+        provizio_radar_point_cloud_api_contexts_set_dispatch_table(contexts.get(), num_radars, dispatch_table.get());
+    }
+
+    std::uint32_t frame_index = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        set_frame_index(packets, frame_index++);
+        state.ResumeTiming();
+
+        for (auto &record : packets)
+        {
+            benchmark::DoNotOptimize(provizio_handle_radars_point_cloud_packet(contexts.get(), num_radars,
+                                                                               &record.packet, record.packet_size));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * num_radars) * num_points_per_frame);
+    state.counters["point_clouds"] = static_cast<double>(num_point_clouds);
+}
+BENCHMARK(BM_HandleRadarsPointCloudPacket)->ArgName("dispatch_table")->Arg(0)->Arg(1);
+
+// Accumulates a point cloud, with all points (0) or only the static ones (1)
+static void BM_AccumulateRadarPointCloud(benchmark::State &state)
+{
+    accumulation_fixture accumulation;
+    const provizio_radar_points_accumulation_filter filter =
+        state.range(0) != 0 ? &provizio_radar_points_accumulation_filter_static : nullptr;
+
+    for (auto _ : state)
+    {
+        accumulation.accumulate(filter);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * num_points_per_frame);
+    state.counters["accumulated_points"] = static_cast<double>(accumulation.num_points());
+}
+BENCHMARK(BM_AccumulateRadarPointCloud)->ArgName("static_filter")->Arg(0)->Arg(1);
+
+// Traverses all accumulated points with an iterator, with no transformation
+static void BM_IterateAccumulatedPoints(benchmark::State &state)
+{
+    const accumulation_fixture accumulation;
+
+    for (auto _ : state)
+    {
+        float sum = 0.0F;
+        auto iterator = accumulation.newest;
+        while (!provizio_accumulated_radar_point_cloud_iterator_is_end(
+            &iterator, accumulation.accumulated_point_clouds.data(), accumulation.accumulated_point_clouds.size()))
+        {
+            sum += provizio_accumulated_radar_point_cloud_iterator_get_point(
+                       &iterator, nullptr, accumulation.accumulated_point_clouds.data(),
+                       accumulation.accumulated_point_clouds.size(), nullptr, nullptr)
+                       ->x_meters;
+            provizio_accumulated_radar_point_cloud_iterator_next_point(
+                &iterator, accumulation.accumulated_point_clouds.data(), accumulation.accumulated_point_clouds.size());
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * accumulation.num_points()));
+}
+BENCHMARK(BM_IterateAccumulatedPoints);
+
+// Transforms all accumulated points one by one, as they are iterated over
+static void BM_TransformAccumulatedPointsOneByOne(benchmark::State &state)
+{
+    const accumulation_fixture accumulation;
+    provizio_radar_point transformed_point;
+
+    for (auto _ : state)
+    {
+        auto iterator = accumulation.newest;
+        while (!provizio_accumulated_radar_point_cloud_iterator_is_end(
+            &iterator, accumulation.accumulated_point_clouds.data(), accumulation.accumulated_point_clouds.size()))
+        {
+            provizio_accumulated_radar_point_cloud_iterator_get_point(
+                &iterator, &accumulation.current_fix, accumulation.accumulated_point_clouds.data(),
+                accumulation.accumulated_point_clouds.size(), &transformed_point, nullptr);
+            benchmark::DoNotOptimize(transformed_point);
+            provizio_accumulated_radar_point_cloud_iterator_next_point(
+                &iterator, accumulation.accumulated_point_clouds.data(), accumulation.accumulated_point_clouds.size());
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * accumulation.num_points()));
+}
+BENCHMARK(BM_TransformAccumulatedPointsOneByOne);
+
+// Transforms all accumulated points a point cloud at a time
+static void BM_TransformAccumulatedPointClouds(benchmark::State &state)
+{
+    const accumulation_fixture accumulation;
+    std::unique_ptr<provizio_radar_point_cloud> transformed_point_cloud{new provizio_radar_point_cloud};
+
+    for (auto _ : state)
+    {
+        auto iterator = accumulation.newest;
+        while (!provizio_accumulated_radar_point_cloud_iterator_is_end(
+            &iterator, accumulation.accumulated_point_clouds.data(), accumulation.accumulated_point_clouds.size()))
+        {
+            provizio_accumulated_radar_point_cloud_iterator_get_point_cloud(
+                &iterator, &accumulation.current_fix, accumulation.accumulated_point_clouds.data(),
+                accumulation.accumulated_point_clouds.size(), transformed_point_cloud.get(), nullptr);
+            benchmark::ClobberMemory();
+            provizio_accumulated_radar_point_cloud_iterator_next_point_cloud(
+                &iterator, accumulation.accumulated_point_clouds.data(), accumulation.accumulated_point_clouds.size());
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * accumulation.num_points()));
+}
+BENCHMARK(BM_TransformAccumulatedPointClouds);
+
+// Transforms all accumulated points in a single call
+static void BM_TransformAccumulatedRadarPoints(benchmark::State &state)
+{
+    const accumulation_fixture accumulation;
+    std::vector<provizio_radar_point> transformed_points(accumulation.num_points());
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(provizio_transform_accumulated_radar_points(
+            &accumulation.newest, &accumulation.current_fix, accumulation.accumulated_point_clouds.data(),
+            accumulation.accumulated_point_clouds.size(), transformed_points.data(), transformed_points.size()));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * transformed_points.size()));
+}
+BENCHMARK(BM_TransformAccumulatedRadarPoints);
+
+// Transforms the specified number of points by a matrix, as done for every accumulated point cloud
+static void BM_TransformRadarPoints(benchmark::State &state)
+{
+    const accumulation_fixture accumulation;
+    auto iterator = accumulation.newest;
+    provizio_accumulated_radar_point_cloud_iterator_next_point_cloud(
+        &iterator, accumulation.accumulated_point_clouds.data(), accumulation.accumulated_point_clouds.size());
+    float transformation_matrix[16]; // NOLINT: 4x4 matrix as used by the API
+    provizio_accumulated_radar_point_cloud_iterator_get_point_cloud(
+        &iterator, &accumulation.current_fix, accumulation.accumulated_point_clouds.data(),
+        accumulation.accumulated_point_clouds.size(), nullptr, transformation_matrix);
+
+    const auto num_points = static_cast<std::size_t>(state.range(0));
+    std::vector<provizio_radar_point> points(num_points);
+    for (std::size_t i = 0; i < num_points; ++i)
+    {
+        points[i] = accumulation.point_cloud->radar_points[i % num_points_per_frame];
+    }
+    std::vector<provizio_radar_point> transformed_points(num_points);
+
+    for (auto _ : state)
+    {
+        provizio_transform_radar_points(transformation_matrix, points.data(), num_points, transformed_points.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * num_points));
+}
+BENCHMARK(BM_TransformRadarPoints)->Arg(64)->Arg(num_points_per_frame)->Arg(PROVIZIO__MAX_RADAR_POINTS_IN_POINT_CLOUD);
+
+int main(int argc, char *argv[])
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    // Stored to the JSON output, so results can be told apart across releases
+    benchmark::AddCustomContext("provizio_radar_api_core_version", PROVIZIO__BENCHMARK_LIBRARY_VERSION);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
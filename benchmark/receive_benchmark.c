@@ -0,0 +1,278 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares receive backends of provizio_radar_api_connection, i.e. provizio_radar_api_receive_packet (a system call per
+// packet), provizio_radar_api_receive_packets (recvmmsg) and provizio_radar_api_io_uring_receiver, at various packet
+// rates. Point cloud packets are sent over the loopback
+// interface by another thread, and the receiving thread's CPU time per packet is reported along with packets lost.
+//
+// Usage: provizio_radar_api_core_receive_benchmark [duration_ms [packet_rate...]], where 0 packet rate stands for "as
+// fast as possible"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "provizio/atomic.h"
+#include "provizio/radar_api/core.h"
+#include "provizio/radar_api/io_uring_receiver.h"
+
+#define PROVIZIO__BENCHMARK_PORT ((uint16_t)(PROVIZIO__RADAR_API_DEFAULT_PORT + 200))
+#define PROVIZIO__BENCHMARK_DEFAULT_DURATION_MS 1000
+#define PROVIZIO__BENCHMARK_RECEIVE_TIMEOUT_NS ((uint64_t)10000000)
+#define PROVIZIO__BENCHMARK_NUM_POINTS_PER_FRAME ((uint16_t)1000)
+#define PROVIZIO__BENCHMARK_NUM_PACKETS_PER_FRAME                                                                      \
+    ((PROVIZIO__BENCHMARK_NUM_POINTS_PER_FRAME + PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET - 1) /                      \
+     PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET)
+
+typedef enum provizio_benchmark_backend
+{
+    provizio_benchmark_backend_receive_packet = 0,
+    provizio_benchmark_backend_receive_packets,
+    provizio_benchmark_backend_io_uring,
+
+    provizio_benchmark_num_backends
+} provizio_benchmark_backend;
+
+static const char *const provizio_benchmark_backend_names[provizio_benchmark_num_backends] = {
+    "receive_packet", "receive_packets", "io_uring"};
+
+typedef struct provizio_benchmark_sender
+{
+    uint64_t packet_rate; // Packets per second, 0 for as fast as possible
+    uint64_t duration_ns;
+    uint64_t num_packets_sent;
+    uint32_t done;
+    pthread_t thread;
+} provizio_benchmark_sender;
+
+static void provizio_benchmark_ignore_warning(const char *warning)
+{
+    (void)warning; // Partial frames are expected at high packet rates, as packets get lost
+}
+
+static void provizio_benchmark_count_frame(const provizio_pooled_radar_point_cloud *point_cloud,
+                                           provizio_pooled_radar_point_cloud_api_context *context)
+{
+    (void)point_cloud;
+    ++*(uint64_t *)context->user_data;
+}
+
+static uint64_t provizio_benchmark_thread_cpu_time_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+static void provizio_benchmark_make_frame(provizio_radar_point_cloud_packet *packets)
+{
+    memset(packets, 0, sizeof(provizio_radar_point_cloud_packet) * PROVIZIO__BENCHMARK_NUM_PACKETS_PER_FRAME);
+
+    uint16_t num_points_left = PROVIZIO__BENCHMARK_NUM_POINTS_PER_FRAME;
+    for (size_t i = 0; i < PROVIZIO__BENCHMARK_NUM_PACKETS_PER_FRAME; ++i)
+    {
+        provizio_radar_point_cloud_packet *packet = &packets[i];
+        const uint16_t num_points = num_points_left < PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET
+                                        ? num_points_left
+                                        : PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+        num_points_left = (uint16_t)(num_points_left - num_points);
+
+        provizio_set_protocol_field_uint16_t(&packet->header.protocol_header.packet_type,
+                                             PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE);
+        provizio_set_protocol_field_uint16_t(&packet->header.protocol_header.protocol_version,
+                                             PROVIZIO__RADAR_API_POINT_CLOUD_PROTOCOL_VERSION);
+        provizio_set_protocol_field_uint16_t(&packet->header.radar_position_id, provizio_radar_position_front_center);
+        provizio_set_protocol_field_uint16_t(&packet->header.radar_range, provizio_radar_range_medium);
+        provizio_set_protocol_field_uint16_t(&packet->header.total_points_in_frame,
+                                             PROVIZIO__BENCHMARK_NUM_POINTS_PER_FRAME);
+        provizio_set_protocol_field_uint16_t(&packet->header.num_points_in_packet, num_points);
+        for (uint16_t j = 0; j < num_points; ++j)
+        {
+            provizio_set_protocol_field_float(&packet->radar_points[j].x_meters, (float)j);
+            provizio_set_protocol_field_float(&packet->radar_points[j].y_meters, (float)i);
+            provizio_set_protocol_field_float(&packet->radar_points[j].signal_to_noise_ratio, 10.0F);
+        }
+    }
+}
+
+static void *provizio_benchmark_send(void *thread_data)
+{
+    provizio_benchmark_sender *sender = (provizio_benchmark_sender *)thread_data;
+    // NOLINTNEXTLINE: static to keep the stack small
+    static provizio_radar_point_cloud_packet packets[PROVIZIO__BENCHMARK_NUM_PACKETS_PER_FRAME];
+    provizio_benchmark_make_frame(packets);
+
+    PROVIZIO__SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    struct sockaddr_in target_address;
+    memset(&target_address, 0, sizeof(target_address));
+    target_address.sin_family = AF_INET;
+    target_address.sin_port = htons(PROVIZIO__BENCHMARK_PORT); // NOLINT: htons is up to a platform
+    target_address.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    const uint64_t start_time_ns = provizio_monotonic_time_ns();
+    uint32_t frame_index = 0;
+    uint64_t num_packets_sent = 0;
+    while (provizio_monotonic_time_ns() - start_time_ns < sender->duration_ns)
+    {
+        for (size_t i = 0; i < PROVIZIO__BENCHMARK_NUM_PACKETS_PER_FRAME; ++i)
+        {
+            if (sender->packet_rate != 0)
+            {
+                // Paced by the total number of packets sent, so an occasional delay doesn't lower the average rate
+                const uint64_t send_time_ns = start_time_ns + num_packets_sent * 1000000000ULL / sender->packet_rate;
+                while (provizio_monotonic_time_ns() < send_time_ns)
+                {
+                    // Busy-wait, as sleeping is too coarse for high packet rates
+                }
+            }
+
+            provizio_set_protocol_field_uint32_t(&packets[i].header.frame_index, frame_index);
+            const size_t packet_size = provizio_radar_point_cloud_packet_size(&packets[i].header);
+            if (sendto(sock, (const char *)&packets[i], packet_size, 0, (const struct sockaddr *)&target_address,
+                       sizeof(target_address)) == (PROVIZIO__RECV_RETURN_TYPE)packet_size)
+            {
+                ++num_packets_sent;
+            }
+        }
+        ++frame_index;
+    }
+
+    provizio_socket_close(sock);
+    sender->num_packets_sent = num_packets_sent;
+    PROVIZIO__ATOMIC_STORE_UINT32(&sender->done, 1);
+    return NULL;
+}
+
+static int32_t provizio_benchmark_run(provizio_benchmark_backend backend, uint64_t packet_rate, uint64_t duration_ns)
+{
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(PROVIZIO__BENCHMARK_NUM_POINTS_PER_FRAME, 2);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    provizio_memory_pool_init(memory, memory_size, &pool);
+
+    uint64_t num_frames = 0;
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&provizio_benchmark_count_frame, &num_frames, &pool, &context);
+
+    provizio_radar_api_connection connection;
+    int32_t status = provizio_open_pooled_radars_connection(
+        PROVIZIO__BENCHMARK_PORT, PROVIZIO__BENCHMARK_RECEIVE_TIMEOUT_NS, 0, &context, 1, &connection);
+    if (status != 0)
+    {
+        free(memory);
+        return status;
+    }
+
+    provizio_radar_api_io_uring_receiver io_uring_receiver;
+    if (backend == provizio_benchmark_backend_io_uring)
+    {
+        status = provizio_radar_api_io_uring_receiver_init(
+            &connection, PROVIZIO__RADAR_API_IO_URING_DEFAULT_NUM_BUFFERS, &io_uring_receiver);
+        if (status != 0)
+        {
+            provizio_close_radars_connection(&connection);
+            free(memory);
+            return status;
+        }
+    }
+
+    provizio_benchmark_sender sender;
+    memset(&sender, 0, sizeof(sender));
+    sender.packet_rate = packet_rate;
+    sender.duration_ns = duration_ns;
+    pthread_create(&sender.thread, NULL, &provizio_benchmark_send, &sender);
+
+    const uint64_t start_cpu_time_ns = provizio_benchmark_thread_cpu_time_ns();
+    uint64_t num_packets_received = 0;
+    uint8_t sender_done = 0;
+    for (;;)
+    {
+        // Stops once nothing is left to receive after the sender is done
+        sender_done = sender_done || PROVIZIO__ATOMIC_LOAD_UINT32(&sender.done);
+
+        size_t num_packets_handled = 0;
+        if (backend == provizio_benchmark_backend_receive_packet)
+        {
+            status = provizio_radar_api_receive_packet(&connection);
+            num_packets_handled = status != PROVIZIO_E_TIMEOUT ? 1 : 0;
+        }
+        else if (backend == provizio_benchmark_backend_receive_packets)
+        {
+            status = provizio_radar_api_receive_packets(&connection, SIZE_MAX, &num_packets_handled);
+        }
+        else
+        {
+            status = provizio_radar_api_io_uring_receiver_receive(
+                &io_uring_receiver, PROVIZIO__BENCHMARK_RECEIVE_TIMEOUT_NS, &num_packets_handled);
+        }
+        num_packets_received += num_packets_handled;
+        if (status == PROVIZIO_E_TIMEOUT && sender_done)
+        {
+            break;
+        }
+    }
+    const uint64_t cpu_time_ns = provizio_benchmark_thread_cpu_time_ns() - start_cpu_time_ns;
+    pthread_join(sender.thread, NULL);
+
+    const double packets_lost_percent =
+        sender.num_packets_sent != 0
+            ? 100.0 * (double)(sender.num_packets_sent - num_packets_received) / (double)sender.num_packets_sent
+            : 0.0;
+    printf("%-16s %12llu %12llu %12llu %10.2f%% %10llu %14.1f\n", provizio_benchmark_backend_names[backend],
+           (unsigned long long)packet_rate, (unsigned long long)sender.num_packets_sent,
+           (unsigned long long)num_packets_received, packets_lost_percent, (unsigned long long)num_frames,
+           num_packets_received != 0 ? (double)cpu_time_ns / (double)num_packets_received : 0.0);
+
+    if (backend == provizio_benchmark_backend_io_uring)
+    {
+        provizio_radar_api_io_uring_receiver_release(&io_uring_receiver);
+    }
+    provizio_close_radars_connection(&connection);
+    free(memory);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const uint64_t default_packet_rates[] = {10000, 50000, 100000, 250000, 0};
+    const size_t num_default_packet_rates = sizeof(default_packet_rates) / sizeof(default_packet_rates[0]);
+
+    const uint64_t duration_ns =
+        (argc > 1 ? strtoull(argv[1], NULL, 10) : PROVIZIO__BENCHMARK_DEFAULT_DURATION_MS) * 1000000ULL;
+    const size_t num_packet_rates = argc > 2 ? (size_t)(argc - 2) : num_default_packet_rates;
+
+    provizio_set_on_warning(&provizio_benchmark_ignore_warning);
+
+    printf("%-16s %12s %12s %12s %11s %10s %14s\n", "backend", "rate (pps)", "sent", "received", "lost", "frames",
+           "cpu ns/packet");
+    for (size_t i = 0; i < num_packet_rates; ++i)
+    {
+        const uint64_t packet_rate = argc > 2 ? strtoull(argv[i + 2], NULL, 10) : default_packet_rates[i];
+        for (int backend = 0; backend < (int)provizio_benchmark_num_backends; ++backend)
+        {
+            const int32_t status =
+                provizio_benchmark_run((provizio_benchmark_backend)backend, packet_rate, duration_ns);
+            if (status != 0)
+            {
+                printf("%-16s %12llu failed with error %d\n", provizio_benchmark_backend_names[backend],
+                       (unsigned long long)packet_rate, (int)status);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_ATOMIC
+#define PROVIZIO_ATOMIC
+
+#include "provizio/common.h"
+
+// Minimal set of atomic operations on uint32_t, uint64_t and pointers, used to share state between threads without
+// locks. Loads have acquire semantics, stores have release semantics. C11 <stdatomic.h> is not used, as the library is
+// C99. Pointer loads return void * with MSVC, so their results are to be cast to the pointer type.
+#if defined(_MSC_VER) && !defined(__clang__)
+
+#include <intrin.h>
+
+// Interlocked functions are full barriers, which is stronger than required, but portable across MSVC targets
+#define PROVIZIO__ATOMIC_LOAD_UINT32(POINTER) ((uint32_t)_InterlockedOr((volatile long *)(POINTER), 0))
+#define PROVIZIO__ATOMIC_STORE_UINT32(POINTER, VALUE)                                                                  \
+    ((void)_InterlockedExchange((volatile long *)(POINTER), (long)(VALUE)))
+#define PROVIZIO__ATOMIC_ADD_UINT32(POINTER, VALUE)                                                                    \
+    ((void)_InterlockedExchangeAdd((volatile long *)(POINTER), (long)(VALUE)))
+#define PROVIZIO__ATOMIC_LOAD_UINT64(POINTER) ((uint64_t)_InterlockedOr64((volatile __int64 *)(POINTER), 0))
+#define PROVIZIO__ATOMIC_STORE_UINT64(POINTER, VALUE)                                                                  \
+    ((void)_InterlockedExchange64((volatile __int64 *)(POINTER), (__int64)(VALUE)))
+#define PROVIZIO__ATOMIC_ADD_UINT64(POINTER, VALUE)                                                                    \
+    ((void)_InterlockedExchangeAdd64((volatile __int64 *)(POINTER), (__int64)(VALUE)))
+#define PROVIZIO__ATOMIC_SUB_UINT64(POINTER, VALUE)                                                                    \
+    ((void)_InterlockedExchangeAdd64((volatile __int64 *)(POINTER), -(__int64)(VALUE)))
+#define PROVIZIO__ATOMIC_LOAD_POINTER(POINTER)                                                                         \
+    _InterlockedCompareExchangePointer((void *volatile *)(POINTER), NULL, NULL)
+#define PROVIZIO__ATOMIC_STORE_POINTER(POINTER, VALUE)                                                                 \
+    ((void)_InterlockedExchangePointer((void *volatile *)(POINTER), (void *)(VALUE)))
+
+#else
+
+#define PROVIZIO__ATOMIC_LOAD_UINT32(POINTER) __atomic_load_n((POINTER), __ATOMIC_ACQUIRE)
+#define PROVIZIO__ATOMIC_STORE_UINT32(POINTER, VALUE) __atomic_store_n((POINTER), (uint32_t)(VALUE), __ATOMIC_RELEASE)
+#define PROVIZIO__ATOMIC_ADD_UINT32(POINTER, VALUE)                                                                    \
+    ((void)__atomic_fetch_add((POINTER), (uint32_t)(VALUE), __ATOMIC_RELAXED))
+#define PROVIZIO__ATOMIC_LOAD_UINT64(POINTER) __atomic_load_n((POINTER), __ATOMIC_ACQUIRE)
+#define PROVIZIO__ATOMIC_STORE_UINT64(POINTER, VALUE) __atomic_store_n((POINTER), (uint64_t)(VALUE), __ATOMIC_RELEASE)
+#define PROVIZIO__ATOMIC_ADD_UINT64(POINTER, VALUE)                                                                    \
+    ((void)__atomic_fetch_add((POINTER), (uint64_t)(VALUE), __ATOMIC_RELAXED))
+#define PROVIZIO__ATOMIC_SUB_UINT64(POINTER, VALUE)                                                                    \
+    ((void)__atomic_fetch_sub((POINTER), (uint64_t)(VALUE), __ATOMIC_RELAXED))
+#define PROVIZIO__ATOMIC_LOAD_POINTER(POINTER) __atomic_load_n((POINTER), __ATOMIC_ACQUIRE)
+#define PROVIZIO__ATOMIC_STORE_POINTER(POINTER, VALUE) __atomic_store_n((POINTER), (VALUE), __ATOMIC_RELEASE)
+
+#endif
+
+#endif // PROVIZIO_ATOMIC
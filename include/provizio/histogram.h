@@ -0,0 +1,98 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_HISTOGRAM
+#define PROVIZIO_HISTOGRAM
+
+#include "provizio/common.h"
+
+// Every power of 2 range of values is split into 2^PROVIZIO__HISTOGRAM_SUB_BUCKET_BITS equal buckets, i.e. a recorded
+// value is off by less than 1 / 2^PROVIZIO__HISTOGRAM_SUB_BUCKET_BITS (12.5%) of it, while values below
+// 2^(PROVIZIO__HISTOGRAM_SUB_BUCKET_BITS + 1) are exact
+#define PROVIZIO__HISTOGRAM_SUB_BUCKET_BITS 3
+#define PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT (1 << PROVIZIO__HISTOGRAM_SUB_BUCKET_BITS)
+// Enough to cover all uint64_t values
+#define PROVIZIO__HISTOGRAM_BUCKETS_COUNT                                                                              \
+    ((64 - PROVIZIO__HISTOGRAM_SUB_BUCKET_BITS + 1) * PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT)
+
+/**
+ * @brief An HDR-style (log-linear buckets) histogram of uint64_t values with a fixed memory footprint and constant time
+ * recording, which can be read by other threads (see provizio_histogram_snapshot) while values are being recorded
+ *
+ * @warning Values are to be recorded by a single thread at a time
+ * @note Zero-initialized (e.g. using memset) histogram is empty and ready to use
+ */
+typedef struct provizio_histogram
+{
+    uint64_t count; // Number of values recorded
+    uint64_t sum;   // Sum of values recorded (wraps around on overflow)
+    uint64_t max;   // Max value recorded, 0 if none
+    uint32_t buckets[PROVIZIO__HISTOGRAM_BUCKETS_COUNT];
+} provizio_histogram;
+
+/**
+ * @brief Returns the index of the bucket a value is counted in
+ *
+ * @param value Any value
+ * @return Index in provizio_histogram::buckets
+ */
+PROVIZIO__EXTERN_C size_t provizio_histogram_bucket_index(uint64_t value);
+
+/**
+ * @brief Returns the lowest value counted in a bucket
+ *
+ * @param bucket_index Index in provizio_histogram::buckets, must be less than PROVIZIO__HISTOGRAM_BUCKETS_COUNT
+ * @return The lowest value counted in the bucket
+ */
+PROVIZIO__EXTERN_C uint64_t provizio_histogram_bucket_lowest_value(size_t bucket_index);
+
+/**
+ * @brief Returns the highest value counted in a bucket
+ *
+ * @param bucket_index Index in provizio_histogram::buckets, must be less than PROVIZIO__HISTOGRAM_BUCKETS_COUNT
+ * @return The highest value counted in the bucket
+ */
+PROVIZIO__EXTERN_C uint64_t provizio_histogram_bucket_highest_value(size_t bucket_index);
+
+/**
+ * @brief Records a value in constant time, without locking
+ *
+ * @param histogram Previously zero-initialized provizio_histogram
+ * @param value The value to record
+ */
+PROVIZIO__EXTERN_C void provizio_histogram_record(provizio_histogram *histogram, uint64_t value);
+
+/**
+ * @brief Copies a histogram that may be concurrently recorded to, e.g. to export it or compute percentiles
+ *
+ * @param histogram The provizio_histogram to copy
+ * @param out_snapshot The provizio_histogram to copy to
+ *
+ * @note Every field is read atomically, but values recorded concurrently may be only partially reflected
+ */
+PROVIZIO__EXTERN_C void provizio_histogram_snapshot(const provizio_histogram *histogram,
+                                                    provizio_histogram *out_snapshot);
+
+/**
+ * @brief Returns the value at a percentile of a histogram, i.e. the highest value of the bucket that the percentile of
+ * recorded values doesn't exceed (capped by the max value recorded)
+ *
+ * @param histogram A provizio_histogram that is not concurrently recorded to (e.g. a snapshot)
+ * @param percentile Percentile in [0, 100]
+ * @return The value at the percentile, or 0 if the histogram is empty
+ */
+PROVIZIO__EXTERN_C uint64_t provizio_histogram_value_at_percentile(const provizio_histogram *histogram,
+                                                                   double percentile);
+
+#endif // PROVIZIO_HISTOGRAM
@@ -0,0 +1,78 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_MEMORY_POOL
+#define PROVIZIO_MEMORY_POOL
+
+#include "provizio/common.h"
+
+// Memory pools allocate in units of this size (bytes), which is also the alignment of all allocations
+#define PROVIZIO__MEMORY_POOL_UNIT_SIZE ((size_t)64)
+
+/**
+ * @brief A first-fit memory pool in a caller-supplied memory block, intended for a small number of relatively large
+ * allocations (such as radar frames). Allocation takes O(number of blocks in the pool), releasing is O(1), adjacent
+ * released blocks are merged on allocating.
+ *
+ * @warning Not thread safe
+ * @see provizio_memory_pool_init
+ */
+typedef struct provizio_memory_pool
+{
+    uint8_t *memory;       // PROVIZIO__MEMORY_POOL_UNIT_SIZE-aligned
+    size_t num_units;      // Capacity in units of PROVIZIO__MEMORY_POOL_UNIT_SIZE bytes
+    size_t num_units_used; // Including per-allocation headers
+} provizio_memory_pool;
+
+/**
+ * @brief Initializes a provizio_memory_pool in a caller-supplied memory block
+ *
+ * @param memory Memory block to allocate from, must remain valid as long as the pool is used. Doesn't have to be
+ * aligned, but some of it is skipped otherwise
+ * @param memory_size The size of memory in bytes
+ * @param out_pool The provizio_memory_pool to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if memory is too small to allocate anything
+ */
+PROVIZIO__EXTERN_C int32_t provizio_memory_pool_init(void *memory, size_t memory_size, provizio_memory_pool *out_pool);
+
+/**
+ * @brief Returns the recommended size of a memory block (in bytes) to keep num_allocations allocations of up to
+ * allocation_size bytes each at the same time. It includes a spare allocation to reduce the effect of fragmentation,
+ * but doesn't prevent it: as allocations are first-fit, interleaving allocations of different sizes can still split
+ * the free memory into blocks too small for an allocation of allocation_size bytes.
+ *
+ * @param allocation_size Max size of a single allocation in bytes
+ * @param num_allocations Max number of simultaneous allocations
+ * @return Required memory size in bytes, including the worst case alignment of the memory block
+ */
+PROVIZIO__EXTERN_C size_t provizio_memory_pool_required_size(size_t allocation_size, size_t num_allocations);
+
+/**
+ * @brief Allocates a block of memory from the pool
+ *
+ * @param pool Previously initialized provizio_memory_pool
+ * @param size Number of bytes to allocate, must be positive
+ * @return Pointer to PROVIZIO__MEMORY_POOL_UNIT_SIZE-aligned memory, or NULL if there is not enough memory in the pool
+ */
+PROVIZIO__EXTERN_C void *provizio_memory_pool_allocate(provizio_memory_pool *pool, size_t size);
+
+/**
+ * @brief Releases a block of memory previously allocated using provizio_memory_pool_allocate
+ *
+ * @param pool The provizio_memory_pool it was allocated from
+ * @param memory The pointer returned by provizio_memory_pool_allocate (NULL is ignored)
+ */
+PROVIZIO__EXTERN_C void provizio_memory_pool_release(provizio_memory_pool *pool, void *memory);
+
+#endif // PROVIZIO_MEMORY_POOL
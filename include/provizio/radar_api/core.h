@@ -17,6 +17,8 @@
 
 #include "provizio/common.h"
 #include "provizio/radar_api/errno.h"
+#include "provizio/radar_api/packet_recorder.h"
+#include "provizio/radar_api/pooled_radar_point_cloud.h"
 #include "provizio/radar_api/radar_point_cloud.h"
 #include "provizio/radar_api/radar_points_accumulation.h"
 #include "provizio/radar_api/radar_ranges.h"
@@ -26,6 +28,22 @@
 #define PROVIZIO__RADAR_API_DEFAULT_PORT ((uint16_t)7769)
 #define PROVIZIO__RADAR_API_SET_RANGE_DEFAULT_PORT ((uint16_t)7770)
 
+// Max number of UDP packets provizio_radar_api_receive_packets receives in a single system call (where supported)
+#ifndef PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE
+#define PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE 16
+#endif // PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE
+
+/**
+ * @brief Clock domains packet receive times can be recorded in, see provizio_radar_api_enable_receive_timestamps and
+ * provizio_radar_api_enable_hardware_receive_timestamps
+ */
+typedef enum provizio_radar_api_receive_timestamps
+{
+    provizio_radar_api_receive_timestamps_none = 0,     // Receive times are not recorded
+    provizio_radar_api_receive_timestamps_software = 1, // Kernel's CLOCK_REALTIME (SO_TIMESTAMPNS)
+    provizio_radar_api_receive_timestamps_hardware = 2  // NIC's own clock (raw SO_TIMESTAMPING)
+} provizio_radar_api_receive_timestamps;
+
 /**
  * @brief A single Provizio Radar API connection handle on a single UDP port
  */
@@ -34,8 +52,49 @@ typedef struct provizio_radar_api_connection
     PROVIZIO__SOCKET sock;
     provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts;
     size_t num_radar_point_cloud_api_contexts;
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts;
+    size_t num_pooled_radar_point_cloud_api_contexts;
+    uint8_t receive_timestamps; // One of provizio_radar_api_receive_timestamps
+    size_t receive_buffer_size; // Effective size of the kernel receive buffer, see provizio_socket_get_recv_buffer_size
+    provizio_packet_recorder *packet_recorder; // See provizio_radar_api_set_packet_recorder
 } provizio_radar_api_connection;
 
+/**
+ * @brief Options of the UDP socket of a provizio_radar_api_connection, beyond the broadcasting and address & port reuse
+ * that are always enabled
+ *
+ * @see provizio_radar_api_connection_options_init
+ * @see provizio_open_radars_connection_with_options
+ * @see provizio_open_pooled_radars_connection_with_options
+ */
+typedef struct provizio_radar_api_connection_options
+{
+    // Requested size of the kernel receive buffer in bytes, 0 to keep the OS default. Bursts of packets of several
+    // radars may overflow the default buffer, so the packets are dropped by the kernel before they are received.
+    // See provizio_socket_set_recv_buffer_size.
+    size_t receive_buffer_size;
+    // Microseconds to busy poll the network device for packets when there are none to receive (SO_BUSY_POLL, Linux
+    // only), trading CPU time for latency, 0 to disable
+    uint32_t busy_poll_us;
+    // CPU to prefer handling the socket's packets on (SO_INCOMING_CPU, Linux only), e.g. the one the receiving thread
+    // is pinned to, -1 to leave it up to the kernel
+    int32_t incoming_cpu;
+    // IPv4 multicast group to join (e.g. "239.1.1.1"), NULL to not join any
+    const char *multicast_group;
+    // IPv4 address of the network interface to join multicast_group on, NULL to leave it up to the OS
+    const char *multicast_interface_address;
+    // Name of the network interface (e.g. "eth0") to receive packets from (SO_BINDTODEVICE, Linux only), NULL for any
+    const char *bind_interface;
+} provizio_radar_api_connection_options;
+
+/**
+ * @brief Initializes provizio_radar_api_connection_options with defaults, i.e. with no options beyond the ones
+ * provizio_open_radars_connection uses
+ *
+ * @param out_options The provizio_radar_api_connection_options to initialize
+ */
+PROVIZIO__EXTERN_C void provizio_radar_api_connection_options_init(provizio_radar_api_connection_options *out_options);
+
 /**
  * @brief Connect to the Provizio radar to start receiving packets by UDP (single radar on a UDP port)
  *
@@ -78,15 +137,260 @@ PROVIZIO__EXTERN_C int32_t provizio_open_radars_connection(
     provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts, size_t num_radar_point_cloud_api_contexts,
     provizio_radar_api_connection *out_connection);
 
+/**
+ * @brief Connect to the radar API to start receiving packets by UDP (multiple radars on the same UDP port), handling
+ * point clouds using provizio_pooled_radar_point_cloud_api_context objects
+ *
+ * @param udp_port UDP port to receive from, by default = PROVIZIO__RADAR_API_DEFAULT_PORT
+ * @param receive_timeout_ns Max number of nanoseconds provizio_radar_api_receive_packet should wait for a
+ * packet, or 0 to wait as long as required
+ * @param check_connection Use any non-zero value if the connection is to be checked to be receiving anything prior to
+ * returning a successful result
+ * @param pooled_radar_point_cloud_api_contexts Array of initialized provizio_pooled_radar_point_cloud_api_context to
+ * handle point cloud packets
+ * @param num_pooled_radar_point_cloud_api_contexts Number of pooled_radar_point_cloud_api_contexts, i.e. max numbers
+ * of radars to handle
+ * @param out_connection A provizio_radar_api_connection to store the connection handle
+ * @return 0 if received successfully, PROVIZIO_E_TIMEOUT if timed out, other error value if failed for another reason
+ *
+ * @note The connection has to be eventually closed with provizio_close_radars_connection
+ */
+PROVIZIO__EXTERN_C int32_t provizio_open_pooled_radars_connection(
+    uint16_t udp_port, uint64_t receive_timeout_ns, uint8_t check_connection,
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts,
+    size_t num_pooled_radar_point_cloud_api_contexts, provizio_radar_api_connection *out_connection);
+
+/**
+ * @brief Same as provizio_open_radars_connection, but with extra options of the UDP socket
+ *
+ * @param udp_port UDP port to receive from, by default = PROVIZIO__RADAR_API_DEFAULT_PORT
+ * @param receive_timeout_ns Max number of nanoseconds provizio_radar_api_receive_packet should wait for a
+ * packet, or 0 to wait as long as required
+ * @param check_connection Use any non-zero value if the connection is to be checked to be receiving anything prior to
+ * returning a successful result
+ * @param options Options of the socket, previously initialized by provizio_radar_api_connection_options_init (may be
+ * NULL for defaults)
+ * @param radar_point_cloud_api_contexts Array of initialized provizio_radar_point_cloud_api_context to handle point
+ * cloud packets (may be NULL to skip any point cloud packets)
+ * @param num_radar_point_cloud_api_contexts Number of radar_point_cloud_api_contexts, i.e. max numbers of radars to
+ * handle (may be 0 to skip any point cloud packets)
+ * @param out_connection A provizio_radar_api_connection to store the connection handle
+ * @return 0 if received successfully, PROVIZIO_E_TIMEOUT if timed out, PROVIZIO_E_NOT_PERMITTED if an option is not
+ * supported on this platform, other error value if failed for another reason (e.g. if an option could not be applied)
+ *
+ * @note The OS may cap receive_buffer_size with only a warning, see provizio_radar_api_connection::receive_buffer_size
+ * for the size achieved
+ * @note The connection has to be eventually closed with provizio_close_radars_connection
+ */
+PROVIZIO__EXTERN_C int32_t provizio_open_radars_connection_with_options(
+    uint16_t udp_port, uint64_t receive_timeout_ns, uint8_t check_connection,
+    const provizio_radar_api_connection_options *options,
+    provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts, size_t num_radar_point_cloud_api_contexts,
+    provizio_radar_api_connection *out_connection);
+
+/**
+ * @brief Same as provizio_open_pooled_radars_connection, but with extra options of the UDP socket
+ *
+ * @param udp_port UDP port to receive from, by default = PROVIZIO__RADAR_API_DEFAULT_PORT
+ * @param receive_timeout_ns Max number of nanoseconds provizio_radar_api_receive_packet should wait for a
+ * packet, or 0 to wait as long as required
+ * @param check_connection Use any non-zero value if the connection is to be checked to be receiving anything prior to
+ * returning a successful result
+ * @param options Options of the socket, previously initialized by provizio_radar_api_connection_options_init (may be
+ * NULL for defaults)
+ * @param pooled_radar_point_cloud_api_contexts Array of initialized provizio_pooled_radar_point_cloud_api_context to
+ * handle point cloud packets
+ * @param num_pooled_radar_point_cloud_api_contexts Number of pooled_radar_point_cloud_api_contexts, i.e. max numbers
+ * of radars to handle
+ * @param out_connection A provizio_radar_api_connection to store the connection handle
+ * @return 0 if received successfully, PROVIZIO_E_TIMEOUT if timed out, PROVIZIO_E_NOT_PERMITTED if an option is not
+ * supported on this platform, other error value if failed for another reason (e.g. if an option could not be applied)
+ *
+ * @note The connection has to be eventually closed with provizio_close_radars_connection
+ */
+PROVIZIO__EXTERN_C int32_t provizio_open_pooled_radars_connection_with_options(
+    uint16_t udp_port, uint64_t receive_timeout_ns, uint8_t check_connection,
+    const provizio_radar_api_connection_options *options,
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts,
+    size_t num_pooled_radar_point_cloud_api_contexts, provizio_radar_api_connection *out_connection);
+
+/**
+ * @brief Makes a previously connected API record kernel receive times of packets, which are then exposed by point
+ * clouds next to the radar's own timestamp (see provizio_radar_point_cloud::first_packet_receive_time_ns and
+ * provizio_pooled_radar_point_cloud::first_packet_receive_time_ns), e.g. to measure network and reassembly latency.
+ * The times are software times of the kernel (SO_TIMESTAMPNS), i.e. CLOCK_REALTIME nanoseconds since the Unix Epoch.
+ *
+ * @param connection A previously connected provizio_radar_api_connection
+ * @return 0 if successful, PROVIZIO_E_NOT_PERMITTED if not supported on this platform (only Linux is supported), other
+ * error code if failed for another reason
+ *
+ * @note Not supported by provizio_threaded_radar_api_receiver and provizio_radar_api_io_uring_receiver, which handle
+ * packets with unknown receive times (i.e. point clouds they receive have first_packet_receive_time_ns and
+ * last_packet_receive_time_ns set to 0)
+ * @see provizio_radar_api_enable_hardware_receive_timestamps
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_enable_receive_timestamps(provizio_radar_api_connection *connection);
+
+/**
+ * @brief Same as provizio_radar_api_enable_receive_timestamps, but records times reported by the NIC (raw
+ * SO_TIMESTAMPING) instead of the kernel's ones. They are in the clock domain of the NIC's own clock (its PTP hardware
+ * clock), which is not CLOCK_REALTIME unless synchronized to it (e.g. by phc2sys), so they are only comparable to each
+ * other. The NIC must be configured to timestamp received packets (e.g. using hwstamp_ctl). Packets it hasn't
+ * timestamped are handled with unknown receive times, as the two clock domains are never mixed. Replaces software
+ * timestamps, if enabled before.
+ *
+ * @param connection A previously connected provizio_radar_api_connection
+ * @return 0 if successful, PROVIZIO_E_NOT_PERMITTED if not supported on this platform (only Linux is supported), other
+ * error code if failed for another reason (e.g. hardware timestamps not supported by the kernel)
+ */
+PROVIZIO__EXTERN_C int32_t
+provizio_radar_api_enable_hardware_receive_timestamps(provizio_radar_api_connection *connection);
+
+/**
+ * @brief Makes a previously connected API append every packet it receives (before handling it) to a packet log, along
+ * with its receive time (see provizio_radar_api_enable_receive_timestamps, the current time is used when unknown) and
+ * source address, so the exact inputs can be replayed later
+ *
+ * @param connection A previously connected provizio_radar_api_connection
+ * @param packet_recorder A previously opened provizio_packet_recorder, must remain open while it's set, or NULL to stop
+ * recording
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if not connected
+ *
+ * @note Used by provizio_radar_api_io_uring_receiver and provizio_threaded_radar_api_receiver as well, but not by
+ * provizio_reuseport_radar_api_receiver
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_set_packet_recorder(provizio_radar_api_connection *connection,
+                                                                  provizio_packet_recorder *packet_recorder);
+
+/**
+ * @brief Appends a packet received by an external receive backend (e.g. provizio_radar_api_io_uring_receiver) to the
+ * connection's packet log, if a recorder is set, the same way provizio_radar_api_receive_packet(s) do it
+ *
+ * @param connection A previously connected provizio_radar_api_connection the packet has been received on
+ * @param packet The packet's payload
+ * @param packet_size Size of the payload in bytes
+ * @param receive_time_ns Time the packet has been received at in nanoseconds since the epoch, 0 if unknown
+ * @param source_address IPv4 address the packet has been sent from, network byte order (as in sockaddr_in)
+ * @param source_port UDP port the packet has been sent from, network byte order (as in sockaddr_in)
+ */
+PROVIZIO__EXTERN_C void provizio_radar_api_record_received_packet(provizio_radar_api_connection *connection,
+                                                                  const void *packet, size_t packet_size,
+                                                                  uint64_t receive_time_ns, uint32_t source_address,
+                                                                  uint16_t source_port);
+
 /**
  * @brief Receive and handle the next UDP packet using a previously connected API
  *
  * @param connection A previously connected provizio_radar_api_connection
- * @return 0 if received successfully, PROVIZIO_E_TIMEOUT if timed out, PROVIZIO_E_SKIPPED if received but skipped,
- * other error value if failed for another reason
+ * @return 0 if received successfully, PROVIZIO_E_TIMEOUT if timed out (or interrupted, e.g. by a signal),
+ * PROVIZIO_E_SKIPPED if received but skipped, other error value if failed for another reason
  */
 PROVIZIO__EXTERN_C int32_t provizio_radar_api_receive_packet(provizio_radar_api_connection *connection);
 
+/**
+ * @brief Receives the next UDP packet already queued for a previously connected API into a caller-supplied buffer and
+ * records it (see provizio_radar_api_set_packet_recorder), with its receive time (see
+ * provizio_radar_api_enable_receive_timestamps), but doesn't handle it. Doesn't wait for packets, so it's to be used
+ * once the connection's socket is ready to be read from (e.g. by poll), by receive backends that handle packets
+ * elsewhere (e.g. provizio_threaded_radar_api_receiver, which passes them to its workers).
+ *
+ * @param connection A previously connected provizio_radar_api_connection
+ * @param packet Buffer of PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES bytes to receive the packet into
+ * @param out_packet_size Stores the size of the packet received in bytes
+ * @param out_receive_time_ns Stores the time the packet has been received at in nanoseconds since the epoch, 0 if
+ * unknown
+ * @return 0 if received successfully, PROVIZIO_E_TIMEOUT if there are no packets to receive (or interrupted, e.g. by a
+ * signal), other error value if failed for another reason
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_receive_packet_into(provizio_radar_api_connection *connection,
+                                                                  void *packet, size_t *out_packet_size,
+                                                                  uint64_t *out_receive_time_ns);
+
+/**
+ * @brief Receive and handle up to max_packets UDP packets using a previously connected API. Waits for the first packet
+ * (up to the connection's receive timeout), then handles only the packets that are already queued, without waiting for
+ * more. On Linux it uses recvmmsg to receive up to PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE packets per system
+ * call, other platforms fall back to a loop of non-blocking recv calls.
+ *
+ * @param connection A previously connected provizio_radar_api_connection
+ * @param max_packets Max number of packets to receive and handle (must be positive)
+ * @param out_num_packets_handled Stores the number of packets received and handled, i.e. including skipped and failed
+ * ones (may be NULL)
+ * @return 0 if received successfully (even if some of the packets were skipped), PROVIZIO_E_SKIPPED if all the packets
+ * received were skipped, PROVIZIO_E_TIMEOUT if timed out (or interrupted, e.g. by a signal) before receiving any
+ * packets, error code of the first failed packet handling (all the received packets are still handled), other error
+ * value if failed for another reason
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_receive_packets(provizio_radar_api_connection *connection,
+                                                              size_t max_packets, size_t *out_num_packets_handled);
+
+/**
+ * @brief Handles a UDP packet received by an external receive backend (e.g. provizio_radar_api_io_uring_receiver) the
+ * same way provizio_radar_api_receive_packet(s) handle the packets they receive
+ *
+ * @param connection A previously connected provizio_radar_api_connection the packet has been received on
+ * @param packet The packet's payload (if it's a buffer of the connection's packet pool, it's taken care of)
+ * @param packet_size Size of the payload in bytes
+ * @param receive_time_ns Time the packet has been received at in nanoseconds since the epoch, 0 if unknown
+ * @return 0 if handled successfully, PROVIZIO_E_SKIPPED if skipped, other error value if failed for another reason
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_handle_received_packet(provizio_radar_api_connection *connection,
+                                                                     const void *packet, size_t packet_size,
+                                                                     uint64_t receive_time_ns);
+
+/**
+ * @brief Switches a previously connected API to (or from) non-blocking mode, to integrate it into an external event
+ * loop (e.g. epoll, poll, select or io_uring) rather than dedicating a thread to blocking receiving. In non-blocking
+ * mode provizio_radar_api_receive_packet(s) return PROVIZIO_E_TIMEOUT straight away when there is nothing to receive,
+ * and the connection's receive timeout is not used.
+ *
+ * @param connection A previously connected provizio_radar_api_connection
+ * @param non_blocking Non-zero to switch to non-blocking mode, 0 to switch back to blocking mode
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if not connected, other error code if failed for another reason
+ *
+ * @see provizio_radar_api_get_socket
+ * @see provizio_radar_api_drain
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_set_non_blocking(provizio_radar_api_connection *connection,
+                                                               uint8_t non_blocking);
+
+/**
+ * @brief Returns the socket of a connection, to be watched for readability by an external event loop
+ *
+ * @param connection A previously connected provizio_radar_api_connection
+ * @return The socket (file descriptor in POSIX systems), PROVIZIO__INVALID_SOCKET if not connected
+ *
+ * @warning The socket is owned by the connection: it's not to be read from or closed directly
+ */
+PROVIZIO__EXTERN_C PROVIZIO__SOCKET provizio_radar_api_get_socket(const provizio_radar_api_connection *connection);
+
+/**
+ * @brief Receives and handles every UDP packet already queued for a previously connected API, without waiting for more
+ * (i.e. until EAGAIN), regardless of the connection's mode. To be called whenever an external event loop reports the
+ * connection's socket readable.
+ *
+ * @param connection A previously connected provizio_radar_api_connection
+ * @param out_num_packets_handled Stores the number of packets received and handled, i.e. including skipped and failed
+ * ones (may be NULL)
+ * @return 0 if successful (including when nothing was queued or some of the packets were skipped), error code of the
+ * first failed packet handling (all the received packets are still handled), other error value if failed for another
+ * reason
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_drain(provizio_radar_api_connection *connection,
+                                                    size_t *out_num_packets_handled);
+
+/**
+ * @brief Returns partial point clouds past their completion deadline (see
+ * provizio_radar_point_cloud_api_context_set_completion_deadline and
+ * provizio_pooled_radar_point_cloud_api_context_set_completion_deadline) of the connection's contexts. To be called
+ * periodically, e.g. after every PROVIZIO_E_TIMEOUT of provizio_radar_api_receive_packet(s), so every frame is returned
+ * with a bounded latency even when the radar stops sending packets.
+ *
+ * @param connection A previously connected provizio_radar_api_connection
+ * @return Number of partial point clouds returned due to the deadline
+ */
+PROVIZIO__EXTERN_C size_t provizio_radar_api_tick(provizio_radar_api_connection *connection);
+
 /**
  * @brief Closes a previously connected radar API (either a single or multiple radars on the same port)
  *
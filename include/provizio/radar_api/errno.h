@@ -23,5 +23,6 @@
 #define PROVIZIO_E_PROTOCOL EPROTO       // Protocol error
 #define PROVIZIO_E_ARGUMENT EINVAL       // Invalid argument
 #define PROVIZIO_E_NOT_PERMITTED EPERM   // Operation not permitted
+#define PROVIZIO_E_OUT_OF_MEMORY ENOMEM  // Not enough memory in a caller-supplied memory pool
 
 #endif // PROVIZIO_RADAR_API_ERRNO
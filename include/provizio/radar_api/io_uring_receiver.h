@@ -0,0 +1,117 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_IO_URING_RECEIVER
+#define PROVIZIO_RADAR_API_IO_URING_RECEIVER
+
+#include "provizio/radar_api/core.h"
+
+// Default number of buffers provizio_radar_api_io_uring_receiver receives packets into
+#ifndef PROVIZIO__RADAR_API_IO_URING_DEFAULT_NUM_BUFFERS
+#define PROVIZIO__RADAR_API_IO_URING_DEFAULT_NUM_BUFFERS 256
+#endif // PROVIZIO__RADAR_API_IO_URING_DEFAULT_NUM_BUFFERS
+
+// Max time (in nanoseconds) provizio_radar_api_io_uring_receiver_release waits for the receive request to be cancelled
+#ifndef PROVIZIO__RADAR_API_IO_URING_CANCEL_TIMEOUT_NS
+#define PROVIZIO__RADAR_API_IO_URING_CANCEL_TIMEOUT_NS ((uint64_t)100000000)
+#endif // PROVIZIO__RADAR_API_IO_URING_CANCEL_TIMEOUT_NS
+
+// Max number of buffers of a provizio_radar_api_io_uring_receiver, as limited by the kernel
+#define PROVIZIO__RADAR_API_IO_URING_MAX_NUM_BUFFERS 32768
+
+/**
+ * @brief An optional io_uring based receive backend of a provizio_radar_api_connection (Linux 6.0+). A single
+ * multishot recvmsg request keeps receiving UDP packets into buffers registered with the kernel in advance (a provided
+ * buffer ring), so packets are received without a system call per packet (or per batch), and then handled straight
+ * from these buffers, the same way provizio_radar_api_receive_packets does.
+ *
+ * @warning Not thread safe, and the connection is not to be received from by other means while the receiver is used
+ * @note Receive timestamps (provizio_radar_api_enable_receive_timestamps) are not supported, so packets are handled
+ * with unknown receive times
+ * @see provizio_radar_api_io_uring_receiver_init
+ */
+typedef struct provizio_radar_api_io_uring_receiver
+{
+    provizio_radar_api_connection *connection;
+    int32_t ring_fd; // -1 if not initialized
+
+    // Submission and completion queues shared with the kernel (a single mapping)
+    void *rings;
+    size_t rings_size;
+    void *submission_queue_entries;
+    size_t submission_queue_entries_size;
+    uint32_t *submission_queue_head;
+    uint32_t *submission_queue_tail;
+    uint32_t *submission_queue_array;
+    uint32_t *submission_queue_flags;
+    uint32_t submission_queue_mask;
+    uint32_t *completion_queue_head;
+    uint32_t *completion_queue_tail;
+    void *completion_queue_entries;
+    uint32_t completion_queue_mask;
+
+    // The provided buffer ring, the message header template and the buffers themselves (a single mapping)
+    void *buffers_mapping;
+    size_t buffers_mapping_size;
+    void *message_header;
+    uint8_t *buffers;
+    uint32_t num_buffers;
+    uint16_t buffer_ring_tail;
+
+    uint8_t receiving; // Non-zero if the multishot receive request is active
+} provizio_radar_api_io_uring_receiver;
+
+/**
+ * @brief Initializes a provizio_radar_api_io_uring_receiver of a connection: sets up an io_uring instance, registers
+ * num_buffers buffers of PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES each with it, and starts receiving
+ *
+ * @param connection A previously connected provizio_radar_api_connection, must remain valid while the receiver is used
+ * @param num_buffers Number of packets that can be received before they are handled, must be a power of 2 not greater
+ * than PROVIZIO__RADAR_API_IO_URING_MAX_NUM_BUFFERS (use PROVIZIO__RADAR_API_IO_URING_DEFAULT_NUM_BUFFERS by default)
+ * @param out_receiver The provizio_radar_api_io_uring_receiver to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments, PROVIZIO_E_NOT_PERMITTED if io_uring (or
+ * its features required) is not supported on this platform or kernel, other error code if failed for another reason
+ *
+ * @note If the kernel has no spare buffers at the moment, packets remain queued in the socket until
+ * provizio_radar_api_io_uring_receiver_receive returns the buffers, so num_buffers should cover the packets expected
+ * between its calls
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_io_uring_receiver_init(
+    provizio_radar_api_connection *connection, size_t num_buffers, provizio_radar_api_io_uring_receiver *out_receiver);
+
+/**
+ * @brief Handles all the packets received by a provizio_radar_api_io_uring_receiver so far, waiting (up to
+ * wait_timeout_ns) only if there are none yet
+ *
+ * @param receiver Previously initialized provizio_radar_api_io_uring_receiver
+ * @param wait_timeout_ns Max number of nanoseconds to wait for a packet if none have been received yet, 0 to not wait
+ * @param out_num_packets_handled Stores the number of packets received and handled, i.e. including skipped and failed
+ * ones (may be NULL)
+ * @return 0 if received successfully (even if some of the packets were skipped), PROVIZIO_E_TIMEOUT if no packets were
+ * received in time, error code of the first failed packet handling (all the received packets are still handled),
+ * other error value if failed for another reason
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_io_uring_receiver_receive(provizio_radar_api_io_uring_receiver *receiver,
+                                                                        uint64_t wait_timeout_ns,
+                                                                        size_t *out_num_packets_handled);
+
+/**
+ * @brief Releases all resources of a provizio_radar_api_io_uring_receiver (but doesn't close its connection)
+ *
+ * @param receiver Previously initialized provizio_radar_api_io_uring_receiver
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if not initialized
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_io_uring_receiver_release(provizio_radar_api_io_uring_receiver *receiver);
+
+#endif // PROVIZIO_RADAR_API_IO_URING_RECEIVER
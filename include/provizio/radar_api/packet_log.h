@@ -0,0 +1,79 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_PACKET_LOG
+#define PROVIZIO_RADAR_API_PACKET_LOG
+
+#include "provizio/common.h"
+
+// A packet log is a sequence of segment files (<path_prefix>.<segment_index>.plog, segment_index is 6+ digits),
+// each laid out as:
+//   provizio_packet_log_segment_header
+//   provizio_packet_log_index_entry[max_index_entries] (first num_index_entries are valid)
+//   provizio_packet_log_record_header + payload, padded to PROVIZIO__PACKET_LOG_RECORD_ALIGNMENT (num_records of them)
+// All the fields use the host byte order (except for the source address and port, which use the network byte order),
+// so a segment can be mapped to memory and read in place. The header counters are updated after every record is
+// written, so a segment of a crashed recording remains readable up to the last complete record.
+
+#define PROVIZIO__PACKET_LOG_MAGIC "PRVZPLOG"
+#define PROVIZIO__PACKET_LOG_MAGIC_SIZE 8
+#define PROVIZIO__PACKET_LOG_VERSION ((uint32_t)1)
+#define PROVIZIO__PACKET_LOG_BYTE_ORDER_MARK ((uint32_t)0x01020304)
+#define PROVIZIO__PACKET_LOG_RECORD_ALIGNMENT 8
+#define PROVIZIO__PACKET_LOG_SEGMENT_EXTENSION ".plog"
+
+/**
+ * @brief Header of a packet log segment file
+ */
+typedef struct provizio_packet_log_segment_header
+{
+    char magic[PROVIZIO__PACKET_LOG_MAGIC_SIZE]; // PROVIZIO__PACKET_LOG_MAGIC, not null-terminated
+    uint32_t version;                            // PROVIZIO__PACKET_LOG_VERSION
+    uint32_t byte_order_mark;                    // PROVIZIO__PACKET_LOG_BYTE_ORDER_MARK in the writer's byte order
+    uint64_t segment_index;                      // 0-based index of the segment in the log
+    uint64_t index_offset;                       // Offset of the index entries from the start of the segment
+    uint32_t max_index_entries;                  // Capacity of the index
+    uint32_t num_index_entries;                  // Number of valid index entries
+    uint64_t records_offset;                     // Offset of the first record from the start of the segment
+    uint64_t records_end_offset;                 // Offset past the last complete record
+    uint64_t num_records;                        // Number of complete records
+} provizio_packet_log_segment_header;
+
+/**
+ * @brief An entry of the index of a packet log segment: the first record of a radar's frame in the segment (a frame
+ * started in a previous segment gets an entry for its first record in this one as well)
+ */
+typedef struct provizio_packet_log_index_entry
+{
+    uint16_t radar_position_id;
+    uint16_t reserved;
+    uint32_t frame_index;
+    uint64_t record_offset; // Offset of the record from the start of the segment
+} provizio_packet_log_index_entry;
+
+/**
+ * @brief Header of a single received packet's record in a packet log segment, followed by payload_size bytes of the
+ * packet's payload exactly as received
+ */
+typedef struct provizio_packet_log_record_header
+{
+    uint32_t record_size;     // Including the header, the payload and the padding
+    uint32_t payload_size;    // Size of the packet's payload in bytes
+    uint64_t receive_time_ns; // Time the packet has been received at in nanoseconds since the epoch
+    uint32_t source_address;  // IPv4 address the packet has been sent from, network byte order
+    uint16_t source_port;     // UDP port the packet has been sent from, network byte order
+    uint16_t reserved;
+} provizio_packet_log_record_header;
+
+#endif // PROVIZIO_RADAR_API_PACKET_LOG
@@ -0,0 +1,122 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_PACKET_RECORDER
+#define PROVIZIO_RADAR_API_PACKET_RECORDER
+
+#include "provizio/radar_api/errno.h"
+#include "provizio/radar_api/packet_log.h"
+
+// Default size of a packet log segment file in bytes
+#ifndef PROVIZIO__PACKET_RECORDER_DEFAULT_SEGMENT_SIZE
+#define PROVIZIO__PACKET_RECORDER_DEFAULT_SEGMENT_SIZE ((size_t)64 * 1024 * 1024)
+#endif // PROVIZIO__PACKET_RECORDER_DEFAULT_SEGMENT_SIZE
+
+// Default capacity of the index of a packet log segment
+#ifndef PROVIZIO__PACKET_RECORDER_DEFAULT_MAX_INDEX_ENTRIES
+#define PROVIZIO__PACKET_RECORDER_DEFAULT_MAX_INDEX_ENTRIES ((uint32_t)16384)
+#endif // PROVIZIO__PACKET_RECORDER_DEFAULT_MAX_INDEX_ENTRIES
+
+// Max length of the path prefix of a packet log, including the null terminator
+#define PROVIZIO__PACKET_RECORDER_MAX_PATH_PREFIX 256
+
+// Number of radars a packet recorder keeps track of the last indexed frames of, radars beyond it may get extra index
+// entries
+#define PROVIZIO__PACKET_RECORDER_NUM_INDEXED_RADARS 32
+
+/**
+ * @brief Records received packets to a packet log (see packet_log.h), one preallocated segment file mapped to memory at
+ * a time, so appending a packet is a memcpy with no system calls until the segment is full. A full segment is truncated
+ * to its actual size and the next one is started.
+ *
+ * @warning Not thread safe
+ * @note Currently supported on POSIX platforms only
+ * @see provizio_packet_recorder_open
+ * @see provizio_radar_api_set_packet_recorder
+ */
+typedef struct provizio_packet_recorder
+{
+    char path_prefix[PROVIZIO__PACKET_RECORDER_MAX_PATH_PREFIX];
+    size_t segment_size;
+    uint32_t max_index_entries;
+
+    int32_t segment_fd; // -1 if not open
+    uint8_t *segment;   // The current segment mapped to memory, NULL if not open
+    uint64_t segment_index;
+
+    // Last indexed frame per radar_position_id % PROVIZIO__PACKET_RECORDER_NUM_INDEXED_RADARS in the current segment
+    uint16_t indexed_radar_position_ids[PROVIZIO__PACKET_RECORDER_NUM_INDEXED_RADARS];
+    uint32_t indexed_frame_indices[PROVIZIO__PACKET_RECORDER_NUM_INDEXED_RADARS];
+    uint8_t indexed[PROVIZIO__PACKET_RECORDER_NUM_INDEXED_RADARS];
+
+    uint64_t num_records;  // Total number of packets recorded
+    uint64_t num_segments; // Total number of segments started
+} provizio_packet_recorder;
+
+/**
+ * @brief Opens a packet recorder, creating (or overwriting) the first segment of the log
+ *
+ * @param path_prefix Path of the log's segment files without the <segment_index>.plog suffix (e.g. "/data/drive_1"
+ * for /data/drive_1.000000.plog, /data/drive_1.000001.plog etc), shorter than PROVIZIO__PACKET_RECORDER_MAX_PATH_PREFIX
+ * @param segment_size Size of a segment file in bytes, 0 for PROVIZIO__PACKET_RECORDER_DEFAULT_SEGMENT_SIZE. Must fit
+ * the segment's header, index and at least a single record of the largest packet.
+ * @param max_index_entries Capacity of a segment's index, 0 for PROVIZIO__PACKET_RECORDER_DEFAULT_MAX_INDEX_ENTRIES. A
+ * segment with a full index is finished as a full one.
+ * @param out_recorder The provizio_packet_recorder to open
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments, PROVIZIO_E_NOT_PERMITTED if not supported
+ * on this platform, other error code if failed to create the segment file
+ *
+ * @note The recorder has to be eventually closed with provizio_packet_recorder_close
+ */
+PROVIZIO__EXTERN_C int32_t provizio_packet_recorder_open(const char *path_prefix, size_t segment_size,
+                                                         uint32_t max_index_entries,
+                                                         provizio_packet_recorder *out_recorder);
+
+/**
+ * @brief Appends a received packet to the log, starting a new segment if the current one is full
+ *
+ * @param recorder A previously opened provizio_packet_recorder
+ * @param packet The packet's payload
+ * @param packet_size Size of the payload in bytes, up to PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES
+ * @param receive_time_ns Time the packet has been received at in nanoseconds since the epoch, 0 to use the current time
+ * @param source_address IPv4 address the packet has been sent from, network byte order (as in sockaddr_in)
+ * @param source_port UDP port the packet has been sent from, network byte order (as in sockaddr_in)
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments, other error code if failed to start a new
+ * segment
+ */
+PROVIZIO__EXTERN_C int32_t provizio_packet_recorder_append(provizio_packet_recorder *recorder, const void *packet,
+                                                           size_t packet_size, uint64_t receive_time_ns,
+                                                           uint32_t source_address, uint16_t source_port);
+
+/**
+ * @brief Finishes the current segment (truncating it to its actual size) and closes the recorder
+ *
+ * @param recorder A previously opened provizio_packet_recorder
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if not open, other error code if failed to finish the segment
+ */
+PROVIZIO__EXTERN_C int32_t provizio_packet_recorder_close(provizio_packet_recorder *recorder);
+
+/**
+ * @brief Formats the path of a segment file of a packet log
+ *
+ * @param path_prefix Path of the log's segment files without the <segment_index>.plog suffix
+ * @param segment_index 0-based index of the segment
+ * @param out_path Buffer to store the null-terminated path to
+ * @param out_path_size Size of out_path in bytes
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if out_path is too small
+ */
+PROVIZIO__EXTERN_C int32_t provizio_packet_log_segment_path(const char *path_prefix, uint64_t segment_index,
+                                                            char *out_path, size_t out_path_size);
+
+#endif // PROVIZIO_RADAR_API_PACKET_RECORDER
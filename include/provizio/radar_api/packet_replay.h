@@ -0,0 +1,87 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_PACKET_REPLAY
+#define PROVIZIO_RADAR_API_PACKET_REPLAY
+
+#include "provizio/radar_api/errno.h"
+#include "provizio/radar_api/packet_log.h"
+#include "provizio/radar_api/pooled_radar_point_cloud.h"
+#include "provizio/radar_api/radar_point_cloud.h"
+
+// Max number of contexts a replay can feed packets to, as it keeps their callbacks to count the frames they return
+#ifndef PROVIZIO__PACKET_REPLAY_MAX_CONTEXTS
+#define PROVIZIO__PACKET_REPLAY_MAX_CONTEXTS 256
+#endif // PROVIZIO__PACKET_REPLAY_MAX_CONTEXTS
+
+/**
+ * @brief Results of replaying a packet log
+ *
+ * @see provizio_replay_packet_log
+ */
+typedef struct provizio_packet_replay_stats
+{
+    uint64_t num_segments;       // Number of segments replayed
+    uint64_t num_packets;        // Number of packets replayed
+    uint64_t num_frames;         // Number of frames (complete or partial) returned by the contexts during the replay
+    uint64_t num_failed_packets; // Number of packets that failed to be handled (other than non-point cloud ones)
+    uint64_t duration_ns;        // Wall time the replay took
+    float packets_per_second;    // Throughput achieved, num_packets / duration
+    float frames_per_second;     // Throughput achieved, num_frames / duration
+} provizio_packet_replay_stats;
+
+/**
+ * @brief Replays a packet log recorded by provizio_packet_recorder, feeding its packets to
+ * provizio_handle_possible_radars_point_cloud_packet, as if they were received from the radars. The log's segments are
+ * mapped to memory rather than read, and no sockets are involved, so a replay can be used for offline regression runs
+ * and, when not paced, as a throughput benchmark of the packets handling.
+ *
+ * @param path_prefix Path of the log's segment files without the <segment_index>.plog suffix (see
+ * provizio_packet_recorder_open). Segments are replayed from 0 and on, until the next one doesn't exist.
+ * @param speed 0 to replay as fast as possible, or a positive multiplier of the original pace, as recorded in the
+ * receive times of the packets (i.e. 1 for real time, 2 for twice as fast etc)
+ * @param contexts Previously initialized array of num_contexts of provizio_radar_point_cloud_api_context objects
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle), up to
+ * PROVIZIO__PACKET_REPLAY_MAX_CONTEXTS
+ * @param out_stats Stats of the replay, may be NULL
+ * @return 0 if successful (even if some packets failed to be handled, see num_failed_packets),
+ * PROVIZIO_E_ARGUMENT in case of invalid arguments or if the log doesn't exist, PROVIZIO_E_PROTOCOL if a segment is
+ * malformed, PROVIZIO_E_NOT_PERMITTED if not supported on this platform, other error code if failed to map a segment
+ *
+ * @note Callbacks of the contexts are called in the caller's thread. While the replay is running, the contexts'
+ * callback and user_data are substituted to count the frames returned, but callbacks still see their own user_data.
+ * @note Currently supported on POSIX platforms only
+ */
+PROVIZIO__EXTERN_C int32_t provizio_replay_packet_log(const char *path_prefix, float speed,
+                                                      provizio_radar_point_cloud_api_context *contexts,
+                                                      size_t num_contexts, provizio_packet_replay_stats *out_stats);
+
+/**
+ * @brief Same as provizio_replay_packet_log, but feeds the packets (along with their original receive times) to
+ * provizio_handle_possible_pooled_radars_point_cloud_packet_received_at
+ *
+ * @param path_prefix Path of the log's segment files without the <segment_index>.plog suffix
+ * @param speed 0 to replay as fast as possible, or a positive multiplier of the original pace
+ * @param contexts Previously initialized array of num_contexts of provizio_pooled_radar_point_cloud_api_context objects
+ * (in zero-copy mode, the packets are copied to buffers of their packet pool)
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle)
+ * @param out_stats Stats of the replay, may be NULL
+ * @return Same as provizio_replay_packet_log
+ */
+PROVIZIO__EXTERN_C int32_t provizio_replay_packet_log_pooled(const char *path_prefix, float speed,
+                                                             provizio_pooled_radar_point_cloud_api_context *contexts,
+                                                             size_t num_contexts,
+                                                             provizio_packet_replay_stats *out_stats);
+
+#endif // PROVIZIO_RADAR_API_PACKET_REPLAY
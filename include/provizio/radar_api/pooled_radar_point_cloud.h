@@ -0,0 +1,481 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_POOLED_RADAR_POINT_CLOUD
+#define PROVIZIO_RADAR_API_POOLED_RADAR_POINT_CLOUD
+
+#include "provizio/histogram.h"
+#include "provizio/memory_pool.h"
+#include "provizio/radar_api/radar_packet_pool.h"
+#include "provizio/radar_api/radar_point_cloud.h"
+
+// An alternative to provizio_radar_point_cloud / provizio_radar_point_cloud_api_context, which stores points of every
+// frame in a right-sized block of a caller-supplied memory pool rather than in a fixed-size array of
+// PROVIZIO__MAX_RADAR_POINTS_IN_POINT_CLOUD points. Points can be stored either as an array of provizio_radar_point or
+// as a provizio_radar_points_soa (see provizio_pooled_radar_point_cloud_api_context_init_soa).
+// In zero-copy mode (see provizio_pooled_radar_point_cloud_api_context_init_zero_copy) points are not copied at all:
+// the received packets are kept in a caller-supplied provizio_radar_packet_pool until the frame is handled, and the
+// callback gets a list of spans pointing to the points in the packets.
+// With ordered reassembly (see provizio_pooled_radar_point_cloud_api_context_enable_ordered_reassembly) points of every
+// packet are placed at the packet's position in the frame, as passed by a custom transport that knows it, rather than
+// appended in order of receiving.
+
+// Number of uint32_t words in a bitmap of packets ("chunks" of PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET points) of a
+// single point cloud, as used by ordered reassembly
+#define PROVIZIO__POOLED_RADAR_POINT_CLOUD_CHUNKS_BITMAP_SIZE                                                          \
+    ((PROVIZIO__MAX_RADAR_POINTS_IN_POINT_CLOUD / PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET + 1 + 31) / 32)
+
+/**
+ * @brief A complete or partial radar point cloud with points stored in a provizio_memory_pool
+ *
+ * @note Complete point clouds always have num_points_received == num_points_expected
+ */
+typedef struct provizio_pooled_radar_point_cloud
+{
+    uint32_t frame_index; // 0-based
+    uint64_t timestamp;   // Time of the frame capture measured in absolute number of nanoseconds since the start of the
+                          // GPS Epoch (midnight on Jan 6, 1980)
+    uint16_t radar_position_id;   // Either one of provizio_radar_position enum values or a custom position id
+    uint16_t num_points_expected; // Number of points in the entire frame
+    uint16_t num_points_received; // Number of points in the frame received so far
+    uint16_t radar_range;         // One of provizio_radar_range enum values
+    // Receive times of the earliest and the latest received packets of the frame in nanoseconds, or 0 if unknown. Since
+    // the Unix Epoch as reported by the kernel (see provizio_radar_api_enable_receive_timestamps), or by the NIC's own
+    // clock (see provizio_radar_api_enable_hardware_receive_timestamps), but never a mix of the two
+    uint64_t first_packet_receive_time_ns;
+    uint64_t last_packet_receive_time_ns;
+    provizio_radar_point *radar_points; // Allocated for num_points_expected points, num_points_received of them are set
+                                        // (NULL in zero-copy mode and for provizio_pooled_radar_point_cloud_layout_soa)
+    provizio_radar_points_soa radar_points_soa; // provizio_pooled_radar_point_cloud_layout_soa only: same as
+                                                // radar_points, but stored as columns
+    // Zero-copy mode only: num_spans spans of num_points_received points in total, in order of receiving, which
+    // differs from the radar's order of points if packets get reordered on the way (only set while being passed to the
+    // callback)
+    const provizio_radar_point_span *spans;
+    size_t num_spans;
+    // Ordered reassembly only: bitmap of chunks received, i.e. bit i % 32 of received_chunks[i / 32] is set if points
+    // [i * PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET, (i + 1) * PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET) have been
+    // received. Points of chunks not received are not initialized. Only set while being passed to the callback.
+    const uint32_t *received_chunks;
+} provizio_pooled_radar_point_cloud;
+
+struct provizio_pooled_radar_point_cloud_api_context;
+typedef void (*provizio_pooled_radar_point_cloud_callback)(
+    const provizio_pooled_radar_point_cloud *point_cloud,
+    struct provizio_pooled_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Specifies how points of provizio_pooled_radar_point_cloud are stored
+ */
+typedef enum provizio_pooled_radar_point_cloud_layout
+{
+    provizio_pooled_radar_point_cloud_layout_aos = 0, // radar_points
+    provizio_pooled_radar_point_cloud_layout_soa = 1  // radar_points_soa
+} provizio_pooled_radar_point_cloud_layout;
+
+typedef struct provizio_pooled_radar_point_cloud_storage
+{
+    void *memory; // Block of the memory pool the points are stored in (NULL in zero-copy mode)
+
+    // Zero-copy mode only
+    uint32_t num_packet_buffers;
+    uint32_t first_packet_buffer; // Index in provizio_radar_packet_pool::buffers, valid if num_packet_buffers > 0
+    uint32_t last_packet_buffer;  // Index in provizio_radar_packet_pool::buffers, valid if num_packet_buffers > 0
+
+    // Ordered reassembly only
+    uint32_t received_chunks[PROVIZIO__POOLED_RADAR_POINT_CLOUD_CHUNKS_BITMAP_SIZE];
+
+    // provizio_monotonic_time_ns of the first packet, if a completion deadline or stats are set
+    uint64_t first_packet_time_ns;
+} provizio_pooled_radar_point_cloud_storage;
+
+/**
+ * @brief A slot for a single frame being received by a provizio_pooled_radar_point_cloud_api_context
+ *
+ * @see provizio_pooled_radar_point_cloud_api_context_set_window
+ */
+typedef struct provizio_pooled_radar_point_cloud_slot
+{
+    provizio_pooled_radar_point_cloud point_cloud;
+    provizio_pooled_radar_point_cloud_storage storage;
+} provizio_pooled_radar_point_cloud_slot;
+
+// Stats of a provizio_pooled_radar_point_cloud_api_context, same as of a provizio_radar_point_cloud_api_context
+typedef provizio_radar_point_cloud_stats provizio_pooled_radar_point_cloud_stats;
+
+typedef struct provizio_pooled_radar_point_cloud_api_context_impl
+{
+    uint32_t latest_frame;
+    provizio_pooled_radar_point_cloud_slot
+        slots_being_received[PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT];
+    provizio_pooled_radar_point_cloud_slot *window; // Replaces slots_being_received if set
+    uint32_t window_size;
+    uint8_t ordered_reassembly;
+    uint64_t completion_deadline_ns; // 0 if not set
+    provizio_pooled_radar_point_cloud_stats *stats; // NULL if not set
+    provizio_radar_point_cloud_loss_tracker loss_tracker; // Stats only
+} provizio_pooled_radar_point_cloud_api_context_impl;
+
+/**
+ * @brief Keeps all data required for functioning of pooled radar point clouds API
+ */
+typedef struct provizio_pooled_radar_point_cloud_api_context
+{
+    provizio_pooled_radar_point_cloud_callback callback;
+    void *user_data;
+    uint16_t radar_position_id;
+    provizio_memory_pool *pool;              // NULL in zero-copy mode
+    provizio_radar_packet_pool *packet_pool; // Zero-copy mode only
+    provizio_pooled_radar_point_cloud_layout layout;
+    provizio_radar_api_contexts_dispatch_table *dispatch_table; // Used by the first of multiple contexts only, if set
+
+    provizio_pooled_radar_point_cloud_api_context_impl impl;
+} provizio_pooled_radar_point_cloud_api_context;
+
+/**
+ * @brief Returns the recommended size of a memory block (in bytes) for a provizio_memory_pool shared by contexts
+ * handling num_radars radars, i.e. enough for all their frames being received plus a spare frame
+ *
+ * @note As frames of different sizes fragment the pool (see provizio_memory_pool_required_size), it may still run out
+ * of memory. In that case, older incomplete frames of the same radar are returned to free some up and, if that isn't
+ * enough, handling the packet fails with PROVIZIO_E_OUT_OF_MEMORY.
+ *
+ * @param max_points_per_frame Max number of points in a single frame of any of the radars
+ * @param num_radars Number of radars, i.e. contexts sharing the pool
+ * @return Memory size in bytes to be used with provizio_memory_pool_init (suits both layouts)
+ */
+PROVIZIO__EXTERN_C size_t provizio_pooled_radar_point_cloud_pool_size(uint16_t max_points_per_frame,
+                                                                      size_t num_radars);
+
+/**
+ * @brief Returns the recommended size of a memory block (in bytes) for a provizio_memory_pool shared by contexts with a
+ * reassembly window of window_size frames (see provizio_pooled_radar_point_cloud_api_context_set_window)
+ *
+ * @param max_points_per_frame Max number of points in a single frame of any of the radars
+ * @param num_radars Number of radars, i.e. contexts sharing the pool
+ * @param window_size Number of frames being received at the same time per radar
+ * @return Memory size in bytes to be used with provizio_memory_pool_init (suits both layouts)
+ */
+PROVIZIO__EXTERN_C size_t provizio_pooled_radar_point_cloud_window_pool_size(uint16_t max_points_per_frame,
+                                                                             size_t num_radars, size_t window_size);
+
+/**
+ * @brief Initializes a provizio_pooled_radar_point_cloud_api_context object to handle a single radar
+ *
+ * @param callback Function to be called on receiving a complete or partial radar point cloud
+ * @param user_data Custom argument to be passed to the callback, may be NULL
+ * @param pool Previously initialized provizio_memory_pool to allocate points from, can be shared by multiple contexts
+ * (as long as they are all used by the same thread)
+ * @param context The provizio_pooled_radar_point_cloud_api_context object to initialize
+ *
+ * @warning radar_position_id of all packets handled by this context must be same
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_api_context_init(
+    provizio_pooled_radar_point_cloud_callback callback, void *user_data, provizio_memory_pool *pool,
+    provizio_pooled_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Initializes multiple provizio_pooled_radar_point_cloud_api_context objects to handle packets from multiple
+ * radars
+ *
+ * @param callback Function to be called on receiving a complete or partial radar point cloud
+ * @param user_data Custom argument to be passed to the callback, may be NULL
+ * @param pool Previously initialized provizio_memory_pool to allocate points from, shared by all the contexts
+ * @param contexts Array of num_contexts of provizio_pooled_radar_point_cloud_api_context objects to initialize
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle) to initialize
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_api_contexts_init(
+    provizio_pooled_radar_point_cloud_callback callback, void *user_data, provizio_memory_pool *pool,
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts);
+
+/**
+ * @brief Initializes a provizio_pooled_radar_point_cloud_api_context object to handle a single radar, storing points as
+ * provizio_radar_points_soa, i.e. scattering them to aligned columns straight on receiving
+ *
+ * @param callback Function to be called on receiving a complete or partial radar point cloud, gets radar_points_soa
+ * @param user_data Custom argument to be passed to the callback, may be NULL
+ * @param pool Previously initialized provizio_memory_pool to allocate points from, can be shared by multiple contexts
+ * (as long as they are all used by the same thread)
+ * @param context The provizio_pooled_radar_point_cloud_api_context object to initialize
+ *
+ * @warning radar_position_id of all packets handled by this context must be same
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_api_context_init_soa(
+    provizio_pooled_radar_point_cloud_callback callback, void *user_data, provizio_memory_pool *pool,
+    provizio_pooled_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Initializes multiple provizio_pooled_radar_point_cloud_api_context objects to handle packets from multiple
+ * radars, storing points as provizio_radar_points_soa
+ *
+ * @param callback Function to be called on receiving a complete or partial radar point cloud, gets radar_points_soa
+ * @param user_data Custom argument to be passed to the callback, may be NULL
+ * @param pool Previously initialized provizio_memory_pool to allocate points from, shared by all the contexts
+ * @param contexts Array of num_contexts of provizio_pooled_radar_point_cloud_api_context objects to initialize
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle) to initialize
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_api_contexts_init_soa(
+    provizio_pooled_radar_point_cloud_callback callback, void *user_data, provizio_memory_pool *pool,
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts);
+
+/**
+ * @brief Initializes a provizio_pooled_radar_point_cloud_api_context object to handle a single radar in zero-copy mode,
+ * i.e. keeping received packets in packet_pool until the point cloud is returned
+ *
+ * @param callback Function to be called on receiving a complete or partial radar point cloud, gets the points as spans
+ * @param user_data Custom argument to be passed to the callback, may be NULL
+ * @param packet_pool Previously initialized provizio_radar_packet_pool, can be shared by multiple contexts (as long as
+ * they are all used by the same thread)
+ * @param context The provizio_pooled_radar_point_cloud_api_context object to initialize
+ *
+ * @note Only protocol version 2 and newer packets are supported in zero-copy mode
+ * @warning radar_position_id of all packets handled by this context must be same
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_api_context_init_zero_copy(
+    provizio_pooled_radar_point_cloud_callback callback, void *user_data, provizio_radar_packet_pool *packet_pool,
+    provizio_pooled_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Initializes multiple provizio_pooled_radar_point_cloud_api_context objects to handle packets from multiple
+ * radars in zero-copy mode
+ *
+ * @param callback Function to be called on receiving a complete or partial radar point cloud, gets the points as spans
+ * @param user_data Custom argument to be passed to the callback, may be NULL
+ * @param packet_pool Previously initialized provizio_radar_packet_pool, shared by all the contexts
+ * @param contexts Array of num_contexts of provizio_pooled_radar_point_cloud_api_context objects to initialize
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle) to initialize
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_api_contexts_init_zero_copy(
+    provizio_pooled_radar_point_cloud_callback callback, void *user_data, provizio_radar_packet_pool *packet_pool,
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts);
+
+/**
+ * @brief Makes provizio_pooled_radar_point_cloud_api_context object handle a specific radar, which makes it skip
+ * packets intended for other radars
+ *
+ * @param context provizio_pooled_radar_point_cloud_api_context to be assigned
+ * @param radar_position_id radar to assign
+ * @return 0 in case it was successfully assigned, an error code otherwise
+ */
+PROVIZIO__EXTERN_C int32_t provizio_pooled_radar_point_cloud_api_context_assign(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_radar_position radar_position_id);
+
+/**
+ * @brief Makes multiple provizio_pooled_radar_point_cloud_api_context objects dispatch packets between them in
+ * constant time using a provizio_radar_api_contexts_dispatch_table
+ *
+ * @param contexts Previously initialized array of num_contexts of provizio_pooled_radar_point_cloud_api_context objects
+ * @param num_contexts Number of contexts, must be positive and not exceed UINT16_MAX
+ * @param dispatch_table The provizio_radar_api_contexts_dispatch_table to initialize and use, must remain valid as long
+ * as the contexts are used. May be NULL to go back to looking contexts up linearly.
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of an invalid num_contexts
+ *
+ * @note It's to be called again if the contexts are re-initialized
+ */
+PROVIZIO__EXTERN_C int32_t provizio_pooled_radar_point_cloud_api_contexts_set_dispatch_table(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts,
+    provizio_radar_api_contexts_dispatch_table *dispatch_table);
+
+/**
+ * @brief Makes a provizio_pooled_radar_point_cloud_api_context receive up to window_size frames at the same time, using
+ * caller-supplied slots (rather than PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT
+ * built-in ones). Slots are compact, as points are stored in the pool, and a frame is mapped to its slot in constant
+ * time (frame_index % window_size). A frame is returned as partial only once it falls out of the window, i.e. a frame
+ * window_size or more frames newer is received, and packets of frames already out of the window are skipped as
+ * obsolete. Complete frames are still returned in order of frame indices, so a complete frame is kept until all older
+ * frames have been returned.
+ *
+ * @param context Previously initialized provizio_pooled_radar_point_cloud_api_context, with no frames being received
+ * (i.e. before handling any packets or after provizio_pooled_radar_point_cloud_api_context_release)
+ * @param slots Array of window_size slots, must remain valid as long as the context is used
+ * @param window_size Number of slots, must be positive and not exceed UINT16_MAX
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments
+ *
+ * @note The pool (or packet pool) is to be sized accordingly, see provizio_pooled_radar_point_cloud_window_pool_size
+ */
+PROVIZIO__EXTERN_C int32_t provizio_pooled_radar_point_cloud_api_context_set_window(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_pooled_radar_point_cloud_slot *slots,
+    size_t window_size);
+
+/**
+ * @brief Makes a provizio_pooled_radar_point_cloud_api_context place points of every packet at the packet's position in
+ * the frame, rather than append them in order of receiving, and drop duplicate packets.
+ *
+ * Radars split frames to packets of exactly PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET points ("chunks"), but the last
+ * one. The packet header doesn't include the packet's position in the frame, so it has to be known to a custom
+ * transport (e.g. from its own sequence numbers), that passes it to
+ * provizio_handle_pooled_radar_point_cloud_packet_chunk.
+ * Other functions handling packets (including receiving them by provizio_radar_api_connection) reject packets of such a
+ * context with PROVIZIO_E_NOT_PERMITTED. Packets that don't fit their chunk are rejected with PROVIZIO_E_PROTOCOL.
+ *
+ * @param context Previously initialized provizio_pooled_radar_point_cloud_api_context, frames being received (if any)
+ * are dropped
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments, PROVIZIO_E_NOT_PERMITTED in zero-copy
+ * mode, as packets are kept in order of receiving
+ *
+ * @note Partial point clouds may have gaps, see provizio_pooled_radar_point_cloud::received_chunks
+ */
+PROVIZIO__EXTERN_C int32_t provizio_pooled_radar_point_cloud_api_context_enable_ordered_reassembly(
+    provizio_pooled_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Sets a completion deadline of point clouds being received by a provizio_pooled_radar_point_cloud_api_context,
+ * so a partial point cloud doesn't wait for a newer frame to be returned (e.g. when the radar stops sending packets)
+ *
+ * @param context Previously initialized provizio_pooled_radar_point_cloud_api_context
+ * @param deadline_ns Max number of nanoseconds since receiving the first packet of a frame till it's returned by one of
+ * provizio_pooled_radar_point_cloud_api_context(s)_tick (or provizio_radar_api_tick), or 0 to disable the deadline
+ *
+ * @note The deadline applies to the frames started after the call
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_api_context_set_completion_deadline(
+    provizio_pooled_radar_point_cloud_api_context *context, uint64_t deadline_ns);
+
+/**
+ * @brief Returns point clouds being received by a provizio_pooled_radar_point_cloud_api_context past their completion
+ * deadline as partial (as well as older ones, to keep the order of frames). To be called periodically, e.g. after every
+ * receive timeout.
+ *
+ * @param context Previously initialized provizio_pooled_radar_point_cloud_api_context
+ * @return Number of partial point clouds returned due to the deadline
+ *
+ * @see provizio_pooled_radar_point_cloud_api_context_set_completion_deadline
+ */
+PROVIZIO__EXTERN_C size_t provizio_pooled_radar_point_cloud_api_context_tick(
+    provizio_pooled_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Same as provizio_pooled_radar_point_cloud_api_context_tick, but for multiple contexts
+ *
+ * @param contexts Previously initialized array of num_contexts of provizio_pooled_radar_point_cloud_api_context objects
+ * @param num_contexts Number of contexts
+ * @return Number of partial point clouds returned due to the deadline
+ */
+PROVIZIO__EXTERN_C size_t provizio_pooled_radar_point_cloud_api_contexts_tick(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts);
+
+/**
+ * @brief Makes a provizio_pooled_radar_point_cloud_api_context count handled packets and returned point clouds, as well
+ * as record their sizes and timings, in caller-supplied stats
+ *
+ * @param context Previously initialized provizio_pooled_radar_point_cloud_api_context
+ * @param stats Zero-initialized (or previously used) stats, must remain valid as long as the context uses them. Can be
+ * shared by multiple contexts used by the same thread. NULL to stop collecting stats.
+ *
+ * @note Timings cost 2 provizio_monotonic_time_ns calls per point cloud, none per packet
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_api_context_set_stats(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_pooled_radar_point_cloud_stats *stats);
+
+/**
+ * @brief Same as provizio_radar_point_cloud_stats_snapshot
+ *
+ * @param stats The provizio_pooled_radar_point_cloud_stats to copy
+ * @param out_snapshot The provizio_pooled_radar_point_cloud_stats to copy to
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_stats_snapshot(
+    const provizio_pooled_radar_point_cloud_stats *stats, provizio_pooled_radar_point_cloud_stats *out_snapshot);
+
+/**
+ * @brief Drops all point clouds being received by the context (without calling the callback) and returns their memory
+ * (or packet buffers) to the pool, i.e. the context can be disposed or reused after that
+ *
+ * @param context Previously initialized provizio_pooled_radar_point_cloud_api_context
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_api_context_release(
+    provizio_pooled_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Handles a single radar point cloud UDP packet from a single radar
+ *
+ * @param context Previously initialized provizio_pooled_radar_point_cloud_api_context
+ * @param packet Valid provizio_radar_point_cloud_packet. In zero-copy mode, if it's the payload of a buffer acquired
+ * from the context's packet pool, the buffer is taken over (i.e. kept till the frame is handled or released) regardless
+ * of the result, otherwise the packet is copied to a buffer of the packet pool.
+ * @param packet_size The size of the packet, to check data is valid and avoid out-of-bounds access
+ * @return 0 in case the packet was handled successfully, PROVIZIO_E_SKIPPED in case the packet was skipped as obsolete,
+ * PROVIZIO_E_OUT_OF_MEMORY in case the pool (or packet pool) doesn't have enough memory for a new frame, other error
+ * code in case of another error
+ *
+ * @warning radar_position_id of all packets handled by this context must be same (returns an error otherwise)
+ */
+PROVIZIO__EXTERN_C int32_t provizio_handle_pooled_radar_point_cloud_packet(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_radar_point_cloud_packet *packet,
+    size_t packet_size);
+
+/**
+ * @brief Same as provizio_handle_pooled_radar_point_cloud_packet, but places the packet's points at a known position
+ * in the frame (a context with ordered reassembly enabled only)
+ *
+ * @param context Previously initialized provizio_pooled_radar_point_cloud_api_context with ordered reassembly enabled
+ * @param packet Valid provizio_radar_point_cloud_packet
+ * @param packet_size The size of the packet, to check data is valid and avoid out-of-bounds access
+ * @param chunk_index 0-based position of the packet in the frame, i.e. of its first point in units of
+ * PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET points
+ * @return 0 in case the packet was handled successfully, PROVIZIO_E_SKIPPED in case the packet was skipped as obsolete
+ * or duplicate, PROVIZIO_E_PROTOCOL in case the packet doesn't fit the chunk, other error code in case of another error
+ */
+PROVIZIO__EXTERN_C int32_t provizio_handle_pooled_radar_point_cloud_packet_chunk(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_radar_point_cloud_packet *packet,
+    size_t packet_size, uint32_t chunk_index);
+
+/**
+ * @brief Handles a single radar point cloud UDP packet from one of multiple radars
+ *
+ * @param contexts Previously initialized array of num_contexts of provizio_pooled_radar_point_cloud_api_context objects
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle)
+ * @param packet Valid provizio_radar_point_cloud_packet, taken over in zero-copy mode if it's the payload of a buffer
+ * acquired from the contexts' packet pool (see provizio_handle_pooled_radar_point_cloud_packet)
+ * @param packet_size The size of the packet, to check data is valid and avoid out-of-bounds access
+ * @return 0 in case the packet was handled successfully, PROVIZIO_E_SKIPPED in case the packet was skipped as obsolete,
+ * PROVIZIO_E_OUT_OF_CONTEXTS in case num_contexts is not enough, PROVIZIO_E_OUT_OF_MEMORY in case the pool (or packet
+ * pool) doesn't have enough memory for a new frame, other error code in case of another error
+ */
+PROVIZIO__EXTERN_C int32_t provizio_handle_pooled_radars_point_cloud_packet(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts,
+    provizio_radar_point_cloud_packet *packet, size_t packet_size);
+
+/**
+ * @brief Handles a single Provizio Radar API UDP packet from one of multiple radars, that can be a correct
+ * provizio_radar_point_cloud_packet or something else
+ *
+ * @param contexts Previously initialized array of num_contexts of provizio_pooled_radar_point_cloud_api_context objects
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle)
+ * @param payload The payload of the UDP packet, taken over in zero-copy mode if it's the payload of a buffer acquired
+ * from the contexts' packet pool (see provizio_handle_pooled_radar_point_cloud_packet)
+ * @param payload_size The size of the payload in bytes
+ * @return 0 if it's a provizio_radar_point_cloud_packet and it was handled successfully, PROVIZIO_E_SKIPPED if it's not
+ * a provizio_radar_point_cloud_packet, PROVIZIO_E_OUT_OF_CONTEXTS in case num_contexts is not enough, other error code
+ * if it's a provizio_radar_point_cloud_packet but its handling failed for another reason
+ */
+PROVIZIO__EXTERN_C int32_t provizio_handle_possible_pooled_radars_point_cloud_packet(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts, const void *payload,
+    size_t payload_size);
+
+/**
+ * @brief Same as provizio_handle_possible_pooled_radars_point_cloud_packet, but also records the packet's receive time
+ * in the point cloud (see provizio_pooled_radar_point_cloud::first_packet_receive_time_ns)
+ *
+ * @param contexts Previously initialized array of num_contexts of provizio_pooled_radar_point_cloud_api_context objects
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle)
+ * @param payload The payload of the UDP packet (see provizio_handle_possible_pooled_radars_point_cloud_packet)
+ * @param payload_size The size of the payload in bytes
+ * @param receive_time_ns Receive time of the packet in nanoseconds since the Unix Epoch, or 0 if unknown
+ * @return Same as provizio_handle_possible_pooled_radars_point_cloud_packet
+ */
+PROVIZIO__EXTERN_C int32_t provizio_handle_possible_pooled_radars_point_cloud_packet_received_at(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts, const void *payload,
+    size_t payload_size, uint64_t receive_time_ns);
+
+#endif // PROVIZIO_RADAR_API_POOLED_RADAR_POINT_CLOUD
@@ -0,0 +1,201 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_RADAR_API_ARENA
+#define PROVIZIO_RADAR_API_RADAR_API_ARENA
+
+#include "provizio/memory_pool.h"
+#include "provizio/radar_api/pooled_radar_point_cloud.h"
+#include "provizio/radar_api/radar_points_accumulation_types.h"
+
+/**
+ * @brief Limits the state kept by a provizio_radar_api_arena is sized by
+ *
+ * @see provizio_radar_api_arena_config_init
+ */
+typedef struct provizio_radar_api_arena_config
+{
+    size_t max_radars;             // Number of contexts, 1 to UINT16_MAX
+    uint16_t max_points_per_frame; // Max number of points in a single frame of any of the radars, 1 or more
+    // Number of frames being received at the same time per radar (see
+    // provizio_pooled_radar_point_cloud_api_context_set_window), 0 to use the contexts' built-in slots
+    size_t window_size;
+    size_t history_depth; // Number of point clouds to accumulate per radar, 0 for no accumulation
+    provizio_pooled_radar_point_cloud_layout layout;
+} provizio_radar_api_arena_config;
+
+/**
+ * @brief A past point cloud of a radar accumulated by a provizio_radar_api_arena, along with a provizio_enu_fix of the
+ * radar at the moment of capture. Unlike provizio_accumulated_radar_point_cloud, which embeds a full-size point cloud,
+ * its points are stored in the arena with room for config.max_points_per_frame points.
+ *
+ * @see provizio_radar_api_arena_accumulate
+ */
+typedef struct provizio_radar_api_arena_accumulated_point_cloud
+{
+    uint32_t frame_index;
+    uint64_t timestamp; // Same as provizio_pooled_radar_point_cloud::timestamp
+    uint16_t radar_position_id;
+    uint16_t radar_range;
+    uint16_t num_points;                // Number of points in radar_points
+    provizio_radar_point *radar_points; // Room for config.max_points_per_frame points
+    provizio_enu_fix fix_when_received;
+} provizio_radar_api_arena_accumulated_point_cloud;
+
+/**
+ * @brief Point clouds accumulated by a single context of a provizio_radar_api_arena, as a circular buffer
+ */
+typedef struct provizio_radar_api_arena_accumulation
+{
+    provizio_radar_api_arena_accumulated_point_cloud *point_clouds; // config.history_depth point clouds
+    size_t newest; // Index of the newest accumulated point cloud in point_clouds, valid if count > 0
+    size_t count;  // Number of point clouds accumulated so far, up to config.history_depth
+} provizio_radar_api_arena_accumulation;
+
+/**
+ * @brief All state required to receive point clouds of multiple radars (and optionally accumulate them), carved out of
+ * a single caller-supplied memory block at sizes derived from a provizio_radar_api_arena_config, so that nothing is
+ * allocated on the heap or kept on the stack:
+ * - config.max_radars provizio_pooled_radar_point_cloud_api_context objects
+ * - config.window_size reassembly slots per context (if set)
+ * - a provizio_memory_pool for points of config.max_radars radars' frames being received, right-sized by
+ * config.max_points_per_frame
+ * - config.history_depth accumulated point clouds per context of config.max_points_per_frame points each (if set)
+ *
+ * @warning Contexts keep a pointer to the pool, so the arena must not be moved or copied once initialized
+ * @see provizio_radar_api_arena_required_size
+ * @see provizio_radar_api_arena_init
+ */
+typedef struct provizio_radar_api_arena
+{
+    provizio_radar_api_arena_config config;
+    provizio_pooled_radar_point_cloud_api_context *contexts; // config.max_radars contexts
+    provizio_pooled_radar_point_cloud_slot *slots; // config.window_size slots of every context, NULL if not set
+    // Point clouds accumulated by every context, i.e. the ones of contexts[i] are accumulations[i], NULL if
+    // config.history_depth is not set
+    provizio_radar_api_arena_accumulation *accumulations;
+    provizio_memory_pool pool;
+} provizio_radar_api_arena;
+
+/**
+ * @brief Initializes provizio_radar_api_arena_config with defaults: a single radar of up to
+ * PROVIZIO__MAX_RADAR_POINTS_IN_POINT_CLOUD points per frame, using the contexts' built-in slots, no accumulation and
+ * provizio_pooled_radar_point_cloud_layout_aos
+ *
+ * @param out_config The provizio_radar_api_arena_config to initialize
+ */
+PROVIZIO__EXTERN_C void provizio_radar_api_arena_config_init(provizio_radar_api_arena_config *out_config);
+
+/**
+ * @brief Returns the size of a memory block (in bytes) required by provizio_radar_api_arena_init, i.e. a byte less is
+ * not enough
+ *
+ * @note Its pool part is sized by provizio_pooled_radar_point_cloud_window_pool_size, so, just like any other pool of
+ * pooled contexts, it may still run out of memory due to fragmentation (see
+ * provizio_pooled_radar_point_cloud_pool_size)
+ *
+ * @param config Limits of the arena
+ * @return Required memory size in bytes, including the worst case alignment of the memory block, or 0 in case of an
+ * invalid config
+ */
+PROVIZIO__EXTERN_C size_t provizio_radar_api_arena_required_size(const provizio_radar_api_arena_config *config);
+
+/**
+ * @brief Initializes a provizio_radar_api_arena in a caller-supplied memory block, i.e. initializes its contexts (with
+ * reassembly windows, if set) and their accumulations (if set)
+ *
+ * @param config Limits of the arena
+ * @param callback Function to be called on receiving a complete or partial radar point cloud by any of the contexts
+ * @param user_data Custom argument to be passed to the callback, may be NULL
+ * @param memory Memory block to carve the state out of, must remain valid as long as the arena is used. Doesn't have to
+ * be aligned.
+ * @param memory_size The size of memory in bytes, at least provizio_radar_api_arena_required_size(config)
+ * @param out_arena The provizio_radar_api_arena to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of an invalid config or not enough memory
+ *
+ * @note Packets are to be handled by the arena's contexts as usual, f.e. using
+ * provizio_handle_pooled_radars_point_cloud_packet(arena.contexts, arena.config.max_radars, packet, packet_size)
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_arena_init(const provizio_radar_api_arena_config *config,
+                                                         provizio_pooled_radar_point_cloud_callback callback,
+                                                         void *user_data, void *memory, size_t memory_size,
+                                                         provizio_radar_api_arena *out_arena);
+
+/**
+ * @brief Accumulates a point cloud received by one of the arena's contexts, copying its points to the arena and
+ * dropping the oldest point cloud accumulated by the context if its history is full. Unlike
+ * provizio_accumulate_radar_point_cloud, all points are accumulated, i.e. filters are not supported.
+ *
+ * @param arena Previously initialized provizio_radar_api_arena with a positive config.history_depth
+ * @param context_index Index of the context in arena->contexts
+ * @param point_cloud The point cloud to accumulate of up to config.max_points_per_frame points, f.e. as passed to the
+ * callback (of any layout, including zero-copy)
+ * @param fix_when_received A provizio_enu_fix of the radar at the moment of the point cloud capture (see
+ * provizio_accumulate_radar_point_cloud)
+ * @return 0 if successful, PROVIZIO_E_SKIPPED if the point cloud has no points, PROVIZIO_E_ARGUMENT in case of invalid
+ * arguments, including a point cloud older than the newest one accumulated by the context
+ *
+ * @note Just like provizio_accumulate_radar_point_cloud, resets the context's accumulation on a frame indices overflow
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_api_arena_accumulate(provizio_radar_api_arena *arena, size_t context_index,
+                                                               const provizio_pooled_radar_point_cloud *point_cloud,
+                                                               const provizio_enu_fix *fix_when_received);
+
+/**
+ * @brief Returns a point cloud accumulated by one of the arena's contexts
+ *
+ * @param arena Previously initialized provizio_radar_api_arena with a positive config.history_depth
+ * @param context_index Index of the context in arena->contexts
+ * @param age 0 for the newest accumulated point cloud, 1 for the one before it, etc
+ * @return The accumulated point cloud, or NULL if fewer than age + 1 point clouds are accumulated or in case of invalid
+ * arguments
+ */
+PROVIZIO__EXTERN_C const provizio_radar_api_arena_accumulated_point_cloud *
+provizio_radar_api_arena_get_accumulated_point_cloud(const provizio_radar_api_arena *arena, size_t context_index,
+                                                     size_t age);
+
+/**
+ * @brief Transforms points of all point clouds accumulated by one of the arena's contexts relative to the specified
+ * provizio_enu_fix of the radar, same as provizio_transform_accumulated_radar_points
+ *
+ * @param arena Previously initialized provizio_radar_api_arena with a positive config.history_depth
+ * @param context_index Index of the context in arena->contexts
+ * @param current_fix A provizio_enu_fix of the radar to transform relative to, i.e. where the same radar is at now
+ * @param out_transformed_points Array of max_points radar points to store transformed points in, from newest to oldest
+ * @param max_points Max number of points to store in out_transformed_points, points that don't fit are skipped
+ * @return Number of transformed points stored in out_transformed_points
+ */
+PROVIZIO__EXTERN_C size_t provizio_radar_api_arena_transform_accumulated_points(
+    const provizio_radar_api_arena *arena, size_t context_index, const provizio_enu_fix *current_fix,
+    provizio_radar_point *out_transformed_points, size_t max_points);
+
+/**
+ * @brief Drops all point clouds accumulated by one of the arena's contexts, f.e. when a new ENU reference point is
+ * required
+ *
+ * @param arena Previously initialized provizio_radar_api_arena with a positive config.history_depth
+ * @param context_index Index of the context in arena->contexts
+ */
+PROVIZIO__EXTERN_C void provizio_radar_api_arena_reset_accumulation(provizio_radar_api_arena *arena,
+                                                                    size_t context_index);
+
+/**
+ * @brief Releases all point clouds being received by the arena's contexts (without calling the callback), i.e. the
+ * memory block can be freed or reused after that
+ *
+ * @param arena Previously initialized provizio_radar_api_arena
+ */
+PROVIZIO__EXTERN_C void provizio_radar_api_arena_release(provizio_radar_api_arena *arena);
+
+#endif // PROVIZIO_RADAR_API_RADAR_API_ARENA
@@ -0,0 +1,120 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_RADAR_PACKET_POOL
+#define PROVIZIO_RADAR_API_RADAR_PACKET_POOL
+
+#include "provizio/radar_api/radar_point_cloud.h"
+
+/**
+ * @brief A buffer to receive a single UDP packet into, that can be kept as is (i.e. without copying its content) until
+ * the point cloud it belongs to is handled
+ */
+typedef struct provizio_radar_packet_buffer
+{
+    uint8_t payload[PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES]; // Normally a provizio_radar_point_cloud_packet
+    uint32_t next; // Index of the next buffer in the same list (of a point cloud or of free buffers)
+} provizio_radar_packet_buffer;
+
+/**
+ * @brief A contiguous range of radar points (located in a provizio_radar_packet_buffer)
+ */
+typedef struct provizio_radar_point_span
+{
+    const provizio_radar_point *radar_points;
+    uint16_t num_points;
+} provizio_radar_point_span;
+
+/**
+ * @brief A pool of provizio_radar_packet_buffer in caller-supplied memory, used for zero-copy point clouds handling
+ *
+ * @warning Not thread safe
+ * @see provizio_radar_packet_pool_init
+ * @see provizio_pooled_radar_point_cloud_api_context_init_zero_copy
+ */
+typedef struct provizio_radar_packet_pool
+{
+    provizio_radar_packet_buffer *buffers;
+    provizio_radar_point_span *spans; // Used to describe a point cloud being returned, one per buffer
+    uint32_t num_buffers;
+    uint32_t first_free_buffer;
+    uint32_t num_free_buffers;
+} provizio_radar_packet_pool;
+
+/**
+ * @brief Returns the recommended number of buffers in a provizio_radar_packet_pool shared by contexts handling
+ * num_radars radars: enough for all frames being received plus PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE buffers
+ * to receive a batch of packets into, as provizio_radar_api_receive_packets acquires a buffer for every packet of a
+ * batch before handling any of them
+ *
+ * @param max_points_per_frame Max number of points in a single frame of any of the radars
+ * @param num_radars Number of radars, i.e. contexts sharing the pool
+ * @return Number of buffers (and spans) to be used with provizio_radar_packet_pool_init
+ */
+PROVIZIO__EXTERN_C size_t provizio_radar_packet_pool_num_buffers(uint16_t max_points_per_frame, size_t num_radars);
+
+/**
+ * @brief Same as provizio_radar_packet_pool_num_buffers, but for contexts with a reassembly window of window_size
+ * frames (see provizio_pooled_radar_point_cloud_api_context_set_window)
+ *
+ * @param max_points_per_frame Max number of points in a single frame of any of the radars
+ * @param num_radars Number of radars, i.e. contexts sharing the pool
+ * @param window_size Number of frames being received at the same time per radar
+ * @return Number of buffers (and spans) to be used with provizio_radar_packet_pool_init
+ */
+PROVIZIO__EXTERN_C size_t provizio_radar_packet_pool_window_num_buffers(uint16_t max_points_per_frame,
+                                                                        size_t num_radars, size_t window_size);
+
+/**
+ * @brief Initializes a provizio_radar_packet_pool in caller-supplied memory
+ *
+ * @param buffers Array of num_buffers buffers, must remain valid as long as the pool is used
+ * @param spans Array of num_buffers spans, must remain valid as long as the pool is used
+ * @param num_buffers Number of buffers, must be positive
+ * @param out_pool The provizio_radar_packet_pool to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_packet_pool_init(provizio_radar_packet_buffer *buffers,
+                                                           provizio_radar_point_span *spans, size_t num_buffers,
+                                                           provizio_radar_packet_pool *out_pool);
+
+/**
+ * @brief Takes a free buffer to receive a packet into. It's to be either passed to one of provizio_handle_*pooled*
+ * functions (which take care of it afterwards) or returned using provizio_radar_packet_pool_release.
+ *
+ * @param pool Previously initialized provizio_radar_packet_pool
+ * @return A free buffer or NULL if there are none
+ */
+PROVIZIO__EXTERN_C provizio_radar_packet_buffer *provizio_radar_packet_pool_acquire(provizio_radar_packet_pool *pool);
+
+/**
+ * @brief Returns a previously acquired buffer to the pool
+ *
+ * @param pool The provizio_radar_packet_pool the buffer was acquired from
+ * @param buffer The buffer to return
+ */
+PROVIZIO__EXTERN_C void provizio_radar_packet_pool_release(provizio_radar_packet_pool *pool,
+                                                           provizio_radar_packet_buffer *buffer);
+
+/**
+ * @brief Returns a buffer of the pool the memory belongs to, if any
+ *
+ * @param pool Previously initialized provizio_radar_packet_pool (may be NULL)
+ * @param payload Pointer to the payload of a packet
+ * @return The buffer if payload is the payload of one of the pool's buffers, NULL otherwise
+ */
+PROVIZIO__EXTERN_C provizio_radar_packet_buffer *provizio_radar_packet_pool_find(provizio_radar_packet_pool *pool,
+                                                                                 const void *payload);
+
+#endif // PROVIZIO_RADAR_API_RADAR_PACKET_POOL
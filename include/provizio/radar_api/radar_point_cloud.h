@@ -15,6 +15,7 @@
 #ifndef PROVIZIO_RADAR_API_RADAR_POINT_CLOUD
 #define PROVIZIO_RADAR_API_RADAR_POINT_CLOUD
 
+#include "provizio/histogram.h"
 #include "provizio/radar_api/common.h"
 #include "provizio/radar_api/radar_position.h"
 #include "provizio/radar_api/radar_ranges.h"
@@ -111,6 +112,8 @@ provizio_radar_point_cloud_packet_size(const provizio_radar_point_cloud_packet_h
  * @brief A complete or partial radar point cloud
  *
  * @note Complete point clouds always have num_points_received == num_points_expected
+ * @note Points beyond num_points_received are always zero, which is maintained by resetting only the points received
+ * (rather than the entire radar_points array) once a point cloud has been handled
  */
 typedef struct provizio_radar_point_cloud
 {
@@ -121,9 +124,95 @@ typedef struct provizio_radar_point_cloud
     uint16_t num_points_expected; // Number of points in the entire frame
     uint16_t num_points_received; // Number of points in the frame received so far
     uint16_t radar_range;         // One of provizio_radar_range enum values
+    // Receive times of the earliest and the latest received packets of the frame in nanoseconds, or 0 if unknown. Since
+    // the Unix Epoch as reported by the kernel (see provizio_radar_api_enable_receive_timestamps), or by the NIC's own
+    // clock (see provizio_radar_api_enable_hardware_receive_timestamps), but never a mix of the two
+    uint64_t first_packet_receive_time_ns;
+    uint64_t last_packet_receive_time_ns;
     provizio_radar_point radar_points[PROVIZIO__MAX_RADAR_POINTS_IN_POINT_CLOUD];
 } provizio_radar_point_cloud;
 
+#ifndef PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT
+#define PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT 64 // Alignment (in bytes) of every column of provizio_radar_points_soa
+#endif // PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT
+
+/**
+ * @brief Radar points stored as a structure of arrays (one column per provizio_radar_point field) in caller-supplied
+ * memory, every column aligned to PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT bytes, which suits SIMD processing
+ *
+ * @see provizio_radar_points_soa_init
+ */
+typedef struct provizio_radar_points_soa
+{
+    float *x_meters;
+    float *y_meters;
+    float *z_meters;
+    float *radar_relative_radial_velocity_m_s;
+    float *signal_to_noise_ratio;
+    float *ground_relative_radial_velocity_m_s;
+    uint16_t capacity; // Number of points every column has room for
+} provizio_radar_points_soa;
+
+// Number of possible radar_position_id values
+#define PROVIZIO__RADAR_POSITION_IDS_COUNT ((size_t)provizio_radar_position_max + 1)
+
+/**
+ * @brief Maps radar_position_id values (including custom ones) to indices of contexts handling them, so that packets
+ * are dispatched between multiple contexts in constant time regardless of the number of radars. It's filled lazily, as
+ * radars are first seen. Given its size (128KB), it's normally allocated statically or on heap.
+ *
+ * @see provizio_radar_point_cloud_api_contexts_set_dispatch_table
+ * @see provizio_pooled_radar_point_cloud_api_contexts_set_dispatch_table
+ */
+typedef struct provizio_radar_api_contexts_dispatch_table
+{
+    uint16_t context_indices[PROVIZIO__RADAR_POSITION_IDS_COUNT]; // Index + 1 of the context by radar_position_id, or 0
+} provizio_radar_api_contexts_dispatch_table;
+
+// Number of frames behind the latest one that are tracked to tell frames arriving late from missing ones
+#define PROVIZIO__RADAR_POINT_CLOUD_RECENT_FRAMES_COUNT 64
+
+/**
+ * @brief Counters and histograms of a radar point clouds API context (either provizio_radar_point_cloud_api_context or
+ * provizio_pooled_radar_point_cloud_api_context), updated without locking as packets are handled, so they can be read
+ * by other threads (see provizio_radar_point_cloud_stats_snapshot)
+ *
+ * @see provizio_radar_point_cloud_api_context_set_stats
+ * @see provizio_pooled_radar_point_cloud_api_context_set_stats
+ * @note Zero-initialized (e.g. using memset) stats are ready to use
+ */
+typedef struct provizio_radar_point_cloud_stats
+{
+    uint64_t num_packets_received; // Point cloud packets handled by the context, including skipped ones
+    uint64_t num_packets_skipped;  // Packets skipped as obsolete, duplicate or belonging to an empty frame
+    uint64_t num_frames_complete;  // Point clouds returned complete
+    uint64_t num_frames_partial;   // Point clouds returned partial
+    // Frames not received judging by gaps in frame_index (excluding frames that arrived late, up to
+    // PROVIZIO__RADAR_POINT_CLOUD_RECENT_FRAMES_COUNT frames behind the latest one)
+    uint64_t num_frames_missing;
+    uint64_t num_points_lost; // Points missing in partial point clouds returned
+    // Packets received right after a packet sent after them, i.e. of a newer frame or of a later chunk of the same
+    // frame (chunks are known with ordered reassembly only, otherwise just the shorter last packet is known to be last)
+    uint64_t num_packets_out_of_order;
+    uint64_t num_packets_duplicate;  // Packets of chunks already received (detected with ordered reassembly only)
+    uint64_t num_frame_index_resets; // Times frame indices wrapped around, which drops the frames being received
+    provizio_histogram points_per_frame;       // Number of points received of every point cloud returned
+    provizio_histogram reassembly_duration_ns; // Since receiving the first packet of a frame till returning it
+    provizio_histogram callback_duration_ns;   // Time spent in the callback per point cloud
+} provizio_radar_point_cloud_stats;
+
+/**
+ * @brief State of a radar point clouds API context required to account for packet and frame loss in its stats
+ *
+ * @note Zero-initialized state means no packets have been accounted yet
+ */
+typedef struct provizio_radar_point_cloud_loss_tracker
+{
+    uint64_t recent_frames;     // Bit i is set if frame latest_frame - i has been received (all set on the first frame)
+    uint32_t last_packet_frame; // frame_index of the last packet accounted
+    uint32_t last_packet_chunk; // Position of the last packet accounted in its frame, in chunks
+} provizio_radar_point_cloud_loss_tracker;
+
 struct provizio_radar_point_cloud_api_context;
 typedef void (*provizio_radar_point_cloud_callback)(const provizio_radar_point_cloud *point_cloud,
                                                     struct provizio_radar_point_cloud_api_context *context);
@@ -136,6 +225,12 @@ typedef struct provizio_radar_point_cloud_api_context_impl
     uint32_t latest_frame;
     provizio_radar_point_cloud
         point_clouds_being_received[PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT];
+    // provizio_monotonic_time_ns of the first packet of every point cloud being received, if a completion deadline or
+    // stats are set
+    uint64_t first_packet_times_ns[PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT];
+    uint64_t completion_deadline_ns;           // 0 if not set
+    provizio_radar_point_cloud_stats *stats;   // NULL if not set
+    provizio_radar_point_cloud_loss_tracker loss_tracker; // Stats only
 } provizio_radar_point_cloud_api_context_impl;
 
 /**
@@ -146,6 +241,7 @@ typedef struct provizio_radar_point_cloud_api_context
     provizio_radar_point_cloud_callback callback;
     void *user_data;
     uint16_t radar_position_id;
+    provizio_radar_api_contexts_dispatch_table *dispatch_table; // Used by the first of multiple contexts only, if set
 
     provizio_radar_point_cloud_api_context_impl impl;
 } provizio_radar_point_cloud_api_context;
@@ -187,6 +283,137 @@ PROVIZIO__EXTERN_C void provizio_radar_point_cloud_api_contexts_init(provizio_ra
 PROVIZIO__EXTERN_C int32_t provizio_radar_point_cloud_api_context_assign(
     provizio_radar_point_cloud_api_context *context, provizio_radar_position radar_position_id);
 
+/**
+ * @brief Makes multiple provizio_radar_point_cloud_api_context objects dispatch packets between them in constant time
+ * using a provizio_radar_api_contexts_dispatch_table
+ *
+ * @param contexts Previously initialized array of num_contexts of provizio_radar_point_cloud_api_context objects
+ * @param num_contexts Number of contexts, must be positive and not exceed UINT16_MAX
+ * @param dispatch_table The provizio_radar_api_contexts_dispatch_table to initialize and use, must remain valid as long
+ * as the contexts are used. May be NULL to go back to looking contexts up linearly.
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of an invalid num_contexts
+ *
+ * @note It's to be called again if the contexts are re-initialized
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_point_cloud_api_contexts_set_dispatch_table(
+    provizio_radar_point_cloud_api_context *contexts, size_t num_contexts,
+    provizio_radar_api_contexts_dispatch_table *dispatch_table);
+
+/**
+ * @brief Sets a completion deadline of point clouds being received by a provizio_radar_point_cloud_api_context, so a
+ * partial point cloud doesn't wait for a newer frame to be returned (e.g. when the radar stops sending packets)
+ *
+ * @param context Previously initialized provizio_radar_point_cloud_api_context
+ * @param deadline_ns Max number of nanoseconds since receiving the first packet of a frame till it's returned by one of
+ * provizio_radar_point_cloud_api_context(s)_tick (or provizio_radar_api_tick), or 0 to disable the deadline
+ *
+ * @note The deadline applies to the frames started after the call
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_api_context_set_completion_deadline(
+    provizio_radar_point_cloud_api_context *context, uint64_t deadline_ns);
+
+/**
+ * @brief Returns point clouds being received by a provizio_radar_point_cloud_api_context past their completion deadline
+ * as partial (as well as older ones, to keep the order of frames). To be called periodically, e.g. after every receive
+ * timeout.
+ *
+ * @param context Previously initialized provizio_radar_point_cloud_api_context
+ * @return Number of partial point clouds returned due to the deadline
+ *
+ * @see provizio_radar_point_cloud_api_context_set_completion_deadline
+ */
+PROVIZIO__EXTERN_C size_t provizio_radar_point_cloud_api_context_tick(provizio_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Same as provizio_radar_point_cloud_api_context_tick, but for multiple contexts
+ *
+ * @param contexts Previously initialized array of num_contexts of provizio_radar_point_cloud_api_context objects
+ * @param num_contexts Number of contexts
+ * @return Number of partial point clouds returned due to the deadline
+ */
+PROVIZIO__EXTERN_C size_t provizio_radar_point_cloud_api_contexts_tick(provizio_radar_point_cloud_api_context *contexts,
+                                                                       size_t num_contexts);
+
+/**
+ * @brief Makes a provizio_radar_point_cloud_api_context count handled packets and returned point clouds, as well as
+ * record their sizes and timings, in caller-supplied stats
+ *
+ * @param context Previously initialized provizio_radar_point_cloud_api_context
+ * @param stats Zero-initialized (or previously used) stats, must remain valid as long as the context uses them. Can be
+ * shared by multiple contexts used by the same thread. NULL to stop collecting stats.
+ *
+ * @note Timings cost 2 provizio_monotonic_time_ns calls per point cloud, none per packet
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_api_context_set_stats(
+    provizio_radar_point_cloud_api_context *context, provizio_radar_point_cloud_stats *stats);
+
+/**
+ * @brief Copies stats that may be concurrently updated by a radar point clouds API context, e.g. to export them to a
+ * metrics system from another thread
+ *
+ * @param stats The provizio_radar_point_cloud_stats to copy
+ * @param out_snapshot The provizio_radar_point_cloud_stats to copy to
+ *
+ * @note Every counter is read atomically, but the snapshot as a whole is not (e.g. a packet may already be counted as
+ * received but not as skipped yet)
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_stats_snapshot(const provizio_radar_point_cloud_stats *stats,
+                                                                  provizio_radar_point_cloud_stats *out_snapshot);
+
+/**
+ * @brief Accounts a packet of frame_index for loss in stats, i.e. counts missing frames by gaps in frame indices (and
+ * un-counts frames arriving late) and newer frames overtaken by older ones. Shared by all radar point clouds API
+ * contexts and to be called before the context's latest frame is updated.
+ *
+ * @param stats The provizio_radar_point_cloud_stats to update
+ * @param loss_tracker The context's provizio_radar_point_cloud_loss_tracker
+ * @param latest_frame The latest frame_index seen by the context before this packet
+ * @param frame_index frame_index of the packet
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_stats_account_frame(
+    provizio_radar_point_cloud_stats *stats, provizio_radar_point_cloud_loss_tracker *loss_tracker,
+    uint32_t latest_frame, uint32_t frame_index);
+
+/**
+ * @brief Accounts the position of a packet in its frame for out of order packets in stats. Shared by all radar point
+ * clouds API contexts and to be called after provizio_radar_point_cloud_stats_account_frame.
+ *
+ * @param stats The provizio_radar_point_cloud_stats to update
+ * @param loss_tracker The context's provizio_radar_point_cloud_loss_tracker
+ * @param chunk_index 0-based position of the packet in the frame in units of PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET
+ * points, if known, or UINT32_MAX to derive it from the numbers of points
+ * @param num_points_expected Number of points in the entire frame
+ * @param num_points_received Number of points of the frame received before the packet
+ * @param num_points_in_packet Number of points in the packet
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_stats_account_packet(
+    provizio_radar_point_cloud_stats *stats, provizio_radar_point_cloud_loss_tracker *loss_tracker,
+    uint32_t chunk_index, uint16_t num_points_expected, uint16_t num_points_received, uint16_t num_points_in_packet);
+
+/**
+ * @brief Accounts a point cloud about to be passed to the callback in stats. Shared by all radar point clouds API
+ * contexts.
+ *
+ * @param stats The provizio_radar_point_cloud_stats to update
+ * @param num_points_expected Number of points in the entire frame
+ * @param num_points_received Number of points of the frame received
+ * @param first_packet_time_ns provizio_monotonic_time_ns of the first packet of the frame, or 0 if unknown
+ * @return provizio_monotonic_time_ns of the callback start, to be passed to
+ * provizio_radar_point_cloud_stats_account_callback once the callback returns
+ */
+PROVIZIO__EXTERN_C uint64_t provizio_radar_point_cloud_stats_account_frame_returned(
+    provizio_radar_point_cloud_stats *stats, uint16_t num_points_expected, uint16_t num_points_received,
+    uint64_t first_packet_time_ns);
+
+/**
+ * @brief Accounts the time spent in the callback in stats. Shared by all radar point clouds API contexts.
+ *
+ * @param stats The provizio_radar_point_cloud_stats to update
+ * @param callback_start_time_ns As returned by provizio_radar_point_cloud_stats_account_frame_returned
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_stats_account_callback(provizio_radar_point_cloud_stats *stats,
+                                                                          uint64_t callback_start_time_ns);
+
 /**
  * @brief Handles a single radar point cloud UDP packet from a single radar
  *
@@ -249,6 +476,43 @@ PROVIZIO__EXTERN_C int32_t provizio_handle_possible_radar_point_cloud_packet(
 PROVIZIO__EXTERN_C int32_t provizio_handle_possible_radars_point_cloud_packet(
     provizio_radar_point_cloud_api_context *contexts, size_t num_contexts, const void *payload, size_t payload_size);
 
+/**
+ * @brief Same as provizio_handle_possible_radars_point_cloud_packet, but also records the packet's receive time in the
+ * point cloud (see provizio_radar_point_cloud::first_packet_receive_time_ns)
+ *
+ * @param contexts Previously initialized array of num_contexts of provizio_radar_point_cloud_api_context objects
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle)
+ * @param payload The payload of the UDP packet
+ * @param payload_size The size of the payload in bytes
+ * @param receive_time_ns Receive time of the packet in nanoseconds since the Unix Epoch, or 0 if unknown
+ * @return Same as provizio_handle_possible_radars_point_cloud_packet
+ */
+PROVIZIO__EXTERN_C int32_t provizio_handle_possible_radars_point_cloud_packet_received_at(
+    provizio_radar_point_cloud_api_context *contexts, size_t num_contexts, const void *payload, size_t payload_size,
+    uint64_t receive_time_ns);
+
+/**
+ * @brief Checks a radar point cloud UDP packet to be valid, i.e. to be safe to handle
+ *
+ * @param packet A provizio_radar_point_cloud_packet to check
+ * @param packet_size The size of the packet
+ * @return 0 if the packet is valid, PROVIZIO_E_PROTOCOL otherwise
+ */
+PROVIZIO__EXTERN_C int32_t provizio_check_radar_point_cloud_packet(provizio_radar_point_cloud_packet *packet,
+                                                                   size_t packet_size);
+
+/**
+ * @brief Converts all radar points of a radar point cloud UDP packet (of any supported protocol version) to the host
+ * representation
+ *
+ * @param packet A provizio_radar_point_cloud_packet previously checked with provizio_check_radar_point_cloud_packet
+ * @param out_points Array of at least header.num_points_in_packet points to store the converted points. Can be
+ * packet->radar_points for converting in place, as long as the protocol version is 2 or newer.
+ * @return 0 if successful, PROVIZIO_E_PROTOCOL in case of an unsupported protocol version
+ */
+PROVIZIO__EXTERN_C int32_t provizio_get_radar_point_cloud_packet_points(const provizio_radar_point_cloud_packet *packet,
+                                                                        provizio_radar_point *out_points);
+
 #if defined(__cplusplus) && __cplusplus >= 201103L
 static_assert(offsetof(provizio_radar_point_cloud_packet_header, protocol_header) == 0,
               "Unexpected position of protocol_header in provizio_radar_point_cloud_packet_header");
@@ -285,4 +549,60 @@ static_assert(offsetof(provizio_radar_point, ground_relative_radial_velocity_m_s
 static_assert(sizeof(provizio_radar_point) == 24, "Unexpected size of provizio_radar_point");
 #endif // defined(__cplusplus) && __cplusplus >= 201103L
 
+/**
+ * @brief Converts all radar points of a radar point cloud UDP packet (of any supported protocol version) to the host
+ * representation, scattering them straight to columns of a provizio_radar_points_soa
+ *
+ * @param packet A provizio_radar_point_cloud_packet previously checked with provizio_check_radar_point_cloud_packet
+ * @param out_points provizio_radar_points_soa to store the converted points to
+ * @param first_point_index Index in out_points to store the first point of the packet to
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if out_points doesn't have enough capacity, PROVIZIO_E_PROTOCOL in case
+ * of an unsupported protocol version
+ */
+PROVIZIO__EXTERN_C int32_t provizio_get_radar_point_cloud_packet_points_soa(
+    const provizio_radar_point_cloud_packet *packet, provizio_radar_points_soa *out_points, uint16_t first_point_index);
+
+/**
+ * @brief Returns the size of memory (in bytes) required for a provizio_radar_points_soa of the specified capacity,
+ * including space for alignment
+ *
+ * @param capacity Number of points to store
+ * @return Memory size in bytes to be used with provizio_radar_points_soa_init
+ */
+PROVIZIO__EXTERN_C size_t provizio_radar_points_soa_required_size(uint16_t capacity);
+
+/**
+ * @brief Initializes a provizio_radar_points_soa with columns located in caller-supplied memory
+ *
+ * @param memory Memory to place the columns in, must remain valid as long as out_points is used
+ * @param memory_size Size of memory in bytes, at least provizio_radar_points_soa_required_size(capacity)
+ * @param capacity Number of points to store
+ * @param out_points The provizio_radar_points_soa to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if there is not enough memory
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_points_soa_init(void *memory, size_t memory_size, uint16_t capacity,
+                                                          provizio_radar_points_soa *out_points);
+
+/**
+ * @brief Converts radar points from an array of provizio_radar_point to a provizio_radar_points_soa
+ *
+ * @param points Array of num_points points
+ * @param num_points Number of points to convert
+ * @param out_points provizio_radar_points_soa to store the points to, starting from index 0
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if out_points doesn't have enough capacity
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_points_aos_to_soa(const provizio_radar_point *points, uint16_t num_points,
+                                                            provizio_radar_points_soa *out_points);
+
+/**
+ * @brief Converts radar points from a provizio_radar_points_soa to an array of provizio_radar_point
+ *
+ * @param points provizio_radar_points_soa to convert points from, starting from index 0
+ * @param num_points Number of points to convert
+ * @param out_points Array of at least num_points points to store the points to
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if points doesn't have num_points points
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_points_soa_to_aos(const provizio_radar_points_soa *points,
+                                                            uint16_t num_points, provizio_radar_point *out_points);
+
 #endif // PROVIZIO_RADAR_API_RADAR_POINT_CLOUD
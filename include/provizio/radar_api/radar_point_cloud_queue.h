@@ -0,0 +1,190 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_RADAR_POINT_CLOUD_QUEUE
+#define PROVIZIO_RADAR_API_RADAR_POINT_CLOUD_QUEUE
+
+#include "provizio/radar_api/pooled_radar_point_cloud.h"
+#include "provizio/radar_api/radar_point_cloud.h"
+#include "provizio/spsc_queue.h"
+
+// Time (in nanoseconds) provizio_radar_point_cloud_queue_pop sleeps for between checks while the queue is empty, on
+// platforms other than Linux (where it waits on a futex)
+#ifndef PROVIZIO__RADAR_POINT_CLOUD_QUEUE_POLL_INTERVAL_NS
+#define PROVIZIO__RADAR_POINT_CLOUD_QUEUE_POLL_INTERVAL_NS ((uint64_t)100000)
+#endif // PROVIZIO__RADAR_POINT_CLOUD_QUEUE_POLL_INTERVAL_NS
+
+/**
+ * @brief A bounded lock-free queue of complete or partial point clouds in caller-supplied slots, used to hand point
+ * clouds over from the thread receiving packets to a consumer thread. Contexts publish to it instead of calling a
+ * callback (see provizio_radar_point_cloud_api_contexts_init_queued and
+ * provizio_pooled_radar_point_cloud_queue_publish), so heavy processing doesn't stall receiving. Publishing copies only
+ * the points received and never allocates memory. If the queue is full, the point cloud being published is dropped.
+ *
+ * Slots are either provizio_radar_point_cloud (see provizio_radar_point_cloud_queue_init) or, to not spend 1.5MB per
+ * slot, provizio_pooled_radar_point_cloud with room for as many points as the radars send per frame (see
+ * provizio_radar_point_cloud_queue_init_pooled). Both classic and pooled contexts can publish to either of them.
+ *
+ * @warning Thread safe only as long as all contexts publishing to the queue are used in a single thread, and a single
+ * thread consumes the point clouds
+ * @see provizio_radar_point_cloud_queue_init
+ */
+typedef struct provizio_radar_point_cloud_queue
+{
+    provizio_spsc_queue queue;
+    provizio_radar_point *points; // Points of all pooled slots, NULL unless initialized by *_init_pooled
+    uint16_t max_points_per_slot; // Pooled slots only
+    uint32_t num_dropped_point_clouds; // Point clouds dropped as the queue was full, use PROVIZIO__ATOMIC_LOAD_UINT32
+                                       // to read concurrently
+    uint32_t num_published;            // Changes on every publishing, the consumer waits for it to change
+    uint32_t consumer_waiting;         // Non-zero while the consumer waits, so that publishing has to wake it up
+} provizio_radar_point_cloud_queue;
+
+/**
+ * @brief Initializes a provizio_radar_point_cloud_queue in caller-supplied memory
+ *
+ * @param slots Array of num_slots point clouds, must remain valid as long as the queue is used. Given the size of
+ * provizio_radar_point_cloud, it's normally allocated statically or on heap.
+ * @param num_slots Max number of point clouds in the queue, must be positive
+ * @param out_queue The provizio_radar_point_cloud_queue to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_point_cloud_queue_init(provizio_radar_point_cloud *slots, size_t num_slots,
+                                                                 provizio_radar_point_cloud_queue *out_queue);
+
+/**
+ * @brief Initializes a provizio_radar_point_cloud_queue of provizio_pooled_radar_point_cloud slots in caller-supplied
+ * memory, so that slots take only as much memory as the points they are meant to hold. Point clouds are consumed by
+ * provizio_radar_point_cloud_queue_try_pop_pooled and provizio_radar_point_cloud_queue_pop_pooled.
+ *
+ * @param slots Array of num_slots point clouds, must remain valid as long as the queue is used
+ * @param points Array of num_slots * max_points_per_slot points, must remain valid as long as the queue is used
+ * @param num_slots Max number of point clouds in the queue, must be positive
+ * @param max_points_per_slot Max number of points in a single point cloud (point clouds of more points received get
+ * dropped), must be positive
+ * @param out_queue The provizio_radar_point_cloud_queue to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_point_cloud_queue_init_pooled(provizio_pooled_radar_point_cloud *slots,
+                                                                        provizio_radar_point *points, size_t num_slots,
+                                                                        uint16_t max_points_per_slot,
+                                                                        provizio_radar_point_cloud_queue *out_queue);
+
+/**
+ * @brief A provizio_radar_point_cloud_callback publishing point clouds to the provizio_radar_point_cloud_queue set as
+ * the context's user_data
+ *
+ * @param point_cloud The point cloud to publish
+ * @param context The context handling it, with user_data pointing to a provizio_radar_point_cloud_queue
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_queue_publish(const provizio_radar_point_cloud *point_cloud,
+                                                                 provizio_radar_point_cloud_api_context *context);
+
+/**
+ * @brief A provizio_pooled_radar_point_cloud_callback publishing point clouds to the provizio_radar_point_cloud_queue
+ * set as the context's user_data, i.e. pooled contexts are initialized with it as the callback and the queue as the
+ * user_data. Points are published as an array of structures whatever the context's layout and mode are. In ordered
+ * reassembly the points of the chunks received are published one after another, without gaps.
+ *
+ * @param point_cloud The point cloud to publish
+ * @param context The context handling it, with user_data pointing to a provizio_radar_point_cloud_queue
+ */
+PROVIZIO__EXTERN_C void provizio_pooled_radar_point_cloud_queue_publish(
+    const provizio_pooled_radar_point_cloud *point_cloud, provizio_pooled_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Initializes a provizio_radar_point_cloud_api_context object to handle a single radar, publishing point clouds
+ * to a queue rather than calling a callback
+ *
+ * @param queue Previously initialized provizio_radar_point_cloud_queue to publish to
+ * @param context The provizio_radar_point_cloud_api_context object to initialize
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_api_context_init_queued(
+    provizio_radar_point_cloud_queue *queue, provizio_radar_point_cloud_api_context *context);
+
+/**
+ * @brief Initializes multiple provizio_radar_point_cloud_api_context objects to handle packets from multiple radars,
+ * publishing point clouds to a queue rather than calling a callback
+ *
+ * @param queue Previously initialized provizio_radar_point_cloud_queue to publish to
+ * @param contexts Array of num_contexts of provizio_radar_point_cloud_api_context objects to initialize
+ * @param num_contexts Number of contexts (i.e. max numbers of radars to handle) to initialize
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_api_contexts_init_queued(
+    provizio_radar_point_cloud_queue *queue, provizio_radar_point_cloud_api_context *contexts, size_t num_contexts);
+
+/**
+ * @brief Takes the oldest point cloud in the queue without waiting (consumer only)
+ *
+ * @param queue Previously initialized provizio_radar_point_cloud_queue
+ * @return The point cloud (only the first num_points_received of its radar_points are valid), or NULL if the queue is
+ * empty. It remains valid until provizio_radar_point_cloud_queue_release is called.
+ * @warning Queues of pooled slots are to be consumed by provizio_radar_point_cloud_queue_try_pop_pooled instead
+ */
+PROVIZIO__EXTERN_C const provizio_radar_point_cloud *
+provizio_radar_point_cloud_queue_try_pop(provizio_radar_point_cloud_queue *queue);
+
+/**
+ * @brief Same as provizio_radar_point_cloud_queue_try_pop, but for queues of pooled slots (see
+ * provizio_radar_point_cloud_queue_init_pooled)
+ *
+ * @param queue Previously initialized provizio_radar_point_cloud_queue of pooled slots
+ * @return The point cloud (num_points_received of its radar_points are set), or NULL if the queue is empty. It remains
+ * valid until provizio_radar_point_cloud_queue_release is called.
+ */
+PROVIZIO__EXTERN_C const provizio_pooled_radar_point_cloud *
+provizio_radar_point_cloud_queue_try_pop_pooled(provizio_radar_point_cloud_queue *queue);
+
+/**
+ * @brief Takes the oldest point cloud in the queue, waiting for one to be published if the queue is empty (consumer
+ * only)
+ *
+ * @param queue Previously initialized provizio_radar_point_cloud_queue
+ * @param timeout_ns Max number of nanoseconds to wait for
+ * @param out_point_cloud Stores the point cloud (only the first num_points_received of its radar_points are valid),
+ * which remains valid until provizio_radar_point_cloud_queue_release is called
+ * @return 0 if successful, PROVIZIO_E_TIMEOUT if the queue remained empty for timeout_ns
+ * @warning Queues of pooled slots are to be consumed by provizio_radar_point_cloud_queue_pop_pooled instead
+ *
+ * @note In Linux the consumer sleeps on a futex that publishing wakes it up with (publishing makes a system call only
+ * while the consumer waits, and never takes locks), other platforms poll every
+ * PROVIZIO__RADAR_POINT_CLOUD_QUEUE_POLL_INTERVAL_NS
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_point_cloud_queue_pop(provizio_radar_point_cloud_queue *queue,
+                                                                uint64_t timeout_ns,
+                                                                const provizio_radar_point_cloud **out_point_cloud);
+
+/**
+ * @brief Same as provizio_radar_point_cloud_queue_pop, but for queues of pooled slots (see
+ * provizio_radar_point_cloud_queue_init_pooled)
+ *
+ * @param queue Previously initialized provizio_radar_point_cloud_queue of pooled slots
+ * @param timeout_ns Max number of nanoseconds to wait for
+ * @param out_point_cloud Stores the point cloud (num_points_received of its radar_points are set), which remains valid
+ * until provizio_radar_point_cloud_queue_release is called
+ * @return 0 if successful, PROVIZIO_E_TIMEOUT if the queue remained empty for timeout_ns
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_point_cloud_queue_pop_pooled(
+    provizio_radar_point_cloud_queue *queue, uint64_t timeout_ns,
+    const provizio_pooled_radar_point_cloud **out_point_cloud);
+
+/**
+ * @brief Releases the point cloud returned by provizio_radar_point_cloud_queue_(try_)pop or
+ * provizio_radar_point_cloud_queue_(try_)pop_pooled, making its slot available for publishing (consumer only)
+ *
+ * @param queue The provizio_radar_point_cloud_queue the point cloud was taken from
+ */
+PROVIZIO__EXTERN_C void provizio_radar_point_cloud_queue_release(provizio_radar_point_cloud_queue *queue);
+
+#endif // PROVIZIO_RADAR_API_RADAR_POINT_CLOUD_QUEUE
@@ -182,9 +182,11 @@ PROVIZIO__EXTERN_C void provizio_accumulated_radar_point_cloud_iterator_next_poi
  * @see provizio_accumulated_radar_point_cloud_iterator
  * @see provizio_enu_fix
  *
- * @note When non-NULL optional_out_transformed_point_cloud is specified, the transformation is done without any use of
- * hardware acceleration, so it can be slow. When runtime performance is important and appropriate hw capabilities are
- * present, it's recommended to use optional_out_transformation_matrix and then hw-accelerated transformation instead.
+ * @note When non-NULL optional_out_transformed_point_cloud is specified, the transformation is done on CPU using
+ * provizio_transform_radar_points. When appropriate hw capabilities (f.e. GPU) are present, it may be more efficient
+ * to use optional_out_transformation_matrix and then hw-accelerated transformation instead.
+ * @see provizio_transform_radar_points
+ * @see provizio_transform_accumulated_radar_points
  */
 PROVIZIO__EXTERN_C const provizio_accumulated_radar_point_cloud *
 provizio_accumulated_radar_point_cloud_iterator_get_point_cloud(
@@ -226,4 +228,62 @@ PROVIZIO__EXTERN_C const provizio_radar_point *provizio_accumulated_radar_point_
     const provizio_accumulated_radar_point_cloud *accumulated_point_clouds, size_t num_accumulated_point_clouds,
     provizio_radar_point *optional_out_transformed_point, float *optional_out_transformation_matrix);
 
+/**
+ * @brief Builds a 4x4 transformation matrix that transforms positions of radar points from where they were relative to
+ * the radar at the moment of their capture to where they would be "seen" by the same radar in its current position, if
+ * it could still "see" them.
+ *
+ * @param fix_when_received A provizio_enu_fix of the radar at the moment of the points capture.
+ * @param current_fix A provizio_enu_fix of the radar to transform relative to, i.e. where the same radar is at now.
+ * @param out_transformation_matrix Must point to a float array 16 floats (64 bytes) long to store the 4x4
+ * transformation matrix in column major order.
+ * @see provizio_transform_radar_points
+ *
+ * @warning Both fixes must have valid rotation orientations (see provizio_quaternion_is_valid_rotation).
+ */
+PROVIZIO__EXTERN_C void provizio_build_transformation_matrix(const provizio_enu_fix *fix_when_received,
+                                                             const provizio_enu_fix *current_fix,
+                                                             float *out_transformation_matrix);
+
+/**
+ * @brief Transforms positions of radar points by multiplying a 4x4 transformation matrix to them (as (x, y, z, 1)
+ * 4d-vectors). Uses SIMD (SSE/AVX on x86, NEON on ARM) when available, as selected at runtime on first call.
+ *
+ * @param transformation_matrix A 4x4 transformation matrix in column major order (16 floats), f.e. as generated by
+ * provizio_accumulated_radar_point_cloud_iterator_get_point_cloud.
+ * @param points Radar points to transform.
+ * @param num_points Number of radar points to transform.
+ * @param out_points Array of at least num_points radar points to store transformed points in. Fields other than
+ * positions are copied as is. May be the same array as points (for in-place transformation) but must not overlap it
+ * otherwise.
+ * @see provizio_accumulated_radar_point_cloud_iterator_get_point_cloud
+ * @see provizio_transform_accumulated_radar_points
+ */
+PROVIZIO__EXTERN_C void provizio_transform_radar_points(const float *transformation_matrix,
+                                                        const provizio_radar_point *points, size_t num_points,
+                                                        provizio_radar_point *out_points);
+
+/**
+ * @brief Transforms all points of the accumulated point cloud the iterator points to and all older accumulated point
+ * clouds relative to the specified provizio_enu_fix of the radar, in one call. The transformation matrix is built once
+ * per accumulated point cloud and applied using provizio_transform_radar_points.
+ *
+ * @param iterator A provizio_accumulated_radar_point_cloud_iterator to start from, f.e. as returned by
+ * provizio_accumulate_radar_point_cloud. Its point_index is ignored, i.e. the entire point cloud is transformed.
+ * @param current_fix A provizio_enu_fix of the radar to transform relative to, i.e. where the same radar is at now.
+ * @param accumulated_point_clouds An array of provizio_accumulated_radar_point_cloud previously initialized with
+ * provizio_accumulated_radar_point_clouds_init to store accumulated points clouds as a circular buffer.
+ * @param num_accumulated_point_clouds Number of provizio_accumulated_radar_point_cloud in accumulated_point_clouds.
+ * @param out_transformed_points Array of max_points radar points to store transformed points in, from newest to
+ * oldest. provizio_accumulated_radar_points_count can be used to find out the required size.
+ * @param max_points Max number of points to store in out_transformed_points, points that don't fit are skipped.
+ * @return Number of transformed points stored in out_transformed_points.
+ * @see provizio_transform_radar_points
+ * @see provizio_accumulated_radar_points_count
+ */
+PROVIZIO__EXTERN_C size_t provizio_transform_accumulated_radar_points(
+    const provizio_accumulated_radar_point_cloud_iterator *iterator, const provizio_enu_fix *current_fix,
+    const provizio_accumulated_radar_point_cloud *accumulated_point_clouds, size_t num_accumulated_point_clouds,
+    provizio_radar_point *out_transformed_points, size_t max_points);
+
 #endif // PROVIZIO_RADAR_API_RADAR_POINTS_ACCUMULATION
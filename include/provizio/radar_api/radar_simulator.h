@@ -0,0 +1,164 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_RADAR_SIMULATOR
+#define PROVIZIO_RADAR_API_RADAR_SIMULATOR
+
+#include "provizio/radar_api/errno.h"
+#include "provizio/radar_api/radar_point_cloud.h"
+#include "provizio/socket.h"
+
+// Max number of radars a single simulator emulates
+#define PROVIZIO__RADAR_SIMULATOR_MAX_RADARS 64
+
+// Default number of points in a frame of every radar
+#define PROVIZIO__RADAR_SIMULATOR_DEFAULT_POINTS_PER_FRAME ((uint16_t)1000)
+
+// Default frame rate of every radar, in frames per second
+#define PROVIZIO__RADAR_SIMULATOR_DEFAULT_FRAME_RATE 10.0F
+
+/**
+ * @brief Configuration of the traffic emitted by provizio_radar_simulator
+ *
+ * @see provizio_radar_simulator_options_init
+ */
+typedef struct provizio_radar_simulator_options
+{
+    uint16_t radar_position_ids[PROVIZIO__RADAR_SIMULATOR_MAX_RADARS]; // Radars to emulate
+    size_t num_radars;                                                 // Number of radar_position_ids, 1 or more
+    uint16_t radar_range;                                              // One of provizio_radar_range enum values
+    uint16_t num_points_per_frame; // Number of points in a frame of every radar, 1 or more
+    float frame_rate;              // Frames per second of every radar, 0 to emit frames as fast as possible
+    // Probabilities (0 to 1) of a packet to be delayed until after the next one, emitted twice, or not emitted at all
+    float reorder_probability;
+    float duplicate_probability;
+    float loss_probability;
+    uint32_t seed; // Seed of the pseudo-random generator of the points and the reordering, duplication and loss
+} provizio_radar_simulator_options;
+
+/**
+ * @brief Stats of the traffic emitted by a provizio_radar_simulator
+ */
+typedef struct provizio_radar_simulator_stats
+{
+    uint64_t num_frames;             // Number of radar frames emitted (i.e. frames of all radars)
+    uint64_t num_packets;            // Number of packets emitted, including the duplicates
+    uint64_t num_packets_reordered;  // Number of packets emitted after the packets following them
+    uint64_t num_packets_duplicated; // Number of packets emitted twice
+    uint64_t num_packets_lost;       // Number of packets not emitted
+} provizio_radar_simulator_stats;
+
+/**
+ * @brief Called by provizio_radar_simulator_make_frame for every packet emitted
+ *
+ * @return 0 to proceed, an error code to stop making the frame with
+ */
+typedef int32_t (*provizio_radar_simulator_packet_callback)(const provizio_radar_point_cloud_packet *packet,
+                                                            size_t packet_size, void *user_data);
+
+/**
+ * @brief Emulates multiple radars emitting point cloud packets, to load test the receiving side (normally over the
+ * loopback interface) or to craft packets in tests. Points of every frame are scattered over the field of view, as
+ * reflections of static objects by a moving vehicle. Packets of a frame of all radars are interleaved, as if the radars
+ * were sending them at the same time, and optionally reordered, duplicated and lost, as in a congested network.
+ *
+ * @warning Not thread safe
+ * @see provizio_radar_simulator_init
+ * @see provizio_radar_simulator_open
+ */
+typedef struct provizio_radar_simulator
+{
+    provizio_radar_simulator_options options;
+    uint32_t frame_index;
+    uint64_t timestamp;    // Of the next frame, nanoseconds since the GPS Epoch
+    uint32_t random_state; // xorshift32
+
+    provizio_radar_point_cloud_packet held_packet; // A packet delayed until after the next one, to reorder them
+    size_t held_packet_size;                       // 0 if none
+
+    PROVIZIO__SOCKET sock; // PROVIZIO__INVALID_SOCKET unless opened by provizio_radar_simulator_open
+    struct sockaddr_in target_address;
+
+    provizio_radar_simulator_stats stats;
+} provizio_radar_simulator;
+
+/**
+ * @brief Initializes provizio_radar_simulator_options with defaults: a single front center radar emitting
+ * PROVIZIO__RADAR_SIMULATOR_DEFAULT_POINTS_PER_FRAME points at PROVIZIO__RADAR_SIMULATOR_DEFAULT_FRAME_RATE frames per
+ * second, with no reordering, duplication or loss
+ *
+ * @param out_options The provizio_radar_simulator_options to initialize
+ */
+PROVIZIO__EXTERN_C void provizio_radar_simulator_options_init(provizio_radar_simulator_options *out_options);
+
+/**
+ * @brief Initializes a provizio_radar_simulator to make frames with provizio_radar_simulator_make_frame, with no socket
+ *
+ * @param options Configuration of the traffic, NULL for defaults (see provizio_radar_simulator_options_init)
+ * @param out_simulator The provizio_radar_simulator to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid options
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_simulator_init(const provizio_radar_simulator_options *options,
+                                                         provizio_radar_simulator *out_simulator);
+
+/**
+ * @brief Makes the next frame of all the radars, calling a callback for every packet emitted
+ *
+ * @param simulator A previously initialized provizio_radar_simulator
+ * @param callback Function to be called for every packet emitted
+ * @param user_data Custom argument to be passed to the callback, may be NULL
+ * @return 0 if successful, otherwise the error code returned by the callback
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_simulator_make_frame(provizio_radar_simulator *simulator,
+                                                               provizio_radar_simulator_packet_callback callback,
+                                                               void *user_data);
+
+/**
+ * @brief Initializes a provizio_radar_simulator and opens a UDP socket to send its frames with
+ * provizio_radar_simulator_send_frames
+ *
+ * @param options Configuration of the traffic, NULL for defaults (see provizio_radar_simulator_options_init)
+ * @param target_address IPv4 address to send the packets to, NULL for "127.0.0.1"
+ * @param udp_port UDP port to send the packets to, by default = PROVIZIO__RADAR_API_DEFAULT_PORT (if 0)
+ * @param out_simulator The provizio_radar_simulator to open
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments, other error code if failed to open the
+ * socket
+ *
+ * @note The simulator has to be eventually closed with provizio_radar_simulator_close
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_simulator_open(const provizio_radar_simulator_options *options,
+                                                         const char *target_address, uint16_t udp_port,
+                                                         provizio_radar_simulator *out_simulator);
+
+/**
+ * @brief Sends frames of all the radars, paced by the configured frame rate
+ *
+ * @param simulator A previously opened provizio_radar_simulator
+ * @param num_frames Number of frames of every radar to send, 0 to send until stopped
+ * @param stop Optional flag checked (atomically) between frames, sending stops once it's non-zero, e.g. as set by
+ * another thread or a signal handler, may be NULL
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if not open, other error code if failed to send a packet
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_simulator_send_frames(provizio_radar_simulator *simulator,
+                                                                uint64_t num_frames, const uint32_t *stop);
+
+/**
+ * @brief Closes the socket of a previously opened provizio_radar_simulator
+ *
+ * @param simulator A previously opened provizio_radar_simulator
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT if not open, other error code if failed to close the socket
+ */
+PROVIZIO__EXTERN_C int32_t provizio_radar_simulator_close(provizio_radar_simulator *simulator);
+
+#endif // PROVIZIO_RADAR_API_RADAR_SIMULATOR
@@ -0,0 +1,126 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_REUSEPORT_RECEIVER
+#define PROVIZIO_RADAR_API_REUSEPORT_RECEIVER
+
+#include "provizio/radar_api/core.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif // _WIN32
+
+// Max time (in nanoseconds) a shard's thread waits for packets before checking if it's been requested to stop
+#ifndef PROVIZIO__REUSEPORT_RECEIVER_POLL_TIMEOUT_NS
+#define PROVIZIO__REUSEPORT_RECEIVER_POLL_TIMEOUT_NS ((uint64_t)50000000)
+#endif // PROVIZIO__REUSEPORT_RECEIVER_POLL_TIMEOUT_NS
+
+/**
+ * @brief A shard of provizio_reuseport_radar_api_receiver: its own socket, thread and contexts, receiving and handling
+ * point cloud packets of the radars steered to it (i.e. radar_position_id % num_shards == shard index). Callbacks of
+ * its contexts are called in its thread.
+ *
+ * @see provizio_reuseport_radar_api_shard_init
+ * @see provizio_reuseport_radar_api_shard_init_pooled
+ */
+typedef struct provizio_reuseport_radar_api_shard
+{
+    provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts;
+    size_t num_radar_point_cloud_api_contexts;
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts;
+    size_t num_pooled_radar_point_cloud_api_contexts;
+    provizio_radar_api_connection connection; // Opened by provizio_reuseport_radar_api_receiver_start
+    int32_t status;                           // Error code the shard's thread stopped with, if any
+    const uint32_t *stop;                     // Owned by provizio_reuseport_radar_api_receiver
+#ifndef _WIN32
+    pthread_t thread;
+#endif // _WIN32
+} provizio_reuseport_radar_api_shard;
+
+/**
+ * @brief An optional multi-socket receiver: num_shards UDP sockets share the same port (SO_REUSEPORT), and a classic
+ * BPF program attached to them steers every point cloud packet to the socket of radar_position_id % num_shards, so
+ * each shard's thread receives, reassembles and handles its own radars without any packets passing between threads.
+ * Unlike provizio_threaded_radar_api_receiver, there is no single I/O thread to saturate, so receive throughput scales
+ * with the number of cores.
+ *
+ * @warning Callbacks (including error and warning handlers) are called from the shards' threads, so the handlers set
+ * by provizio_set_on_error / provizio_set_on_warning must be thread safe
+ * @warning The steering relies on the shards' sockets being the only sockets on the port (the BPF program returns an
+ * index of a socket in the port's SO_REUSEPORT group), so no other connections should be opened on the same port
+ * @note Currently supported on Linux only
+ * @see provizio_reuseport_radar_api_receiver_start
+ */
+typedef struct provizio_reuseport_radar_api_receiver
+{
+    provizio_reuseport_radar_api_shard *shards;
+    size_t num_shards;
+    uint32_t stop; // Non-zero once requested to stop
+} provizio_reuseport_radar_api_receiver;
+
+/**
+ * @brief Initializes a provizio_reuseport_radar_api_shard handling point clouds by
+ * provizio_radar_point_cloud_api_context objects
+ *
+ * @param radar_point_cloud_api_contexts Array of initialized provizio_radar_point_cloud_api_context, enough to handle
+ * all the radars steered to this shard. Must only be used by this shard while the receiver runs.
+ * @param num_radar_point_cloud_api_contexts Number of radar_point_cloud_api_contexts, must be positive
+ * @param out_shard The provizio_reuseport_radar_api_shard to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments
+ */
+PROVIZIO__EXTERN_C int32_t provizio_reuseport_radar_api_shard_init(
+    provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts, size_t num_radar_point_cloud_api_contexts,
+    provizio_reuseport_radar_api_shard *out_shard);
+
+/**
+ * @brief Initializes a provizio_reuseport_radar_api_shard handling point clouds by
+ * provizio_pooled_radar_point_cloud_api_context objects
+ *
+ * @param pooled_radar_point_cloud_api_contexts Array of initialized provizio_pooled_radar_point_cloud_api_context,
+ * enough to handle all the radars steered to this shard. Must only be used by this shard while the receiver runs, and
+ * their memory pool (and packet pool, in zero-copy mode) must not be shared with other shards.
+ * @param num_pooled_radar_point_cloud_api_contexts Number of pooled_radar_point_cloud_api_contexts, must be positive
+ * @param out_shard The provizio_reuseport_radar_api_shard to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments
+ */
+PROVIZIO__EXTERN_C int32_t provizio_reuseport_radar_api_shard_init_pooled(
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts,
+    size_t num_pooled_radar_point_cloud_api_contexts, provizio_reuseport_radar_api_shard *out_shard);
+
+/**
+ * @brief Opens a socket per shard on the same UDP port, attaches the steering program and starts the shards' threads
+ *
+ * @param udp_port UDP port to receive from, by default = PROVIZIO__RADAR_API_DEFAULT_PORT (if 0)
+ * @param options Options of the shards' sockets (see provizio_open_radars_connection_with_options), NULL for defaults
+ * @param shards Array of num_shards previously initialized shards, must remain valid until the receiver is stopped
+ * @param num_shards Number of shards, must be positive
+ * @param out_receiver The provizio_reuseport_radar_api_receiver to start
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments, PROVIZIO_E_NOT_PERMITTED if not supported
+ * on this platform, other error code if failed to open the sockets, attach the steering program or start the threads
+ *
+ * @note The receiver has to be eventually stopped with provizio_reuseport_radar_api_receiver_stop
+ */
+PROVIZIO__EXTERN_C int32_t provizio_reuseport_radar_api_receiver_start(
+    uint16_t udp_port, const provizio_radar_api_connection_options *options, provizio_reuseport_radar_api_shard *shards,
+    size_t num_shards, provizio_reuseport_radar_api_receiver *out_receiver);
+
+/**
+ * @brief Stops a previously started receiver, waiting for the shards' threads to finish, and closes their sockets
+ *
+ * @param receiver A previously started provizio_reuseport_radar_api_receiver
+ * @return 0 if successful, the error code of the first shard that failed to receive, if any
+ */
+PROVIZIO__EXTERN_C int32_t provizio_reuseport_radar_api_receiver_stop(provizio_reuseport_radar_api_receiver *receiver);
+
+#endif // PROVIZIO_RADAR_API_REUSEPORT_RECEIVER
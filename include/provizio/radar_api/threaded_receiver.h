@@ -0,0 +1,153 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_RADAR_API_THREADED_RECEIVER
+#define PROVIZIO_RADAR_API_THREADED_RECEIVER
+
+#include "provizio/radar_api/core.h"
+#include "provizio/spsc_queue.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif // _WIN32
+
+// Max time (in nanoseconds) the I/O thread waits for a packet before checking if it's been requested to stop
+#ifndef PROVIZIO__THREADED_RECEIVER_POLL_TIMEOUT_NS
+#define PROVIZIO__THREADED_RECEIVER_POLL_TIMEOUT_NS ((uint64_t)50000000)
+#endif // PROVIZIO__THREADED_RECEIVER_POLL_TIMEOUT_NS
+
+// Time (in nanoseconds) a worker thread sleeps for when it has no packets to handle
+#ifndef PROVIZIO__THREADED_RECEIVER_WORKER_IDLE_SLEEP_NS
+#define PROVIZIO__THREADED_RECEIVER_WORKER_IDLE_SLEEP_NS ((uint64_t)100000)
+#endif // PROVIZIO__THREADED_RECEIVER_WORKER_IDLE_SLEEP_NS
+
+/**
+ * @brief A single UDP packet passed from the I/O thread to a worker thread
+ */
+typedef struct provizio_threaded_radar_packet
+{
+    uint8_t payload[PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES];
+    size_t payload_size;
+    uint64_t receive_time_ns; // See provizio_radar_api_enable_receive_timestamps, 0 if unknown
+} provizio_threaded_radar_packet;
+
+/**
+ * @brief A worker of provizio_threaded_radar_api_receiver: a thread handling point cloud packets of the radars sharded
+ * to it (i.e. radar_position_id % num_workers == worker index) by its own contexts. Callbacks of its contexts are
+ * called in its thread, so a slow callback delays this worker's radars only.
+ *
+ * @see provizio_threaded_radar_api_worker_init
+ * @see provizio_threaded_radar_api_worker_init_pooled
+ */
+typedef struct provizio_threaded_radar_api_worker
+{
+    // The worker's contexts (with no socket), so the packets are handled by provizio_radar_api_handle_received_packet
+    provizio_radar_api_connection contexts;
+    provizio_spsc_queue queue; // Packets received by the I/O thread (producer) to be handled by the worker (consumer)
+    uint32_t num_dropped_packets; // Packets dropped as the queue was full, use PROVIZIO__ATOMIC_LOAD_UINT32 to read
+    const uint32_t *stop;         // Owned by provizio_threaded_radar_api_receiver
+#ifndef _WIN32
+    pthread_t thread;
+#endif // _WIN32
+} provizio_threaded_radar_api_worker;
+
+/**
+ * @brief An optional multi-threaded receiver of a provizio_radar_api_connection: a single I/O thread receives UDP
+ * packets (recording them and timestamping them, if enabled for the connection) straight into lock-free
+ * single-producer single-consumer queues of the workers, sharded by radar_position_id, and each worker's thread
+ * reassembles point clouds and calls the callbacks.
+ *
+ * @warning Callbacks (including error and warning handlers) are called from the worker threads, so the handlers set by
+ * provizio_set_on_error / provizio_set_on_warning must be thread safe
+ * @note Currently supported on POSIX platforms only
+ * @see provizio_threaded_radar_api_receiver_start
+ */
+typedef struct provizio_threaded_radar_api_receiver
+{
+    provizio_radar_api_connection *connection;
+    provizio_threaded_radar_api_worker *workers;
+    size_t num_workers;
+    uint32_t stop;                // Non-zero once requested to stop
+    uint32_t num_skipped_packets; // Packets that are not point cloud packets, use PROVIZIO__ATOMIC_LOAD_UINT32 to read
+    int32_t status;               // Error code the I/O thread stopped with, if any
+#ifndef _WIN32
+    pthread_t io_thread;
+#endif // _WIN32
+} provizio_threaded_radar_api_receiver;
+
+/**
+ * @brief Initializes a provizio_threaded_radar_api_worker handling point clouds by
+ * provizio_radar_point_cloud_api_context objects
+ *
+ * @param radar_point_cloud_api_contexts Array of initialized provizio_radar_point_cloud_api_context, enough to handle
+ * all the radars sharded to this worker. Must only be used by this worker while the receiver runs.
+ * @param num_radar_point_cloud_api_contexts Number of radar_point_cloud_api_contexts, must be positive
+ * @param queue_slots Memory for the queue of packets, must remain valid as long as the worker is used
+ * @param queue_length Number of queue_slots, i.e. max number of packets waiting for the worker before new ones get
+ * dropped
+ * @param out_worker The provizio_threaded_radar_api_worker to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments
+ */
+PROVIZIO__EXTERN_C int32_t provizio_threaded_radar_api_worker_init(
+    provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts, size_t num_radar_point_cloud_api_contexts,
+    provizio_threaded_radar_packet *queue_slots, size_t queue_length, provizio_threaded_radar_api_worker *out_worker);
+
+/**
+ * @brief Initializes a provizio_threaded_radar_api_worker handling point clouds by
+ * provizio_pooled_radar_point_cloud_api_context objects
+ *
+ * @param pooled_radar_point_cloud_api_contexts Array of initialized provizio_pooled_radar_point_cloud_api_context,
+ * enough to handle all the radars sharded to this worker. Must only be used by this worker while the receiver runs. As
+ * the packet pool is not thread safe, in zero-copy mode the packets are moved from the queue to the contexts' packet
+ * pool by the worker, so the pool must not be shared with other workers.
+ * @param num_pooled_radar_point_cloud_api_contexts Number of pooled_radar_point_cloud_api_contexts, must be positive
+ * @param queue_slots Memory for the queue of packets, must remain valid as long as the worker is used
+ * @param queue_length Number of queue_slots, i.e. max number of packets waiting for the worker before new ones get
+ * dropped
+ * @param out_worker The provizio_threaded_radar_api_worker to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments
+ */
+PROVIZIO__EXTERN_C int32_t provizio_threaded_radar_api_worker_init_pooled(
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts,
+    size_t num_pooled_radar_point_cloud_api_contexts, provizio_threaded_radar_packet *queue_slots, size_t queue_length,
+    provizio_threaded_radar_api_worker *out_worker);
+
+/**
+ * @brief Starts receiving packets of a connection in a separate I/O thread and handling them in the workers' threads
+ *
+ * @param connection A previously connected provizio_radar_api_connection. Its own contexts are not used, and it must
+ * not be used to receive packets until the receiver is stopped. Its packet recorder (if any) is only used by the I/O
+ * thread.
+ * @param workers Array of num_workers previously initialized workers, must remain valid until the receiver is stopped
+ * @param num_workers Number of workers, must be positive
+ * @param out_receiver The provizio_threaded_radar_api_receiver to start
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments, PROVIZIO_E_NOT_PERMITTED if not supported
+ * on this platform, other error code if failed to start the threads
+ *
+ * @note The receiver has to be eventually stopped with provizio_threaded_radar_api_receiver_stop
+ */
+PROVIZIO__EXTERN_C int32_t provizio_threaded_radar_api_receiver_start(
+    provizio_radar_api_connection *connection, provizio_threaded_radar_api_worker *workers, size_t num_workers,
+    provizio_threaded_radar_api_receiver *out_receiver);
+
+/**
+ * @brief Stops a previously started receiver, waiting for its threads to finish. Packets already queued are handled
+ * before the workers stop.
+ *
+ * @param receiver A previously started provizio_threaded_radar_api_receiver
+ * @return 0 if successful, the error code the I/O thread failed with, if it did
+ */
+PROVIZIO__EXTERN_C int32_t provizio_threaded_radar_api_receiver_stop(provizio_threaded_radar_api_receiver *receiver);
+
+#endif // PROVIZIO_RADAR_API_THREADED_RECEIVER
@@ -0,0 +1,38 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_SIMD
+#define PROVIZIO_SIMD
+
+#include "provizio/common.h"
+
+// Define PROVIZIO__DISABLE_SIMD to use portable (non-SIMD) implementations only
+#if !defined(PROVIZIO__DISABLE_SIMD) && (defined(__GNUC__) || defined(__clang__)) &&                                  \
+    (defined(__x86_64__) || defined(__i386__))
+
+// x86 kernels are compiled regardless of the target flags (using target attributes) and selected at runtime
+#define PROVIZIO__SIMD_X86
+#define PROVIZIO__SIMD_TARGET(TARGET) __attribute__((target(TARGET)))
+#define PROVIZIO__SIMD_CPU_SUPPORTS(FEATURE) (__builtin_cpu_init(), __builtin_cpu_supports(FEATURE))
+#include <immintrin.h>
+
+#elif !defined(PROVIZIO__DISABLE_SIMD) && defined(__ARM_NEON)
+
+// NEON is always available when the compiler targets it (it's mandatory in AArch64)
+#define PROVIZIO__SIMD_NEON
+#include <arm_neon.h>
+
+#endif
+
+#endif // PROVIZIO_SIMD
@@ -83,6 +83,16 @@ PROVIZIO__EXTERN_C int32_t provizio_socket_close(PROVIZIO__SOCKET sock);
  */
 PROVIZIO__EXTERN_C int32_t provizio_socket_set_recv_timeout(PROVIZIO__SOCKET sock, uint64_t timeout_ns);
 
+/**
+ * @brief Makes recv operations on a previously opened socket return immediately when there is nothing to receive
+ * (failing with EAGAIN / EWOULDBLOCK) instead of waiting
+ *
+ * @param sock `socket`-returned socket object
+ * @param non_blocking Non-zero to make the socket non-blocking, 0 to make it blocking again
+ * @return 0 if successfull, error code otherwise
+ */
+PROVIZIO__EXTERN_C int32_t provizio_socket_set_non_blocking(PROVIZIO__SOCKET sock, uint8_t non_blocking);
+
 /**
  * @brief Permits for having multiple processes in the system to receive same UDP messages
  *
@@ -91,4 +101,26 @@ PROVIZIO__EXTERN_C int32_t provizio_socket_set_recv_timeout(PROVIZIO__SOCKET soc
  */
 PROVIZIO__EXTERN_C int32_t provizio_socket_enable_address_and_port_reuse(PROVIZIO__SOCKET sock);
 
+/**
+ * @brief Requests the size of the kernel receive buffer of a previously opened socket. On Linux SO_RCVBUFFORCE is tried
+ * first, as it's not capped by net.core.rmem_max (but requires CAP_NET_ADMIN), then SO_RCVBUF.
+ *
+ * @param sock `socket`-returned socket object
+ * @param size Requested size in bytes (values above INT_MAX are capped)
+ * @return 0 if successfull, error code otherwise
+ *
+ * @note The OS may silently cap the size, use provizio_socket_get_recv_buffer_size to learn the effective one
+ */
+PROVIZIO__EXTERN_C int32_t provizio_socket_set_recv_buffer_size(PROVIZIO__SOCKET sock, size_t size);
+
+/**
+ * @brief Returns the effective size of the kernel receive buffer of a previously opened socket (SO_RCVBUF)
+ *
+ * @param sock `socket`-returned socket object
+ * @param out_size Stores the size in bytes, as reported by the OS (Linux reports twice the size requested, as it
+ * accounts for its bookkeeping overhead), or 0 if failed
+ * @return 0 if successfull, error code otherwise
+ */
+PROVIZIO__EXTERN_C int32_t provizio_socket_get_recv_buffer_size(PROVIZIO__SOCKET sock, size_t *out_size);
+
 #endif // PROVIZIO_SOCKET
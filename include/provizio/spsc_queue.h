@@ -0,0 +1,96 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROVIZIO_SPSC_QUEUE
+#define PROVIZIO_SPSC_QUEUE
+
+#include "provizio/common.h"
+
+// Size of a cache line in bytes, used to keep the producer's and the consumer's state apart (avoiding false sharing)
+#ifndef PROVIZIO__CACHE_LINE_SIZE
+#define PROVIZIO__CACHE_LINE_SIZE 64
+#endif // PROVIZIO__CACHE_LINE_SIZE
+
+/**
+ * @brief A bounded lock-free single-producer single-consumer queue of fixed-size slots in caller-supplied memory.
+ * Items are written and read in place: the producer fills the slot returned by provizio_spsc_queue_back and publishes
+ * it with provizio_spsc_queue_push, the consumer reads the slot returned by provizio_spsc_queue_front and releases it
+ * with provizio_spsc_queue_pop.
+ *
+ * @warning Thread safe only as long as there is at most one producer thread and at most one consumer thread
+ * @see provizio_spsc_queue_init
+ */
+typedef struct provizio_spsc_queue
+{
+    uint8_t *slots;
+    size_t slot_size;
+    uint32_t num_slots;
+    uint8_t padding_0[PROVIZIO__CACHE_LINE_SIZE];
+    uint32_t head; // Position of the next item to pop in [0, 2 * num_slots), written by the consumer only
+    uint8_t padding_1[PROVIZIO__CACHE_LINE_SIZE - sizeof(uint32_t)];
+    uint32_t tail; // Position of the next item to push in [0, 2 * num_slots), written by the producer only
+    uint8_t padding_2[PROVIZIO__CACHE_LINE_SIZE - sizeof(uint32_t)];
+} provizio_spsc_queue;
+
+/**
+ * @brief Initializes a provizio_spsc_queue in caller-supplied memory
+ *
+ * @param slots Memory for num_slots slots of slot_size bytes each, must remain valid as long as the queue is used
+ * @param slot_size Size of a single slot in bytes, must be positive
+ * @param num_slots Max number of items in the queue, must be positive and not exceed UINT32_MAX / 2
+ * @param out_queue The provizio_spsc_queue to initialize
+ * @return 0 if successful, PROVIZIO_E_ARGUMENT in case of invalid arguments
+ */
+PROVIZIO__EXTERN_C int32_t provizio_spsc_queue_init(void *slots, size_t slot_size, size_t num_slots,
+                                                    provizio_spsc_queue *out_queue);
+
+/**
+ * @brief Returns a free slot to write the next item to (producer only)
+ *
+ * @param queue Previously initialized provizio_spsc_queue
+ * @return The slot, or NULL if the queue is full
+ */
+PROVIZIO__EXTERN_C void *provizio_spsc_queue_back(provizio_spsc_queue *queue);
+
+/**
+ * @brief Publishes the item written to the slot returned by provizio_spsc_queue_back (producer only)
+ *
+ * @param queue Previously initialized provizio_spsc_queue, that is not full
+ */
+PROVIZIO__EXTERN_C void provizio_spsc_queue_push(provizio_spsc_queue *queue);
+
+/**
+ * @brief Returns the oldest item in the queue without removing it (consumer only)
+ *
+ * @param queue Previously initialized provizio_spsc_queue
+ * @return The slot of the item, or NULL if the queue is empty
+ */
+PROVIZIO__EXTERN_C void *provizio_spsc_queue_front(provizio_spsc_queue *queue);
+
+/**
+ * @brief Removes the oldest item from the queue, making its slot available to the producer (consumer only)
+ *
+ * @param queue Previously initialized provizio_spsc_queue, that is not empty
+ */
+PROVIZIO__EXTERN_C void provizio_spsc_queue_pop(provizio_spsc_queue *queue);
+
+/**
+ * @brief Returns the number of items in the queue
+ *
+ * @param queue Previously initialized provizio_spsc_queue
+ * @return Number of items, which is approximate if the queue is concurrently modified
+ */
+PROVIZIO__EXTERN_C size_t provizio_spsc_queue_size(provizio_spsc_queue *queue);
+
+#endif // PROVIZIO_SPSC_QUEUE
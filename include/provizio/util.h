@@ -112,6 +112,18 @@ PROVIZIO__EXTERN_C uint64_t provizio_get_protocol_field_uint64_t(const uint64_t
  */
 PROVIZIO__EXTERN_C float provizio_get_protocol_field_float(const float *field);
 
+/**
+ * @brief Retrieves count consecutive float values using host byte order from protocol fields, regardless of their
+ * alignment. Uses SIMD (SSSE3/AVX2 on x86, NEON on ARM) when available, as selected at runtime on first call.
+ *
+ * @param fields Protocol fields using network byte order to be retrieved
+ * @param out_values Output values using host byte order, may be the same memory as fields (for in-place conversion)
+ * but must not overlap it otherwise
+ * @param count Number of float values
+ * @note Define PROVIZIO__DISABLE_SIMD to use the portable version only
+ */
+PROVIZIO__EXTERN_C void provizio_get_protocol_fields_float(const void *fields, void *out_values, size_t count);
+
 /**
  * @brief Like *nix gettimeofday with timezone argument set to NULL, to measure time intervals
  *
@@ -137,4 +149,19 @@ PROVIZIO__EXTERN_C int64_t provizio_time_interval_ns(struct timeval *time_b, str
  */
 PROVIZIO__EXTERN_C float provizio_nanoseconds_to_seconds(int64_t duration_ns);
 
+/**
+ * @brief Suspends the calling thread for at least the specified duration
+ *
+ * @param duration_ns Duration in nanoseconds (rounded up to milliseconds in Windows)
+ */
+PROVIZIO__EXTERN_C void provizio_sleep_ns(uint64_t duration_ns);
+
+/**
+ * @brief Returns the current time of a monotonic clock, i.e. not affected by system time changes, to measure time
+ * intervals
+ *
+ * @return Time in nanoseconds since an arbitrary point in the past
+ */
+PROVIZIO__EXTERN_C uint64_t provizio_monotonic_time_ns(void);
+
 #endif // PROVIZIO_UTIL
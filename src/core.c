@@ -12,11 +12,39 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // Required for recvmmsg
+#endif
+
 #include "provizio/radar_api/core.h"
 #include "provizio/util.h"
 
 #include <string.h>
 
+#if defined(__linux__) && !defined(PROVIZIO__RADAR_API_DISABLE_RECVMMSG)
+#define PROVIZIO__RADAR_API_USE_RECVMMSG
+#endif
+
+#ifdef __linux__
+#include <linux/net_tstamp.h>
+
+#define PROVIZIO__RADAR_API_RECEIVE_TIMESTAMPS_SUPPORTED
+
+// SO_TIMESTAMPING reports software, (deprecated) transformed hardware and raw hardware times, in this order
+enum
+{
+    provizio_radar_api_num_timestamping_times = 3
+};
+
+// Control messages buffer to receive timestamps into (both SO_TIMESTAMPNS and SO_TIMESTAMPING)
+typedef union provizio_radar_api_control_buffer
+{
+    size_t alignment; // Only to align the buffer as struct cmsghdr
+    uint8_t data[CMSG_SPACE(sizeof(struct timespec)) +
+                 CMSG_SPACE(sizeof(struct timespec) * provizio_radar_api_num_timestamping_times)];
+} provizio_radar_api_control_buffer;
+#endif // __linux__
+
 int32_t provizio_open_radar_connection(uint16_t udp_port, uint64_t receive_timeout_ns, uint8_t check_connection,
                                        provizio_radar_point_cloud_api_context *radar_point_cloud_api_context,
                                        provizio_radar_api_connection *out_connection)
@@ -30,6 +58,163 @@ int32_t provizio_open_radars_connection(uint16_t udp_port, uint64_t receive_time
                                         provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts,
                                         size_t num_radar_point_cloud_api_contexts,
                                         provizio_radar_api_connection *out_connection)
+{
+    return provizio_open_radars_connection_with_options(udp_port, receive_timeout_ns, check_connection, NULL,
+                                                        radar_point_cloud_api_contexts,
+                                                        num_radar_point_cloud_api_contexts, out_connection);
+}
+
+void provizio_radar_api_connection_options_init(provizio_radar_api_connection_options *out_options)
+{
+    memset(out_options, 0, sizeof(provizio_radar_api_connection_options));
+    out_options->incoming_cpu = -1;
+}
+
+static int32_t provizio_radar_api_set_receive_buffer_size(PROVIZIO__SOCKET sock, size_t receive_buffer_size)
+{
+    if (provizio_socket_set_recv_buffer_size(sock, receive_buffer_size) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        provizio_error("provizio_open_radars_connection: Failed to set the receive buffer size");
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    size_t effective_size = 0;
+    provizio_socket_get_recv_buffer_size(sock, &effective_size);
+    if (effective_size < receive_buffer_size)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the OS configuration (e.g. net.core.rmem_max)
+        provizio_warning("provizio_open_radars_connection: The receive buffer is smaller than requested (consider "
+                         "increasing net.core.rmem_max or granting CAP_NET_ADMIN)");
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+}
+
+static int32_t provizio_radar_api_set_linux_socket_option(PROVIZIO__SOCKET sock, int option, int value,
+                                                          const char *error_message)
+{
+#ifdef __linux__
+    if (setsockopt(sock, SOL_SOCKET, option, &value, sizeof(value)) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        provizio_error(error_message);
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+#else
+    (void)sock;
+    (void)option;
+    (void)value;
+    (void)error_message;
+    return PROVIZIO_E_NOT_PERMITTED;
+#endif // __linux__
+}
+
+static int32_t provizio_radar_api_join_multicast_group(PROVIZIO__SOCKET sock, const char *multicast_group,
+                                                       const char *multicast_interface_address)
+{
+    struct ip_mreq membership;
+    memset(&membership, 0, sizeof(membership));
+    membership.imr_multiaddr.s_addr = inet_addr(multicast_group);
+    membership.imr_interface.s_addr =
+        multicast_interface_address != NULL ? inet_addr(multicast_interface_address) : htonl(INADDR_ANY); // NOLINT
+    if (membership.imr_multiaddr.s_addr == INADDR_NONE || membership.imr_interface.s_addr == INADDR_NONE)
+    {
+        provizio_error("provizio_open_radars_connection: Invalid multicast group or interface address");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char *)&membership, sizeof(membership)) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        provizio_error("provizio_open_radars_connection: Failed to join the multicast group");
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+}
+
+static int32_t provizio_radar_api_bind_to_interface(PROVIZIO__SOCKET sock, const char *bind_interface)
+{
+#ifdef __linux__
+    if (setsockopt(sock, SOL_SOCKET, SO_BINDTODEVICE, bind_interface, (socklen_t)(strlen(bind_interface) + 1)) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        provizio_error("provizio_open_radars_connection: Failed to bind to the network interface");
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+#else
+    (void)sock;
+    (void)bind_interface;
+    provizio_error("provizio_open_radars_connection: bind_interface is not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+#endif // __linux__
+}
+
+static int32_t provizio_radar_api_apply_connection_options(PROVIZIO__SOCKET sock,
+                                                           const provizio_radar_api_connection_options *options)
+{
+    int32_t status = 0;
+    if (options->receive_buffer_size != 0)
+    {
+        status = provizio_radar_api_set_receive_buffer_size(sock, options->receive_buffer_size);
+    }
+
+#ifdef __linux__
+    if (status == 0 && options->busy_poll_us != 0)
+    {
+        status = provizio_radar_api_set_linux_socket_option(sock, SO_BUSY_POLL, (int)options->busy_poll_us,
+                                                            "provizio_open_radars_connection: Failed to enable busy "
+                                                            "polling (may require CAP_NET_ADMIN)");
+    }
+
+    if (status == 0 && options->incoming_cpu >= 0)
+    {
+        status = provizio_radar_api_set_linux_socket_option(
+            sock, SO_INCOMING_CPU, (int)options->incoming_cpu,
+            "provizio_open_radars_connection: Failed to set the incoming CPU");
+    }
+#else
+    if (status == 0 && (options->busy_poll_us != 0 || options->incoming_cpu >= 0))
+    {
+        provizio_error("provizio_open_radars_connection: busy_poll_us and incoming_cpu are not supported on this "
+                       "platform");
+        status = PROVIZIO_E_NOT_PERMITTED;
+    }
+#endif // __linux__
+
+    if (status == 0 && options->multicast_group != NULL)
+    {
+        status = provizio_radar_api_join_multicast_group(sock, options->multicast_group,
+                                                         options->multicast_interface_address);
+    }
+
+    if (status == 0 && options->bind_interface != NULL)
+    {
+        status = provizio_radar_api_bind_to_interface(sock, options->bind_interface);
+    }
+
+    return status;
+}
+
+int32_t provizio_open_radars_connection_with_options(
+    uint16_t udp_port, uint64_t receive_timeout_ns, uint8_t check_connection,
+    const provizio_radar_api_connection_options *options,
+    provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts, size_t num_radar_point_cloud_api_contexts,
+    provizio_radar_api_connection *out_connection)
 {
     memset(out_connection, 0, sizeof(provizio_radar_api_connection));
     out_connection->sock = PROVIZIO__INVALID_SOCKET;
@@ -82,6 +267,16 @@ int32_t provizio_open_radars_connection(uint16_t udp_port, uint64_t receive_time
         // LCOV_EXCL_STOP
     }
 
+    if (options != NULL)
+    {
+        status = provizio_radar_api_apply_connection_options(sock, options);
+        if (status != 0)
+        {
+            provizio_socket_close(sock);
+            return status;
+        }
+    }
+
     struct sockaddr_in my_address;
     memset(&my_address, 0, sizeof(my_address));
     my_address.sin_family = AF_INET;
@@ -119,6 +314,7 @@ int32_t provizio_open_radars_connection(uint16_t udp_port, uint64_t receive_time
         }
     }
 
+    provizio_socket_get_recv_buffer_size(sock, &out_connection->receive_buffer_size);
     out_connection->sock = sock;
     out_connection->radar_point_cloud_api_contexts = radar_point_cloud_api_contexts;
     out_connection->num_radar_point_cloud_api_contexts = num_radar_point_cloud_api_contexts;
@@ -126,6 +322,283 @@ int32_t provizio_open_radars_connection(uint16_t udp_port, uint64_t receive_time
     return 0;
 }
 
+int32_t provizio_open_pooled_radars_connection(
+    uint16_t udp_port, uint64_t receive_timeout_ns, uint8_t check_connection,
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts,
+    size_t num_pooled_radar_point_cloud_api_contexts, provizio_radar_api_connection *out_connection)
+{
+    return provizio_open_pooled_radars_connection_with_options(
+        udp_port, receive_timeout_ns, check_connection, NULL, pooled_radar_point_cloud_api_contexts,
+        num_pooled_radar_point_cloud_api_contexts, out_connection);
+}
+
+int32_t provizio_open_pooled_radars_connection_with_options(
+    uint16_t udp_port, uint64_t receive_timeout_ns, uint8_t check_connection,
+    const provizio_radar_api_connection_options *options,
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts,
+    size_t num_pooled_radar_point_cloud_api_contexts, provizio_radar_api_connection *out_connection)
+{
+    const int32_t status = provizio_open_radars_connection_with_options(udp_port, receive_timeout_ns, check_connection,
+                                                                        options, NULL, 0, out_connection);
+    if (status == 0)
+    {
+        out_connection->pooled_radar_point_cloud_api_contexts = pooled_radar_point_cloud_api_contexts;
+        out_connection->num_pooled_radar_point_cloud_api_contexts = num_pooled_radar_point_cloud_api_contexts;
+    }
+
+    return status;
+}
+
+static provizio_radar_packet_pool *provizio_radar_api_packet_pool(provizio_radar_api_connection *connection)
+{
+    // All zero-copy contexts of a connection share same packet pool
+    return connection->num_pooled_radar_point_cloud_api_contexts > 0 &&
+                   connection->pooled_radar_point_cloud_api_contexts != NULL
+               ? connection->pooled_radar_point_cloud_api_contexts[0].packet_pool
+               : NULL;
+}
+
+static uint8_t *provizio_radar_api_acquire_packet_buffer(provizio_radar_packet_pool *packet_pool,
+                                                         uint8_t *fallback_buffer)
+{
+    provizio_radar_packet_buffer *buffer = packet_pool != NULL ? provizio_radar_packet_pool_acquire(packet_pool) : NULL;
+
+    // If the packet pool is exhausted, the packet is received to fallback_buffer, and then handling it fails
+    return buffer != NULL ? buffer->payload : fallback_buffer;
+}
+
+static void provizio_radar_api_release_packet_buffer(provizio_radar_packet_pool *packet_pool, const uint8_t *packet)
+{
+    provizio_radar_packet_buffer *buffer = provizio_radar_packet_pool_find(packet_pool, packet);
+    if (buffer != NULL)
+    {
+        provizio_radar_packet_pool_release(packet_pool, buffer);
+    }
+}
+
+#ifdef PROVIZIO__RADAR_API_RECEIVE_TIMESTAMPS_SUPPORTED
+// Returns the receive time of a packet in the clock domain the connection timestamps packets in (never mixing the two,
+// so all receive times of a point cloud are comparable), or 0 if it's not been reported
+static uint64_t provizio_radar_api_receive_time_ns(const provizio_radar_api_connection *connection,
+                                                   struct msghdr *message)
+{
+    const uint64_t nanoseconds_in_second = 1000000000ULL;
+    const uint8_t hardware = connection->receive_timestamps == provizio_radar_api_receive_timestamps_hardware;
+
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(message); cmsg != NULL; cmsg = CMSG_NXTHDR(message, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET)
+        {
+            continue;
+        }
+
+        if (!hardware && cmsg->cmsg_type == SO_TIMESTAMPNS)
+        {
+            struct timespec software_time;
+            memcpy(&software_time, CMSG_DATA(cmsg), sizeof(software_time));
+            return (uint64_t)software_time.tv_sec * nanoseconds_in_second + (uint64_t)software_time.tv_nsec;
+        }
+
+        if (hardware && cmsg->cmsg_type == SO_TIMESTAMPING)
+        {
+            struct timespec times[provizio_radar_api_num_timestamping_times];
+            memcpy(times, CMSG_DATA(cmsg), sizeof(times));
+
+            // 0 if the NIC hasn't timestamped this packet, in which case it's of an unknown receive time
+            const struct timespec *raw_hardware_time = &times[provizio_radar_api_num_timestamping_times - 1];
+            return (uint64_t)raw_hardware_time->tv_sec * nanoseconds_in_second + (uint64_t)raw_hardware_time->tv_nsec;
+        }
+    }
+
+    return 0;
+}
+#endif // PROVIZIO__RADAR_API_RECEIVE_TIMESTAMPS_SUPPORTED
+
+int32_t provizio_radar_api_enable_receive_timestamps(provizio_radar_api_connection *connection)
+{
+    if (!provizio_socket_valid(connection->sock))
+    {
+        provizio_error("provizio_radar_api_enable_receive_timestamps: Not connected");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+#ifdef PROVIZIO__RADAR_API_RECEIVE_TIMESTAMPS_SUPPORTED
+    const int enable = 1;
+    if (setsockopt(connection->sock, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the kernel
+        const int32_t status_code = errno;
+        provizio_error("provizio_radar_api_enable_receive_timestamps: Failed to enable timestamps");
+        return status_code != 0 ? status_code : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    connection->receive_timestamps = provizio_radar_api_receive_timestamps_software;
+    return 0;
+#else
+    provizio_error("provizio_radar_api_enable_receive_timestamps: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+#endif // PROVIZIO__RADAR_API_RECEIVE_TIMESTAMPS_SUPPORTED
+}
+
+int32_t provizio_radar_api_enable_hardware_receive_timestamps(provizio_radar_api_connection *connection)
+{
+    if (!provizio_socket_valid(connection->sock))
+    {
+        provizio_error("provizio_radar_api_enable_hardware_receive_timestamps: Not connected");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+#ifdef PROVIZIO__RADAR_API_RECEIVE_TIMESTAMPS_SUPPORTED
+    const int timestamping_flags = SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+    if (setsockopt(connection->sock, SOL_SOCKET, SO_TIMESTAMPING, &timestamping_flags, sizeof(timestamping_flags)) !=
+        0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the kernel
+        const int32_t status_code = errno;
+        provizio_error("provizio_radar_api_enable_hardware_receive_timestamps: Failed to enable timestamps");
+        return status_code != 0 ? status_code : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    connection->receive_timestamps = provizio_radar_api_receive_timestamps_hardware;
+    return 0;
+#else
+    provizio_error("provizio_radar_api_enable_hardware_receive_timestamps: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+#endif // PROVIZIO__RADAR_API_RECEIVE_TIMESTAMPS_SUPPORTED
+}
+
+int32_t provizio_radar_api_set_packet_recorder(provizio_radar_api_connection *connection,
+                                               provizio_packet_recorder *packet_recorder)
+{
+    if (!provizio_socket_valid(connection->sock))
+    {
+        provizio_error("provizio_radar_api_set_packet_recorder: Not connected");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    connection->packet_recorder = packet_recorder;
+    return 0;
+}
+
+void provizio_radar_api_record_received_packet(provizio_radar_api_connection *connection, const void *packet,
+                                               size_t packet_size, uint64_t receive_time_ns, uint32_t source_address,
+                                               uint16_t source_port)
+{
+    if (connection->packet_recorder != NULL)
+    {
+        // Failing to record is reported by the recorder, but it doesn't prevent the packet from being handled
+        (void)provizio_packet_recorder_append(connection->packet_recorder, packet, packet_size, receive_time_ns,
+                                              source_address, source_port);
+    }
+}
+
+// Records a packet received from source_address (if recording) and handles it
+static int32_t provizio_radar_api_record_and_handle_packet(provizio_radar_api_connection *connection,
+                                                           const void *packet, size_t packet_size,
+                                                           uint64_t receive_time_ns,
+                                                           const struct sockaddr_in *source_address)
+{
+    provizio_radar_api_record_received_packet(connection, packet, packet_size, receive_time_ns,
+                                              (uint32_t)source_address->sin_addr.s_addr,
+                                              (uint16_t)source_address->sin_port);
+    return provizio_radar_api_handle_received_packet(connection, packet, packet_size, receive_time_ns);
+}
+
+int32_t provizio_radar_api_handle_received_packet(provizio_radar_api_connection *connection, const void *packet,
+                                                  size_t packet_size, uint64_t receive_time_ns)
+{
+    int32_t status_code = PROVIZIO_E_SKIPPED;
+
+    // Let's try to handle it as a point cloud packet
+    if (status_code == PROVIZIO_E_SKIPPED && connection->num_radar_point_cloud_api_contexts > 0 &&
+        connection->radar_point_cloud_api_contexts != NULL)
+    {
+        status_code = provizio_handle_possible_radars_point_cloud_packet_received_at(
+            connection->radar_point_cloud_api_contexts, connection->num_radar_point_cloud_api_contexts, packet,
+            packet_size, receive_time_ns);
+    }
+
+    // Let's try to handle it as a point cloud packet by pooled contexts
+    if (status_code == PROVIZIO_E_SKIPPED && connection->num_pooled_radar_point_cloud_api_contexts > 0 &&
+        connection->pooled_radar_point_cloud_api_contexts != NULL)
+    {
+        // Takes care of the packet buffer if it's been received in zero-copy mode
+        return provizio_handle_possible_pooled_radars_point_cloud_packet_received_at(
+            connection->pooled_radar_point_cloud_api_contexts, connection->num_pooled_radar_point_cloud_api_contexts,
+            packet, packet_size, receive_time_ns);
+    }
+
+    provizio_radar_api_release_packet_buffer(provizio_radar_api_packet_pool(connection), packet);
+    return status_code;
+}
+
+// Receives a single packet to a buffer of PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES bytes and records it (if
+// recording), returns the number of bytes received or -1 if failed (see errno)
+static int32_t provizio_radar_api_receive_and_record_packet(provizio_radar_api_connection *connection, uint8_t *packet,
+                                                            int flags, uint64_t *out_receive_time_ns,
+                                                            struct sockaddr_in *out_source_address)
+{
+    uint64_t receive_time_ns = 0;
+    int32_t received = 0;
+    memset(out_source_address, 0, sizeof(struct sockaddr_in));
+    socklen_t source_address_size = (socklen_t)sizeof(struct sockaddr_in);
+#ifdef PROVIZIO__RADAR_API_RECEIVE_TIMESTAMPS_SUPPORTED
+    if (connection->receive_timestamps)
+    {
+        struct iovec iov;
+        iov.iov_base = packet;
+        iov.iov_len = PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES;
+        provizio_radar_api_control_buffer control;
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_name = out_source_address;
+        message.msg_namelen = source_address_size;
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = &control;
+        message.msg_controllen = sizeof(control);
+
+        received = (int32_t)recvmsg(connection->sock, &message, flags);
+        if (received != (int32_t)-1)
+        {
+            receive_time_ns = provizio_radar_api_receive_time_ns(connection, &message);
+        }
+    }
+    else
+#endif // PROVIZIO__RADAR_API_RECEIVE_TIMESTAMPS_SUPPORTED
+    {
+        received = (int32_t)recvfrom(connection->sock, (char *)packet, PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES,
+                                     flags, (struct sockaddr *)out_source_address, &source_address_size);
+    }
+
+    if (received != (int32_t)-1)
+    {
+        provizio_radar_api_record_received_packet(connection, packet, (size_t)received, receive_time_ns,
+                                                  (uint32_t)out_source_address->sin_addr.s_addr,
+                                                  (uint16_t)out_source_address->sin_port);
+    }
+
+    *out_receive_time_ns = receive_time_ns;
+    return received;
+}
+
+// Turns errno of a failed receiving to the status code to return
+static int32_t provizio_radar_api_receive_error(const char *error_message)
+{
+    if (errno != 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status_code = errno;
+        provizio_error(error_message);
+        return (int32_t)status_code; // NOLINT: Type cast is platform specific
+        // LCOV_EXCL_STOP
+    }
+
+    return (int32_t)PROVIZIO_E_TIMEOUT;
+}
+
 int32_t provizio_radar_api_receive_packet(provizio_radar_api_connection *connection)
 {
     if (!provizio_socket_valid(connection->sock))
@@ -134,34 +607,282 @@ int32_t provizio_radar_api_receive_packet(provizio_radar_api_connection *connect
         return PROVIZIO_E_ARGUMENT;
     }
 
-    uint8_t packet[PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES];
-    int32_t received = (int32_t)recv(connection->sock, (char *)&packet, PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES, 0);
+    uint8_t fallback_packet[PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES];
+    provizio_radar_packet_pool *packet_pool = provizio_radar_api_packet_pool(connection);
+    uint8_t *packet = provizio_radar_api_acquire_packet_buffer(packet_pool, fallback_packet);
+    uint64_t receive_time_ns = 0;
+    struct sockaddr_in source_address;
+    const int32_t received =
+        provizio_radar_api_receive_and_record_packet(connection, packet, 0, &receive_time_ns, &source_address);
+    if (received == (int32_t)-1)
+    {
+        provizio_radar_api_release_packet_buffer(packet_pool, packet);
+        return provizio_radar_api_receive_error("provizio_radar_api_receive_packet: Failed to receive");
+    }
+
+    return provizio_radar_api_handle_received_packet(connection, packet, (size_t)received, receive_time_ns);
+}
+
+int32_t provizio_radar_api_receive_packet_into(provizio_radar_api_connection *connection, void *packet,
+                                               size_t *out_packet_size, uint64_t *out_receive_time_ns)
+{
+    if (!provizio_socket_valid(connection->sock))
+    {
+        provizio_error("provizio_radar_api_receive_packet_into: Not connected");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+#ifdef _WIN32
+    u_long bytes_available = 0;
+    if (ioctlsocket(connection->sock, FIONREAD, &bytes_available) != 0 || bytes_available == 0)
+    {
+        return (int32_t)PROVIZIO_E_TIMEOUT;
+    }
+    const int flags = 0;
+#else
+    const int flags = MSG_DONTWAIT;
+#endif
+
+    struct sockaddr_in source_address;
+    const int32_t received = provizio_radar_api_receive_and_record_packet(connection, (uint8_t *)packet, flags,
+                                                                          out_receive_time_ns, &source_address);
     if (received == (int32_t)-1)
     {
-        if (errno != 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+        return provizio_radar_api_receive_error("provizio_radar_api_receive_packet_into: Failed to receive");
+    }
+
+    *out_packet_size = (size_t)received;
+    return 0;
+}
+
+// Receives and handles up to max_packets packets, the first one is waited for (up to the connection's timeout) only if
+// wait_for_first_packet is non-zero
+static int32_t provizio_radar_api_receive_queued_packets(provizio_radar_api_connection *connection, size_t max_packets,
+                                                         uint8_t wait_for_first_packet,
+                                                         size_t *out_num_packets_handled)
+{
+    int32_t status_code = PROVIZIO_E_SKIPPED; // Unless any of the packets is handled (or fails to be)
+    int32_t receive_error = 0;                // errno of the receive call that failed, if any
+    size_t num_packets_handled = 0;
+    provizio_radar_packet_pool *packet_pool = provizio_radar_api_packet_pool(connection);
+
+#ifdef PROVIZIO__RADAR_API_USE_RECVMMSG
+    uint8_t fallback_packets[PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE]
+                            [PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES];
+    struct iovec iovecs[PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE];
+    struct mmsghdr messages[PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE];
+    provizio_radar_api_control_buffer controls[PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE];
+    struct sockaddr_in source_addresses[PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE];
+    memset(messages, 0, sizeof(messages));
+    memset(source_addresses, 0, sizeof(source_addresses));
+    for (size_t i = 0; i < PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE; ++i)
+    {
+        iovecs[i].iov_len = PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES;
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (num_packets_handled < max_packets)
+    {
+        const size_t packets_left = max_packets - num_packets_handled;
+        const unsigned int batch_size = (unsigned int)(packets_left < PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE
+                                                           ? packets_left
+                                                           : PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE);
+        for (unsigned int i = 0; i < batch_size; ++i)
+        {
+            // In zero-copy mode packets are received directly to the buffers they are kept in
+            iovecs[i].iov_base = provizio_radar_api_acquire_packet_buffer(packet_pool, fallback_packets[i]);
+
+            // Reset every time, as the kernel updates it to the actual length
+            messages[i].msg_hdr.msg_name = &source_addresses[i];
+            messages[i].msg_hdr.msg_namelen = (socklen_t)sizeof(source_addresses[i]);
+
+            if (connection->receive_timestamps)
+            {
+                messages[i].msg_hdr.msg_control = &controls[i];
+                messages[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+            }
+        }
+
+        // Only the very first datagram is waited for (up to the connection's timeout), the rest is what's already
+        // queued
+        const int received =
+            recvmmsg(connection->sock, messages, batch_size,
+                     num_packets_handled == 0 && wait_for_first_packet ? MSG_WAITFORONE : MSG_DONTWAIT, NULL);
+        for (unsigned int i = received > 0 ? (unsigned int)received : 0; i < batch_size; ++i)
+        {
+            provizio_radar_api_release_packet_buffer(packet_pool, (const uint8_t *)iovecs[i].iov_base);
+        }
+
+        if (received < 0)
+        {
+            receive_error = errno;
+            break;
+        }
+
+        for (int i = 0; i < received; ++i)
+        {
+            const uint64_t receive_time_ns = connection->receive_timestamps
+                                                 ? provizio_radar_api_receive_time_ns(connection, &messages[i].msg_hdr)
+                                                 : 0;
+            const int32_t packet_status_code = provizio_radar_api_record_and_handle_packet(
+                connection, (const uint8_t *)iovecs[i].iov_base, (size_t)messages[i].msg_len, receive_time_ns,
+                &source_addresses[i]);
+            if ((status_code == PROVIZIO_E_SKIPPED || status_code == 0) && packet_status_code != PROVIZIO_E_SKIPPED)
+            {
+                status_code = packet_status_code;
+            }
+        }
+
+        num_packets_handled += (size_t)received;
+        if ((unsigned int)received < batch_size)
+        {
+            // Nothing else queued at the moment
+            break;
+        }
+    }
+#else
+    uint8_t fallback_packet[PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES];
+    while (num_packets_handled < max_packets)
+    {
+        int flags = 0;
+        if (num_packets_handled != 0 || !wait_for_first_packet)
+        {
+            // Only the very first datagram is waited for (up to the connection's timeout), the rest is what's already
+            // queued
+#ifdef _WIN32
+            u_long bytes_available = 0;
+            if (ioctlsocket(connection->sock, FIONREAD, &bytes_available) != 0 || bytes_available == 0)
+            {
+                break;
+            }
+#else
+            flags = MSG_DONTWAIT;
+#endif
+        }
+
+        uint8_t *packet = provizio_radar_api_acquire_packet_buffer(packet_pool, fallback_packet);
+        struct sockaddr_in source_address;
+        memset(&source_address, 0, sizeof(source_address));
+        socklen_t source_address_size = (socklen_t)sizeof(source_address);
+        const int32_t received =
+            (int32_t)recvfrom(connection->sock, (char *)packet, PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES, flags,
+                              (struct sockaddr *)&source_address, &source_address_size);
+        if (received == (int32_t)-1)
+        {
+            receive_error = errno;
+            provizio_radar_api_release_packet_buffer(packet_pool, packet);
+            break;
+        }
+
+        // Receive timestamps are supported along with recvmmsg only
+        const int32_t packet_status_code =
+            provizio_radar_api_record_and_handle_packet(connection, packet, (size_t)received, 0, &source_address);
+        if ((status_code == PROVIZIO_E_SKIPPED || status_code == 0) && packet_status_code != PROVIZIO_E_SKIPPED)
+        {
+            status_code = packet_status_code;
+        }
+
+        ++num_packets_handled;
+    }
+#endif
+
+    if (out_num_packets_handled != NULL)
+    {
+        *out_num_packets_handled = num_packets_handled;
+    }
+
+    if (num_packets_handled == 0)
+    {
+        if (receive_error != 0 && receive_error != EAGAIN && receive_error != EWOULDBLOCK && receive_error != EINTR)
         {
             // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
-            const int32_t status_code = errno;
-            provizio_error("provizio_radar_api_receive_packet: Failed to receive");
-            return (int32_t)status_code; // NOLINT: Type cast is platform specific
+            provizio_error("provizio_radar_api_receive_packets: Failed to receive");
+            return (int32_t)receive_error; // NOLINT: Type cast is platform specific
             // LCOV_EXCL_STOP
         }
 
         return (int32_t)PROVIZIO_E_TIMEOUT;
     }
 
-    int32_t status_code = PROVIZIO_E_SKIPPED;
+    return status_code;
+}
 
-    // Let's try to handle it as a point cloud packet
-    if (status_code == PROVIZIO_E_SKIPPED && connection->num_radar_point_cloud_api_contexts > 0 &&
-        connection->radar_point_cloud_api_contexts != NULL)
+int32_t provizio_radar_api_receive_packets(provizio_radar_api_connection *connection, size_t max_packets,
+                                           size_t *out_num_packets_handled)
+{
+    if (out_num_packets_handled != NULL)
     {
-        status_code = provizio_handle_possible_radars_point_cloud_packet(connection->radar_point_cloud_api_contexts,
-                                                                         connection->num_radar_point_cloud_api_contexts,
-                                                                         packet, received);
+        *out_num_packets_handled = 0;
     }
 
-    return status_code;
+    if (!provizio_socket_valid(connection->sock))
+    {
+        provizio_error("provizio_radar_api_receive_packets: Not connected");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (max_packets == 0)
+    {
+        provizio_error("provizio_radar_api_receive_packets: max_packets can't be 0");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    return provizio_radar_api_receive_queued_packets(connection, max_packets, 1, out_num_packets_handled);
+}
+
+int32_t provizio_radar_api_set_non_blocking(provizio_radar_api_connection *connection, uint8_t non_blocking)
+{
+    if (!provizio_socket_valid(connection->sock))
+    {
+        provizio_error("provizio_radar_api_set_non_blocking: Not connected");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    const int32_t status = provizio_socket_set_non_blocking(connection->sock, non_blocking);
+    if (status != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t error_code = errno;
+        provizio_error("provizio_radar_api_set_non_blocking: provizio_socket_set_non_blocking failed!");
+        return error_code != 0 ? error_code : status;
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+}
+
+PROVIZIO__SOCKET provizio_radar_api_get_socket(const provizio_radar_api_connection *connection)
+{
+    return connection->sock;
+}
+
+int32_t provizio_radar_api_drain(provizio_radar_api_connection *connection, size_t *out_num_packets_handled)
+{
+    if (out_num_packets_handled != NULL)
+    {
+        *out_num_packets_handled = 0;
+    }
+
+    if (!provizio_socket_valid(connection->sock))
+    {
+        provizio_error("provizio_radar_api_drain: Not connected");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    const int32_t status_code =
+        provizio_radar_api_receive_queued_packets(connection, SIZE_MAX, 0, out_num_packets_handled);
+
+    // Nothing (else) queued is the normal outcome of draining, as well as skipping some (or all) of the packets
+    return status_code != PROVIZIO_E_TIMEOUT && status_code != PROVIZIO_E_SKIPPED ? status_code : 0;
+}
+
+size_t provizio_radar_api_tick(provizio_radar_api_connection *connection)
+{
+    return provizio_radar_point_cloud_api_contexts_tick(connection->radar_point_cloud_api_contexts,
+                                                        connection->num_radar_point_cloud_api_contexts) +
+           provizio_pooled_radar_point_cloud_api_contexts_tick(connection->pooled_radar_point_cloud_api_contexts,
+                                                               connection->num_pooled_radar_point_cloud_api_contexts);
 }
 
 int32_t provizio_close_radars_connection(provizio_radar_api_connection *connection)
@@ -0,0 +1,133 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/histogram.h"
+
+#include <assert.h>
+
+#include "provizio/atomic.h"
+
+// Index of the most significant bit set, value must be positive
+static uint32_t provizio_histogram_most_significant_bit(uint64_t value)
+{
+    uint32_t result = 0;
+    for (uint32_t shift = 32; shift > 0; shift >>= 1U)
+    {
+        if ((value >> shift) != 0)
+        {
+            value >>= shift;
+            result += shift;
+        }
+    }
+
+    return result;
+}
+
+size_t provizio_histogram_bucket_index(uint64_t value)
+{
+    if (value < PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT)
+    {
+        return (size_t)value;
+    }
+
+    // The top PROVIZIO__HISTOGRAM_SUB_BUCKET_BITS + 1 bits of the value select the bucket in its power of 2 range
+    const uint32_t shift = provizio_histogram_most_significant_bit(value) - PROVIZIO__HISTOGRAM_SUB_BUCKET_BITS;
+    return (size_t)shift * PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT + (size_t)(value >> shift);
+}
+
+uint64_t provizio_histogram_bucket_lowest_value(size_t bucket_index)
+{
+    assert(bucket_index < PROVIZIO__HISTOGRAM_BUCKETS_COUNT);
+
+    if (bucket_index < 2 * PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT)
+    {
+        return (uint64_t)bucket_index;
+    }
+
+    // Inverse of provizio_histogram_bucket_index
+    const size_t shift = bucket_index / PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT - 1;
+    return (uint64_t)(bucket_index - shift * PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT) << shift;
+}
+
+uint64_t provizio_histogram_bucket_highest_value(size_t bucket_index)
+{
+    assert(bucket_index < PROVIZIO__HISTOGRAM_BUCKETS_COUNT);
+
+    return bucket_index + 1 < PROVIZIO__HISTOGRAM_BUCKETS_COUNT
+               ? provizio_histogram_bucket_lowest_value(bucket_index + 1) - 1
+               : UINT64_MAX;
+}
+
+void provizio_histogram_record(provizio_histogram *histogram, uint64_t value)
+{
+    PROVIZIO__ATOMIC_ADD_UINT32(&histogram->buckets[provizio_histogram_bucket_index(value)], 1);
+    PROVIZIO__ATOMIC_ADD_UINT64(&histogram->count, 1);
+    PROVIZIO__ATOMIC_ADD_UINT64(&histogram->sum, value);
+
+    // A single writer, so no compare-and-swap loop is required
+    if (value > PROVIZIO__ATOMIC_LOAD_UINT64(&histogram->max))
+    {
+        PROVIZIO__ATOMIC_STORE_UINT64(&histogram->max, value);
+    }
+}
+
+void provizio_histogram_snapshot(const provizio_histogram *histogram, provizio_histogram *out_snapshot)
+{
+    out_snapshot->count = PROVIZIO__ATOMIC_LOAD_UINT64(&histogram->count);
+    out_snapshot->sum = PROVIZIO__ATOMIC_LOAD_UINT64(&histogram->sum);
+    out_snapshot->max = PROVIZIO__ATOMIC_LOAD_UINT64(&histogram->max);
+    for (size_t i = 0; i < PROVIZIO__HISTOGRAM_BUCKETS_COUNT; ++i)
+    {
+        out_snapshot->buckets[i] = PROVIZIO__ATOMIC_LOAD_UINT32(&histogram->buckets[i]);
+    }
+}
+
+uint64_t provizio_histogram_value_at_percentile(const provizio_histogram *histogram, double percentile)
+{
+    uint64_t total_count = 0;
+    for (size_t i = 0; i < PROVIZIO__HISTOGRAM_BUCKETS_COUNT; ++i)
+    {
+        total_count += histogram->buckets[i];
+    }
+
+    if (total_count == 0)
+    {
+        return 0;
+    }
+
+    percentile = percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile);
+    // Number of values the percentile covers, rounded up
+    const double exact_target_count = (double)total_count * percentile / 100.0;
+    uint64_t target_count = (uint64_t)exact_target_count;
+    if ((double)target_count < exact_target_count)
+    {
+        ++target_count;
+    }
+    target_count = target_count > 0 ? (target_count < total_count ? target_count : total_count) : 1;
+
+    uint64_t count = 0;
+    for (size_t i = 0; i < PROVIZIO__HISTOGRAM_BUCKETS_COUNT; ++i)
+    {
+        count += histogram->buckets[i];
+        if (count >= target_count)
+        {
+            const uint64_t value = provizio_histogram_bucket_highest_value(i);
+            return value < histogram->max ? value : histogram->max;
+        }
+    }
+
+    // LCOV_EXCL_START: unreachable, as target_count never exceeds total_count
+    return histogram->max;
+    // LCOV_EXCL_STOP
+}
@@ -0,0 +1,542 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // Required for syscall
+#endif
+
+#include "provizio/radar_api/io_uring_receiver.h"
+
+#include <string.h>
+
+#include "provizio/atomic.h"
+#include "provizio/util.h"
+
+#if defined(__linux__) && !defined(PROVIZIO__RADAR_API_DISABLE_IO_URING) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+// Multishot recvmsg is the most recent feature used (Linux 6.0), liburing is not required
+#ifdef IORING_RECV_MULTISHOT
+#define PROVIZIO__RADAR_API_IO_URING_SUPPORTED
+#endif
+
+#ifdef PROVIZIO__RADAR_API_IO_URING_SUPPORTED
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+enum
+{
+    // Only a single request (the multishot receive) is ever submitted at a time
+    provizio_radar_api_io_uring_num_submission_queue_entries = 2,
+    provizio_radar_api_io_uring_buffer_group_id = 0,
+    // Every buffer is received to as an io_uring_recvmsg_out header followed by the source address (for
+    // provizio_radar_api_set_packet_recorder) and the payload (no control messages are requested), rounded up to a
+    // cache line
+    provizio_radar_api_io_uring_payload_offset = sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_in),
+    provizio_radar_api_io_uring_buffer_size =
+        (provizio_radar_api_io_uring_payload_offset + PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES + 63) & ~63
+};
+
+static int provizio_io_uring_setup(uint32_t entries, struct io_uring_params *params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int provizio_io_uring_enter(int ring_fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags,
+                                   const void *arg, size_t arg_size)
+{
+    return (int)syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, arg, arg_size);
+}
+
+static int provizio_io_uring_register(int ring_fd, uint32_t opcode, const void *arg, uint32_t num_args)
+{
+    return (int)syscall(__NR_io_uring_register, ring_fd, opcode, arg, num_args);
+}
+
+static void provizio_radar_api_io_uring_unmap(provizio_radar_api_io_uring_receiver *receiver)
+{
+    if (receiver->rings != NULL)
+    {
+        munmap(receiver->rings, receiver->rings_size);
+        receiver->rings = NULL;
+    }
+
+    if (receiver->submission_queue_entries != NULL)
+    {
+        munmap(receiver->submission_queue_entries, receiver->submission_queue_entries_size);
+        receiver->submission_queue_entries = NULL;
+    }
+
+    if (receiver->ring_fd >= 0)
+    {
+        close(receiver->ring_fd);
+        receiver->ring_fd = -1;
+    }
+
+    // Unmapped after closing the ring, so the kernel doesn't use the buffers anymore
+    if (receiver->buffers_mapping != NULL)
+    {
+        munmap(receiver->buffers_mapping, receiver->buffers_mapping_size);
+        receiver->buffers_mapping = NULL;
+    }
+}
+
+// Returns a buffer to the provided buffer ring, takes effect on provizio_radar_api_io_uring_publish_buffers
+static void provizio_radar_api_io_uring_provide_buffer(provizio_radar_api_io_uring_receiver *receiver,
+                                                       uint16_t buffer_id)
+{
+    struct io_uring_buf *buffer_ring_entries = (struct io_uring_buf *)receiver->buffers_mapping;
+    struct io_uring_buf *entry = &buffer_ring_entries[receiver->buffer_ring_tail & (receiver->num_buffers - 1)];
+    uint8_t *buffer = receiver->buffers + (size_t)buffer_id * provizio_radar_api_io_uring_buffer_size;
+    entry->addr = (uint64_t)(uintptr_t)buffer;
+    entry->len = provizio_radar_api_io_uring_buffer_size;
+    entry->bid = buffer_id;
+    ++receiver->buffer_ring_tail;
+}
+
+static void provizio_radar_api_io_uring_publish_buffers(provizio_radar_api_io_uring_receiver *receiver)
+{
+    // The ring's tail overlays the reserved field of its first entry
+    struct io_uring_buf_ring *buffer_ring = (struct io_uring_buf_ring *)receiver->buffers_mapping;
+    __atomic_store_n(&buffer_ring->tail, receiver->buffer_ring_tail, __ATOMIC_RELEASE);
+}
+
+// Queues the multishot receive request, it's submitted on the next provizio_io_uring_enter
+static void provizio_radar_api_io_uring_prepare_receive(provizio_radar_api_io_uring_receiver *receiver)
+{
+    const uint32_t tail = *receiver->submission_queue_tail; // Only written by this thread
+    const uint32_t index = tail & receiver->submission_queue_mask;
+    struct io_uring_sqe *entry = &((struct io_uring_sqe *)receiver->submission_queue_entries)[index];
+    memset(entry, 0, sizeof(struct io_uring_sqe));
+    entry->opcode = IORING_OP_RECVMSG;
+    entry->fd = (int32_t)receiver->connection->sock;
+    entry->addr = (uint64_t)(uintptr_t)receiver->message_header;
+    entry->len = 1;
+    entry->ioprio = IORING_RECV_MULTISHOT;
+    entry->flags = IOSQE_BUFFER_SELECT;
+    entry->buf_group = provizio_radar_api_io_uring_buffer_group_id;
+
+    receiver->submission_queue_array[index] = index;
+    PROVIZIO__ATOMIC_STORE_UINT32(receiver->submission_queue_tail, tail + 1);
+    receiver->receiving = 1;
+}
+
+// Queues cancellation of the multishot receive request, it's submitted on the next provizio_io_uring_enter
+static void provizio_radar_api_io_uring_prepare_cancel(provizio_radar_api_io_uring_receiver *receiver)
+{
+    const uint32_t tail = *receiver->submission_queue_tail; // Only written by this thread
+    const uint32_t index = tail & receiver->submission_queue_mask;
+    struct io_uring_sqe *entry = &((struct io_uring_sqe *)receiver->submission_queue_entries)[index];
+    memset(entry, 0, sizeof(struct io_uring_sqe));
+    entry->opcode = IORING_OP_ASYNC_CANCEL;
+    entry->fd = -1;
+    entry->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+
+    receiver->submission_queue_array[index] = index;
+    PROVIZIO__ATOMIC_STORE_UINT32(receiver->submission_queue_tail, tail + 1);
+}
+
+static uint32_t provizio_radar_api_io_uring_num_to_submit(provizio_radar_api_io_uring_receiver *receiver)
+{
+    return *receiver->submission_queue_tail - PROVIZIO__ATOMIC_LOAD_UINT32(receiver->submission_queue_head);
+}
+
+static int32_t provizio_radar_api_io_uring_map(provizio_radar_api_io_uring_receiver *receiver,
+                                               const struct io_uring_params *params)
+{
+    if ((params->features & IORING_FEAT_SINGLE_MMAP) == 0 || (params->features & IORING_FEAT_EXT_ARG) == 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the kernel
+        provizio_error("provizio_radar_api_io_uring_receiver_init: The kernel's io_uring is too old");
+        return PROVIZIO_E_NOT_PERMITTED;
+        // LCOV_EXCL_STOP
+    }
+
+    const size_t submission_ring_size = params->sq_off.array + params->sq_entries * sizeof(uint32_t);
+    const size_t completion_ring_size = params->cq_off.cqes + params->cq_entries * sizeof(struct io_uring_cqe);
+    receiver->rings_size = submission_ring_size > completion_ring_size ? submission_ring_size : completion_ring_size;
+    void *rings = mmap(NULL, receiver->rings_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       receiver->ring_fd, IORING_OFF_SQ_RING);
+    receiver->submission_queue_entries_size = params->sq_entries * sizeof(struct io_uring_sqe);
+    void *submission_queue_entries = mmap(NULL, receiver->submission_queue_entries_size, PROT_READ | PROT_WRITE,
+                                          MAP_SHARED | MAP_POPULATE, receiver->ring_fd, IORING_OFF_SQES);
+    receiver->rings = rings != MAP_FAILED ? rings : NULL;
+    receiver->submission_queue_entries = submission_queue_entries != MAP_FAILED ? submission_queue_entries : NULL;
+    if (receiver->rings == NULL || receiver->submission_queue_entries == NULL)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status_code = errno;
+        provizio_error("provizio_radar_api_io_uring_receiver_init: Failed to map the rings");
+        return status_code != 0 ? status_code : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    uint8_t *rings_bytes = (uint8_t *)receiver->rings;
+    receiver->submission_queue_head = (uint32_t *)(rings_bytes + params->sq_off.head);
+    receiver->submission_queue_tail = (uint32_t *)(rings_bytes + params->sq_off.tail);
+    receiver->submission_queue_array = (uint32_t *)(rings_bytes + params->sq_off.array);
+    receiver->submission_queue_flags = (uint32_t *)(rings_bytes + params->sq_off.flags);
+    receiver->submission_queue_mask = *(const uint32_t *)(rings_bytes + params->sq_off.ring_mask);
+    receiver->completion_queue_head = (uint32_t *)(rings_bytes + params->cq_off.head);
+    receiver->completion_queue_tail = (uint32_t *)(rings_bytes + params->cq_off.tail);
+    receiver->completion_queue_entries = rings_bytes + params->cq_off.cqes;
+    receiver->completion_queue_mask = *(const uint32_t *)(rings_bytes + params->cq_off.ring_mask);
+
+    return 0;
+}
+
+static int32_t provizio_radar_api_io_uring_register_buffers(provizio_radar_api_io_uring_receiver *receiver)
+{
+    // Page aligned (as required for the buffer ring) anonymous mapping: buffer ring, message header, buffers
+    const size_t buffer_ring_size = receiver->num_buffers * sizeof(struct io_uring_buf);
+    const size_t message_header_size = (sizeof(struct msghdr) + 63) & ~(size_t)63;
+    receiver->buffers_mapping_size = buffer_ring_size + message_header_size +
+                                     (size_t)receiver->num_buffers * provizio_radar_api_io_uring_buffer_size;
+    void *buffers_mapping = mmap(NULL, receiver->buffers_mapping_size, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (buffers_mapping == MAP_FAILED)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status_code = errno;
+        provizio_error("provizio_radar_api_io_uring_receiver_init: Failed to allocate buffers");
+        return status_code != 0 ? status_code : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    // Anonymous mappings are zero-filled, so the message header requests no control messages
+    receiver->buffers_mapping = buffers_mapping;
+    receiver->message_header = (uint8_t *)buffers_mapping + buffer_ring_size;
+    ((struct msghdr *)receiver->message_header)->msg_namelen = (socklen_t)sizeof(struct sockaddr_in);
+    receiver->buffers = (uint8_t *)buffers_mapping + buffer_ring_size + message_header_size;
+
+    struct io_uring_buf_reg registration;
+    memset(&registration, 0, sizeof(registration));
+    registration.ring_addr = (uint64_t)(uintptr_t)buffers_mapping;
+    registration.ring_entries = receiver->num_buffers;
+    registration.bgid = provizio_radar_api_io_uring_buffer_group_id;
+    if (provizio_io_uring_register(receiver->ring_fd, IORING_REGISTER_PBUF_RING, &registration, 1) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the kernel
+        provizio_error("provizio_radar_api_io_uring_receiver_init: Provided buffer rings are not supported");
+        return PROVIZIO_E_NOT_PERMITTED;
+        // LCOV_EXCL_STOP
+    }
+
+    for (uint32_t i = 0; i < receiver->num_buffers; ++i)
+    {
+        provizio_radar_api_io_uring_provide_buffer(receiver, (uint16_t)i);
+    }
+    provizio_radar_api_io_uring_publish_buffers(receiver);
+
+    return 0;
+}
+
+int32_t provizio_radar_api_io_uring_receiver_init(provizio_radar_api_connection *connection, size_t num_buffers,
+                                                  provizio_radar_api_io_uring_receiver *out_receiver)
+{
+    memset(out_receiver, 0, sizeof(provizio_radar_api_io_uring_receiver));
+    out_receiver->ring_fd = -1;
+
+    if (!provizio_socket_valid(connection->sock))
+    {
+        provizio_error("provizio_radar_api_io_uring_receiver_init: Not connected");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (num_buffers == 0 || num_buffers > PROVIZIO__RADAR_API_IO_URING_MAX_NUM_BUFFERS ||
+        (num_buffers & (num_buffers - 1)) != 0)
+    {
+        provizio_error("provizio_radar_api_io_uring_receiver_init: num_buffers must be a power of 2 not greater than "
+                       "PROVIZIO__RADAR_API_IO_URING_MAX_NUM_BUFFERS");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (connection->receive_timestamps)
+    {
+        provizio_warning("provizio_radar_api_io_uring_receiver_init: Receive timestamps are not supported, so packets "
+                         "are handled with unknown receive times");
+    }
+
+    out_receiver->connection = connection;
+    out_receiver->num_buffers = (uint32_t)num_buffers;
+
+    // Every buffer produces a completion, so the completion queue is sized to fit them all
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    // Cooperative task running keeps io_uring from interrupting the thread's other system calls (e.g. with EINTR),
+    // the pending work is flagged instead, and run by provizio_radar_api_io_uring_receiver_receive
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN | IORING_SETUP_TASKRUN_FLAG;
+    params.cq_entries = (uint32_t)num_buffers;
+    const int ring_fd = provizio_io_uring_setup(provizio_radar_api_io_uring_num_submission_queue_entries, &params);
+    if (ring_fd < 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the kernel
+        provizio_error("provizio_radar_api_io_uring_receiver_init: io_uring is not available");
+        return PROVIZIO_E_NOT_PERMITTED;
+        // LCOV_EXCL_STOP
+    }
+    out_receiver->ring_fd = (int32_t)ring_fd;
+
+    int32_t status_code = provizio_radar_api_io_uring_map(out_receiver, &params);
+    if (status_code == 0)
+    {
+        status_code = provizio_radar_api_io_uring_register_buffers(out_receiver);
+    }
+
+    if (status_code == 0)
+    {
+        // Start receiving straight away, so packets are not lost while the receiver is idle
+        provizio_radar_api_io_uring_prepare_receive(out_receiver);
+        if (provizio_io_uring_enter(ring_fd, provizio_radar_api_io_uring_num_to_submit(out_receiver), 0, 0, NULL, 0) <
+            0)
+        {
+            // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+            status_code = errno != 0 ? errno : -1;
+            provizio_error("provizio_radar_api_io_uring_receiver_init: Failed to submit the receive request");
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    if (status_code != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the kernel
+        provizio_radar_api_io_uring_unmap(out_receiver);
+        // LCOV_EXCL_STOP
+    }
+
+    return status_code;
+}
+
+// Handles a single completion of the multishot receive request
+static int32_t provizio_radar_api_io_uring_handle_completion(provizio_radar_api_io_uring_receiver *receiver,
+                                                             const struct io_uring_cqe *completion,
+                                                             size_t *num_packets_handled)
+{
+    if ((completion->flags & IORING_CQE_F_MORE) == 0)
+    {
+        // The request has terminated (e.g. as it ran out of buffers), it's resubmitted on the next receive
+        receiver->receiving = 0;
+    }
+
+    if (completion->res < 0)
+    {
+        if (completion->res == -ENOBUFS)
+        {
+            // Packets remain queued in the socket until the buffers are returned
+            return PROVIZIO_E_SKIPPED;
+        }
+
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        provizio_error("provizio_radar_api_io_uring_receiver_receive: Failed to receive");
+        return (int32_t)-completion->res;
+        // LCOV_EXCL_STOP
+    }
+
+    if ((completion->flags & IORING_CQE_F_BUFFER) == 0)
+    {
+        // LCOV_EXCL_START: Not expected, as a multishot receive always selects a buffer
+        return PROVIZIO_E_SKIPPED;
+        // LCOV_EXCL_STOP
+    }
+
+    const uint16_t buffer_id = (uint16_t)(completion->flags >> IORING_CQE_BUFFER_SHIFT);
+    uint8_t *buffer = receiver->buffers + (size_t)buffer_id * provizio_radar_api_io_uring_buffer_size;
+    const struct io_uring_recvmsg_out *message = (const struct io_uring_recvmsg_out *)buffer;
+    const size_t payload_size = message->payloadlen < PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES
+                                    ? (size_t)message->payloadlen
+                                    : (size_t)PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES; // Truncated otherwise
+
+    // The payload is copied (if kept), so the buffer can be reused right away
+    const struct sockaddr_in *source_address =
+        (const struct sockaddr_in *)(buffer + sizeof(struct io_uring_recvmsg_out));
+    const uint8_t *payload = buffer + provizio_radar_api_io_uring_payload_offset;
+    provizio_radar_api_record_received_packet(receiver->connection, payload, payload_size, 0,
+                                              (uint32_t)source_address->sin_addr.s_addr,
+                                              (uint16_t)source_address->sin_port);
+    const int32_t status_code =
+        provizio_radar_api_handle_received_packet(receiver->connection, payload, payload_size, 0);
+    provizio_radar_api_io_uring_provide_buffer(receiver, buffer_id);
+    ++*num_packets_handled;
+
+    return status_code;
+}
+
+// Submits the queued requests (if any) and waits (up to wait_timeout_ns) for min_completions completions
+static int32_t provizio_radar_api_io_uring_submit_and_wait(provizio_radar_api_io_uring_receiver *receiver,
+                                                           uint32_t min_completions, uint64_t wait_timeout_ns)
+{
+    const uint32_t num_to_submit = provizio_radar_api_io_uring_num_to_submit(receiver);
+    const uint8_t task_pending =
+        (PROVIZIO__ATOMIC_LOAD_UINT32(receiver->submission_queue_flags) & IORING_SQ_TASKRUN) != 0;
+    const uint8_t wait = min_completions != 0;
+    if (num_to_submit == 0 && !wait && !task_pending)
+    {
+        // A system call is only required to (re)submit the request, to let the kernel post completions or to wait
+        return 0;
+    }
+
+    const uint64_t nanoseconds_in_second = 1000000000ULL;
+    struct __kernel_timespec timeout;
+    timeout.tv_sec = (int64_t)(wait_timeout_ns / nanoseconds_in_second);
+    timeout.tv_nsec = (long long)(wait_timeout_ns % nanoseconds_in_second);
+    struct io_uring_getevents_arg wait_arg;
+    memset(&wait_arg, 0, sizeof(wait_arg));
+    wait_arg.ts = (uint64_t)(uintptr_t)&timeout;
+
+    const uint32_t flags = (wait || task_pending ? IORING_ENTER_GETEVENTS : 0) | (wait ? IORING_ENTER_EXT_ARG : 0);
+    if (provizio_io_uring_enter(receiver->ring_fd, num_to_submit, min_completions, flags, wait ? &wait_arg : NULL,
+                                wait ? sizeof(wait_arg) : 0) < 0 &&
+        errno != ETIME && errno != EINTR && errno != EBUSY)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status_code = errno;
+        provizio_error("provizio_radar_api_io_uring_receiver_receive: io_uring_enter failed");
+        return status_code != 0 ? status_code : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+}
+
+int32_t provizio_radar_api_io_uring_receiver_receive(provizio_radar_api_io_uring_receiver *receiver,
+                                                     uint64_t wait_timeout_ns, size_t *out_num_packets_handled)
+{
+    if (out_num_packets_handled != NULL)
+    {
+        *out_num_packets_handled = 0;
+    }
+
+    if (receiver->ring_fd < 0)
+    {
+        provizio_error("provizio_radar_api_io_uring_receiver_receive: Not initialized");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    int32_t status_code = 0;
+    size_t num_packets_handled = 0;
+    do
+    {
+        if (!receiver->receiving)
+        {
+            provizio_radar_api_io_uring_prepare_receive(receiver);
+        }
+
+        uint32_t head = *receiver->completion_queue_head; // Only written by this thread
+        const uint8_t wait =
+            head == PROVIZIO__ATOMIC_LOAD_UINT32(receiver->completion_queue_tail) && wait_timeout_ns != 0;
+        const int32_t wait_status_code = provizio_radar_api_io_uring_submit_and_wait(receiver, wait, wait_timeout_ns);
+        if (wait_status_code != 0)
+        {
+            // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+            return wait_status_code;
+            // LCOV_EXCL_STOP
+        }
+
+        uint32_t tail = PROVIZIO__ATOMIC_LOAD_UINT32(receiver->completion_queue_tail);
+        while (head != tail)
+        {
+            const struct io_uring_cqe *completion_queue_entries =
+                (const struct io_uring_cqe *)receiver->completion_queue_entries;
+            const struct io_uring_cqe *completion = &completion_queue_entries[head & receiver->completion_queue_mask];
+            const int32_t packet_status_code =
+                provizio_radar_api_io_uring_handle_completion(receiver, completion, &num_packets_handled);
+            if (status_code == 0 && packet_status_code != PROVIZIO_E_SKIPPED)
+            {
+                status_code = packet_status_code;
+            }
+
+            ++head;
+            if (head == tail)
+            {
+                // Return the buffers and the completions to the kernel, then pick up what's arrived meanwhile
+                provizio_radar_api_io_uring_publish_buffers(receiver);
+                PROVIZIO__ATOMIC_STORE_UINT32(receiver->completion_queue_head, head);
+                tail = PROVIZIO__ATOMIC_LOAD_UINT32(receiver->completion_queue_tail);
+            }
+        }
+
+        // If the request has terminated having received nothing (i.e. the kernel ran out of buffers before they were
+        // returned), it's resubmitted to wait for the packets still queued in the socket
+    } while (num_packets_handled == 0 && status_code == 0 && !receiver->receiving && wait_timeout_ns != 0);
+
+    if (out_num_packets_handled != NULL)
+    {
+        *out_num_packets_handled = num_packets_handled;
+    }
+
+    return num_packets_handled != 0 || status_code != 0 ? status_code : PROVIZIO_E_TIMEOUT;
+}
+
+int32_t provizio_radar_api_io_uring_receiver_release(provizio_radar_api_io_uring_receiver *receiver)
+{
+    if (receiver->ring_fd < 0)
+    {
+        provizio_error("provizio_radar_api_io_uring_receiver_release: Not initialized");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (receiver->receiving)
+    {
+        // Cancel the request and reap its completions first, otherwise the kernel cancels it asynchronously on closing,
+        // which may interrupt the thread's system calls that follow
+        provizio_radar_api_io_uring_prepare_cancel(receiver);
+        provizio_radar_api_io_uring_submit_and_wait(receiver, 2, PROVIZIO__RADAR_API_IO_URING_CANCEL_TIMEOUT_NS);
+        receiver->receiving = 0;
+    }
+
+    provizio_radar_api_io_uring_unmap(receiver);
+    return 0;
+}
+
+#else // PROVIZIO__RADAR_API_IO_URING_SUPPORTED
+
+int32_t provizio_radar_api_io_uring_receiver_init(provizio_radar_api_connection *connection, size_t num_buffers,
+                                                  provizio_radar_api_io_uring_receiver *out_receiver)
+{
+    (void)connection;
+    (void)num_buffers;
+    memset(out_receiver, 0, sizeof(provizio_radar_api_io_uring_receiver));
+    out_receiver->ring_fd = -1;
+
+    provizio_error("provizio_radar_api_io_uring_receiver_init: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+
+int32_t provizio_radar_api_io_uring_receiver_receive(provizio_radar_api_io_uring_receiver *receiver,
+                                                     uint64_t wait_timeout_ns, size_t *out_num_packets_handled)
+{
+    (void)receiver;
+    (void)wait_timeout_ns;
+    if (out_num_packets_handled != NULL)
+    {
+        *out_num_packets_handled = 0;
+    }
+
+    provizio_error("provizio_radar_api_io_uring_receiver_receive: Not initialized");
+    return PROVIZIO_E_ARGUMENT;
+}
+
+int32_t provizio_radar_api_io_uring_receiver_release(provizio_radar_api_io_uring_receiver *receiver)
+{
+    (void)receiver;
+
+    provizio_error("provizio_radar_api_io_uring_receiver_release: Not initialized");
+    return PROVIZIO_E_ARGUMENT;
+}
+
+#endif // PROVIZIO__RADAR_API_IO_URING_SUPPORTED
@@ -0,0 +1,124 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/memory_pool.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "provizio/radar_api/errno.h"
+
+// Placed in the first unit of every block, blocks cover the entire pool one after another
+typedef struct provizio_memory_pool_block_header
+{
+    size_t num_units; // Including the header itself
+    size_t allocated; // 0 for free blocks
+} provizio_memory_pool_block_header;
+
+static provizio_memory_pool_block_header *provizio_memory_pool_block(provizio_memory_pool *pool, size_t unit)
+{
+    return (provizio_memory_pool_block_header *)(void *)&pool->memory[unit * PROVIZIO__MEMORY_POOL_UNIT_SIZE];
+}
+
+static size_t provizio_memory_pool_units(size_t size)
+{
+    // One more unit for the header
+    return (size + PROVIZIO__MEMORY_POOL_UNIT_SIZE - 1) / PROVIZIO__MEMORY_POOL_UNIT_SIZE + 1;
+}
+
+int32_t provizio_memory_pool_init(void *memory, size_t memory_size, provizio_memory_pool *out_pool)
+{
+    memset(out_pool, 0, sizeof(provizio_memory_pool));
+
+    const size_t misalignment = (size_t)((uintptr_t)memory % PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+    const size_t skip_bytes = misalignment != 0 ? PROVIZIO__MEMORY_POOL_UNIT_SIZE - misalignment : 0;
+    if (memory == NULL || memory_size < skip_bytes + 2 * PROVIZIO__MEMORY_POOL_UNIT_SIZE)
+    {
+        provizio_error("provizio_memory_pool_init: Not enough memory");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    out_pool->memory = (uint8_t *)memory + skip_bytes;
+    out_pool->num_units = (memory_size - skip_bytes) / PROVIZIO__MEMORY_POOL_UNIT_SIZE;
+
+    // A single free block
+    provizio_memory_pool_block_header *block = provizio_memory_pool_block(out_pool, 0);
+    block->num_units = out_pool->num_units;
+    block->allocated = 0;
+
+    return 0;
+}
+
+size_t provizio_memory_pool_required_size(size_t allocation_size, size_t num_allocations)
+{
+    return (num_allocations + 1) * provizio_memory_pool_units(allocation_size) * PROVIZIO__MEMORY_POOL_UNIT_SIZE +
+           PROVIZIO__MEMORY_POOL_UNIT_SIZE - 1;
+}
+
+void *provizio_memory_pool_allocate(provizio_memory_pool *pool, size_t size)
+{
+    const size_t num_units = provizio_memory_pool_units(size);
+
+    size_t unit = 0;
+    while (unit < pool->num_units)
+    {
+        provizio_memory_pool_block_header *block = provizio_memory_pool_block(pool, unit);
+        if (!block->allocated)
+        {
+            // Merge with the following free blocks, if any
+            size_t next_unit = unit + block->num_units;
+            while (next_unit < pool->num_units && !provizio_memory_pool_block(pool, next_unit)->allocated)
+            {
+                block->num_units += provizio_memory_pool_block(pool, next_unit)->num_units;
+                next_unit = unit + block->num_units;
+            }
+
+            if (block->num_units >= num_units)
+            {
+                if (block->num_units > num_units)
+                {
+                    // Split off the rest as a free block
+                    provizio_memory_pool_block_header *rest = provizio_memory_pool_block(pool, unit + num_units);
+                    rest->num_units = block->num_units - num_units;
+                    rest->allocated = 0;
+                }
+
+                block->num_units = num_units;
+                block->allocated = 1;
+                pool->num_units_used += num_units;
+
+                return &pool->memory[(unit + 1) * PROVIZIO__MEMORY_POOL_UNIT_SIZE];
+            }
+        }
+
+        unit += block->num_units;
+    }
+
+    return NULL;
+}
+
+void provizio_memory_pool_release(provizio_memory_pool *pool, void *memory)
+{
+    if (memory == NULL)
+    {
+        return;
+    }
+
+    const size_t unit = (size_t)((uint8_t *)memory - pool->memory) / PROVIZIO__MEMORY_POOL_UNIT_SIZE - 1;
+    provizio_memory_pool_block_header *block = provizio_memory_pool_block(pool, unit);
+    assert(unit < pool->num_units && block->allocated);
+
+    block->allocated = 0;
+    pool->num_units_used -= block->num_units;
+}
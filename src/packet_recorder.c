@@ -0,0 +1,317 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/radar_api/packet_recorder.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "provizio/radar_api/radar_point_cloud.h"
+#include "provizio/util.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#define PROVIZIO__PACKET_RECORDER_ALIGN(size)                                                                          \
+    (((size) + PROVIZIO__PACKET_LOG_RECORD_ALIGNMENT - 1) & ~(size_t)(PROVIZIO__PACKET_LOG_RECORD_ALIGNMENT - 1))
+
+int32_t provizio_packet_log_segment_path(const char *path_prefix, uint64_t segment_index, char *out_path,
+                                         size_t out_path_size)
+{
+    const int length = snprintf(out_path, out_path_size, "%s.%06llu" PROVIZIO__PACKET_LOG_SEGMENT_EXTENSION,
+                                path_prefix, (unsigned long long)segment_index);
+    if (length < 0 || (size_t)length >= out_path_size)
+    {
+        provizio_error("provizio_packet_log_segment_path: Insufficient out_path_size");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    return 0;
+}
+
+#ifndef _WIN32
+
+static size_t provizio_packet_recorder_records_offset(uint32_t max_index_entries)
+{
+    return PROVIZIO__PACKET_RECORDER_ALIGN(sizeof(provizio_packet_log_segment_header) +
+                                           (size_t)max_index_entries * sizeof(provizio_packet_log_index_entry));
+}
+
+static int32_t provizio_packet_recorder_start_segment(provizio_packet_recorder *recorder, uint64_t segment_index)
+{
+    char path[PROVIZIO__PACKET_RECORDER_MAX_PATH_PREFIX + 32];
+    provizio_packet_log_segment_path(recorder->path_prefix, segment_index, path, sizeof(path));
+
+    const int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644); // NOLINT: open is variadic
+    if (fd < 0)
+    {
+        const int32_t status = errno;
+        provizio_error("provizio_packet_recorder: Failed to create a segment file");
+        return status != 0 ? status : -1;
+    }
+
+    // Preallocated, so appending records never extends the file (which would require a system call)
+    if (ftruncate(fd, (off_t)recorder->segment_size) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        close(fd);
+        provizio_error("provizio_packet_recorder: Failed to allocate a segment file");
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    void *segment = mmap(NULL, recorder->segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (segment == MAP_FAILED)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        close(fd);
+        provizio_error("provizio_packet_recorder: Failed to map a segment file");
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    // The file is zero-filled, so only the header needs to be written
+    provizio_packet_log_segment_header *header = (provizio_packet_log_segment_header *)segment;
+    memcpy(header->magic, PROVIZIO__PACKET_LOG_MAGIC, PROVIZIO__PACKET_LOG_MAGIC_SIZE);
+    header->version = PROVIZIO__PACKET_LOG_VERSION;
+    header->byte_order_mark = PROVIZIO__PACKET_LOG_BYTE_ORDER_MARK;
+    header->segment_index = segment_index;
+    header->index_offset = sizeof(provizio_packet_log_segment_header);
+    header->max_index_entries = recorder->max_index_entries;
+    header->records_offset = provizio_packet_recorder_records_offset(recorder->max_index_entries);
+    header->records_end_offset = header->records_offset;
+
+    recorder->segment_fd = (int32_t)fd;
+    recorder->segment = (uint8_t *)segment;
+    recorder->segment_index = segment_index;
+    memset(recorder->indexed, 0, sizeof(recorder->indexed));
+    ++recorder->num_segments;
+
+    return 0;
+}
+
+static int32_t provizio_packet_recorder_finish_segment(provizio_packet_recorder *recorder)
+{
+    const provizio_packet_log_segment_header *header = (const provizio_packet_log_segment_header *)recorder->segment;
+    const off_t actual_size = (off_t)header->records_end_offset;
+
+    int32_t status = 0;
+    if (munmap(recorder->segment, recorder->segment_size) != 0 || ftruncate(recorder->segment_fd, actual_size) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        status = errno != 0 ? errno : -1;
+        provizio_error("provizio_packet_recorder: Failed to finish a segment file");
+        // LCOV_EXCL_STOP
+    }
+
+    close(recorder->segment_fd);
+    recorder->segment_fd = -1;
+    recorder->segment = NULL;
+
+    return status;
+}
+
+int32_t provizio_packet_recorder_open(const char *path_prefix, size_t segment_size, uint32_t max_index_entries,
+                                      provizio_packet_recorder *out_recorder)
+{
+    memset(out_recorder, 0, sizeof(provizio_packet_recorder));
+    out_recorder->segment_fd = -1;
+
+    if (segment_size == 0)
+    {
+        segment_size = PROVIZIO__PACKET_RECORDER_DEFAULT_SEGMENT_SIZE;
+    }
+
+    if (max_index_entries == 0)
+    {
+        max_index_entries = PROVIZIO__PACKET_RECORDER_DEFAULT_MAX_INDEX_ENTRIES;
+    }
+
+    const size_t max_record_size = PROVIZIO__PACKET_RECORDER_ALIGN(sizeof(provizio_packet_log_record_header) +
+                                                                   PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES);
+    if (path_prefix == NULL || strlen(path_prefix) >= PROVIZIO__PACKET_RECORDER_MAX_PATH_PREFIX ||
+        segment_size < provizio_packet_recorder_records_offset(max_index_entries) + max_record_size)
+    {
+        provizio_error("provizio_packet_recorder_open: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    strncpy(out_recorder->path_prefix, path_prefix, PROVIZIO__PACKET_RECORDER_MAX_PATH_PREFIX - 1);
+    out_recorder->segment_size = segment_size;
+    out_recorder->max_index_entries = max_index_entries;
+
+    return provizio_packet_recorder_start_segment(out_recorder, 0);
+}
+
+// Adds an index entry if it's the first record of a radar's frame in the segment. Returns 0 if there is no space left.
+static uint8_t provizio_packet_recorder_index(provizio_packet_recorder *recorder, const void *packet,
+                                              size_t packet_size, uint64_t record_offset)
+{
+    const provizio_radar_point_cloud_packet_header *packet_header =
+        (const provizio_radar_point_cloud_packet_header *)packet;
+    if (packet_size < sizeof(provizio_radar_point_cloud_packet_header) ||
+        provizio_get_protocol_field_uint16_t(&packet_header->protocol_header.packet_type) !=
+            PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE)
+    {
+        return 1;
+    }
+
+    const uint16_t radar_position_id = provizio_get_protocol_field_uint16_t(&packet_header->radar_position_id);
+    const uint32_t frame_index = provizio_get_protocol_field_uint32_t(&packet_header->frame_index);
+    const size_t slot = radar_position_id % PROVIZIO__PACKET_RECORDER_NUM_INDEXED_RADARS;
+    if (recorder->indexed[slot] && recorder->indexed_radar_position_ids[slot] == radar_position_id &&
+        recorder->indexed_frame_indices[slot] == frame_index)
+    {
+        return 1;
+    }
+
+    provizio_packet_log_segment_header *header = (provizio_packet_log_segment_header *)recorder->segment;
+    if (header->num_index_entries == header->max_index_entries)
+    {
+        return 0;
+    }
+
+    provizio_packet_log_index_entry *entry =
+        &((provizio_packet_log_index_entry *)(recorder->segment + header->index_offset))[header->num_index_entries];
+    entry->radar_position_id = radar_position_id;
+    entry->frame_index = frame_index;
+    entry->record_offset = record_offset;
+    ++header->num_index_entries;
+
+    recorder->indexed[slot] = 1;
+    recorder->indexed_radar_position_ids[slot] = radar_position_id;
+    recorder->indexed_frame_indices[slot] = frame_index;
+
+    return 1;
+}
+
+int32_t provizio_packet_recorder_append(provizio_packet_recorder *recorder, const void *packet, size_t packet_size,
+                                        uint64_t receive_time_ns, uint32_t source_address, uint16_t source_port)
+{
+    if (recorder->segment == NULL)
+    {
+        provizio_error("provizio_packet_recorder_append: Not open");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (packet_size > PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES)
+    {
+        provizio_error("provizio_packet_recorder_append: Packet is too large");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (receive_time_ns == 0)
+    {
+        struct timeval now;
+        provizio_gettimeofday(&now);
+        receive_time_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_usec * 1000ULL;
+    }
+
+    const size_t record_size = PROVIZIO__PACKET_RECORDER_ALIGN(sizeof(provizio_packet_log_record_header) + packet_size);
+    provizio_packet_log_segment_header *header = (provizio_packet_log_segment_header *)recorder->segment;
+    if (header->records_end_offset + record_size > recorder->segment_size ||
+        !provizio_packet_recorder_index(recorder, packet, packet_size, header->records_end_offset))
+    {
+        // The segment is full, so it's the first record of a new one (which always fits it)
+        int32_t status = provizio_packet_recorder_finish_segment(recorder);
+        if (status == 0)
+        {
+            status = provizio_packet_recorder_start_segment(recorder, recorder->segment_index + 1);
+        }
+
+        if (status != 0)
+        {
+            // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+            return status;
+            // LCOV_EXCL_STOP
+        }
+
+        header = (provizio_packet_log_segment_header *)recorder->segment;
+        provizio_packet_recorder_index(recorder, packet, packet_size, header->records_end_offset);
+    }
+
+    provizio_packet_log_record_header *record =
+        (provizio_packet_log_record_header *)(recorder->segment + header->records_end_offset);
+    record->record_size = (uint32_t)record_size;
+    record->payload_size = (uint32_t)packet_size;
+    record->receive_time_ns = receive_time_ns;
+    record->source_address = source_address;
+    record->source_port = source_port;
+    memcpy(record + 1, packet, packet_size);
+
+    // Counters are only updated once the record is complete
+    header->records_end_offset += record_size;
+    ++header->num_records;
+    ++recorder->num_records;
+
+    return 0;
+}
+
+int32_t provizio_packet_recorder_close(provizio_packet_recorder *recorder)
+{
+    if (recorder->segment == NULL)
+    {
+        provizio_error("provizio_packet_recorder_close: Not open");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    return provizio_packet_recorder_finish_segment(recorder);
+}
+
+#else // _WIN32
+
+// LCOV_EXCL_START: Coverage is collected in Linux only
+int32_t provizio_packet_recorder_open(const char *path_prefix, size_t segment_size, uint32_t max_index_entries,
+                                      provizio_packet_recorder *out_recorder)
+{
+    (void)path_prefix;
+    (void)segment_size;
+    (void)max_index_entries;
+    memset(out_recorder, 0, sizeof(provizio_packet_recorder));
+    out_recorder->segment_fd = -1;
+
+    provizio_error("provizio_packet_recorder_open: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+
+int32_t provizio_packet_recorder_append(provizio_packet_recorder *recorder, const void *packet, size_t packet_size,
+                                        uint64_t receive_time_ns, uint32_t source_address, uint16_t source_port)
+{
+    (void)recorder;
+    (void)packet;
+    (void)packet_size;
+    (void)receive_time_ns;
+    (void)source_address;
+    (void)source_port;
+
+    provizio_error("provizio_packet_recorder_append: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+
+int32_t provizio_packet_recorder_close(provizio_packet_recorder *recorder)
+{
+    (void)recorder;
+
+    provizio_error("provizio_packet_recorder_close: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+// LCOV_EXCL_STOP
+
+#endif // _WIN32
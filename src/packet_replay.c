@@ -0,0 +1,399 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/radar_api/packet_replay.h"
+
+#include <string.h>
+
+#include "provizio/radar_api/packet_recorder.h"
+#include "provizio/util.h"
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#ifndef _WIN32
+
+// Callback and user_data of a context, substituted while replaying to count the frames it returns
+typedef struct provizio_packet_replay_context_callback
+{
+    provizio_radar_point_cloud_callback callback;
+    provizio_pooled_radar_point_cloud_callback pooled_callback;
+    void *user_data;
+} provizio_packet_replay_context_callback;
+
+typedef struct provizio_packet_replay
+{
+    float speed;
+    provizio_radar_point_cloud_api_context *contexts;
+    provizio_pooled_radar_point_cloud_api_context *pooled_contexts;
+    size_t num_contexts;
+
+    uint64_t start_time_ns;         // provizio_monotonic_time_ns the replay started at
+    uint64_t first_receive_time_ns; // Receive time of the first packet replayed
+
+    provizio_packet_replay_context_callback callbacks[PROVIZIO__PACKET_REPLAY_MAX_CONTEXTS]; // Of every context
+
+    provizio_packet_replay_stats stats;
+} provizio_packet_replay;
+
+static void provizio_packet_replay_callback(const provizio_radar_point_cloud *point_cloud,
+                                            provizio_radar_point_cloud_api_context *context)
+{
+    provizio_packet_replay *replay = (provizio_packet_replay *)context->user_data;
+    const provizio_packet_replay_context_callback *callback = &replay->callbacks[context - replay->contexts];
+    ++replay->stats.num_frames;
+
+    // The callback expects its own user_data in the context
+    context->user_data = callback->user_data;
+    if (callback->callback != NULL)
+    {
+        callback->callback(point_cloud, context);
+    }
+    context->user_data = replay;
+}
+
+static void provizio_packet_replay_pooled_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                                                   provizio_pooled_radar_point_cloud_api_context *context)
+{
+    provizio_packet_replay *replay = (provizio_packet_replay *)context->user_data;
+    const provizio_packet_replay_context_callback *callback = &replay->callbacks[context - replay->pooled_contexts];
+    ++replay->stats.num_frames;
+
+    // The callback expects its own user_data in the context
+    context->user_data = callback->user_data;
+    if (callback->pooled_callback != NULL)
+    {
+        callback->pooled_callback(point_cloud, context);
+    }
+    context->user_data = replay;
+}
+
+// Substitutes (if substitute is not 0) or restores callbacks of all contexts
+static void provizio_packet_replay_substitute_callbacks(provizio_packet_replay *replay, uint8_t substitute)
+{
+    for (size_t i = 0; i < replay->num_contexts; ++i)
+    {
+        provizio_packet_replay_context_callback *callback = &replay->callbacks[i];
+        if (replay->contexts != NULL)
+        {
+            provizio_radar_point_cloud_api_context *context = &replay->contexts[i];
+            if (substitute)
+            {
+                callback->callback = context->callback;
+                callback->user_data = context->user_data;
+                context->callback = &provizio_packet_replay_callback;
+                context->user_data = replay;
+            }
+            else
+            {
+                context->callback = callback->callback;
+                context->user_data = callback->user_data;
+            }
+        }
+        else
+        {
+            provizio_pooled_radar_point_cloud_api_context *context = &replay->pooled_contexts[i];
+            if (substitute)
+            {
+                callback->pooled_callback = context->callback;
+                callback->user_data = context->user_data;
+                context->callback = &provizio_packet_replay_pooled_callback;
+                context->user_data = replay;
+            }
+            else
+            {
+                context->callback = callback->pooled_callback;
+                context->user_data = callback->user_data;
+            }
+        }
+    }
+}
+
+// Sleeps until it's time to replay a packet received at receive_time_ns, unless replaying as fast as possible
+static void provizio_packet_replay_pace(provizio_packet_replay *replay, uint64_t receive_time_ns)
+{
+    if (replay->speed <= 0.0F)
+    {
+        return;
+    }
+
+    if (replay->stats.num_packets == 0)
+    {
+        replay->first_receive_time_ns = receive_time_ns;
+        return;
+    }
+
+    if (receive_time_ns <= replay->first_receive_time_ns)
+    {
+        return;
+    }
+
+    const uint64_t target_time_ns =
+        replay->start_time_ns +
+        (uint64_t)((double)(receive_time_ns - replay->first_receive_time_ns) / (double)replay->speed);
+    const uint64_t now_ns = provizio_monotonic_time_ns();
+    if (target_time_ns > now_ns)
+    {
+        provizio_sleep_ns(target_time_ns - now_ns);
+    }
+}
+
+static int32_t provizio_packet_replay_segment(provizio_packet_replay *replay, const uint8_t *segment,
+                                              size_t segment_size)
+{
+    const provizio_packet_log_segment_header *header = (const provizio_packet_log_segment_header *)segment;
+    if (segment_size < sizeof(provizio_packet_log_segment_header) ||
+        memcmp(header->magic, PROVIZIO__PACKET_LOG_MAGIC, PROVIZIO__PACKET_LOG_MAGIC_SIZE) != 0 ||
+        header->version != PROVIZIO__PACKET_LOG_VERSION ||
+        header->byte_order_mark != PROVIZIO__PACKET_LOG_BYTE_ORDER_MARK ||
+        header->records_offset > header->records_end_offset || header->records_end_offset > segment_size)
+    {
+        provizio_error("provizio_replay_packet_log: Malformed segment");
+        return PROVIZIO_E_PROTOCOL;
+    }
+
+    uint64_t offset = header->records_offset;
+    for (uint64_t i = 0; i < header->num_records; ++i)
+    {
+        const provizio_packet_log_record_header *record =
+            (const provizio_packet_log_record_header *)(segment + offset);
+        if (offset + sizeof(provizio_packet_log_record_header) > header->records_end_offset ||
+            record->payload_size > PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES ||
+            record->record_size < sizeof(provizio_packet_log_record_header) + record->payload_size ||
+            offset + record->record_size > header->records_end_offset)
+        {
+            provizio_error("provizio_replay_packet_log: Malformed segment");
+            return PROVIZIO_E_PROTOCOL;
+        }
+
+        const void *packet = record + 1;
+        provizio_packet_replay_pace(replay, record->receive_time_ns);
+
+        const int32_t status_code =
+            replay->contexts != NULL
+                ? provizio_handle_possible_radars_point_cloud_packet_received_at(
+                      replay->contexts, replay->num_contexts, packet, record->payload_size, record->receive_time_ns)
+                : provizio_handle_possible_pooled_radars_point_cloud_packet_received_at(
+                      replay->pooled_contexts, replay->num_contexts, packet, record->payload_size,
+                      record->receive_time_ns);
+        if (status_code != 0 && status_code != PROVIZIO_E_SKIPPED)
+        {
+            ++replay->stats.num_failed_packets;
+        }
+
+        ++replay->stats.num_packets;
+        offset += record->record_size;
+    }
+
+    ++replay->stats.num_segments;
+    return 0;
+}
+
+// Maps a segment to memory and replays it. Returns PROVIZIO_E_SKIPPED if it doesn't exist.
+static int32_t provizio_packet_replay_segment_file(provizio_packet_replay *replay, const char *path)
+{
+    const int fd = open(path, O_RDONLY); // NOLINT: open is variadic
+    if (fd < 0)
+    {
+        if (errno == ENOENT)
+        {
+            return PROVIZIO_E_SKIPPED;
+        }
+
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        provizio_error("provizio_replay_packet_log: Failed to open a segment");
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        close(fd);
+        provizio_error("provizio_replay_packet_log: Failed to map a segment");
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    const size_t segment_size = (size_t)file_stat.st_size;
+    if (segment_size < sizeof(provizio_packet_log_segment_header))
+    {
+        close(fd);
+        provizio_error("provizio_replay_packet_log: Malformed segment");
+        return PROVIZIO_E_PROTOCOL;
+    }
+
+    void *segment = mmap(NULL, segment_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping remains valid
+    if (segment == MAP_FAILED)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        provizio_error("provizio_replay_packet_log: Failed to map a segment");
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+#ifdef MADV_SEQUENTIAL
+    // Records are read once, in order, so the kernel can read ahead aggressively and drop the pages already replayed
+    (void)madvise(segment, segment_size, MADV_SEQUENTIAL);
+#endif // MADV_SEQUENTIAL
+
+    const int32_t status_code = provizio_packet_replay_segment(replay, (const uint8_t *)segment, segment_size);
+    munmap(segment, segment_size);
+
+    return status_code;
+}
+
+static int32_t provizio_replay_packet_log_impl(const char *path_prefix, provizio_packet_replay *replay,
+                                               provizio_packet_replay_stats *out_stats)
+{
+    if (out_stats != NULL)
+    {
+        memset(out_stats, 0, sizeof(provizio_packet_replay_stats));
+    }
+
+    if (path_prefix == NULL || replay->num_contexts == 0 || replay->speed < 0.0F)
+    {
+        provizio_error("provizio_replay_packet_log: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (replay->num_contexts > PROVIZIO__PACKET_REPLAY_MAX_CONTEXTS)
+    {
+        provizio_error("provizio_replay_packet_log: Too many contexts");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    char path[PROVIZIO__PACKET_RECORDER_MAX_PATH_PREFIX + 32];
+    provizio_packet_replay_substitute_callbacks(replay, 1);
+    replay->start_time_ns = provizio_monotonic_time_ns();
+
+    int32_t status_code = 0;
+    for (uint64_t segment_index = 0;; ++segment_index)
+    {
+        status_code = provizio_packet_log_segment_path(path_prefix, segment_index, path, sizeof(path));
+        if (status_code == 0)
+        {
+            status_code = provizio_packet_replay_segment_file(replay, path);
+        }
+
+        if (status_code == PROVIZIO_E_SKIPPED)
+        {
+            // No more segments
+            status_code = 0;
+            if (segment_index == 0)
+            {
+                provizio_error("provizio_replay_packet_log: Failed to open the packet log");
+                status_code = PROVIZIO_E_ARGUMENT;
+            }
+            break;
+        }
+
+        if (status_code != 0)
+        {
+            break;
+        }
+    }
+
+    replay->stats.duration_ns = provizio_monotonic_time_ns() - replay->start_time_ns;
+    provizio_packet_replay_substitute_callbacks(replay, 0);
+    if (replay->stats.duration_ns > 0)
+    {
+        const double seconds = (double)replay->stats.duration_ns / 1e9;
+        replay->stats.packets_per_second = (float)((double)replay->stats.num_packets / seconds);
+        replay->stats.frames_per_second = (float)((double)replay->stats.num_frames / seconds);
+    }
+
+    if (out_stats != NULL)
+    {
+        *out_stats = replay->stats;
+    }
+
+    return status_code;
+}
+
+int32_t provizio_replay_packet_log(const char *path_prefix, float speed,
+                                   provizio_radar_point_cloud_api_context *contexts, size_t num_contexts,
+                                   provizio_packet_replay_stats *out_stats)
+{
+    provizio_packet_replay replay;
+    memset(&replay, 0, sizeof(replay));
+    replay.speed = speed;
+    replay.contexts = contexts;
+    replay.num_contexts = contexts != NULL ? num_contexts : 0;
+
+    return provizio_replay_packet_log_impl(path_prefix, &replay, out_stats);
+}
+
+int32_t provizio_replay_packet_log_pooled(const char *path_prefix, float speed,
+                                          provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts,
+                                          provizio_packet_replay_stats *out_stats)
+{
+    provizio_packet_replay replay;
+    memset(&replay, 0, sizeof(replay));
+    replay.speed = speed;
+    replay.pooled_contexts = contexts;
+    replay.num_contexts = contexts != NULL ? num_contexts : 0;
+
+    return provizio_replay_packet_log_impl(path_prefix, &replay, out_stats);
+}
+
+#else // _WIN32
+
+// LCOV_EXCL_START: Coverage is collected in Linux only
+int32_t provizio_replay_packet_log(const char *path_prefix, float speed,
+                                   provizio_radar_point_cloud_api_context *contexts, size_t num_contexts,
+                                   provizio_packet_replay_stats *out_stats)
+{
+    (void)path_prefix;
+    (void)speed;
+    (void)contexts;
+    (void)num_contexts;
+    if (out_stats != NULL)
+    {
+        memset(out_stats, 0, sizeof(provizio_packet_replay_stats));
+    }
+
+    provizio_error("provizio_replay_packet_log: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+
+int32_t provizio_replay_packet_log_pooled(const char *path_prefix, float speed,
+                                          provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts,
+                                          provizio_packet_replay_stats *out_stats)
+{
+    (void)path_prefix;
+    (void)speed;
+    (void)contexts;
+    (void)num_contexts;
+    if (out_stats != NULL)
+    {
+        memset(out_stats, 0, sizeof(provizio_packet_replay_stats));
+    }
+
+    provizio_error("provizio_replay_packet_log_pooled: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+// LCOV_EXCL_STOP
+
+#endif // _WIN32
@@ -0,0 +1,1071 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/radar_api/pooled_radar_point_cloud.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "provizio/atomic.h"
+#include "provizio/radar_api/errno.h"
+#include "provizio/util.h"
+
+// Chunk index of packets of unknown position, i.e. not from provizio_handle_pooled_radar_point_cloud_packet_chunk
+#define PROVIZIO__POOLED_RADAR_POINT_CLOUD_CHUNK_UNKNOWN UINT32_MAX
+
+static provizio_pooled_radar_point_cloud_slot *provizio_get_pooled_slots(
+    provizio_pooled_radar_point_cloud_api_context *context)
+{
+    return context->impl.window != NULL ? context->impl.window : context->impl.slots_being_received;
+}
+
+static size_t provizio_get_pooled_num_slots(const provizio_pooled_radar_point_cloud_api_context *context)
+{
+    return context->impl.window != NULL
+               ? (size_t)context->impl.window_size
+               : (size_t)PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT;
+}
+
+static provizio_pooled_radar_point_cloud_storage *provizio_get_pooled_point_cloud_storage(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_pooled_radar_point_cloud *point_cloud)
+{
+    (void)context;
+
+    // point_cloud is the first member of its provizio_pooled_radar_point_cloud_slot
+    return &((provizio_pooled_radar_point_cloud_slot *)point_cloud)->storage;
+}
+
+static void provizio_release_pooled_point_cloud(provizio_pooled_radar_point_cloud_api_context *context,
+                                                provizio_pooled_radar_point_cloud *point_cloud)
+{
+    provizio_pooled_radar_point_cloud_storage *storage = provizio_get_pooled_point_cloud_storage(context, point_cloud);
+    if (context->packet_pool != NULL)
+    {
+        uint32_t buffer_index = storage->first_packet_buffer;
+        for (uint32_t i = 0; i < storage->num_packet_buffers; ++i)
+        {
+            provizio_radar_packet_buffer *buffer = &context->packet_pool->buffers[buffer_index];
+            buffer_index = buffer->next;
+            provizio_radar_packet_pool_release(context->packet_pool, buffer);
+        }
+    }
+    else
+    {
+        provizio_memory_pool_release(context->pool, storage->memory);
+    }
+
+    memset(storage, 0, sizeof(provizio_pooled_radar_point_cloud_storage));
+    memset(point_cloud, 0, sizeof(provizio_pooled_radar_point_cloud));
+}
+
+static void provizio_return_pooled_point_cloud(provizio_pooled_radar_point_cloud_api_context *context,
+                                               provizio_pooled_radar_point_cloud *point_cloud);
+
+static void provizio_return_older_pooled_point_clouds(provizio_pooled_radar_point_cloud_api_context *context,
+                                                      provizio_pooled_radar_point_cloud *point_cloud,
+                                                      uint32_t frame_index)
+{
+    provizio_pooled_radar_point_cloud_slot *slots = provizio_get_pooled_slots(context);
+    const size_t num_slots = provizio_get_pooled_num_slots(context);
+    for (size_t i = 0; i < num_slots; ++i)
+    {
+        provizio_pooled_radar_point_cloud *other_point_cloud = &slots[i].point_cloud;
+        if (other_point_cloud != point_cloud && other_point_cloud->num_points_expected > 0 &&
+            other_point_cloud->frame_index < frame_index)
+        {
+            provizio_return_pooled_point_cloud(context, other_point_cloud);
+        }
+    }
+}
+
+static void provizio_return_pooled_point_cloud(provizio_pooled_radar_point_cloud_api_context *context,
+                                               provizio_pooled_radar_point_cloud *point_cloud)
+{
+    // First of all, make sure all older but incomplete point clouds have been already returned
+    provizio_return_older_pooled_point_clouds(context, point_cloud, point_cloud->frame_index);
+
+    if (context->packet_pool != NULL)
+    {
+        // Zero-copy mode: describe the points kept in the packets
+        const provizio_pooled_radar_point_cloud_storage *storage =
+            provizio_get_pooled_point_cloud_storage(context, point_cloud);
+        provizio_radar_point_span *spans = context->packet_pool->spans;
+        uint32_t buffer_index = storage->first_packet_buffer;
+        for (uint32_t i = 0; i < storage->num_packet_buffers; ++i)
+        {
+            provizio_radar_packet_buffer *buffer = &context->packet_pool->buffers[buffer_index];
+            const provizio_radar_point_cloud_packet *packet =
+                (const provizio_radar_point_cloud_packet *)buffer->payload;
+            spans[i].radar_points = packet->radar_points;
+            spans[i].num_points = provizio_get_protocol_field_uint16_t(&packet->header.num_points_in_packet);
+            buffer_index = buffer->next;
+        }
+
+        point_cloud->spans = spans;
+        point_cloud->num_spans = storage->num_packet_buffers;
+    }
+    else if (context->impl.ordered_reassembly)
+    {
+        point_cloud->received_chunks = provizio_get_pooled_point_cloud_storage(context, point_cloud)->received_chunks;
+    }
+
+    provizio_pooled_radar_point_cloud_stats *stats = context->impl.stats;
+    if (stats != NULL)
+    {
+        const uint64_t callback_start_time_ns = provizio_radar_point_cloud_stats_account_frame_returned(
+            stats, point_cloud->num_points_expected, point_cloud->num_points_received,
+            provizio_get_pooled_point_cloud_storage(context, point_cloud)->first_packet_time_ns);
+        context->callback(point_cloud, context);
+        provizio_radar_point_cloud_stats_account_callback(stats, callback_start_time_ns);
+    }
+    else
+    {
+        context->callback(point_cloud, context);
+    }
+
+    provizio_release_pooled_point_cloud(context, point_cloud);
+}
+
+static void provizio_return_complete_pooled_point_clouds(provizio_pooled_radar_point_cloud_api_context *context)
+{
+    // Complete point clouds are kept in a reassembly window until all older ones have been returned
+    provizio_pooled_radar_point_cloud_slot *slots = provizio_get_pooled_slots(context);
+    const size_t num_slots = provizio_get_pooled_num_slots(context);
+    for (;;)
+    {
+        provizio_pooled_radar_point_cloud *oldest = NULL;
+        for (size_t i = 0; i < num_slots; ++i)
+        {
+            provizio_pooled_radar_point_cloud *point_cloud = &slots[i].point_cloud;
+            if (point_cloud->num_points_expected > 0 && (!oldest || point_cloud->frame_index < oldest->frame_index))
+            {
+                oldest = point_cloud;
+            }
+        }
+
+        if (!oldest || oldest->num_points_received != oldest->num_points_expected)
+        {
+            return;
+        }
+
+        provizio_return_pooled_point_cloud(context, oldest);
+    }
+}
+
+static void provizio_return_pooled_point_clouds_out_of_window(provizio_pooled_radar_point_cloud_api_context *context)
+{
+    provizio_pooled_radar_point_cloud_slot *slots = context->impl.window;
+    const uint32_t window_size = context->impl.window_size;
+    for (uint32_t i = 0; i < window_size; ++i)
+    {
+        provizio_pooled_radar_point_cloud *point_cloud = &slots[i].point_cloud;
+        // Use uint64_t to avoid overflowing uint32_t
+        if (point_cloud->num_points_expected > 0 &&
+            (uint64_t)point_cloud->frame_index + window_size <= (uint64_t)context->impl.latest_frame)
+        {
+            // Won't be complete anymore, return the point cloud as is (older ones are returned first)
+            provizio_return_pooled_point_cloud(context, point_cloud);
+        }
+    }
+
+    // Out of window point clouds may have held newer complete ones
+    provizio_return_complete_pooled_point_clouds(context);
+}
+
+static size_t provizio_pooled_points_size(provizio_pooled_radar_point_cloud_layout layout, uint16_t num_points)
+{
+    return layout == provizio_pooled_radar_point_cloud_layout_soa ? provizio_radar_points_soa_required_size(num_points)
+                                                                   : sizeof(provizio_radar_point) * num_points;
+}
+
+static void *provizio_allocate_pooled_points(provizio_pooled_radar_point_cloud_api_context *context,
+                                             provizio_pooled_radar_point_cloud *point_cloud, uint32_t frame_index,
+                                             size_t size)
+{
+    void *memory = provizio_memory_pool_allocate(context->pool, size);
+    if (memory == NULL)
+    {
+        // Let's free up some memory by returning older incomplete point clouds of the same radar (if any), as they
+        // would be returned soon anyway
+        provizio_return_older_pooled_point_clouds(context, point_cloud, frame_index);
+
+        memory = provizio_memory_pool_allocate(context->pool, size);
+    }
+
+    return memory;
+}
+
+static provizio_radar_packet_buffer *provizio_get_pooled_packet_buffer(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_pooled_radar_point_cloud *point_cloud,
+    provizio_radar_point_cloud_packet *packet)
+{
+    provizio_radar_packet_buffer *buffer = provizio_radar_packet_pool_find(context->packet_pool, packet);
+    if (buffer != NULL)
+    {
+        // Received directly to the packet pool, nothing to copy
+        return buffer;
+    }
+
+    buffer = provizio_radar_packet_pool_acquire(context->packet_pool);
+    if (buffer == NULL)
+    {
+        // Same as in provizio_allocate_pooled_points
+        provizio_return_older_pooled_point_clouds(context, point_cloud, point_cloud->frame_index);
+
+        buffer = provizio_radar_packet_pool_acquire(context->packet_pool);
+        if (buffer == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    memcpy(buffer->payload, packet, provizio_radar_point_cloud_packet_size(&packet->header));
+    return buffer;
+}
+
+static int32_t provizio_get_pooled_point_cloud_being_received(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_radar_point_cloud_packet_header *packet_header,
+    provizio_pooled_radar_point_cloud **out_point_cloud)
+{
+    const uint32_t small_frame_index_cap = 0x0000ffff;
+    const uint32_t large_frame_index_threashold = 0xffff0000;
+
+    provizio_pooled_radar_point_cloud *point_cloud = NULL;
+    provizio_pooled_radar_point_cloud_slot *slots = provizio_get_pooled_slots(context);
+    *out_point_cloud = NULL;
+
+    const uint16_t radar_position_id = provizio_get_protocol_field_uint16_t(&packet_header->radar_position_id);
+    const uint32_t frame_index = provizio_get_protocol_field_uint32_t(&packet_header->frame_index);
+    const uint16_t total_points_in_frame = provizio_get_protocol_field_uint16_t(&packet_header->total_points_in_frame);
+    const uint16_t radar_range = provizio_get_protocol_field_uint16_t(&packet_header->radar_range);
+
+    if (frame_index < small_frame_index_cap && context->impl.latest_frame > large_frame_index_threashold)
+    {
+        // A very special case: frame indices seem to have exceeded the 0xffffffff and have been reset. Let's reset the
+        // state of the API to avoid complicated state-related issues.
+        provizio_warning(
+            "provizio_get_pooled_point_cloud_being_received: frame indices overflow detected - resetting API state");
+        provizio_pooled_radar_point_cloud_api_context_release(context);
+        if (context->impl.stats != NULL)
+        {
+            PROVIZIO__ATOMIC_ADD_UINT64(&context->impl.stats->num_frame_index_resets, 1);
+        }
+    }
+
+    if (context->radar_position_id == provizio_radar_position_unknown)
+    {
+        provizio_pooled_radar_point_cloud_api_context_assign(context, radar_position_id);
+    }
+    else if (context->radar_position_id != radar_position_id)
+    {
+        return PROVIZIO_E_SKIPPED;
+    }
+
+    if (context->impl.stats != NULL)
+    {
+        provizio_radar_point_cloud_stats_account_frame(context->impl.stats, &context->impl.loss_tracker,
+                                                       context->impl.latest_frame, frame_index);
+    }
+
+    if (context->impl.latest_frame < frame_index)
+    {
+        context->impl.latest_frame = frame_index;
+
+        if (context->impl.window != NULL)
+        {
+            provizio_return_pooled_point_clouds_out_of_window(context);
+        }
+    }
+
+    if (context->impl.window != NULL)
+    {
+        // Use uint64_t to avoid overflowing uint32_t
+        if ((uint64_t)frame_index + context->impl.window_size <= (uint64_t)context->impl.latest_frame)
+        {
+            // Out of the reassembly window, i.e. obsolete
+            return PROVIZIO_E_SKIPPED;
+        }
+
+        // Constant time lookup: all frames in the window map to different slots and the ones out of the window have
+        // been returned already
+        point_cloud = &slots[frame_index % context->impl.window_size].point_cloud;
+        assert(point_cloud->num_points_expected == 0 || point_cloud->frame_index == frame_index);
+    }
+    else
+    {
+        // Look for a point cloud already being received
+#pragma unroll
+        for (size_t i = 0; i < PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT; ++i)
+        {
+            point_cloud = &slots[i].point_cloud;
+            if (point_cloud->frame_index == frame_index && point_cloud->num_points_expected > 0)
+            {
+                break;
+            }
+            point_cloud = NULL;
+        }
+    }
+
+    if (point_cloud != NULL && point_cloud->num_points_expected > 0)
+    {
+        if (point_cloud->num_points_expected != total_points_in_frame)
+        {
+            provizio_warning("provizio_get_pooled_point_cloud_being_received: num_points_expected mismatch "
+                             "across different packets of the same frame");
+        }
+
+        if (point_cloud->radar_range != radar_range)
+        {
+            provizio_warning("provizio_get_pooled_point_cloud_being_received: radar_range mismatch across "
+                             "different packets of the same frame");
+        }
+
+        *out_point_cloud = point_cloud;
+        return 0;
+    }
+
+    // In the window mode, it's an empty slot to be used
+    provizio_pooled_radar_point_cloud *result = point_cloud;
+
+    // Look for an empty point cloud to be used
+#pragma unroll
+    for (size_t i = 0; i < PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT && !result;
+         ++i)
+    {
+        point_cloud = &slots[i].point_cloud;
+        if (point_cloud->num_points_expected == 0)
+        {
+            result = point_cloud;
+        }
+    }
+
+    // We have to drop (well, return incomplete) the oldest incomplete point cloud unless it's newer than packet_header
+    if (!result)
+    {
+#pragma unroll
+        for (size_t i = 0; i < PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT; ++i)
+        {
+            point_cloud = &slots[i].point_cloud;
+            if (point_cloud->frame_index < frame_index && (!result || point_cloud->frame_index < result->frame_index))
+            {
+                result = point_cloud;
+            }
+        }
+
+        if (!result)
+        {
+            // Obsolete
+            return PROVIZIO_E_SKIPPED;
+        }
+
+        // Return the obsolete incomplete point cloud
+        provizio_return_pooled_point_cloud(context, result);
+    }
+
+    if (context->packet_pool == NULL)
+    {
+        const size_t size = provizio_pooled_points_size(context->layout, total_points_in_frame);
+        void *memory = provizio_allocate_pooled_points(context, result, frame_index, size);
+        if (memory == NULL)
+        {
+            provizio_error("provizio_get_pooled_point_cloud_being_received: Out of pool memory");
+            return PROVIZIO_E_OUT_OF_MEMORY;
+        }
+
+        provizio_get_pooled_point_cloud_storage(context, result)->memory = memory;
+        if (context->layout == provizio_pooled_radar_point_cloud_layout_soa)
+        {
+            const int32_t status_code =
+                provizio_radar_points_soa_init(memory, size, total_points_in_frame, &result->radar_points_soa);
+            assert(status_code == 0); // The memory has been allocated for exactly this capacity
+            (void)status_code;
+        }
+        else
+        {
+            result->radar_points = (provizio_radar_point *)memory;
+        }
+    }
+
+    if (context->impl.completion_deadline_ns != 0 || context->impl.stats != NULL)
+    {
+        provizio_get_pooled_point_cloud_storage(context, result)->first_packet_time_ns = provizio_monotonic_time_ns();
+    }
+
+    // Initialize the point cloud
+    result->frame_index = frame_index;
+    result->timestamp = provizio_get_protocol_field_uint64_t(&packet_header->timestamp);
+    result->radar_position_id = radar_position_id;
+    result->num_points_expected = total_points_in_frame;
+    result->radar_range = radar_range;
+    assert(result->num_points_received == 0);
+
+    *out_point_cloud = result;
+    return 0;
+}
+
+size_t provizio_pooled_radar_point_cloud_pool_size(uint16_t max_points_per_frame, size_t num_radars)
+{
+    return provizio_pooled_radar_point_cloud_window_pool_size(
+        max_points_per_frame, num_radars,
+        PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT);
+}
+
+size_t provizio_pooled_radar_point_cloud_window_pool_size(uint16_t max_points_per_frame, size_t num_radars,
+                                                          size_t window_size)
+{
+    // The SoA layout requires slightly more memory due to columns alignment, so it's used for both
+    return provizio_memory_pool_required_size(
+        provizio_pooled_points_size(provizio_pooled_radar_point_cloud_layout_soa, max_points_per_frame),
+        num_radars * window_size);
+}
+
+void provizio_pooled_radar_point_cloud_api_context_init(provizio_pooled_radar_point_cloud_callback callback,
+                                                        void *user_data, provizio_memory_pool *pool,
+                                                        provizio_pooled_radar_point_cloud_api_context *context)
+{
+    memset(context, 0, sizeof(provizio_pooled_radar_point_cloud_api_context));
+
+    context->callback = callback;
+    context->user_data = user_data;
+    context->radar_position_id = provizio_radar_position_unknown;
+    context->pool = pool;
+}
+
+void provizio_pooled_radar_point_cloud_api_contexts_init(provizio_pooled_radar_point_cloud_callback callback,
+                                                         void *user_data, provizio_memory_pool *pool,
+                                                         provizio_pooled_radar_point_cloud_api_context *contexts,
+                                                         size_t num_contexts)
+{
+#pragma unroll(5)
+    for (size_t i = 0; i < num_contexts; ++i)
+    {
+        provizio_pooled_radar_point_cloud_api_context_init(callback, user_data, pool, &contexts[i]);
+    }
+}
+
+void provizio_pooled_radar_point_cloud_api_context_init_soa(provizio_pooled_radar_point_cloud_callback callback,
+                                                            void *user_data, provizio_memory_pool *pool,
+                                                            provizio_pooled_radar_point_cloud_api_context *context)
+{
+    provizio_pooled_radar_point_cloud_api_context_init(callback, user_data, pool, context);
+    context->layout = provizio_pooled_radar_point_cloud_layout_soa;
+}
+
+void provizio_pooled_radar_point_cloud_api_contexts_init_soa(provizio_pooled_radar_point_cloud_callback callback,
+                                                             void *user_data, provizio_memory_pool *pool,
+                                                             provizio_pooled_radar_point_cloud_api_context *contexts,
+                                                             size_t num_contexts)
+{
+#pragma unroll(5)
+    for (size_t i = 0; i < num_contexts; ++i)
+    {
+        provizio_pooled_radar_point_cloud_api_context_init_soa(callback, user_data, pool, &contexts[i]);
+    }
+}
+
+void provizio_pooled_radar_point_cloud_api_context_init_zero_copy(
+    provizio_pooled_radar_point_cloud_callback callback, void *user_data, provizio_radar_packet_pool *packet_pool,
+    provizio_pooled_radar_point_cloud_api_context *context)
+{
+    provizio_pooled_radar_point_cloud_api_context_init(callback, user_data, NULL, context);
+    context->packet_pool = packet_pool;
+}
+
+void provizio_pooled_radar_point_cloud_api_contexts_init_zero_copy(
+    provizio_pooled_radar_point_cloud_callback callback, void *user_data, provizio_radar_packet_pool *packet_pool,
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts)
+{
+#pragma unroll(5)
+    for (size_t i = 0; i < num_contexts; ++i)
+    {
+        provizio_pooled_radar_point_cloud_api_context_init_zero_copy(callback, user_data, packet_pool, &contexts[i]);
+    }
+}
+
+int32_t provizio_pooled_radar_point_cloud_api_context_assign(provizio_pooled_radar_point_cloud_api_context *context,
+                                                             provizio_radar_position radar_position_id)
+{
+    if (radar_position_id == provizio_radar_position_unknown)
+    {
+        provizio_error("provizio_pooled_radar_point_cloud_api_context_assign: can't assign to "
+                       "provizio_radar_position_unknown");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (context->radar_position_id == radar_position_id)
+    {
+        return 0;
+    }
+
+    if (context->radar_position_id == provizio_radar_position_unknown)
+    {
+        context->radar_position_id = radar_position_id;
+        return 0;
+    }
+
+    provizio_error("provizio_pooled_radar_point_cloud_api_context_assign: already assigned");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+
+int32_t provizio_pooled_radar_point_cloud_api_contexts_set_dispatch_table(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts,
+    provizio_radar_api_contexts_dispatch_table *dispatch_table)
+{
+    if (num_contexts == 0 || num_contexts > UINT16_MAX)
+    {
+        provizio_error(
+            "provizio_pooled_radar_point_cloud_api_contexts_set_dispatch_table: Invalid number of contexts");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (dispatch_table != NULL)
+    {
+        // Filled lazily, as radars are first seen
+        memset(dispatch_table, 0, sizeof(provizio_radar_api_contexts_dispatch_table));
+    }
+    contexts[0].dispatch_table = dispatch_table;
+
+    return 0;
+}
+
+int32_t provizio_pooled_radar_point_cloud_api_context_set_window(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_pooled_radar_point_cloud_slot *slots,
+    size_t window_size)
+{
+    if (context == NULL || slots == NULL || window_size == 0 || window_size > UINT16_MAX)
+    {
+        provizio_error("provizio_pooled_radar_point_cloud_api_context_set_window: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    provizio_pooled_radar_point_cloud_api_context_release(context);
+
+    memset(slots, 0, sizeof(provizio_pooled_radar_point_cloud_slot) * window_size);
+    context->impl.window = slots;
+    context->impl.window_size = (uint32_t)window_size;
+
+    return 0;
+}
+
+void provizio_pooled_radar_point_cloud_api_context_set_completion_deadline(
+    provizio_pooled_radar_point_cloud_api_context *context, uint64_t deadline_ns)
+{
+    context->impl.completion_deadline_ns = deadline_ns;
+}
+
+size_t provizio_pooled_radar_point_cloud_api_context_tick(provizio_pooled_radar_point_cloud_api_context *context)
+{
+    const uint64_t deadline_ns = context->impl.completion_deadline_ns;
+    if (deadline_ns == 0)
+    {
+        return 0;
+    }
+
+    const uint64_t now_ns = provizio_monotonic_time_ns();
+    provizio_pooled_radar_point_cloud_slot *slots = provizio_get_pooled_slots(context);
+    const size_t num_slots = provizio_get_pooled_num_slots(context);
+
+    // The newest expired point cloud is returned along with all older ones, to keep the order of frames
+    provizio_pooled_radar_point_cloud *newest_expired = NULL;
+    for (size_t i = 0; i < num_slots; ++i)
+    {
+        provizio_pooled_radar_point_cloud *point_cloud = &slots[i].point_cloud;
+        const uint64_t first_packet_time_ns = slots[i].storage.first_packet_time_ns;
+        // Complete point clouds are never expired, as they are only kept waiting for older ones in a reassembly window
+        if (point_cloud->num_points_received < point_cloud->num_points_expected && first_packet_time_ns != 0 &&
+            now_ns - first_packet_time_ns >= deadline_ns &&
+            (!newest_expired || point_cloud->frame_index > newest_expired->frame_index))
+        {
+            newest_expired = point_cloud;
+        }
+    }
+
+    if (!newest_expired)
+    {
+        return 0;
+    }
+
+    size_t num_returned = 0;
+    for (size_t i = 0; i < num_slots; ++i)
+    {
+        const provizio_pooled_radar_point_cloud *point_cloud = &slots[i].point_cloud;
+        if (point_cloud->num_points_received < point_cloud->num_points_expected &&
+            point_cloud->frame_index <= newest_expired->frame_index)
+        {
+            ++num_returned;
+        }
+    }
+
+    provizio_return_pooled_point_cloud(context, newest_expired);
+
+    if (context->impl.window != NULL)
+    {
+        // Newer complete point clouds may have been waiting for the returned ones
+        provizio_return_complete_pooled_point_clouds(context);
+    }
+
+    return num_returned;
+}
+
+size_t provizio_pooled_radar_point_cloud_api_contexts_tick(provizio_pooled_radar_point_cloud_api_context *contexts,
+                                                           size_t num_contexts)
+{
+    size_t num_expired = 0;
+    for (size_t i = 0; i < num_contexts; ++i)
+    {
+        num_expired += provizio_pooled_radar_point_cloud_api_context_tick(&contexts[i]);
+    }
+
+    return num_expired;
+}
+
+void provizio_pooled_radar_point_cloud_api_context_set_stats(provizio_pooled_radar_point_cloud_api_context *context,
+                                                             provizio_pooled_radar_point_cloud_stats *stats)
+{
+    context->impl.stats = stats;
+    memset(&context->impl.loss_tracker, 0, sizeof(provizio_radar_point_cloud_loss_tracker));
+}
+
+void provizio_pooled_radar_point_cloud_stats_snapshot(const provizio_pooled_radar_point_cloud_stats *stats,
+                                                      provizio_pooled_radar_point_cloud_stats *out_snapshot)
+{
+    provizio_radar_point_cloud_stats_snapshot(stats, out_snapshot);
+}
+
+void provizio_pooled_radar_point_cloud_api_context_release(provizio_pooled_radar_point_cloud_api_context *context)
+{
+    provizio_pooled_radar_point_cloud_slot *slots = provizio_get_pooled_slots(context);
+    const size_t num_slots = provizio_get_pooled_num_slots(context);
+    for (size_t i = 0; i < num_slots; ++i)
+    {
+        provizio_release_pooled_point_cloud(context, &slots[i].point_cloud);
+    }
+
+    context->impl.latest_frame = 0;
+    memset(&context->impl.loss_tracker, 0, sizeof(provizio_radar_point_cloud_loss_tracker));
+}
+
+int32_t provizio_pooled_radar_point_cloud_api_context_enable_ordered_reassembly(
+    provizio_pooled_radar_point_cloud_api_context *context)
+{
+    if (context == NULL)
+    {
+        provizio_error("provizio_pooled_radar_point_cloud_api_context_enable_ordered_reassembly: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (context->packet_pool != NULL)
+    {
+        provizio_error(
+            "provizio_pooled_radar_point_cloud_api_context_enable_ordered_reassembly: Not supported in zero-copy mode");
+        return PROVIZIO_E_NOT_PERMITTED;
+    }
+
+    provizio_pooled_radar_point_cloud_api_context_release(context);
+    context->impl.ordered_reassembly = 1;
+
+    return 0;
+}
+
+// Checks a packet fits the chunk at chunk_index of a frame, and it hasn't been received yet
+static int32_t provizio_check_pooled_chunk_index(const provizio_pooled_radar_point_cloud_storage *storage,
+                                                 const provizio_pooled_radar_point_cloud *point_cloud,
+                                                 uint16_t num_points_in_packet, uint32_t chunk_index)
+{
+    const uint32_t chunk_size = PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+    const uint32_t num_chunks = ((uint32_t)point_cloud->num_points_expected + chunk_size - 1) / chunk_size;
+    const uint32_t last_chunk_size = (uint32_t)point_cloud->num_points_expected - (num_chunks - 1) * chunk_size;
+
+    if (chunk_index >= num_chunks ||
+        num_points_in_packet != (chunk_index == num_chunks - 1 ? last_chunk_size : chunk_size))
+    {
+        provizio_error("provizio_check_pooled_chunk_index: Packet doesn't fit the chunks of the frame");
+        return PROVIZIO_E_PROTOCOL;
+    }
+
+    if ((storage->received_chunks[chunk_index / 32] & ((uint32_t)1 << (chunk_index % 32))) != 0)
+    {
+        // Duplicate
+        return PROVIZIO_E_SKIPPED;
+    }
+
+    return 0;
+}
+
+static int32_t provizio_handle_pooled_radar_point_cloud_packet_checked(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_radar_point_cloud_packet *packet,
+    uint32_t chunk_index, uint64_t receive_time_ns)
+{
+    if (provizio_get_protocol_field_uint16_t(&packet->header.total_points_in_frame) == 0)
+    {
+        // No points in the frame - just skip it
+        return PROVIZIO_E_SKIPPED;
+    }
+
+    if (context->packet_pool != NULL &&
+        provizio_get_protocol_field_uint16_t(&packet->header.protocol_header.protocol_version) < 2)
+    {
+        // Protocol version 1 points are smaller than provizio_radar_point, so they can't be converted in place
+        provizio_error(
+            "provizio_handle_pooled_radar_point_cloud_packet_checked: Zero-copy mode requires protocol version 2+");
+        return PROVIZIO_E_PROTOCOL;
+    }
+
+    if (context->impl.ordered_reassembly && chunk_index == PROVIZIO__POOLED_RADAR_POINT_CLOUD_CHUNK_UNKNOWN)
+    {
+        // The packet header carries no position of the packet in the frame, so it's only known to custom transports
+        provizio_error("provizio_handle_pooled_radar_point_cloud_packet_checked: Ordered reassembly requires chunk "
+                       "indices, see provizio_handle_pooled_radar_point_cloud_packet_chunk");
+        return PROVIZIO_E_NOT_PERMITTED;
+    }
+
+    provizio_pooled_radar_point_cloud *cloud = NULL;
+    int32_t status_code = provizio_get_pooled_point_cloud_being_received(context, &packet->header, &cloud);
+    if (status_code != 0)
+    {
+        return status_code;
+    }
+
+    const uint16_t num_points_in_packet = provizio_get_protocol_field_uint16_t(&packet->header.num_points_in_packet);
+    uint16_t first_point_index = cloud->num_points_received;
+    if (context->impl.ordered_reassembly)
+    {
+        status_code = provizio_check_pooled_chunk_index(provizio_get_pooled_point_cloud_storage(context, cloud),
+                                                        cloud, num_points_in_packet, chunk_index);
+        if (status_code != 0)
+        {
+            if (status_code == PROVIZIO_E_SKIPPED && context->impl.stats != NULL)
+            {
+                PROVIZIO__ATOMIC_ADD_UINT64(&context->impl.stats->num_packets_duplicate, 1);
+            }
+
+            return status_code;
+        }
+
+        first_point_index = (uint16_t)(chunk_index * PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET);
+    }
+
+    // Checked after ordered reassembly detects duplicates. Use uint32_t to avoid overflowing uint16_t.
+    if ((uint32_t)cloud->num_points_received + (uint32_t)num_points_in_packet > (uint32_t)cloud->num_points_expected)
+    {
+        provizio_error("provizio_handle_pooled_radar_point_cloud_packet_checked: Too many points received");
+        return PROVIZIO_E_PROTOCOL;
+    }
+
+    if (context->impl.stats != NULL)
+    {
+        // Ordered reassembly always knows the chunk index, otherwise it's unknown
+        provizio_radar_point_cloud_stats_account_packet(context->impl.stats, &context->impl.loss_tracker, chunk_index,
+                                                        cloud->num_points_expected, cloud->num_points_received,
+                                                        num_points_in_packet);
+    }
+
+    if (context->packet_pool != NULL)
+    {
+        // Zero-copy mode: keep the packet (converted in place) as a part of the point cloud being received
+        provizio_radar_packet_buffer *buffer = provizio_get_pooled_packet_buffer(context, cloud, packet);
+        if (buffer == NULL)
+        {
+            provizio_error("provizio_handle_pooled_radar_point_cloud_packet_checked: Out of packet buffers");
+            return PROVIZIO_E_OUT_OF_MEMORY;
+        }
+
+        provizio_radar_point_cloud_packet *kept_packet = (provizio_radar_point_cloud_packet *)buffer->payload;
+        status_code = provizio_get_radar_point_cloud_packet_points(kept_packet, kept_packet->radar_points);
+        assert(status_code == 0); // Protocol version has been checked already
+
+        provizio_pooled_radar_point_cloud_storage *storage = provizio_get_pooled_point_cloud_storage(context, cloud);
+        const uint32_t buffer_index = (uint32_t)(buffer - context->packet_pool->buffers);
+        if (storage->num_packet_buffers == 0)
+        {
+            storage->first_packet_buffer = buffer_index;
+        }
+        else
+        {
+            context->packet_pool->buffers[storage->last_packet_buffer].next = buffer_index;
+        }
+        storage->last_packet_buffer = buffer_index;
+        ++storage->num_packet_buffers;
+    }
+    else if (context->layout == provizio_pooled_radar_point_cloud_layout_soa)
+    {
+        // Scatter new points straight to the columns of the point cloud being received
+        status_code =
+            provizio_get_radar_point_cloud_packet_points_soa(packet, &cloud->radar_points_soa, first_point_index);
+        if (status_code != 0)
+        {
+            return status_code;
+        }
+    }
+    else
+    {
+        // Append new points to the point cloud being received
+        status_code = provizio_get_radar_point_cloud_packet_points(packet, &cloud->radar_points[first_point_index]);
+        if (status_code != 0)
+        {
+            return status_code;
+        }
+    }
+
+    if (receive_time_ns != 0)
+    {
+        if (cloud->first_packet_receive_time_ns == 0 || receive_time_ns < cloud->first_packet_receive_time_ns)
+        {
+            cloud->first_packet_receive_time_ns = receive_time_ns;
+        }
+
+        if (receive_time_ns > cloud->last_packet_receive_time_ns)
+        {
+            cloud->last_packet_receive_time_ns = receive_time_ns;
+        }
+    }
+
+    if (context->impl.ordered_reassembly)
+    {
+        uint32_t *received_chunks = provizio_get_pooled_point_cloud_storage(context, cloud)->received_chunks;
+        received_chunks[chunk_index / 32] |= (uint32_t)1 << (chunk_index % 32);
+    }
+    cloud->num_points_received += num_points_in_packet;
+
+    if (cloud->num_points_received == cloud->num_points_expected)
+    {
+        if (context->impl.window != NULL)
+        {
+            // Returned as soon as all older point clouds have been returned
+            provizio_return_complete_pooled_point_clouds(context);
+        }
+        else
+        {
+            provizio_return_pooled_point_cloud(context, cloud);
+        }
+    }
+
+    return 0;
+}
+
+static int32_t provizio_handle_pooled_radar_point_cloud_packet_counted(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_radar_point_cloud_packet *packet,
+    uint32_t chunk_index, uint64_t receive_time_ns)
+{
+    provizio_pooled_radar_point_cloud_stats *stats = context->impl.stats;
+    if (stats != NULL)
+    {
+        PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_packets_received, 1);
+    }
+
+    const int32_t status_code =
+        provizio_handle_pooled_radar_point_cloud_packet_checked(context, packet, chunk_index, receive_time_ns);
+    if (stats != NULL && status_code == PROVIZIO_E_SKIPPED)
+    {
+        PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_packets_skipped, 1);
+    }
+
+    return status_code;
+}
+
+static int32_t provizio_release_unhandled_pooled_packet(provizio_radar_packet_pool *packet_pool, const void *packet,
+                                                        int32_t status_code)
+{
+    if (status_code != 0)
+    {
+        // The packet has not been kept, so its buffer (if it's in the packet pool) has to be returned
+        provizio_radar_packet_buffer *buffer = provizio_radar_packet_pool_find(packet_pool, packet);
+        if (buffer != NULL)
+        {
+            provizio_radar_packet_pool_release(packet_pool, buffer);
+        }
+    }
+
+    return status_code;
+}
+
+static int32_t provizio_handle_pooled_radar_point_cloud_packet_impl(
+    provizio_pooled_radar_point_cloud_api_context *context, provizio_radar_point_cloud_packet *packet,
+    size_t packet_size, uint64_t receive_time_ns)
+{
+    const int32_t check_status = provizio_check_radar_point_cloud_packet(packet, packet_size);
+    if (check_status != 0)
+    {
+        return check_status;
+    }
+
+    return provizio_handle_pooled_radar_point_cloud_packet_counted(
+        context, packet, PROVIZIO__POOLED_RADAR_POINT_CLOUD_CHUNK_UNKNOWN, receive_time_ns);
+}
+
+int32_t provizio_handle_pooled_radar_point_cloud_packet(provizio_pooled_radar_point_cloud_api_context *context,
+                                                        provizio_radar_point_cloud_packet *packet, size_t packet_size)
+{
+    return provizio_release_unhandled_pooled_packet(context->packet_pool, packet,
+                                                    provizio_handle_pooled_radar_point_cloud_packet_impl(
+                                                        context, packet, packet_size, 0));
+}
+
+int32_t provizio_handle_pooled_radar_point_cloud_packet_chunk(provizio_pooled_radar_point_cloud_api_context *context,
+                                                              provizio_radar_point_cloud_packet *packet,
+                                                              size_t packet_size, uint32_t chunk_index)
+{
+    if (!context->impl.ordered_reassembly)
+    {
+        provizio_error("provizio_handle_pooled_radar_point_cloud_packet_chunk: Ordered reassembly is not enabled");
+        return PROVIZIO_E_NOT_PERMITTED;
+    }
+
+    const int32_t check_status = provizio_check_radar_point_cloud_packet(packet, packet_size);
+    if (check_status != 0)
+    {
+        return check_status;
+    }
+
+    return provizio_handle_pooled_radar_point_cloud_packet_counted(context, packet, chunk_index, 0);
+}
+
+static provizio_pooled_radar_point_cloud_api_context *provizio_get_pooled_radar_point_cloud_api_context_by_position_id(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts,
+    provizio_radar_point_cloud_packet *packet)
+{
+    const uint16_t radar_position_id = provizio_get_protocol_field_uint16_t(&packet->header.radar_position_id);
+    assert(radar_position_id != provizio_radar_position_unknown);
+
+    provizio_radar_api_contexts_dispatch_table *dispatch_table = num_contexts > 0 ? contexts[0].dispatch_table : NULL;
+    if (dispatch_table != NULL)
+    {
+        const size_t context_index_plus_one = dispatch_table->context_indices[radar_position_id];
+        if (context_index_plus_one != 0 && context_index_plus_one <= num_contexts)
+        {
+            // It's still correct unless the context has been since taken by another radar
+            provizio_pooled_radar_point_cloud_api_context *context = &contexts[context_index_plus_one - 1];
+            if (context->radar_position_id == radar_position_id ||
+                context->radar_position_id == provizio_radar_position_unknown)
+            {
+                return context;
+            }
+        }
+    }
+
+    // Not dispatched yet, so look for a context for this radar_position_id or a yet unused context
+    size_t found_index = num_contexts;
+#pragma unroll(5)
+    for (size_t i = 0; i < num_contexts; ++i)
+    {
+        if (contexts[i].radar_position_id == radar_position_id)
+        {
+            // Found the correct context
+            found_index = i;
+            break;
+        }
+
+        if (found_index == num_contexts && contexts[i].radar_position_id == provizio_radar_position_unknown)
+        {
+            // The first yet unused context, to be used unless there is a context for this radar_position_id already
+            found_index = i;
+        }
+    }
+
+    if (found_index == num_contexts)
+    {
+        // Not found
+        provizio_error("provizio_get_pooled_radar_point_cloud_api_context_by_position_id: Out of available contexts");
+        return NULL;
+    }
+
+    if (dispatch_table != NULL)
+    {
+        dispatch_table->context_indices[radar_position_id] = (uint16_t)(found_index + 1);
+    }
+
+    return &contexts[found_index];
+}
+
+static int32_t provizio_handle_pooled_radars_point_cloud_packet_impl(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts,
+    provizio_radar_point_cloud_packet *packet, size_t packet_size, uint64_t receive_time_ns)
+{
+    const int32_t check_status = provizio_check_radar_point_cloud_packet(packet, packet_size);
+    if (check_status != 0)
+    {
+        return check_status;
+    }
+
+    provizio_pooled_radar_point_cloud_api_context *context =
+        provizio_get_pooled_radar_point_cloud_api_context_by_position_id(contexts, num_contexts, packet);
+
+    if (!context)
+    {
+        // Error message has been already posted by provizio_get_pooled_radar_point_cloud_api_context_by_position_id
+        return PROVIZIO_E_OUT_OF_CONTEXTS;
+    }
+
+    return provizio_handle_pooled_radar_point_cloud_packet_counted(
+        context, packet, PROVIZIO__POOLED_RADAR_POINT_CLOUD_CHUNK_UNKNOWN, receive_time_ns);
+}
+
+int32_t provizio_handle_pooled_radars_point_cloud_packet(provizio_pooled_radar_point_cloud_api_context *contexts,
+                                                         size_t num_contexts, provizio_radar_point_cloud_packet *packet,
+                                                         size_t packet_size)
+{
+    return provizio_release_unhandled_pooled_packet(
+        num_contexts > 0 ? contexts[0].packet_pool : NULL, packet,
+        provizio_handle_pooled_radars_point_cloud_packet_impl(contexts, num_contexts, packet, packet_size, 0));
+}
+
+static int32_t provizio_handle_possible_pooled_radars_point_cloud_packet_impl(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts, const void *payload,
+    size_t payload_size, uint64_t receive_time_ns)
+{
+    if (payload_size < sizeof(provizio_radar_point_cloud_packet_header))
+    {
+        // Not enough data
+        return PROVIZIO_E_SKIPPED;
+    }
+
+    provizio_radar_point_cloud_packet_header *packet_header = (provizio_radar_point_cloud_packet_header *)payload;
+    if (provizio_get_protocol_field_uint16_t(&packet_header->protocol_header.packet_type) !=
+        PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE)
+    {
+        // Non-point cloud packet
+        return PROVIZIO_E_SKIPPED;
+    }
+
+    if (provizio_get_protocol_field_uint16_t(&packet_header->protocol_header.protocol_version) >
+        PROVIZIO__RADAR_API_POINT_CLOUD_PROTOCOL_VERSION)
+    {
+        provizio_error("provizio_handle_possible_pooled_radars_point_cloud_packet: Incompatible protocol version");
+        return PROVIZIO_E_PROTOCOL;
+    }
+
+    provizio_radar_point_cloud_packet *packet = (provizio_radar_point_cloud_packet *)payload;
+    return num_contexts != 1 ? provizio_handle_pooled_radars_point_cloud_packet_impl(contexts, num_contexts, packet,
+                                                                                     payload_size, receive_time_ns)
+                             : provizio_handle_pooled_radar_point_cloud_packet_impl(contexts, packet, payload_size,
+                                                                                    receive_time_ns);
+}
+
+int32_t provizio_handle_possible_pooled_radars_point_cloud_packet(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts, const void *payload,
+    size_t payload_size)
+{
+    return provizio_handle_possible_pooled_radars_point_cloud_packet_received_at(contexts, num_contexts, payload,
+                                                                                payload_size, 0);
+}
+
+int32_t provizio_handle_possible_pooled_radars_point_cloud_packet_received_at(
+    provizio_pooled_radar_point_cloud_api_context *contexts, size_t num_contexts, const void *payload,
+    size_t payload_size, uint64_t receive_time_ns)
+{
+    return provizio_release_unhandled_pooled_packet(
+        num_contexts > 0 ? contexts[0].packet_pool : NULL, payload,
+        provizio_handle_possible_pooled_radars_point_cloud_packet_impl(contexts, num_contexts, payload, payload_size,
+                                                                       receive_time_ns));
+}
@@ -0,0 +1,365 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/radar_api/radar_api_arena.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "provizio/radar_api/errno.h"
+#include "provizio/radar_api/radar_points_accumulation.h"
+
+// Sizes (in bytes) of the parts of an arena, every one but the pool is a multiple of PROVIZIO__MEMORY_POOL_UNIT_SIZE
+typedef struct provizio_radar_api_arena_layout
+{
+    size_t contexts_size;
+    size_t slots_size;
+    size_t accumulations_size;
+    size_t accumulated_point_clouds_size;
+    size_t accumulated_points_size;
+    size_t pool_size;
+} provizio_radar_api_arena_layout;
+
+static size_t provizio_radar_api_arena_align(size_t size)
+{
+    return (size + PROVIZIO__MEMORY_POOL_UNIT_SIZE - 1) / PROVIZIO__MEMORY_POOL_UNIT_SIZE *
+           PROVIZIO__MEMORY_POOL_UNIT_SIZE;
+}
+
+static int32_t provizio_radar_api_arena_make_layout(const provizio_radar_api_arena_config *config,
+                                                    provizio_radar_api_arena_layout *out_layout)
+{
+    memset(out_layout, 0, sizeof(provizio_radar_api_arena_layout));
+
+    if (config == NULL || config->max_radars == 0 || config->max_radars > UINT16_MAX ||
+        config->max_points_per_frame == 0 || config->window_size > UINT16_MAX ||
+        (config->layout != provizio_pooled_radar_point_cloud_layout_aos &&
+         config->layout != provizio_pooled_radar_point_cloud_layout_soa) ||
+        config->window_size > SIZE_MAX / 2 / sizeof(provizio_pooled_radar_point_cloud_slot) / config->max_radars ||
+        config->history_depth >
+            SIZE_MAX / 2 / sizeof(provizio_radar_api_arena_accumulated_point_cloud) / config->max_radars ||
+        config->history_depth >
+            SIZE_MAX / 2 / sizeof(provizio_radar_point) / config->max_points_per_frame / config->max_radars)
+    {
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    const size_t window_size = config->window_size != 0
+                                   ? config->window_size
+                                   : PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT;
+    out_layout->contexts_size =
+        provizio_radar_api_arena_align(sizeof(provizio_pooled_radar_point_cloud_api_context) * config->max_radars);
+    out_layout->slots_size = provizio_radar_api_arena_align(sizeof(provizio_pooled_radar_point_cloud_slot) *
+                                                            config->max_radars * config->window_size);
+    if (config->history_depth != 0)
+    {
+        out_layout->accumulations_size =
+            provizio_radar_api_arena_align(sizeof(provizio_radar_api_arena_accumulation) * config->max_radars);
+        out_layout->accumulated_point_clouds_size = provizio_radar_api_arena_align(
+            sizeof(provizio_radar_api_arena_accumulated_point_cloud) * config->max_radars * config->history_depth);
+        out_layout->accumulated_points_size = provizio_radar_api_arena_align(
+            sizeof(provizio_radar_point) * config->max_points_per_frame * config->max_radars * config->history_depth);
+    }
+    out_layout->pool_size = provizio_pooled_radar_point_cloud_window_pool_size(config->max_points_per_frame,
+                                                                               config->max_radars, window_size);
+
+    return 0;
+}
+
+void provizio_radar_api_arena_config_init(provizio_radar_api_arena_config *out_config)
+{
+    memset(out_config, 0, sizeof(provizio_radar_api_arena_config));
+
+    out_config->max_radars = 1;
+    out_config->max_points_per_frame = PROVIZIO__MAX_RADAR_POINTS_IN_POINT_CLOUD;
+    out_config->window_size = 0;
+    out_config->history_depth = 0;
+    out_config->layout = provizio_pooled_radar_point_cloud_layout_aos;
+}
+
+size_t provizio_radar_api_arena_required_size(const provizio_radar_api_arena_config *config)
+{
+    provizio_radar_api_arena_layout layout;
+    if (provizio_radar_api_arena_make_layout(config, &layout) != 0)
+    {
+        return 0;
+    }
+
+    // The memory block is aligned first, so the rest of the parts are aligned too
+    return PROVIZIO__MEMORY_POOL_UNIT_SIZE - 1 + layout.contexts_size + layout.slots_size + layout.accumulations_size +
+           layout.accumulated_point_clouds_size + layout.accumulated_points_size + layout.pool_size;
+}
+
+int32_t provizio_radar_api_arena_init(const provizio_radar_api_arena_config *config,
+                                      provizio_pooled_radar_point_cloud_callback callback, void *user_data,
+                                      void *memory, size_t memory_size, provizio_radar_api_arena *out_arena)
+{
+    memset(out_arena, 0, sizeof(provizio_radar_api_arena));
+
+    provizio_radar_api_arena_layout layout;
+    if (provizio_radar_api_arena_make_layout(config, &layout) != 0)
+    {
+        provizio_error("provizio_radar_api_arena_init: Invalid config");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (memory == NULL || memory_size < provizio_radar_api_arena_required_size(config))
+    {
+        provizio_error("provizio_radar_api_arena_init: Not enough memory");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    const size_t misalignment = (size_t)((uintptr_t)memory % PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+    uint8_t *next = (uint8_t *)memory + (misalignment != 0 ? PROVIZIO__MEMORY_POOL_UNIT_SIZE - misalignment : 0);
+
+    out_arena->config = *config;
+    out_arena->contexts = (provizio_pooled_radar_point_cloud_api_context *)next;
+    next += layout.contexts_size;
+    if (layout.slots_size != 0)
+    {
+        out_arena->slots = (provizio_pooled_radar_point_cloud_slot *)next;
+        next += layout.slots_size;
+    }
+    if (layout.accumulations_size != 0)
+    {
+        out_arena->accumulations = (provizio_radar_api_arena_accumulation *)next;
+        next += layout.accumulations_size;
+        provizio_radar_api_arena_accumulated_point_cloud *accumulated_point_clouds =
+            (provizio_radar_api_arena_accumulated_point_cloud *)next;
+        next += layout.accumulated_point_clouds_size;
+        provizio_radar_point *accumulated_points = (provizio_radar_point *)next;
+        next += layout.accumulated_points_size;
+
+        memset(accumulated_point_clouds, 0, layout.accumulated_point_clouds_size);
+        for (size_t i = 0; i < config->max_radars * config->history_depth; ++i)
+        {
+            accumulated_point_clouds[i].radar_points = &accumulated_points[i * config->max_points_per_frame];
+        }
+        for (size_t i = 0; i < config->max_radars; ++i)
+        {
+            out_arena->accumulations[i].point_clouds = &accumulated_point_clouds[i * config->history_depth];
+            out_arena->accumulations[i].newest = 0;
+            out_arena->accumulations[i].count = 0;
+        }
+    }
+
+    // The rest is enough for the pool, as it's included in the required size
+    int32_t status = provizio_memory_pool_init(next, layout.pool_size, &out_arena->pool);
+    if (status != 0)
+    {
+        return status; // LCOV_EXCL_LINE: Can't happen, as the pool size is always large enough
+    }
+
+    if (config->layout == provizio_pooled_radar_point_cloud_layout_soa)
+    {
+        provizio_pooled_radar_point_cloud_api_contexts_init_soa(callback, user_data, &out_arena->pool,
+                                                                out_arena->contexts, config->max_radars);
+    }
+    else
+    {
+        provizio_pooled_radar_point_cloud_api_contexts_init(callback, user_data, &out_arena->pool, out_arena->contexts,
+                                                            config->max_radars);
+    }
+
+    for (size_t i = 0; out_arena->slots != NULL && i < config->max_radars; ++i)
+    {
+        status = provizio_pooled_radar_point_cloud_api_context_set_window(
+            &out_arena->contexts[i], &out_arena->slots[i * config->window_size], config->window_size);
+        if (status != 0)
+        {
+            return status; // LCOV_EXCL_LINE: Can't happen, as the window size is checked above
+        }
+    }
+
+    return 0;
+}
+
+// Copies points of a pooled point cloud of any layout to a plain array
+static void provizio_radar_api_arena_copy_points(const provizio_pooled_radar_point_cloud *point_cloud,
+                                                 provizio_radar_point *out_points)
+{
+    const uint16_t num_points = point_cloud->num_points_received;
+    if (point_cloud->radar_points != NULL)
+    {
+        memcpy(out_points, point_cloud->radar_points, sizeof(provizio_radar_point) * num_points);
+    }
+    else if (point_cloud->spans != NULL)
+    {
+        // Zero-copy mode
+        size_t num_points_copied = 0;
+        for (size_t i = 0; i < point_cloud->num_spans; ++i)
+        {
+            memcpy(&out_points[num_points_copied], point_cloud->spans[i].radar_points,
+                   sizeof(provizio_radar_point) * point_cloud->spans[i].num_points);
+            num_points_copied += point_cloud->spans[i].num_points;
+        }
+        assert(num_points_copied == num_points);
+    }
+    else
+    {
+        const provizio_radar_points_soa *soa = &point_cloud->radar_points_soa;
+        for (uint16_t i = 0; i < num_points; ++i)
+        {
+            out_points[i].x_meters = soa->x_meters[i];
+            out_points[i].y_meters = soa->y_meters[i];
+            out_points[i].z_meters = soa->z_meters[i];
+            out_points[i].radar_relative_radial_velocity_m_s = soa->radar_relative_radial_velocity_m_s[i];
+            out_points[i].signal_to_noise_ratio = soa->signal_to_noise_ratio[i];
+            out_points[i].ground_relative_radial_velocity_m_s = soa->ground_relative_radial_velocity_m_s[i];
+        }
+    }
+}
+
+int32_t provizio_radar_api_arena_accumulate(provizio_radar_api_arena *arena, size_t context_index,
+                                            const provizio_pooled_radar_point_cloud *point_cloud,
+                                            const provizio_enu_fix *fix_when_received)
+{
+    if (arena->accumulations == NULL || context_index >= arena->config.max_radars ||
+        point_cloud->num_points_received > arena->config.max_points_per_frame)
+    {
+        provizio_error("provizio_radar_api_arena_accumulate: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (!provizio_quaternion_is_valid_rotation(&fix_when_received->orientation))
+    {
+        provizio_error("provizio_radar_api_arena_accumulate: fix_when_received->orientation is not a valid rotation");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (point_cloud->num_points_received == 0)
+    {
+        // Nothing to accumulate
+        return PROVIZIO_E_SKIPPED;
+    }
+
+    provizio_radar_api_arena_accumulation *accumulation = &arena->accumulations[context_index];
+    const uint32_t newest_frame_index = accumulation->point_clouds[accumulation->newest].frame_index;
+    if (accumulation->count > 0 && newest_frame_index >= point_cloud->frame_index)
+    {
+        const uint32_t small_frame_index_cap = 0x0000ffff;
+        const uint32_t large_frame_index_threshold = 0xffff0000;
+
+        if (point_cloud->frame_index >= small_frame_index_cap || newest_frame_index <= large_frame_index_threshold)
+        {
+            provizio_error(
+                "provizio_radar_api_arena_accumulate: Can't accumulate an older point cloud after a newer one");
+            return PROVIZIO_E_ARGUMENT;
+        }
+
+        // Frame indices seem to have exceeded the 0xffffffff and have been reset, same as in
+        // provizio_accumulate_radar_point_cloud
+        provizio_warning(
+            "provizio_radar_api_arena_accumulate: frame indices overflow detected - resetting accumulation");
+        accumulation->count = 0;
+    }
+
+    const size_t index = accumulation->count > 0 ? (accumulation->newest + 1) % arena->config.history_depth : 0;
+    provizio_radar_api_arena_accumulated_point_cloud *accumulated_cloud = &accumulation->point_clouds[index];
+    accumulated_cloud->frame_index = point_cloud->frame_index;
+    accumulated_cloud->timestamp = point_cloud->timestamp;
+    accumulated_cloud->radar_position_id = point_cloud->radar_position_id;
+    accumulated_cloud->radar_range = point_cloud->radar_range;
+    accumulated_cloud->num_points = point_cloud->num_points_received;
+    provizio_radar_api_arena_copy_points(point_cloud, accumulated_cloud->radar_points);
+    accumulated_cloud->fix_when_received = *fix_when_received;
+
+    accumulation->newest = index;
+    if (accumulation->count < arena->config.history_depth)
+    {
+        ++accumulation->count;
+    }
+
+    return 0;
+}
+
+const provizio_radar_api_arena_accumulated_point_cloud *
+provizio_radar_api_arena_get_accumulated_point_cloud(const provizio_radar_api_arena *arena, size_t context_index,
+                                                     size_t age)
+{
+    if (arena->accumulations == NULL || context_index >= arena->config.max_radars)
+    {
+        provizio_error("provizio_radar_api_arena_get_accumulated_point_cloud: Invalid arguments");
+        return NULL;
+    }
+
+    const provizio_radar_api_arena_accumulation *accumulation = &arena->accumulations[context_index];
+    if (age >= accumulation->count)
+    {
+        return NULL;
+    }
+
+    // Adding history_depth makes sure the index doesn't get negative, which can't be stored in size_t
+    return &accumulation->point_clouds[(arena->config.history_depth + accumulation->newest - age) %
+                                       arena->config.history_depth];
+}
+
+size_t provizio_radar_api_arena_transform_accumulated_points(const provizio_radar_api_arena *arena,
+                                                             size_t context_index, const provizio_enu_fix *current_fix,
+                                                             provizio_radar_point *out_transformed_points,
+                                                             size_t max_points)
+{
+    if (arena->accumulations == NULL || context_index >= arena->config.max_radars)
+    {
+        provizio_error("provizio_radar_api_arena_transform_accumulated_points: Invalid arguments");
+        return 0;
+    }
+
+    if (!provizio_quaternion_is_valid_rotation(&current_fix->orientation))
+    {
+        provizio_error(
+            "provizio_radar_api_arena_transform_accumulated_points: current_fix->orientation is not a valid rotation");
+        return 0;
+    }
+
+    size_t num_points = 0;
+    float transformation_matrix[4 * 4];
+    const provizio_radar_api_arena_accumulated_point_cloud *accumulated_cloud = NULL;
+    for (size_t age = 0;
+         num_points < max_points &&
+         (accumulated_cloud = provizio_radar_api_arena_get_accumulated_point_cloud(arena, context_index, age)) != NULL;
+         ++age)
+    {
+        const size_t points_left = max_points - num_points;
+        const size_t num_cloud_points =
+            accumulated_cloud->num_points < points_left ? accumulated_cloud->num_points : points_left;
+
+        provizio_build_transformation_matrix(&accumulated_cloud->fix_when_received, current_fix, transformation_matrix);
+        provizio_transform_radar_points(transformation_matrix, accumulated_cloud->radar_points, num_cloud_points,
+                                        &out_transformed_points[num_points]);
+        num_points += num_cloud_points;
+    }
+
+    return num_points;
+}
+
+void provizio_radar_api_arena_reset_accumulation(provizio_radar_api_arena *arena, size_t context_index)
+{
+    if (arena->accumulations == NULL || context_index >= arena->config.max_radars)
+    {
+        provizio_error("provizio_radar_api_arena_reset_accumulation: Invalid arguments");
+        return;
+    }
+
+    arena->accumulations[context_index].newest = 0;
+    arena->accumulations[context_index].count = 0;
+}
+
+void provizio_radar_api_arena_release(provizio_radar_api_arena *arena)
+{
+    for (size_t i = 0; arena->contexts != NULL && i < arena->config.max_radars; ++i)
+    {
+        provizio_pooled_radar_point_cloud_api_context_release(&arena->contexts[i]);
+    }
+}
@@ -0,0 +1,108 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/radar_api/radar_packet_pool.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "provizio/radar_api/core.h"
+#include "provizio/radar_api/errno.h"
+
+size_t provizio_radar_packet_pool_num_buffers(uint16_t max_points_per_frame, size_t num_radars)
+{
+    return provizio_radar_packet_pool_window_num_buffers(
+        max_points_per_frame, num_radars,
+        PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT);
+}
+
+size_t provizio_radar_packet_pool_window_num_buffers(uint16_t max_points_per_frame, size_t num_radars,
+                                                     size_t window_size)
+{
+    const size_t max_packets_per_frame =
+        ((size_t)max_points_per_frame + PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET - 1) /
+        PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+
+    // Plus a batch of packets to receive into, as provizio_radar_api_receive_packets acquires a buffer for every packet
+    // of a batch before any of them is handled
+    return num_radars * window_size * max_packets_per_frame + PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE;
+}
+
+int32_t provizio_radar_packet_pool_init(provizio_radar_packet_buffer *buffers, provizio_radar_point_span *spans,
+                                        size_t num_buffers, provizio_radar_packet_pool *out_pool)
+{
+    memset(out_pool, 0, sizeof(provizio_radar_packet_pool));
+
+    if (buffers == NULL || spans == NULL || num_buffers == 0 || num_buffers > (size_t)UINT32_MAX)
+    {
+        provizio_error("provizio_radar_packet_pool_init: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    out_pool->buffers = buffers;
+    out_pool->spans = spans;
+    out_pool->num_buffers = (uint32_t)num_buffers;
+    out_pool->first_free_buffer = 0;
+    out_pool->num_free_buffers = (uint32_t)num_buffers;
+
+    for (uint32_t i = 0; i < out_pool->num_buffers; ++i)
+    {
+        buffers[i].next = i + 1;
+    }
+
+    return 0;
+}
+
+provizio_radar_packet_buffer *provizio_radar_packet_pool_acquire(provizio_radar_packet_pool *pool)
+{
+    if (pool->num_free_buffers == 0)
+    {
+        return NULL;
+    }
+
+    provizio_radar_packet_buffer *buffer = &pool->buffers[pool->first_free_buffer];
+    pool->first_free_buffer = buffer->next;
+    --pool->num_free_buffers;
+
+    return buffer;
+}
+
+void provizio_radar_packet_pool_release(provizio_radar_packet_pool *pool, provizio_radar_packet_buffer *buffer)
+{
+    assert(buffer >= pool->buffers && buffer < pool->buffers + pool->num_buffers);
+    assert(pool->num_free_buffers < pool->num_buffers);
+
+    buffer->next = pool->first_free_buffer;
+    pool->first_free_buffer = (uint32_t)(buffer - pool->buffers);
+    ++pool->num_free_buffers;
+}
+
+provizio_radar_packet_buffer *provizio_radar_packet_pool_find(provizio_radar_packet_pool *pool, const void *payload)
+{
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+
+    // Compare as integers, as comparing pointers to different objects is not defined by the C standard
+    const uintptr_t address = (uintptr_t)payload;
+    const uintptr_t first_address = (uintptr_t)pool->buffers;
+    if (address < first_address || address >= (uintptr_t)(pool->buffers + pool->num_buffers) ||
+        (address - first_address) % sizeof(provizio_radar_packet_buffer) != 0)
+    {
+        return NULL;
+    }
+
+    return &pool->buffers[(address - first_address) / sizeof(provizio_radar_packet_buffer)];
+}
@@ -16,8 +16,10 @@
 
 #include <assert.h>
 #include <math.h>
+#include <stddef.h>
 #include <string.h>
 
+#include "provizio/atomic.h"
 #include "provizio/radar_api/errno.h"
 #include "provizio/util.h"
 
@@ -33,11 +35,8 @@ typedef struct provizio_radar_point_protocol_v1
 } provizio_radar_point_protocol_v1;
 #pragma pack(pop)
 
-static int provizio_network_floats_reversed(void)
-{
-    const float test_value = 1.0F;
-    return ((const char *)(&test_value))[3] != 0;
-}
+// Number of points converted to host byte order at once when filling provizio_radar_points_soa
+#define PROVIZIO__SOA_CONVERSION_CHUNK_POINTS 16
 
 void provizio_return_point_cloud(provizio_radar_point_cloud_api_context *context,
                                  provizio_radar_point_cloud *point_cloud)
@@ -55,8 +54,25 @@ void provizio_return_point_cloud(provizio_radar_point_cloud_api_context *context
         }
     }
 
-    context->callback(point_cloud, context);
-    memset(point_cloud, 0, sizeof(provizio_radar_point_cloud));
+    const size_t index = (size_t)(point_cloud - context->impl.point_clouds_being_received);
+    provizio_radar_point_cloud_stats *stats = context->impl.stats;
+    if (stats != NULL)
+    {
+        const uint64_t callback_start_time_ns = provizio_radar_point_cloud_stats_account_frame_returned(
+            stats, point_cloud->num_points_expected, point_cloud->num_points_received,
+            context->impl.first_packet_times_ns[index]);
+        context->callback(point_cloud, context);
+        provizio_radar_point_cloud_stats_account_callback(stats, callback_start_time_ns);
+    }
+    else
+    {
+        context->callback(point_cloud, context);
+    }
+
+    // Only the header and the points received may be non-zero, so there is no need to reset the entire point cloud
+    memset(point_cloud->radar_points, 0, sizeof(provizio_radar_point) * point_cloud->num_points_received);
+    memset(point_cloud, 0, offsetof(provizio_radar_point_cloud, radar_points));
+    context->impl.first_packet_times_ns[index] = 0;
 }
 
 provizio_radar_point_cloud *provizio_get_point_cloud_being_received(
@@ -78,7 +94,17 @@ provizio_radar_point_cloud *provizio_get_point_cloud_being_received(
         // state of the API to avoid complicated state-related issues.
         provizio_warning(
             "provizio_get_point_cloud_being_received: frame indices overflow detected - resetting API state");
+        provizio_radar_api_contexts_dispatch_table *dispatch_table = context->dispatch_table;
+        const uint64_t completion_deadline_ns = context->impl.completion_deadline_ns;
+        provizio_radar_point_cloud_stats *stats = context->impl.stats;
         provizio_radar_point_cloud_api_context_init(context->callback, context->user_data, context);
+        context->dispatch_table = dispatch_table; // Keep dispatching packets in constant time
+        context->impl.completion_deadline_ns = completion_deadline_ns;
+        context->impl.stats = stats;
+        if (stats != NULL)
+        {
+            PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_frame_index_resets, 1);
+        }
     }
 
     if (context->radar_position_id == provizio_radar_position_unknown)
@@ -90,6 +116,12 @@ provizio_radar_point_cloud *provizio_get_point_cloud_being_received(
         return NULL;
     }
 
+    if (context->impl.stats != NULL)
+    {
+        provizio_radar_point_cloud_stats_account_frame(context->impl.stats, &context->impl.loss_tracker,
+                                                       context->impl.latest_frame, frame_index);
+    }
+
     if (context->impl.latest_frame < frame_index)
     {
         context->impl.latest_frame = frame_index;
@@ -160,6 +192,12 @@ provizio_radar_point_cloud *provizio_get_point_cloud_being_received(
         result->num_points_expected = total_points_in_frame;
         result->radar_range = radar_range;
         assert(result->num_points_received == 0);
+
+        if (context->impl.completion_deadline_ns != 0 || context->impl.stats != NULL)
+        {
+            context->impl.first_packet_times_ns[result - context->impl.point_clouds_being_received] =
+                provizio_monotonic_time_ns();
+        }
     }
 
     return result;
@@ -235,6 +273,210 @@ int32_t provizio_radar_point_cloud_api_context_assign(provizio_radar_point_cloud
     return PROVIZIO_E_NOT_PERMITTED;
 }
 
+int32_t provizio_radar_point_cloud_api_contexts_set_dispatch_table(
+    provizio_radar_point_cloud_api_context *contexts, size_t num_contexts,
+    provizio_radar_api_contexts_dispatch_table *dispatch_table)
+{
+    if (num_contexts == 0 || num_contexts > UINT16_MAX)
+    {
+        provizio_error("provizio_radar_point_cloud_api_contexts_set_dispatch_table: Invalid number of contexts");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (dispatch_table != NULL)
+    {
+        // Filled lazily, as radars are first seen
+        memset(dispatch_table, 0, sizeof(provizio_radar_api_contexts_dispatch_table));
+    }
+    contexts[0].dispatch_table = dispatch_table;
+
+    return 0;
+}
+
+void provizio_radar_point_cloud_api_context_set_completion_deadline(provizio_radar_point_cloud_api_context *context,
+                                                                    uint64_t deadline_ns)
+{
+    context->impl.completion_deadline_ns = deadline_ns;
+}
+
+size_t provizio_radar_point_cloud_api_context_tick(provizio_radar_point_cloud_api_context *context)
+{
+    const uint64_t deadline_ns = context->impl.completion_deadline_ns;
+    if (deadline_ns == 0)
+    {
+        return 0;
+    }
+
+    const uint64_t now_ns = provizio_monotonic_time_ns();
+
+    // The newest expired point cloud is returned along with all older ones, to keep the order of frames. Point clouds
+    // being received are never complete, as complete ones are returned straight away.
+    provizio_radar_point_cloud *newest_expired = NULL;
+    for (size_t i = 0; i < PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT; ++i)
+    {
+        provizio_radar_point_cloud *point_cloud = &context->impl.point_clouds_being_received[i];
+        const uint64_t first_packet_time_ns = context->impl.first_packet_times_ns[i];
+        if (point_cloud->num_points_expected > 0 && first_packet_time_ns != 0 &&
+            now_ns - first_packet_time_ns >= deadline_ns &&
+            (!newest_expired || point_cloud->frame_index > newest_expired->frame_index))
+        {
+            newest_expired = point_cloud;
+        }
+    }
+
+    if (!newest_expired)
+    {
+        return 0;
+    }
+
+    size_t num_returned = 0;
+    for (size_t i = 0; i < PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT; ++i)
+    {
+        const provizio_radar_point_cloud *point_cloud = &context->impl.point_clouds_being_received[i];
+        if (point_cloud->num_points_expected > 0 && point_cloud->frame_index <= newest_expired->frame_index)
+        {
+            ++num_returned;
+        }
+    }
+
+    provizio_return_point_cloud(context, newest_expired);
+
+    return num_returned;
+}
+
+size_t provizio_radar_point_cloud_api_contexts_tick(provizio_radar_point_cloud_api_context *contexts,
+                                                    size_t num_contexts)
+{
+    size_t num_expired = 0;
+    for (size_t i = 0; i < num_contexts; ++i)
+    {
+        num_expired += provizio_radar_point_cloud_api_context_tick(&contexts[i]);
+    }
+
+    return num_expired;
+}
+
+void provizio_radar_point_cloud_api_context_set_stats(provizio_radar_point_cloud_api_context *context,
+                                                      provizio_radar_point_cloud_stats *stats)
+{
+    context->impl.stats = stats;
+    memset(&context->impl.loss_tracker, 0, sizeof(provizio_radar_point_cloud_loss_tracker));
+}
+
+void provizio_radar_point_cloud_stats_snapshot(const provizio_radar_point_cloud_stats *stats,
+                                               provizio_radar_point_cloud_stats *out_snapshot)
+{
+    out_snapshot->num_packets_received = PROVIZIO__ATOMIC_LOAD_UINT64(&stats->num_packets_received);
+    out_snapshot->num_packets_skipped = PROVIZIO__ATOMIC_LOAD_UINT64(&stats->num_packets_skipped);
+    out_snapshot->num_frames_complete = PROVIZIO__ATOMIC_LOAD_UINT64(&stats->num_frames_complete);
+    out_snapshot->num_frames_partial = PROVIZIO__ATOMIC_LOAD_UINT64(&stats->num_frames_partial);
+    out_snapshot->num_frames_missing = PROVIZIO__ATOMIC_LOAD_UINT64(&stats->num_frames_missing);
+    out_snapshot->num_points_lost = PROVIZIO__ATOMIC_LOAD_UINT64(&stats->num_points_lost);
+    out_snapshot->num_packets_out_of_order = PROVIZIO__ATOMIC_LOAD_UINT64(&stats->num_packets_out_of_order);
+    out_snapshot->num_packets_duplicate = PROVIZIO__ATOMIC_LOAD_UINT64(&stats->num_packets_duplicate);
+    out_snapshot->num_frame_index_resets = PROVIZIO__ATOMIC_LOAD_UINT64(&stats->num_frame_index_resets);
+    provizio_histogram_snapshot(&stats->points_per_frame, &out_snapshot->points_per_frame);
+    provizio_histogram_snapshot(&stats->reassembly_duration_ns, &out_snapshot->reassembly_duration_ns);
+    provizio_histogram_snapshot(&stats->callback_duration_ns, &out_snapshot->callback_duration_ns);
+}
+
+void provizio_radar_point_cloud_stats_account_frame(provizio_radar_point_cloud_stats *stats,
+                                                    provizio_radar_point_cloud_loss_tracker *loss_tracker,
+                                                    uint32_t latest_frame, uint32_t frame_index)
+{
+    const uint64_t recent_frames = loss_tracker->recent_frames;
+    if (recent_frames != 0 && frame_index < loss_tracker->last_packet_frame)
+    {
+        // Only the first packet of an older frame is out of order, the rest of them follow it
+        PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_packets_out_of_order, 1);
+    }
+    if (recent_frames == 0 || frame_index != loss_tracker->last_packet_frame)
+    {
+        loss_tracker->last_packet_frame = frame_index;
+        loss_tracker->last_packet_chunk = 0;
+    }
+
+    if (recent_frames == 0)
+    {
+        // The first frame, older ones are not known to be missing
+        loss_tracker->recent_frames = UINT64_MAX;
+    }
+    else if (frame_index > latest_frame)
+    {
+        const uint32_t distance = frame_index - latest_frame;
+        if (distance > 1)
+        {
+            PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_frames_missing, distance - 1);
+        }
+
+        loss_tracker->recent_frames =
+            (distance < PROVIZIO__RADAR_POINT_CLOUD_RECENT_FRAMES_COUNT ? recent_frames << distance : 0) | 1U;
+    }
+    else if (frame_index < latest_frame)
+    {
+        const uint32_t distance = latest_frame - frame_index;
+        if (distance < PROVIZIO__RADAR_POINT_CLOUD_RECENT_FRAMES_COUNT &&
+            (recent_frames & ((uint64_t)1 << distance)) == 0)
+        {
+            // The frame arrived late, i.e. it has been counted as missing
+            loss_tracker->recent_frames = recent_frames | ((uint64_t)1 << distance);
+            PROVIZIO__ATOMIC_SUB_UINT64(&stats->num_frames_missing, 1);
+        }
+    }
+}
+
+void provizio_radar_point_cloud_stats_account_packet(provizio_radar_point_cloud_stats *stats,
+                                                     provizio_radar_point_cloud_loss_tracker *loss_tracker,
+                                                     uint32_t chunk_index, uint16_t num_points_expected,
+                                                     uint16_t num_points_received, uint16_t num_points_in_packet)
+{
+    const uint32_t chunk_size = PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+    if (chunk_index == UINT32_MAX)
+    {
+        // Unless it's known, only the shorter last packet is known to go after the ones received after it
+        chunk_index = num_points_in_packet < chunk_size
+                          ? ((uint32_t)num_points_expected + chunk_size - 1) / chunk_size - 1
+                          : (uint32_t)num_points_received / chunk_size;
+    }
+
+    if (chunk_index < loss_tracker->last_packet_chunk)
+    {
+        PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_packets_out_of_order, 1);
+    }
+    loss_tracker->last_packet_chunk = chunk_index;
+}
+
+uint64_t provizio_radar_point_cloud_stats_account_frame_returned(provizio_radar_point_cloud_stats *stats,
+                                                                 uint16_t num_points_expected,
+                                                                 uint16_t num_points_received,
+                                                                 uint64_t first_packet_time_ns)
+{
+    const uint64_t callback_start_time_ns = provizio_monotonic_time_ns();
+    if (num_points_received == num_points_expected)
+    {
+        PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_frames_complete, 1);
+    }
+    else
+    {
+        PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_frames_partial, 1);
+        PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_points_lost, num_points_expected - num_points_received);
+    }
+    provizio_histogram_record(&stats->points_per_frame, num_points_received);
+    if (first_packet_time_ns != 0)
+    {
+        // Not known for frames started before the stats were set
+        provizio_histogram_record(&stats->reassembly_duration_ns, callback_start_time_ns - first_packet_time_ns);
+    }
+
+    return callback_start_time_ns;
+}
+
+void provizio_radar_point_cloud_stats_account_callback(provizio_radar_point_cloud_stats *stats,
+                                                       uint64_t callback_start_time_ns)
+{
+    provizio_histogram_record(&stats->callback_duration_ns, provizio_monotonic_time_ns() - callback_start_time_ns);
+}
+
 int32_t provizio_check_radar_point_cloud_packet(provizio_radar_point_cloud_packet *packet, size_t packet_size)
 {
     if (packet_size < sizeof(provizio_radar_api_protocol_header))
@@ -279,8 +521,184 @@ int32_t provizio_check_radar_point_cloud_packet(provizio_radar_point_cloud_packe
     return 0;
 }
 
+int32_t provizio_get_radar_point_cloud_packet_points(const provizio_radar_point_cloud_packet *packet,
+                                                     provizio_radar_point *out_points)
+{
+    const uint16_t num_points_in_packet = provizio_get_protocol_field_uint16_t(&packet->header.num_points_in_packet);
+    const uint16_t protocol_version =
+        provizio_get_protocol_field_uint16_t(&packet->header.protocol_header.protocol_version);
+
+    if (protocol_version == 0)
+    {
+        provizio_error("provizio_get_radar_point_cloud_packet_points: invalid protocol version");
+        return PROVIZIO_E_PROTOCOL;
+    }
+
+    const size_t floats_per_point = sizeof(provizio_radar_point) / sizeof(float);
+    if (protocol_version >= 2)
+    {
+        // Points are just consecutive floats, so all of them are converted in bulk (or copied as is, if the host uses
+        // network byte order for floats)
+        provizio_get_protocol_fields_float(packet->radar_points, out_points, floats_per_point * num_points_in_packet);
+        return 0;
+    }
+
+    // Protocol v1 has no ground_relative_radial_velocity_m_s: convert all floats in bulk first and then spread them
+    // from the end, so that points don't overwrite the ones not spread yet
+    const size_t floats_per_point_v1 = sizeof(provizio_radar_point_protocol_v1) / sizeof(float);
+    provizio_get_protocol_fields_float(packet->radar_points, out_points, floats_per_point_v1 * num_points_in_packet);
+    float *out_floats = (float *)out_points;
+    for (size_t i = num_points_in_packet; i-- > 0;)
+    {
+        memmove(&out_floats[i * floats_per_point], &out_floats[i * floats_per_point_v1],
+                sizeof(provizio_radar_point_protocol_v1));
+        out_points[i].ground_relative_radial_velocity_m_s = nanf("");
+    }
+
+    return 0;
+}
+
+int32_t provizio_get_radar_point_cloud_packet_points_soa(const provizio_radar_point_cloud_packet *packet,
+                                                         provizio_radar_points_soa *out_points,
+                                                         uint16_t first_point_index)
+{
+    const uint16_t num_points_in_packet = provizio_get_protocol_field_uint16_t(&packet->header.num_points_in_packet);
+    const uint16_t protocol_version =
+        provizio_get_protocol_field_uint16_t(&packet->header.protocol_header.protocol_version);
+
+    if (protocol_version == 0)
+    {
+        provizio_error("provizio_get_radar_point_cloud_packet_points_soa: invalid protocol version");
+        return PROVIZIO_E_PROTOCOL;
+    }
+
+    // Use uint32_t to avoid overflowing uint16_t
+    if ((uint32_t)first_point_index + (uint32_t)num_points_in_packet > (uint32_t)out_points->capacity)
+    {
+        provizio_error("provizio_get_radar_point_cloud_packet_points_soa: Not enough capacity");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    const size_t in_point_size =
+        protocol_version >= 2 ? sizeof(provizio_radar_point) : sizeof(provizio_radar_point_protocol_v1);
+    const size_t floats_per_point = in_point_size / sizeof(float);
+    const uint8_t *in_points = (const uint8_t *)packet->radar_points;
+
+    // Convert the floats in bulk, a chunk of points at a time, and then scatter them to the columns
+    float chunk[PROVIZIO__SOA_CONVERSION_CHUNK_POINTS * sizeof(provizio_radar_point) / sizeof(float)];
+    for (uint16_t first_in_chunk = 0; first_in_chunk < num_points_in_packet;
+         first_in_chunk += PROVIZIO__SOA_CONVERSION_CHUNK_POINTS)
+    {
+        const uint16_t points_left = (uint16_t)(num_points_in_packet - first_in_chunk);
+        const uint16_t num_points_in_chunk =
+            points_left < PROVIZIO__SOA_CONVERSION_CHUNK_POINTS ? points_left : PROVIZIO__SOA_CONVERSION_CHUNK_POINTS;
+        provizio_get_protocol_fields_float(&in_points[in_point_size * first_in_chunk], chunk,
+                                           floats_per_point * num_points_in_chunk);
+
+        for (uint16_t i = 0; i < num_points_in_chunk; ++i)
+        {
+            const float *in_point = &chunk[floats_per_point * i];
+            const size_t out_index = (size_t)first_point_index + first_in_chunk + i;
+
+            out_points->x_meters[out_index] = in_point[0];
+            out_points->y_meters[out_index] = in_point[1];
+            out_points->z_meters[out_index] = in_point[2];
+            out_points->radar_relative_radial_velocity_m_s[out_index] = in_point[3]; // NOLINT
+            out_points->signal_to_noise_ratio[out_index] = in_point[4];              // NOLINT
+            out_points->ground_relative_radial_velocity_m_s[out_index] =
+                protocol_version >= 2 ? in_point[5] : nanf(""); // NOLINT
+        }
+    }
+
+    return 0;
+}
+
+static size_t provizio_radar_points_soa_column_size(uint16_t capacity)
+{
+    const size_t alignment = PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT;
+    return (sizeof(float) * capacity + alignment - 1) / alignment * alignment;
+}
+
+size_t provizio_radar_points_soa_required_size(uint16_t capacity)
+{
+    return provizio_radar_points_soa_column_size(capacity) * 6 + PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT - 1; // NOLINT
+}
+
+int32_t provizio_radar_points_soa_init(void *memory, size_t memory_size, uint16_t capacity,
+                                       provizio_radar_points_soa *out_points)
+{
+    memset(out_points, 0, sizeof(provizio_radar_points_soa));
+
+    const size_t misalignment = (size_t)((uintptr_t)memory % PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT);
+    const size_t alignment_offset = misalignment != 0 ? PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT - misalignment : 0;
+    const size_t column_size = provizio_radar_points_soa_column_size(capacity);
+    if (memory == NULL || memory_size < alignment_offset + column_size * 6) // NOLINT: 6 columns
+    {
+        provizio_error("provizio_radar_points_soa_init: Not enough memory");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    uint8_t *columns = (uint8_t *)memory + alignment_offset;
+    out_points->x_meters = (float *)columns;
+    out_points->y_meters = (float *)(columns + column_size);
+    out_points->z_meters = (float *)(columns + column_size * 2);
+    out_points->radar_relative_radial_velocity_m_s = (float *)(columns + column_size * 3);  // NOLINT
+    out_points->signal_to_noise_ratio = (float *)(columns + column_size * 4);               // NOLINT
+    out_points->ground_relative_radial_velocity_m_s = (float *)(columns + column_size * 5); // NOLINT
+    out_points->capacity = capacity;
+
+    return 0;
+}
+
+int32_t provizio_radar_points_aos_to_soa(const provizio_radar_point *points, uint16_t num_points,
+                                         provizio_radar_points_soa *out_points)
+{
+    if (num_points > out_points->capacity)
+    {
+        provizio_error("provizio_radar_points_aos_to_soa: Not enough capacity");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        const provizio_radar_point *point = &points[i];
+        out_points->x_meters[i] = point->x_meters;
+        out_points->y_meters[i] = point->y_meters;
+        out_points->z_meters[i] = point->z_meters;
+        out_points->radar_relative_radial_velocity_m_s[i] = point->radar_relative_radial_velocity_m_s;
+        out_points->signal_to_noise_ratio[i] = point->signal_to_noise_ratio;
+        out_points->ground_relative_radial_velocity_m_s[i] = point->ground_relative_radial_velocity_m_s;
+    }
+
+    return 0;
+}
+
+int32_t provizio_radar_points_soa_to_aos(const provizio_radar_points_soa *points, uint16_t num_points,
+                                         provizio_radar_point *out_points)
+{
+    if (num_points > points->capacity)
+    {
+        provizio_error("provizio_radar_points_soa_to_aos: Not enough points");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        provizio_radar_point *point = &out_points[i];
+        point->x_meters = points->x_meters[i];
+        point->y_meters = points->y_meters[i];
+        point->z_meters = points->z_meters[i];
+        point->radar_relative_radial_velocity_m_s = points->radar_relative_radial_velocity_m_s[i];
+        point->signal_to_noise_ratio = points->signal_to_noise_ratio[i];
+        point->ground_relative_radial_velocity_m_s = points->ground_relative_radial_velocity_m_s[i];
+    }
+
+    return 0;
+}
+
 int32_t provizio_handle_radar_point_cloud_packet_checked(provizio_radar_point_cloud_api_context *context,
-                                                         provizio_radar_point_cloud_packet *packet)
+                                                         provizio_radar_point_cloud_packet *packet,
+                                                         uint64_t receive_time_ns)
 {
     provizio_radar_point_cloud *cloud = provizio_get_point_cloud_being_received(context, &packet->header);
     if (!cloud)
@@ -303,62 +721,36 @@ int32_t provizio_handle_radar_point_cloud_packet_checked(provizio_radar_point_cl
         return PROVIZIO_E_PROTOCOL;
     }
 
-    const uint16_t protocol_version =
-        provizio_get_protocol_field_uint16_t(&packet->header.protocol_header.protocol_version);
+    if (context->impl.stats != NULL)
+    {
+        provizio_radar_point_cloud_stats_account_packet(context->impl.stats, &context->impl.loss_tracker, UINT32_MAX,
+                                                        cloud->num_points_expected, cloud->num_points_received,
+                                                        num_points_in_packet);
+    }
 
     // Append new points to the point cloud being received
-    if (!provizio_network_floats_reversed() && (protocol_version >= 2))
+    const int32_t status_code =
+        provizio_get_radar_point_cloud_packet_points(packet, &cloud->radar_points[cloud->num_points_received]);
+    if (status_code != 0)
     {
-        // Optimized version: host machine uses network byte order for floats, no need to convert them
-        // LCOV_EXCL_START: host CPU arch dependent
-        memcpy(&cloud->radar_points[cloud->num_points_received], &packet->radar_points,
-               sizeof(provizio_radar_point) * num_points_in_packet);
-        // LCOV_EXCL_STOP
+        return status_code;
     }
-    else
-    {
-        // LCOV_EXCL_START: host CPU arch dependent
-        for (uint16_t i = 0; i < num_points_in_packet; ++i)
-        {
-            provizio_radar_point *out_point = &cloud->radar_points[cloud->num_points_received + i];
-            provizio_radar_point *in_point = NULL;
 
-            if (protocol_version >= 2)
-            {
-                in_point = &packet->radar_points[i];
-            }
-            else if (protocol_version == 1)
-            {
-                in_point = (provizio_radar_point *)&(((provizio_radar_point_protocol_v1 *)packet->radar_points)[i]);
-            }
-            else
-            {
-                provizio_error("provizio_handle_radar_point_cloud_packet_checked: invalid protocol version");
-                return PROVIZIO_E_PROTOCOL;
-            }
+    cloud->num_points_received += num_points_in_packet;
 
-            out_point->x_meters = provizio_get_protocol_field_float(&in_point->x_meters);
-            out_point->y_meters = provizio_get_protocol_field_float(&in_point->y_meters);
-            out_point->z_meters = provizio_get_protocol_field_float(&in_point->z_meters);
-            out_point->radar_relative_radial_velocity_m_s =
-                provizio_get_protocol_field_float(&in_point->radar_relative_radial_velocity_m_s);
-            out_point->signal_to_noise_ratio = provizio_get_protocol_field_float(&in_point->signal_to_noise_ratio);
+    if (receive_time_ns != 0)
+    {
+        if (cloud->first_packet_receive_time_ns == 0 || receive_time_ns < cloud->first_packet_receive_time_ns)
+        {
+            cloud->first_packet_receive_time_ns = receive_time_ns;
+        }
 
-            if (protocol_version >= 2)
-            {
-                out_point->ground_relative_radial_velocity_m_s =
-                    provizio_get_protocol_field_float(&in_point->ground_relative_radial_velocity_m_s);
-            }
-            else
-            {
-                out_point->ground_relative_radial_velocity_m_s = nanf("");
-            }
+        if (receive_time_ns > cloud->last_packet_receive_time_ns)
+        {
+            cloud->last_packet_receive_time_ns = receive_time_ns;
         }
-        // LCOV_EXCL_STOP
     }
 
-    cloud->num_points_received += num_points_in_packet;
-
     if (cloud->num_points_received == cloud->num_points_expected)
     {
         provizio_return_point_cloud(context, cloud);
@@ -367,8 +759,28 @@ int32_t provizio_handle_radar_point_cloud_packet_checked(provizio_radar_point_cl
     return 0;
 }
 
-int32_t provizio_handle_radar_point_cloud_packet(provizio_radar_point_cloud_api_context *context,
-                                                 provizio_radar_point_cloud_packet *packet, size_t packet_size)
+static int32_t provizio_handle_radar_point_cloud_packet_counted(provizio_radar_point_cloud_api_context *context,
+                                                                provizio_radar_point_cloud_packet *packet,
+                                                                uint64_t receive_time_ns)
+{
+    provizio_radar_point_cloud_stats *stats = context->impl.stats;
+    if (stats != NULL)
+    {
+        PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_packets_received, 1);
+    }
+
+    const int32_t status_code = provizio_handle_radar_point_cloud_packet_checked(context, packet, receive_time_ns);
+    if (stats != NULL && status_code == PROVIZIO_E_SKIPPED)
+    {
+        PROVIZIO__ATOMIC_ADD_UINT64(&stats->num_packets_skipped, 1);
+    }
+
+    return status_code;
+}
+
+static int32_t provizio_handle_radar_point_cloud_packet_impl(provizio_radar_point_cloud_api_context *context,
+                                                             provizio_radar_point_cloud_packet *packet,
+                                                             size_t packet_size, uint64_t receive_time_ns)
 {
     const int32_t check_status = provizio_check_radar_point_cloud_packet(packet, packet_size);
     if (check_status != 0)
@@ -376,7 +788,13 @@ int32_t provizio_handle_radar_point_cloud_packet(provizio_radar_point_cloud_api_
         return check_status;
     }
 
-    return provizio_handle_radar_point_cloud_packet_checked(context, packet);
+    return provizio_handle_radar_point_cloud_packet_counted(context, packet, receive_time_ns);
+}
+
+int32_t provizio_handle_radar_point_cloud_packet(provizio_radar_point_cloud_api_context *context,
+                                                 provizio_radar_point_cloud_packet *packet, size_t packet_size)
+{
+    return provizio_handle_radar_point_cloud_packet_impl(context, packet, packet_size, 0);
 }
 
 provizio_radar_point_cloud_api_context *provizio_get_radar_point_cloud_api_context_by_position_id(
@@ -385,35 +803,60 @@ provizio_radar_point_cloud_api_context *provizio_get_radar_point_cloud_api_conte
     const uint16_t radar_position_id = provizio_get_protocol_field_uint16_t(&packet->header.radar_position_id);
     assert(radar_position_id != provizio_radar_position_unknown);
 
-#pragma unroll(5)
-    for (size_t i = 0; i < num_contexts; ++i)
+    provizio_radar_api_contexts_dispatch_table *dispatch_table = num_contexts > 0 ? contexts[0].dispatch_table : NULL;
+    if (dispatch_table != NULL)
     {
-        if (contexts[i].radar_position_id == radar_position_id)
+        const size_t context_index_plus_one = dispatch_table->context_indices[radar_position_id];
+        if (context_index_plus_one != 0 && context_index_plus_one <= num_contexts)
         {
-            // Found the correct context
-            return &contexts[i];
+            // It's still correct unless the context has been since taken by another radar
+            provizio_radar_point_cloud_api_context *context = &contexts[context_index_plus_one - 1];
+            if (context->radar_position_id == radar_position_id ||
+                context->radar_position_id == provizio_radar_position_unknown)
+            {
+                return context;
+            }
         }
     }
 
-    // There is no context for this radar_position_id yet, let's look for a yet unused context
+    // Not dispatched yet, so look for a context for this radar_position_id or a yet unused context
+    size_t found_index = num_contexts;
 #pragma unroll(5)
     for (size_t i = 0; i < num_contexts; ++i)
     {
-        provizio_radar_point_cloud_api_context *context = &contexts[i];
-        if (context->radar_position_id == provizio_radar_position_unknown)
+        if (contexts[i].radar_position_id == radar_position_id)
+        {
+            // Found the correct context
+            found_index = i;
+            break;
+        }
+
+        if (found_index == num_contexts && contexts[i].radar_position_id == provizio_radar_position_unknown)
         {
-            // Found!
-            return context;
+            // The first yet unused context, to be used unless there is a context for this radar_position_id already
+            found_index = i;
         }
     }
 
-    // Not found
-    provizio_error("provizio_get_radar_point_cloud_api_context_by_position_id: Out of available contexts");
-    return NULL;
+    if (found_index == num_contexts)
+    {
+        // Not found
+        provizio_error("provizio_get_radar_point_cloud_api_context_by_position_id: Out of available contexts");
+        return NULL;
+    }
+
+    if (dispatch_table != NULL)
+    {
+        dispatch_table->context_indices[radar_position_id] = (uint16_t)(found_index + 1);
+    }
+
+    return &contexts[found_index];
 }
 
-int32_t provizio_handle_radars_point_cloud_packet(provizio_radar_point_cloud_api_context *contexts, size_t num_contexts,
-                                                  provizio_radar_point_cloud_packet *packet, size_t packet_size)
+static int32_t provizio_handle_radars_point_cloud_packet_impl(provizio_radar_point_cloud_api_context *contexts,
+                                                              size_t num_contexts,
+                                                              provizio_radar_point_cloud_packet *packet,
+                                                              size_t packet_size, uint64_t receive_time_ns)
 {
     const int32_t check_status = provizio_check_radar_point_cloud_packet(packet, packet_size);
     if (check_status != 0)
@@ -430,7 +873,13 @@ int32_t provizio_handle_radars_point_cloud_packet(provizio_radar_point_cloud_api
         return PROVIZIO_E_OUT_OF_CONTEXTS;
     }
 
-    return provizio_handle_radar_point_cloud_packet_checked(context, packet);
+    return provizio_handle_radar_point_cloud_packet_counted(context, packet, receive_time_ns);
+}
+
+int32_t provizio_handle_radars_point_cloud_packet(provizio_radar_point_cloud_api_context *contexts, size_t num_contexts,
+                                                  provizio_radar_point_cloud_packet *packet, size_t packet_size)
+{
+    return provizio_handle_radars_point_cloud_packet_impl(contexts, num_contexts, packet, packet_size, 0);
 }
 
 int32_t provizio_handle_possible_radar_point_cloud_packet(provizio_radar_point_cloud_api_context *context,
@@ -442,6 +891,14 @@ int32_t provizio_handle_possible_radar_point_cloud_packet(provizio_radar_point_c
 int32_t provizio_handle_possible_radars_point_cloud_packet(provizio_radar_point_cloud_api_context *contexts,
                                                            size_t num_contexts, const void *payload,
                                                            size_t payload_size)
+{
+    return provizio_handle_possible_radars_point_cloud_packet_received_at(contexts, num_contexts, payload, payload_size,
+                                                                         0);
+}
+
+int32_t provizio_handle_possible_radars_point_cloud_packet_received_at(
+    provizio_radar_point_cloud_api_context *contexts, size_t num_contexts, const void *payload, size_t payload_size,
+    uint64_t receive_time_ns)
 {
     if (payload_size < sizeof(provizio_radar_point_cloud_packet_header))
     {
@@ -464,9 +921,9 @@ int32_t provizio_handle_possible_radars_point_cloud_packet(provizio_radar_point_
         return PROVIZIO_E_PROTOCOL;
     }
 
-    return num_contexts != 1
-               ? provizio_handle_radars_point_cloud_packet(contexts, num_contexts,
-                                                           (provizio_radar_point_cloud_packet *)payload, payload_size)
-               : provizio_handle_radar_point_cloud_packet(contexts, (provizio_radar_point_cloud_packet *)payload,
-                                                          payload_size);
+    provizio_radar_point_cloud_packet *packet = (provizio_radar_point_cloud_packet *)payload;
+    return num_contexts != 1 ? provizio_handle_radars_point_cloud_packet_impl(contexts, num_contexts, packet,
+                                                                              payload_size, receive_time_ns)
+                             : provizio_handle_radar_point_cloud_packet_impl(contexts, packet, payload_size,
+                                                                             receive_time_ns);
 }
@@ -0,0 +1,308 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // Required for syscall
+#endif
+
+#include "provizio/radar_api/radar_point_cloud_queue.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "provizio/atomic.h"
+#include "provizio/radar_api/errno.h"
+#include "provizio/util.h"
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif // __linux__
+
+#define PROVIZIO__RADAR_POINT_CLOUD_QUEUE_COPY_FIELDS(TO, FROM)                                                        \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        (TO)->frame_index = (FROM)->frame_index;                                                                       \
+        (TO)->timestamp = (FROM)->timestamp;                                                                           \
+        (TO)->radar_position_id = (FROM)->radar_position_id;                                                           \
+        (TO)->num_points_expected = (FROM)->num_points_expected;                                                       \
+        (TO)->num_points_received = (FROM)->num_points_received;                                                       \
+        (TO)->radar_range = (FROM)->radar_range;                                                                       \
+        (TO)->first_packet_receive_time_ns = (FROM)->first_packet_receive_time_ns;                                     \
+        (TO)->last_packet_receive_time_ns = (FROM)->last_packet_receive_time_ns;                                       \
+    } while (0)
+
+int32_t provizio_radar_point_cloud_queue_init(provizio_radar_point_cloud *slots, size_t num_slots,
+                                              provizio_radar_point_cloud_queue *out_queue)
+{
+    memset(out_queue, 0, sizeof(provizio_radar_point_cloud_queue));
+
+    if (slots == NULL || num_slots == 0)
+    {
+        provizio_error("provizio_radar_point_cloud_queue_init: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    return provizio_spsc_queue_init(slots, sizeof(provizio_radar_point_cloud), num_slots, &out_queue->queue);
+}
+
+int32_t provizio_radar_point_cloud_queue_init_pooled(provizio_pooled_radar_point_cloud *slots,
+                                                     provizio_radar_point *points, size_t num_slots,
+                                                     uint16_t max_points_per_slot,
+                                                     provizio_radar_point_cloud_queue *out_queue)
+{
+    memset(out_queue, 0, sizeof(provizio_radar_point_cloud_queue));
+
+    if (slots == NULL || points == NULL || num_slots == 0 || max_points_per_slot == 0)
+    {
+        provizio_error("provizio_radar_point_cloud_queue_init_pooled: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    const int32_t status_code =
+        provizio_spsc_queue_init(slots, sizeof(provizio_pooled_radar_point_cloud), num_slots, &out_queue->queue);
+    if (status_code != 0)
+    {
+        return status_code;
+    }
+
+    // Slots keep their points for good, publishing only sets them
+    memset(slots, 0, sizeof(provizio_pooled_radar_point_cloud) * num_slots);
+    for (size_t i = 0; i < num_slots; ++i)
+    {
+        slots[i].radar_points = &points[i * max_points_per_slot];
+    }
+    out_queue->points = points;
+    out_queue->max_points_per_slot = max_points_per_slot;
+
+    return 0;
+}
+
+// Copies num_points points of a pooled point cloud's radar_points or radar_points_soa, starting from first_point
+static void provizio_radar_point_cloud_queue_copy_points(const provizio_pooled_radar_point_cloud *point_cloud,
+                                                         size_t first_point, size_t num_points,
+                                                         provizio_radar_point *out_points)
+{
+    if (point_cloud->radar_points != NULL)
+    {
+        memcpy(out_points, &point_cloud->radar_points[first_point], sizeof(provizio_radar_point) * num_points);
+        return;
+    }
+
+    const provizio_radar_points_soa *soa = &point_cloud->radar_points_soa;
+    for (size_t i = 0; i < num_points; ++i)
+    {
+        const size_t point_index = first_point + i;
+        provizio_radar_point *point = &out_points[i];
+        point->x_meters = soa->x_meters[point_index];
+        point->y_meters = soa->y_meters[point_index];
+        point->z_meters = soa->z_meters[point_index];
+        point->radar_relative_radial_velocity_m_s = soa->radar_relative_radial_velocity_m_s[point_index];
+        point->signal_to_noise_ratio = soa->signal_to_noise_ratio[point_index];
+        point->ground_relative_radial_velocity_m_s = soa->ground_relative_radial_velocity_m_s[point_index];
+    }
+}
+
+// Copies the num_points_received points of a pooled point cloud, whatever its layout and mode are
+static void provizio_radar_point_cloud_queue_copy_pooled_points(const provizio_pooled_radar_point_cloud *point_cloud,
+                                                                provizio_radar_point *out_points)
+{
+    size_t num_points = 0;
+    if (point_cloud->spans != NULL)
+    {
+        // Zero-copy mode
+        for (size_t i = 0; i < point_cloud->num_spans; ++i)
+        {
+            const provizio_radar_point_span *span = &point_cloud->spans[i];
+            memcpy(&out_points[num_points], span->radar_points, sizeof(provizio_radar_point) * span->num_points);
+            num_points += span->num_points;
+        }
+    }
+    else if (point_cloud->received_chunks != NULL)
+    {
+        // Ordered reassembly: points of the chunks received only
+        const size_t chunk_size = PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+        for (size_t first_point = 0; first_point < point_cloud->num_points_expected; first_point += chunk_size)
+        {
+            const size_t chunk_index = first_point / chunk_size;
+            if ((point_cloud->received_chunks[chunk_index / 32] & (1U << (chunk_index % 32))) != 0) // NOLINT
+            {
+                const size_t num_chunk_points = point_cloud->num_points_expected - first_point < chunk_size
+                                                    ? point_cloud->num_points_expected - first_point
+                                                    : chunk_size;
+                provizio_radar_point_cloud_queue_copy_points(point_cloud, first_point, num_chunk_points,
+                                                             &out_points[num_points]);
+                num_points += num_chunk_points;
+            }
+        }
+    }
+    else
+    {
+        provizio_radar_point_cloud_queue_copy_points(point_cloud, 0, point_cloud->num_points_received, out_points);
+    }
+}
+
+// Publishes a point cloud to the queue (a classic point cloud is passed as a pooled one with the same radar_points)
+static void provizio_radar_point_cloud_queue_push(provizio_radar_point_cloud_queue *queue,
+                                                  const provizio_pooled_radar_point_cloud *point_cloud)
+{
+    void *slot = provizio_spsc_queue_back(&queue->queue);
+    if (slot == NULL)
+    {
+        PROVIZIO__ATOMIC_ADD_UINT32(&queue->num_dropped_point_clouds, 1);
+        provizio_warning("provizio_radar_point_cloud_queue_publish: The queue is full, dropping the point cloud");
+        return;
+    }
+
+    // Copying the points received only, as the rest of a 1.5MB point cloud is of no use
+    provizio_radar_point *points = NULL;
+    if (queue->points != NULL)
+    {
+        if (point_cloud->num_points_received > queue->max_points_per_slot)
+        {
+            PROVIZIO__ATOMIC_ADD_UINT32(&queue->num_dropped_point_clouds, 1);
+            provizio_warning("provizio_radar_point_cloud_queue_publish: Too many points, dropping the point cloud");
+            return;
+        }
+
+        provizio_pooled_radar_point_cloud *pooled_slot = (provizio_pooled_radar_point_cloud *)slot;
+        PROVIZIO__RADAR_POINT_CLOUD_QUEUE_COPY_FIELDS(pooled_slot, point_cloud);
+        points = pooled_slot->radar_points;
+    }
+    else
+    {
+        provizio_radar_point_cloud *classic_slot = (provizio_radar_point_cloud *)slot;
+        PROVIZIO__RADAR_POINT_CLOUD_QUEUE_COPY_FIELDS(classic_slot, point_cloud);
+        points = classic_slot->radar_points;
+    }
+    provizio_radar_point_cloud_queue_copy_pooled_points(point_cloud, points);
+    provizio_spsc_queue_push(&queue->queue);
+
+#ifdef __linux__
+    // Sequentially consistent, so that either the waiting consumer is seen here, or it sees the new num_published
+    __atomic_fetch_add(&queue->num_published, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queue->consumer_waiting, __ATOMIC_SEQ_CST) != 0)
+    {
+        (void)syscall(SYS_futex, &queue->num_published, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+#endif // __linux__
+}
+
+void provizio_radar_point_cloud_queue_publish(const provizio_radar_point_cloud *point_cloud,
+                                              provizio_radar_point_cloud_api_context *context)
+{
+    provizio_pooled_radar_point_cloud pooled_point_cloud;
+    memset(&pooled_point_cloud, 0, sizeof(pooled_point_cloud));
+    PROVIZIO__RADAR_POINT_CLOUD_QUEUE_COPY_FIELDS(&pooled_point_cloud, point_cloud);
+    pooled_point_cloud.radar_points = (provizio_radar_point *)point_cloud->radar_points;
+
+    provizio_radar_point_cloud_queue_push((provizio_radar_point_cloud_queue *)context->user_data, &pooled_point_cloud);
+}
+
+void provizio_pooled_radar_point_cloud_queue_publish(const provizio_pooled_radar_point_cloud *point_cloud,
+                                                     provizio_pooled_radar_point_cloud_api_context *context)
+{
+    provizio_radar_point_cloud_queue_push((provizio_radar_point_cloud_queue *)context->user_data, point_cloud);
+}
+
+void provizio_radar_point_cloud_api_context_init_queued(provizio_radar_point_cloud_queue *queue,
+                                                        provizio_radar_point_cloud_api_context *context)
+{
+    provizio_radar_point_cloud_api_context_init(&provizio_radar_point_cloud_queue_publish, queue, context);
+}
+
+void provizio_radar_point_cloud_api_contexts_init_queued(provizio_radar_point_cloud_queue *queue,
+                                                         provizio_radar_point_cloud_api_context *contexts,
+                                                         size_t num_contexts)
+{
+    provizio_radar_point_cloud_api_contexts_init(&provizio_radar_point_cloud_queue_publish, queue, contexts,
+                                                 num_contexts);
+}
+
+const provizio_radar_point_cloud *provizio_radar_point_cloud_queue_try_pop(provizio_radar_point_cloud_queue *queue)
+{
+    return (const provizio_radar_point_cloud *)provizio_spsc_queue_front(&queue->queue);
+}
+
+const provizio_pooled_radar_point_cloud *
+provizio_radar_point_cloud_queue_try_pop_pooled(provizio_radar_point_cloud_queue *queue)
+{
+    return (const provizio_pooled_radar_point_cloud *)provizio_spsc_queue_front(&queue->queue);
+}
+
+// Returns the slot of the oldest point cloud in the queue, waiting for up to timeout_ns for one to be published if the
+// queue is empty, or NULL if timed out
+static const void *provizio_radar_point_cloud_queue_wait(provizio_radar_point_cloud_queue *queue, uint64_t timeout_ns)
+{
+    const void *slot = provizio_spsc_queue_front(&queue->queue);
+    if (slot != NULL)
+    {
+        return slot;
+    }
+
+    // A monotonic clock, as system time adjustments must not make it wait longer (or shorter) than timeout_ns
+    const uint64_t start_time_ns = provizio_monotonic_time_ns();
+#ifdef __linux__
+    const uint64_t nanoseconds_in_second = 1000000000ULL;
+    __atomic_store_n(&queue->consumer_waiting, 1, __ATOMIC_SEQ_CST);
+    for (;;)
+    {
+        // Read before checking the queue, so that the futex doesn't wait if anything gets published in between
+        const uint32_t num_published = __atomic_load_n(&queue->num_published, __ATOMIC_SEQ_CST);
+        slot = provizio_spsc_queue_front(&queue->queue);
+        const uint64_t waited_ns = provizio_monotonic_time_ns() - start_time_ns;
+        if (slot != NULL || waited_ns >= timeout_ns)
+        {
+            break;
+        }
+
+        const uint64_t remaining_ns = timeout_ns - waited_ns;
+        struct timespec timeout;
+        timeout.tv_sec = (time_t)(remaining_ns / nanoseconds_in_second);
+        timeout.tv_nsec = (long)(remaining_ns % nanoseconds_in_second);
+        (void)syscall(SYS_futex, &queue->num_published, FUTEX_WAIT_PRIVATE, num_published, &timeout, NULL, 0);
+    }
+    __atomic_store_n(&queue->consumer_waiting, 0, __ATOMIC_SEQ_CST);
+#else
+    do
+    {
+        provizio_sleep_ns(PROVIZIO__RADAR_POINT_CLOUD_QUEUE_POLL_INTERVAL_NS);
+        slot = provizio_spsc_queue_front(&queue->queue);
+    } while (slot == NULL && provizio_monotonic_time_ns() - start_time_ns < timeout_ns);
+#endif // __linux__
+
+    return slot;
+}
+
+int32_t provizio_radar_point_cloud_queue_pop(provizio_radar_point_cloud_queue *queue, uint64_t timeout_ns,
+                                             const provizio_radar_point_cloud **out_point_cloud)
+{
+    *out_point_cloud = (const provizio_radar_point_cloud *)provizio_radar_point_cloud_queue_wait(queue, timeout_ns);
+    return *out_point_cloud != NULL ? 0 : PROVIZIO_E_TIMEOUT;
+}
+
+int32_t provizio_radar_point_cloud_queue_pop_pooled(provizio_radar_point_cloud_queue *queue, uint64_t timeout_ns,
+                                                    const provizio_pooled_radar_point_cloud **out_point_cloud)
+{
+    *out_point_cloud =
+        (const provizio_pooled_radar_point_cloud *)provizio_radar_point_cloud_queue_wait(queue, timeout_ns);
+    return *out_point_cloud != NULL ? 0 : PROVIZIO_E_TIMEOUT;
+}
+
+void provizio_radar_point_cloud_queue_release(provizio_radar_point_cloud_queue *queue)
+{
+    provizio_spsc_queue_pop(&queue->queue);
+}
@@ -18,6 +18,9 @@
 #include <linmath.h>
 #include <string.h>
 
+#include "provizio/atomic.h"
+#include "provizio/simd.h"
+
 enum
 {
     provizio_transformation_matrix_components = 4 * 4
@@ -71,12 +74,12 @@ static void provizio_transform_radar_point(const provizio_radar_point *point, co
     out_transformed_point->signal_to_noise_ratio = point->signal_to_noise_ratio;
 }
 
-static void provizio_build_transformation_matrix(const provizio_enu_fix *fix_when_received,
-                                                 const provizio_enu_fix *current_fix, float *out_matrix)
+void provizio_build_transformation_matrix(const provizio_enu_fix *fix_when_received,
+                                          const provizio_enu_fix *current_fix, float *out_transformation_matrix)
 {
     assert(fix_when_received != NULL);
     assert(current_fix != NULL);
-    assert(out_matrix != NULL);
+    assert(out_transformation_matrix != NULL);
     assert(provizio_quaternion_is_valid_rotation(&fix_when_received->orientation));
     assert(provizio_quaternion_is_valid_rotation(&current_fix->orientation));
 
@@ -107,7 +110,260 @@ static void provizio_build_transformation_matrix(const provizio_enu_fix *fix_whe
     mat4x4_from_quat(operation_mat4x4, point_to_enu_quat);
     mat4x4_mul(out_mat4x4, out_mat4x4, operation_mat4x4);
 
-    memcpy(out_matrix, out_mat4x4, sizeof(out_mat4x4));
+    memcpy(out_transformation_matrix, out_mat4x4, sizeof(out_mat4x4));
+}
+
+typedef void (*provizio_transform_radar_points_function)(const float *transformation_matrix,
+                                                         const provizio_radar_point *points, size_t num_points,
+                                                         provizio_radar_point *out_points);
+
+static void provizio_set_transformed_radar_point(const provizio_radar_point *point, const float *transformed_position,
+                                                 provizio_radar_point *out_transformed_point)
+{
+    // point and out_transformed_point may be the same point, so copy the rest first
+    if (out_transformed_point != point)
+    {
+        memcpy(out_transformed_point, point, sizeof(provizio_radar_point));
+    }
+
+    out_transformed_point->x_meters = transformed_position[0];
+    out_transformed_point->y_meters = transformed_position[1];
+    out_transformed_point->z_meters = transformed_position[2];
+}
+
+static void provizio_transform_radar_points_scalar(const float *transformation_matrix,
+                                                   const provizio_radar_point *points, size_t num_points,
+                                                   provizio_radar_point *out_points)
+{
+    const float *m = transformation_matrix; // Column major
+    for (size_t i = 0; i < num_points; ++i)
+    {
+        const float x = points[i].x_meters;
+        const float y = points[i].y_meters;
+        const float z = points[i].z_meters;
+        const float transformed_position[3] = {
+            m[0] * x + m[4] * y + m[8] * z + m[12],  // NOLINT
+            m[1] * x + m[5] * y + m[9] * z + m[13],  // NOLINT
+            m[2] * x + m[6] * y + m[10] * z + m[14]  // NOLINT
+        };
+        provizio_set_transformed_radar_point(&points[i], transformed_position, &out_points[i]);
+    }
+}
+
+#if defined(PROVIZIO__SIMD_X86)
+// Batch kernels transform several points at a time: x, y and z of 4 points (in a 128 bits lane) are deinterleaved out
+// of 6 vectors of 4 floats each (the points are 6 floats each), transformed and interleaved back, while the rest of the
+// fields are kept as is, so that only whole vectors are loaded and stored
+PROVIZIO__SIMD_TARGET("sse") static void provizio_transform_radar_points_sse(const float *transformation_matrix,
+                                                                             const provizio_radar_point *points,
+                                                                             size_t num_points,
+                                                                             provizio_radar_point *out_points)
+{
+    const float *m = transformation_matrix; // Column major
+    const __m128 m_0 = _mm_set1_ps(m[0]);
+    const __m128 m_1 = _mm_set1_ps(m[1]);
+    const __m128 m_2 = _mm_set1_ps(m[2]);
+    const __m128 m_4 = _mm_set1_ps(m[4]);   // NOLINT
+    const __m128 m_5 = _mm_set1_ps(m[5]);   // NOLINT
+    const __m128 m_6 = _mm_set1_ps(m[6]);   // NOLINT
+    const __m128 m_8 = _mm_set1_ps(m[8]);   // NOLINT
+    const __m128 m_9 = _mm_set1_ps(m[9]);   // NOLINT
+    const __m128 m_10 = _mm_set1_ps(m[10]); // NOLINT
+    const __m128 m_12 = _mm_set1_ps(m[12]); // NOLINT
+    const __m128 m_13 = _mm_set1_ps(m[13]); // NOLINT
+    const __m128 m_14 = _mm_set1_ps(m[14]); // NOLINT
+
+    size_t i = 0;
+    for (; i + 4 <= num_points; i += 4)
+    {
+        // r_0 = x0 y0 z0 v0, r_1 = s0 g0 x1 y1, r_2 = z1 v1 s1 g1, r_3..r_5 = the same for points 2 and 3
+        const float *in = &points[i].x_meters;
+        const __m128 r_0 = _mm_loadu_ps(&in[0]);
+        const __m128 r_1 = _mm_loadu_ps(&in[4]);  // NOLINT
+        const __m128 r_2 = _mm_loadu_ps(&in[8]);  // NOLINT
+        const __m128 r_3 = _mm_loadu_ps(&in[12]); // NOLINT
+        const __m128 r_4 = _mm_loadu_ps(&in[16]); // NOLINT
+        const __m128 r_5 = _mm_loadu_ps(&in[20]); // NOLINT
+
+        const __m128 xy_01 = _mm_shuffle_ps(r_0, r_1, _MM_SHUFFLE(3, 2, 1, 0)); // x0 y0 x1 y1
+        const __m128 xy_23 = _mm_shuffle_ps(r_3, r_4, _MM_SHUFFLE(3, 2, 1, 0)); // x2 y2 x3 y3
+        const __m128 x = _mm_shuffle_ps(xy_01, xy_23, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 y = _mm_shuffle_ps(xy_01, xy_23, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(r_0, r_2, _MM_SHUFFLE(0, 0, 2, 2)),
+                                        _mm_shuffle_ps(r_3, r_5, _MM_SHUFFLE(0, 0, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+
+        const __m128 t_x =
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m_0, x), _mm_mul_ps(m_4, y)), _mm_mul_ps(m_8, z)), m_12);
+        const __m128 t_y =
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m_1, x), _mm_mul_ps(m_5, y)), _mm_mul_ps(m_9, z)), m_13);
+        const __m128 t_z =
+            _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m_2, x), _mm_mul_ps(m_6, y)), _mm_mul_ps(m_10, z)), m_14);
+
+        const __m128 t_xy_01 = _mm_unpacklo_ps(t_x, t_y); // tx0 ty0 tx1 ty1
+        const __m128 t_xy_23 = _mm_unpackhi_ps(t_x, t_y); // tx2 ty2 tx3 ty3
+        float *out = &out_points[i].x_meters;
+        _mm_storeu_ps(&out[0], _mm_shuffle_ps(t_xy_01, _mm_shuffle_ps(t_z, r_0, _MM_SHUFFLE(3, 3, 0, 0)),
+                                              _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(&out[4], _mm_shuffle_ps(r_1, t_xy_01, _MM_SHUFFLE(3, 2, 1, 0))); // NOLINT
+        _mm_storeu_ps(&out[8], _mm_shuffle_ps(_mm_shuffle_ps(t_z, r_2, _MM_SHUFFLE(1, 1, 1, 1)), r_2, // NOLINT
+                                              _MM_SHUFFLE(3, 2, 2, 0)));
+        _mm_storeu_ps(&out[12], _mm_shuffle_ps(t_xy_23, _mm_shuffle_ps(t_z, r_3, _MM_SHUFFLE(3, 3, 2, 2)), // NOLINT
+                                               _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(&out[16], _mm_shuffle_ps(r_4, t_xy_23, _MM_SHUFFLE(3, 2, 1, 0))); // NOLINT
+        _mm_storeu_ps(&out[20], _mm_shuffle_ps(_mm_shuffle_ps(t_z, r_5, _MM_SHUFFLE(1, 1, 3, 3)), r_5, // NOLINT
+                                               _MM_SHUFFLE(3, 2, 2, 0)));
+    }
+
+    provizio_transform_radar_points_scalar(transformation_matrix, &points[i], num_points - i, &out_points[i]);
+}
+
+PROVIZIO__SIMD_TARGET("avx") static void provizio_transform_radar_points_avx(const float *transformation_matrix,
+                                                                             const provizio_radar_point *points,
+                                                                             size_t num_points,
+                                                                             provizio_radar_point *out_points)
+{
+    // Same as provizio_transform_radar_points_sse, but 8 points at a time: points 0..3 in the lower lanes and points
+    // 4..7 in the upper ones
+    const float *m = transformation_matrix; // Column major
+    const __m256 m_0 = _mm256_set1_ps(m[0]);
+    const __m256 m_1 = _mm256_set1_ps(m[1]);
+    const __m256 m_2 = _mm256_set1_ps(m[2]);
+    const __m256 m_4 = _mm256_set1_ps(m[4]);   // NOLINT
+    const __m256 m_5 = _mm256_set1_ps(m[5]);   // NOLINT
+    const __m256 m_6 = _mm256_set1_ps(m[6]);   // NOLINT
+    const __m256 m_8 = _mm256_set1_ps(m[8]);   // NOLINT
+    const __m256 m_9 = _mm256_set1_ps(m[9]);   // NOLINT
+    const __m256 m_10 = _mm256_set1_ps(m[10]); // NOLINT
+    const __m256 m_12 = _mm256_set1_ps(m[12]); // NOLINT
+    const __m256 m_13 = _mm256_set1_ps(m[13]); // NOLINT
+    const __m256 m_14 = _mm256_set1_ps(m[14]); // NOLINT
+
+    size_t i = 0;
+    for (; i + 8 <= num_points; i += 8) // NOLINT
+    {
+        // Whole 256 bits loads, regrouped so that r_k holds vector k (see provizio_transform_radar_points_sse) of
+        // points 0..3 and of points 4..7
+        const float *in = &points[i].x_meters;
+        const __m256 l_0 = _mm256_loadu_ps(&in[0]);
+        const __m256 l_1 = _mm256_loadu_ps(&in[8]);  // NOLINT
+        const __m256 l_2 = _mm256_loadu_ps(&in[16]); // NOLINT
+        const __m256 l_3 = _mm256_loadu_ps(&in[24]); // NOLINT
+        const __m256 l_4 = _mm256_loadu_ps(&in[32]); // NOLINT
+        const __m256 l_5 = _mm256_loadu_ps(&in[40]); // NOLINT
+        const __m256 r_0 = _mm256_permute2f128_ps(l_0, l_3, 0x20); // NOLINT
+        const __m256 r_1 = _mm256_permute2f128_ps(l_0, l_3, 0x31); // NOLINT
+        const __m256 r_2 = _mm256_permute2f128_ps(l_1, l_4, 0x20); // NOLINT
+        const __m256 r_3 = _mm256_permute2f128_ps(l_1, l_4, 0x31); // NOLINT
+        const __m256 r_4 = _mm256_permute2f128_ps(l_2, l_5, 0x20); // NOLINT
+        const __m256 r_5 = _mm256_permute2f128_ps(l_2, l_5, 0x31); // NOLINT
+
+        const __m256 xy_01 = _mm256_shuffle_ps(r_0, r_1, _MM_SHUFFLE(3, 2, 1, 0));
+        const __m256 xy_23 = _mm256_shuffle_ps(r_3, r_4, _MM_SHUFFLE(3, 2, 1, 0));
+        const __m256 x = _mm256_shuffle_ps(xy_01, xy_23, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 y = _mm256_shuffle_ps(xy_01, xy_23, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m256 z = _mm256_shuffle_ps(_mm256_shuffle_ps(r_0, r_2, _MM_SHUFFLE(0, 0, 2, 2)),
+                                           _mm256_shuffle_ps(r_3, r_5, _MM_SHUFFLE(0, 0, 2, 2)),
+                                           _MM_SHUFFLE(2, 0, 2, 0));
+
+        const __m256 t_x = _mm256_add_ps(
+            _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m_0, x), _mm256_mul_ps(m_4, y)), _mm256_mul_ps(m_8, z)), m_12);
+        const __m256 t_y = _mm256_add_ps(
+            _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m_1, x), _mm256_mul_ps(m_5, y)), _mm256_mul_ps(m_9, z)), m_13);
+        const __m256 t_z = _mm256_add_ps(
+            _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m_2, x), _mm256_mul_ps(m_6, y)), _mm256_mul_ps(m_10, z)), m_14);
+
+        const __m256 t_xy_01 = _mm256_unpacklo_ps(t_x, t_y);
+        const __m256 t_xy_23 = _mm256_unpackhi_ps(t_x, t_y);
+        const __m256 o_0 = _mm256_shuffle_ps(t_xy_01, _mm256_shuffle_ps(t_z, r_0, _MM_SHUFFLE(3, 3, 0, 0)),
+                                             _MM_SHUFFLE(2, 0, 1, 0));
+        const __m256 o_1 = _mm256_shuffle_ps(r_1, t_xy_01, _MM_SHUFFLE(3, 2, 1, 0));
+        const __m256 o_2 = _mm256_shuffle_ps(_mm256_shuffle_ps(t_z, r_2, _MM_SHUFFLE(1, 1, 1, 1)), r_2,
+                                             _MM_SHUFFLE(3, 2, 2, 0));
+        const __m256 o_3 = _mm256_shuffle_ps(t_xy_23, _mm256_shuffle_ps(t_z, r_3, _MM_SHUFFLE(3, 3, 2, 2)),
+                                             _MM_SHUFFLE(2, 0, 1, 0));
+        const __m256 o_4 = _mm256_shuffle_ps(r_4, t_xy_23, _MM_SHUFFLE(3, 2, 1, 0));
+        const __m256 o_5 = _mm256_shuffle_ps(_mm256_shuffle_ps(t_z, r_5, _MM_SHUFFLE(1, 1, 3, 3)), r_5,
+                                             _MM_SHUFFLE(3, 2, 2, 0));
+
+        float *out = &out_points[i].x_meters;
+        _mm256_storeu_ps(&out[0], _mm256_permute2f128_ps(o_0, o_1, 0x20));  // NOLINT
+        _mm256_storeu_ps(&out[8], _mm256_permute2f128_ps(o_2, o_3, 0x20));  // NOLINT
+        _mm256_storeu_ps(&out[16], _mm256_permute2f128_ps(o_4, o_5, 0x20)); // NOLINT
+        _mm256_storeu_ps(&out[24], _mm256_permute2f128_ps(o_0, o_1, 0x31)); // NOLINT
+        _mm256_storeu_ps(&out[32], _mm256_permute2f128_ps(o_2, o_3, 0x31)); // NOLINT
+        _mm256_storeu_ps(&out[40], _mm256_permute2f128_ps(o_4, o_5, 0x31)); // NOLINT
+    }
+
+    provizio_transform_radar_points_sse(transformation_matrix, &points[i], num_points - i, &out_points[i]);
+}
+#elif defined(PROVIZIO__SIMD_NEON)
+static void provizio_transform_radar_points_neon(const float *transformation_matrix,
+                                                 const provizio_radar_point *points, size_t num_points,
+                                                 provizio_radar_point *out_points)
+{
+    // 4 points at a time: vld3q_f32 splits 2 points (6 floats each) into x0 v0 x1 v1, y0 s0 y1 s1 and z0 g0 z1 g1, so
+    // x, y and z of 4 points are unzipped out of 2 such loads, transformed and zipped back, while the rest of the
+    // fields are kept as is
+    const float *m = transformation_matrix; // Column major
+    const float32x4_t m_12 = vdupq_n_f32(m[12]); // NOLINT
+    const float32x4_t m_13 = vdupq_n_f32(m[13]); // NOLINT
+    const float32x4_t m_14 = vdupq_n_f32(m[14]); // NOLINT
+
+    size_t i = 0;
+    for (; i + 4 <= num_points; i += 4)
+    {
+        const float *in = &points[i].x_meters;
+        float32x4x3_t points_01 = vld3q_f32(&in[0]);
+        float32x4x3_t points_23 = vld3q_f32(&in[12]); // NOLINT
+        const float32x4x2_t x_v = vuzpq_f32(points_01.val[0], points_23.val[0]);
+        const float32x4x2_t y_s = vuzpq_f32(points_01.val[1], points_23.val[1]);
+        const float32x4x2_t z_g = vuzpq_f32(points_01.val[2], points_23.val[2]);
+        const float32x4_t x = x_v.val[0];
+        const float32x4_t y = y_s.val[0];
+        const float32x4_t z = z_g.val[0];
+
+        const float32x4_t t_x = vaddq_f32(
+            vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[0]), vmulq_n_f32(y, m[4])), vmulq_n_f32(z, m[8])), m_12); // NOLINT
+        const float32x4_t t_y = vaddq_f32(
+            vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[1]), vmulq_n_f32(y, m[5])), vmulq_n_f32(z, m[9])), m_13); // NOLINT
+        const float32x4_t t_z = vaddq_f32(
+            vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[2]), vmulq_n_f32(y, m[6])), vmulq_n_f32(z, m[10])), m_14); // NOLINT
+
+        const float32x4x2_t t_x_v = vzipq_f32(t_x, x_v.val[1]);
+        const float32x4x2_t t_y_s = vzipq_f32(t_y, y_s.val[1]);
+        const float32x4x2_t t_z_g = vzipq_f32(t_z, z_g.val[1]);
+        points_01.val[0] = t_x_v.val[0];
+        points_01.val[1] = t_y_s.val[0];
+        points_01.val[2] = t_z_g.val[0];
+        points_23.val[0] = t_x_v.val[1];
+        points_23.val[1] = t_y_s.val[1];
+        points_23.val[2] = t_z_g.val[1];
+
+        float *out = &out_points[i].x_meters;
+        vst3q_f32(&out[0], points_01);
+        vst3q_f32(&out[12], points_23); // NOLINT
+    }
+
+    provizio_transform_radar_points_scalar(transformation_matrix, &points[i], num_points - i, &out_points[i]);
+}
+#endif
+
+static provizio_transform_radar_points_function provizio_select_transform_radar_points(void)
+{
+#if defined(PROVIZIO__SIMD_X86)
+    if (PROVIZIO__SIMD_CPU_SUPPORTS("avx"))
+    {
+        return &provizio_transform_radar_points_avx;
+    }
+    if (PROVIZIO__SIMD_CPU_SUPPORTS("sse"))
+    {
+        return &provizio_transform_radar_points_sse;
+    }
+#elif defined(PROVIZIO__SIMD_NEON)
+    return &provizio_transform_radar_points_neon;
+#endif
+
+    return &provizio_transform_radar_points_scalar; // LCOV_EXCL_LINE: host CPU arch dependent
 }
 
 static void provizio_transform_radar_point_cloud(const provizio_radar_point_cloud *point_cloud,
@@ -120,13 +376,26 @@ static void provizio_transform_radar_point_cloud(const provizio_radar_point_clou
 
     assert(point_cloud->num_points_received <= point_cloud->num_points_expected);
 
-    provizio_radar_point *dest_point = out_transformed_point_cloud->radar_points;
-    for (const provizio_radar_point *source_point = point_cloud->radar_points,
-                                    *source_end = point_cloud->radar_points + point_cloud->num_points_received;
-         source_point != source_end; ++source_point, ++dest_point)
+    float transformation_matrix[provizio_transformation_matrix_components];
+    provizio_build_transformation_matrix(fix_when_received, current_fix, transformation_matrix);
+    provizio_transform_radar_points(transformation_matrix, point_cloud->radar_points, point_cloud->num_points_received,
+                                    out_transformed_point_cloud->radar_points);
+}
+
+void provizio_transform_radar_points(const float *transformation_matrix, const provizio_radar_point *points,
+                                     size_t num_points, provizio_radar_point *out_points)
+{
+    // Selected on the first call, atomically as receivers may accumulate point clouds in several threads
+    static provizio_transform_radar_points_function selected_transform_radar_points = NULL;
+    provizio_transform_radar_points_function transform_radar_points =
+        (provizio_transform_radar_points_function)PROVIZIO__ATOMIC_LOAD_POINTER(&selected_transform_radar_points);
+    if (transform_radar_points == NULL)
     {
-        provizio_transform_radar_point(source_point, fix_when_received, current_fix, dest_point);
+        transform_radar_points = provizio_select_transform_radar_points();
+        PROVIZIO__ATOMIC_STORE_POINTER(&selected_transform_radar_points, transform_radar_points);
     }
+
+    transform_radar_points(transformation_matrix, points, num_points, out_points);
 }
 
 void provizio_accumulated_radar_point_clouds_init(provizio_accumulated_radar_point_cloud *accumulated_point_clouds,
@@ -224,15 +493,18 @@ provizio_accumulated_radar_point_cloud_iterator provizio_accumulate_radar_point_
     }
     provizio_accumulated_radar_point_cloud *accumulated_cloud = &accumulated_point_clouds[iterator.point_cloud_index];
 
-    // Copy the "header" part of things first
+    // Copy the "header" part of things and the fix first, so the filter sees the new point cloud rather than the one
+    // it replaces (if any)
     memcpy(&accumulated_cloud->point_cloud, point_cloud,
            sizeof(provizio_radar_point_cloud) - offsetof(provizio_radar_point_cloud, radar_points));
+    memcpy(&accumulated_cloud->fix_when_received, fix_when_received, sizeof(provizio_enu_fix));
     // Copy the points applying the specified filter
-    accumulated_cloud->point_cloud.num_points_received = 0;
+    uint16_t num_points_accumulated = 0;
     (filter != NULL ? filter : &provizio_radar_points_accumulation_filter_copy_all)(
         &point_cloud->radar_points[0], point_cloud->num_points_received, accumulated_point_clouds,
         num_accumulated_point_clouds, &iterator, filter_user_data, &accumulated_cloud->point_cloud.radar_points[0],
-        &accumulated_cloud->point_cloud.num_points_received);
+        &num_points_accumulated);
+    accumulated_cloud->point_cloud.num_points_received = num_points_accumulated;
     if (accumulated_cloud->point_cloud.num_points_received == 0)
     {
         provizio_warning("provizio_accumulate_radar_point_cloud: filter removed all points, which is not supported, so "
@@ -245,7 +517,6 @@ provizio_accumulated_radar_point_cloud_iterator provizio_accumulate_radar_point_
     assert(accumulated_cloud->point_cloud.num_points_expected <= PROVIZIO__MAX_RADAR_POINTS_IN_POINT_CLOUD);
     assert(accumulated_cloud->point_cloud.num_points_received <= accumulated_cloud->point_cloud.num_points_expected);
 
-    memcpy(&accumulated_cloud->fix_when_received, fix_when_received, sizeof(provizio_enu_fix));
     assert(provizio_accumulated_radar_point_cloud_valid(accumulated_cloud));
 
     return iterator;
@@ -459,3 +730,41 @@ const provizio_radar_point *provizio_accumulated_radar_point_cloud_iterator_get_
 
     return point;
 }
+
+size_t provizio_transform_accumulated_radar_points(
+    const provizio_accumulated_radar_point_cloud_iterator *iterator, const provizio_enu_fix *current_fix,
+    const provizio_accumulated_radar_point_cloud *accumulated_point_clouds, size_t num_accumulated_point_clouds,
+    provizio_radar_point *out_transformed_points, size_t max_points)
+{
+    if (!provizio_quaternion_is_valid_rotation(&current_fix->orientation))
+    {
+        provizio_error("provizio_transform_accumulated_radar_points: current_fix->orientation is not a valid rotation");
+        return 0;
+    }
+
+    size_t num_points = 0;
+    float transformation_matrix[provizio_transformation_matrix_components];
+    provizio_accumulated_radar_point_cloud_iterator cloud_iterator = *iterator;
+    cloud_iterator.point_index = 0;
+    while (num_points < max_points && !provizio_accumulated_radar_point_cloud_iterator_is_end(
+                                          &cloud_iterator, accumulated_point_clouds, num_accumulated_point_clouds))
+    {
+        const provizio_accumulated_radar_point_cloud *accumulated_cloud =
+            &accumulated_point_clouds[cloud_iterator.point_cloud_index];
+        const size_t points_left = max_points - num_points;
+        const size_t num_cloud_points = accumulated_cloud->point_cloud.num_points_received < points_left
+                                            ? accumulated_cloud->point_cloud.num_points_received
+                                            : points_left;
+
+        provizio_build_transformation_matrix(&accumulated_cloud->fix_when_received, current_fix,
+                                             transformation_matrix);
+        provizio_transform_radar_points(transformation_matrix, accumulated_cloud->point_cloud.radar_points,
+                                        num_cloud_points, &out_transformed_points[num_points]);
+        num_points += num_cloud_points;
+
+        provizio_accumulated_radar_point_cloud_iterator_next_point_cloud(&cloud_iterator, accumulated_point_clouds,
+                                                                         num_accumulated_point_clouds);
+    }
+
+    return num_points;
+}
@@ -0,0 +1,355 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/radar_api/radar_simulator.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#include "provizio/atomic.h"
+#include "provizio/radar_api/core.h"
+#include "provizio/util.h"
+
+#define PROVIZIO__RADAR_SIMULATOR_DEFAULT_SEED ((uint32_t)0x2545f491)
+
+// Seconds between the Unix Epoch and the GPS Epoch, and the leap seconds GPS time is currently ahead of UTC by
+#define PROVIZIO__RADAR_SIMULATOR_GPS_EPOCH_OFFSET_S 315964800ULL
+#define PROVIZIO__RADAR_SIMULATOR_GPS_LEAP_SECONDS 18ULL
+
+void provizio_radar_simulator_options_init(provizio_radar_simulator_options *out_options)
+{
+    memset(out_options, 0, sizeof(provizio_radar_simulator_options));
+    out_options->radar_position_ids[0] = provizio_radar_position_front_center;
+    out_options->num_radars = 1;
+    out_options->radar_range = provizio_radar_range_medium;
+    out_options->num_points_per_frame = PROVIZIO__RADAR_SIMULATOR_DEFAULT_POINTS_PER_FRAME;
+    out_options->frame_rate = PROVIZIO__RADAR_SIMULATOR_DEFAULT_FRAME_RATE;
+    out_options->seed = PROVIZIO__RADAR_SIMULATOR_DEFAULT_SEED;
+}
+
+static uint8_t provizio_radar_simulator_probability_valid(float probability)
+{
+    return probability >= 0.0F && probability <= 1.0F;
+}
+
+int32_t provizio_radar_simulator_init(const provizio_radar_simulator_options *options,
+                                      provizio_radar_simulator *out_simulator)
+{
+    memset(out_simulator, 0, sizeof(provizio_radar_simulator));
+    out_simulator->sock = PROVIZIO__INVALID_SOCKET;
+
+    if (options != NULL)
+    {
+        out_simulator->options = *options;
+    }
+    else
+    {
+        provizio_radar_simulator_options_init(&out_simulator->options);
+    }
+
+    const provizio_radar_simulator_options *actual_options = &out_simulator->options;
+    if (actual_options->num_radars == 0 || actual_options->num_radars > PROVIZIO__RADAR_SIMULATOR_MAX_RADARS ||
+        actual_options->num_points_per_frame == 0 || !(actual_options->frame_rate >= 0.0F) ||
+        !provizio_radar_simulator_probability_valid(actual_options->reorder_probability) ||
+        !provizio_radar_simulator_probability_valid(actual_options->duplicate_probability) ||
+        !provizio_radar_simulator_probability_valid(actual_options->loss_probability))
+    {
+        provizio_error("provizio_radar_simulator_init: Invalid options");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    out_simulator->random_state =
+        actual_options->seed != 0 ? actual_options->seed : PROVIZIO__RADAR_SIMULATOR_DEFAULT_SEED;
+
+    struct timeval now;
+    provizio_gettimeofday(&now);
+    const uint64_t gps_time_s = (uint64_t)now.tv_sec - PROVIZIO__RADAR_SIMULATOR_GPS_EPOCH_OFFSET_S +
+                                PROVIZIO__RADAR_SIMULATOR_GPS_LEAP_SECONDS;
+    out_simulator->timestamp = gps_time_s * 1000000000ULL + (uint64_t)now.tv_usec * 1000ULL;
+
+    return 0;
+}
+
+// Returns a pseudo-random number in [0, 1)
+static float provizio_radar_simulator_random(provizio_radar_simulator *simulator)
+{
+    uint32_t state = simulator->random_state;
+    state ^= state << 13U;
+    state ^= state >> 17U;
+    state ^= state << 5U;
+    simulator->random_state = state;
+
+    return (float)(state >> 8U) / (float)(1U << 24U);
+}
+
+static void provizio_radar_simulator_make_point(provizio_radar_simulator *simulator, provizio_radar_point *out_point)
+{
+    const float min_range_meters = 1.0F;
+    const float max_range_meters = 150.0F;
+    const float max_lateral_ratio = 0.7F; // I.e. the field of view of about 70 degrees
+    const float min_z_meters = -1.0F;
+    const float max_z_meters = 3.0F;
+    const float ego_velocity_m_s = 15.0F;
+    const float moving_objects_ratio = 0.1F;
+    const float max_object_velocity_m_s = 20.0F;
+    const float min_signal_to_noise_ratio = 5.0F;
+    const float max_signal_to_noise_ratio = 45.0F;
+    const float half = 0.5F;
+
+    const float x_meters =
+        min_range_meters + (max_range_meters - min_range_meters) * provizio_radar_simulator_random(simulator);
+    const float y_meters = x_meters * max_lateral_ratio * 2.0F * (provizio_radar_simulator_random(simulator) - half);
+    const float z_meters = min_z_meters + (max_z_meters - min_z_meters) * provizio_radar_simulator_random(simulator);
+    const float range_meters = sqrtf(x_meters * x_meters + y_meters * y_meters + z_meters * z_meters);
+
+    // Mostly static objects, approached by the vehicle the radar is mounted on
+    const float object_velocity_m_s = provizio_radar_simulator_random(simulator) < moving_objects_ratio
+                                          ? max_object_velocity_m_s * 2.0F *
+                                                (provizio_radar_simulator_random(simulator) - half)
+                                          : 0.0F;
+    const float projection = x_meters / range_meters;
+
+    provizio_set_protocol_field_float(&out_point->x_meters, x_meters);
+    provizio_set_protocol_field_float(&out_point->y_meters, y_meters);
+    provizio_set_protocol_field_float(&out_point->z_meters, z_meters);
+    provizio_set_protocol_field_float(&out_point->radar_relative_radial_velocity_m_s,
+                                      (object_velocity_m_s - ego_velocity_m_s) * projection);
+    provizio_set_protocol_field_float(&out_point->signal_to_noise_ratio,
+                                      min_signal_to_noise_ratio +
+                                          (max_signal_to_noise_ratio - min_signal_to_noise_ratio) *
+                                              provizio_radar_simulator_random(simulator));
+    provizio_set_protocol_field_float(&out_point->ground_relative_radial_velocity_m_s,
+                                      object_velocity_m_s * projection);
+}
+
+static int32_t provizio_radar_simulator_emit_copies(provizio_radar_simulator *simulator,
+                                                    const provizio_radar_point_cloud_packet *packet,
+                                                    size_t packet_size,
+                                                    provizio_radar_simulator_packet_callback callback,
+                                                    void *user_data)
+{
+    const uint8_t duplicated =
+        provizio_radar_simulator_random(simulator) < simulator->options.duplicate_probability;
+    if (duplicated)
+    {
+        ++simulator->stats.num_packets_duplicated;
+    }
+
+    int32_t status_code = 0;
+    for (uint8_t i = 0; i <= duplicated && status_code == 0; ++i)
+    {
+        status_code = callback(packet, packet_size, user_data);
+        ++simulator->stats.num_packets;
+    }
+
+    return status_code;
+}
+
+static int32_t provizio_radar_simulator_emit(provizio_radar_simulator *simulator,
+                                             const provizio_radar_point_cloud_packet *packet, size_t packet_size,
+                                             provizio_radar_simulator_packet_callback callback, void *user_data)
+{
+    if (provizio_radar_simulator_random(simulator) < simulator->options.loss_probability)
+    {
+        ++simulator->stats.num_packets_lost;
+        return 0;
+    }
+
+    if (simulator->held_packet_size == 0 &&
+        provizio_radar_simulator_random(simulator) < simulator->options.reorder_probability)
+    {
+        // To be emitted after the next packet
+        memcpy(&simulator->held_packet, packet, packet_size);
+        simulator->held_packet_size = packet_size;
+        ++simulator->stats.num_packets_reordered;
+        return 0;
+    }
+
+    int32_t status_code = provizio_radar_simulator_emit_copies(simulator, packet, packet_size, callback, user_data);
+    if (status_code == 0 && simulator->held_packet_size != 0)
+    {
+        const size_t held_packet_size = simulator->held_packet_size;
+        simulator->held_packet_size = 0;
+        status_code = provizio_radar_simulator_emit_copies(simulator, &simulator->held_packet, held_packet_size,
+                                                           callback, user_data);
+    }
+
+    return status_code;
+}
+
+int32_t provizio_radar_simulator_make_frame(provizio_radar_simulator *simulator,
+                                            provizio_radar_simulator_packet_callback callback, void *user_data)
+{
+    const provizio_radar_simulator_options *options = &simulator->options;
+    provizio_radar_point_cloud_packet packet;
+
+    int32_t status_code = 0;
+    for (uint16_t first_point = 0; first_point < options->num_points_per_frame && status_code == 0;)
+    {
+        const uint16_t num_points_left = (uint16_t)(options->num_points_per_frame - first_point);
+        const uint16_t points_in_packet = num_points_left < PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET
+                                              ? num_points_left
+                                              : PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+
+        // Packets of all the radars are interleaved, as they all send their frames at the same time
+        for (size_t i = 0; i < options->num_radars && status_code == 0; ++i)
+        {
+            memset(&packet.header, 0, sizeof(packet.header));
+            provizio_set_protocol_field_uint16_t(&packet.header.protocol_header.packet_type,
+                                                 PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE);
+            provizio_set_protocol_field_uint16_t(&packet.header.protocol_header.protocol_version,
+                                                 PROVIZIO__RADAR_API_POINT_CLOUD_PROTOCOL_VERSION);
+            provizio_set_protocol_field_uint32_t(&packet.header.frame_index, simulator->frame_index);
+            provizio_set_protocol_field_uint64_t(&packet.header.timestamp, simulator->timestamp);
+            provizio_set_protocol_field_uint16_t(&packet.header.radar_position_id, options->radar_position_ids[i]);
+            provizio_set_protocol_field_uint16_t(&packet.header.total_points_in_frame, options->num_points_per_frame);
+            provizio_set_protocol_field_uint16_t(&packet.header.num_points_in_packet, points_in_packet);
+            provizio_set_protocol_field_uint16_t(&packet.header.radar_range, options->radar_range);
+            for (uint16_t j = 0; j < points_in_packet; ++j)
+            {
+                provizio_radar_simulator_make_point(simulator, &packet.radar_points[j]);
+            }
+
+            status_code = provizio_radar_simulator_emit(
+                simulator, &packet, provizio_radar_point_cloud_packet_size(&packet.header), callback, user_data);
+        }
+
+        first_point = (uint16_t)(first_point + points_in_packet);
+    }
+
+    // Packets are only reordered within a frame
+    if (status_code == 0 && simulator->held_packet_size != 0)
+    {
+        const size_t held_packet_size = simulator->held_packet_size;
+        simulator->held_packet_size = 0;
+        status_code = provizio_radar_simulator_emit_copies(simulator, &simulator->held_packet, held_packet_size,
+                                                           callback, user_data);
+    }
+
+    const uint64_t frame_interval_ns =
+        options->frame_rate > 0.0F ? (uint64_t)(1e9 / (double)options->frame_rate)
+                                   : (uint64_t)(1e9 / (double)PROVIZIO__RADAR_SIMULATOR_DEFAULT_FRAME_RATE);
+    ++simulator->frame_index;
+    simulator->timestamp += frame_interval_ns;
+    simulator->stats.num_frames += options->num_radars;
+
+    return status_code;
+}
+
+int32_t provizio_radar_simulator_open(const provizio_radar_simulator_options *options, const char *target_address,
+                                      uint16_t udp_port, provizio_radar_simulator *out_simulator)
+{
+    int32_t status_code = provizio_radar_simulator_init(options, out_simulator);
+    if (status_code != 0)
+    {
+        return status_code;
+    }
+
+    out_simulator->target_address.sin_family = AF_INET;
+    out_simulator->target_address.sin_port = // NOLINT: htons is up to a platform
+        htons(udp_port != 0 ? udp_port : PROVIZIO__RADAR_API_DEFAULT_PORT);
+    out_simulator->target_address.sin_addr.s_addr = inet_addr(target_address != NULL ? target_address : "127.0.0.1");
+    if (out_simulator->target_address.sin_addr.s_addr == INADDR_NONE)
+    {
+        provizio_error("provizio_radar_simulator_open: Invalid target address");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    out_simulator->sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (!provizio_socket_valid(out_simulator->sock))
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        status_code = (int32_t)errno;
+        provizio_error("provizio_radar_simulator_open: Failed to create a UDP socket");
+        return status_code != 0 ? status_code : (int32_t)-1;
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+}
+
+static int32_t provizio_radar_simulator_send_packet(const provizio_radar_point_cloud_packet *packet,
+                                                    size_t packet_size, void *user_data)
+{
+    provizio_radar_simulator *simulator = (provizio_radar_simulator *)user_data;
+
+    if (sendto(simulator->sock, (const char *)packet, (uint16_t)packet_size, 0, // NOLINT: sendto differs by platform
+               (const struct sockaddr *)&simulator->target_address,
+               sizeof(simulator->target_address)) != (PROVIZIO__RECV_RETURN_TYPE)packet_size)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status_code = (int32_t)errno;
+        provizio_error("provizio_radar_simulator_send_frames: Failed to send a packet");
+        return status_code != 0 ? status_code : (int32_t)-1;
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+}
+
+int32_t provizio_radar_simulator_send_frames(provizio_radar_simulator *simulator, uint64_t num_frames,
+                                             const uint32_t *stop)
+{
+    if (!provizio_socket_valid(simulator->sock))
+    {
+        provizio_error("provizio_radar_simulator_send_frames: Not open");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    const uint64_t frame_interval_ns =
+        simulator->options.frame_rate > 0.0F ? (uint64_t)(1e9 / (double)simulator->options.frame_rate) : 0;
+    const uint64_t start_time_ns = provizio_monotonic_time_ns();
+    for (uint64_t i = 0; num_frames == 0 || i < num_frames; ++i)
+    {
+        if (stop != NULL && PROVIZIO__ATOMIC_LOAD_UINT32(stop) != 0)
+        {
+            break;
+        }
+
+        if (frame_interval_ns != 0)
+        {
+            // Paced by the number of frames sent, so an occasional delay doesn't lower the average frame rate
+            const uint64_t send_time_ns = start_time_ns + i * frame_interval_ns;
+            const uint64_t now_ns = provizio_monotonic_time_ns();
+            if (send_time_ns > now_ns)
+            {
+                provizio_sleep_ns(send_time_ns - now_ns);
+            }
+        }
+
+        const int32_t status_code =
+            provizio_radar_simulator_make_frame(simulator, &provizio_radar_simulator_send_packet, simulator);
+        if (status_code != 0)
+        {
+            return status_code; // LCOV_EXCL_LINE: Can't be unit-tested as it depends on the state of the OS
+        }
+    }
+
+    return 0;
+}
+
+int32_t provizio_radar_simulator_close(provizio_radar_simulator *simulator)
+{
+    if (!provizio_socket_valid(simulator->sock))
+    {
+        provizio_error("provizio_radar_simulator_close: Not open");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    const int32_t status_code = provizio_socket_close(simulator->sock);
+    simulator->sock = PROVIZIO__INVALID_SOCKET;
+
+    return status_code;
+}
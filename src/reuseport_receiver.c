@@ -0,0 +1,271 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/radar_api/reuseport_receiver.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "provizio/atomic.h"
+#include "provizio/util.h"
+
+#ifdef __linux__
+#include <linux/filter.h>
+#include <sys/socket.h>
+#endif // __linux__
+
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+#define PROVIZIO__REUSEPORT_RECEIVER_SUPPORTED
+#endif
+
+int32_t provizio_reuseport_radar_api_shard_init(provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts,
+                                                size_t num_radar_point_cloud_api_contexts,
+                                                provizio_reuseport_radar_api_shard *out_shard)
+{
+    memset(out_shard, 0, sizeof(provizio_reuseport_radar_api_shard));
+    out_shard->connection.sock = PROVIZIO__INVALID_SOCKET;
+
+    if (radar_point_cloud_api_contexts == NULL || num_radar_point_cloud_api_contexts == 0)
+    {
+        provizio_error("provizio_reuseport_radar_api_shard_init: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    out_shard->radar_point_cloud_api_contexts = radar_point_cloud_api_contexts;
+    out_shard->num_radar_point_cloud_api_contexts = num_radar_point_cloud_api_contexts;
+    return 0;
+}
+
+int32_t provizio_reuseport_radar_api_shard_init_pooled(
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts,
+    size_t num_pooled_radar_point_cloud_api_contexts, provizio_reuseport_radar_api_shard *out_shard)
+{
+    memset(out_shard, 0, sizeof(provizio_reuseport_radar_api_shard));
+    out_shard->connection.sock = PROVIZIO__INVALID_SOCKET;
+
+    if (pooled_radar_point_cloud_api_contexts == NULL || num_pooled_radar_point_cloud_api_contexts == 0)
+    {
+        provizio_error("provizio_reuseport_radar_api_shard_init_pooled: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    out_shard->pooled_radar_point_cloud_api_contexts = pooled_radar_point_cloud_api_contexts;
+    out_shard->num_pooled_radar_point_cloud_api_contexts = num_pooled_radar_point_cloud_api_contexts;
+    return 0;
+}
+
+#ifdef PROVIZIO__REUSEPORT_RECEIVER_SUPPORTED
+
+static int32_t provizio_reuseport_radar_api_shard_open(uint16_t udp_port,
+                                                       const provizio_radar_api_connection_options *options,
+                                                       provizio_reuseport_radar_api_shard *shard)
+{
+    // The receive timeout bounds the stop request latency
+    if (shard->radar_point_cloud_api_contexts != NULL)
+    {
+        return provizio_open_radars_connection_with_options(
+            udp_port, PROVIZIO__REUSEPORT_RECEIVER_POLL_TIMEOUT_NS, 0, options, shard->radar_point_cloud_api_contexts,
+            shard->num_radar_point_cloud_api_contexts, &shard->connection);
+    }
+
+    return provizio_open_pooled_radars_connection_with_options(
+        udp_port, PROVIZIO__REUSEPORT_RECEIVER_POLL_TIMEOUT_NS, 0, options,
+        shard->pooled_radar_point_cloud_api_contexts, shard->num_pooled_radar_point_cloud_api_contexts,
+        &shard->connection);
+}
+
+static int32_t provizio_reuseport_radar_api_attach_steering_program(PROVIZIO__SOCKET sock, size_t num_shards)
+{
+    // Packets are steered to the socket at index radar_position_id % num_shards of the port's SO_REUSEPORT group (the
+    // sockets get indexed in the order they were bound in). The program runs with the UDP payload at offset 0. Other
+    // packets get an out of range index, so the kernel falls back to its default (flow hash based) selection.
+    struct sock_filter code[] = {
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, offsetof(provizio_radar_point_cloud_packet_header, protocol_header) +
+                                               offsetof(provizio_radar_api_protocol_header, packet_type)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE, 0, 3),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, offsetof(provizio_radar_point_cloud_packet_header, radar_position_id)),
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, (uint32_t)num_shards),
+        BPF_STMT(BPF_RET | BPF_A, 0),
+        BPF_STMT(BPF_RET | BPF_K, 0xffffffff),
+    };
+    struct sock_fprog program;
+    program.len = (unsigned short)(sizeof(code) / sizeof(code[0]));
+    program.filter = code;
+
+    if (setsockopt(sock, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        const int32_t status = errno;
+        provizio_error("provizio_reuseport_radar_api_receiver_start: Failed to attach the steering program");
+        return status != 0 ? status : -1;
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+}
+
+static void *provizio_reuseport_radar_api_shard_thread(void *arg)
+{
+    provizio_reuseport_radar_api_shard *shard = (provizio_reuseport_radar_api_shard *)arg;
+
+    while (!PROVIZIO__ATOMIC_LOAD_UINT32(shard->stop))
+    {
+        size_t num_packets_handled = 0;
+        const int32_t status = provizio_radar_api_receive_packets(
+            &shard->connection, PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE, &num_packets_handled);
+
+        // Errors of handling packets are reported by the handling functions, there is no one else to report them to,
+        // while failing to receive anything at all (other than timing out) means the socket is no longer usable
+        if (status != 0 && status != PROVIZIO_E_TIMEOUT && num_packets_handled == 0)
+        {
+            // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+            shard->status = status;
+            break;
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    return NULL;
+}
+
+static void provizio_reuseport_radar_api_close_shards(provizio_reuseport_radar_api_shard *shards, size_t num_shards)
+{
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+        provizio_close_radars_connection(&shards[i].connection);
+    }
+}
+
+static void provizio_reuseport_radar_api_join_shards(provizio_reuseport_radar_api_shard *shards, size_t num_shards)
+{
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+        pthread_join(shards[i].thread, NULL);
+    }
+}
+
+int32_t provizio_reuseport_radar_api_receiver_start(uint16_t udp_port,
+                                                    const provizio_radar_api_connection_options *options,
+                                                    provizio_reuseport_radar_api_shard *shards, size_t num_shards,
+                                                    provizio_reuseport_radar_api_receiver *out_receiver)
+{
+    memset(out_receiver, 0, sizeof(provizio_reuseport_radar_api_receiver));
+
+    if (shards == NULL || num_shards == 0)
+    {
+        provizio_error("provizio_reuseport_radar_api_receiver_start: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+        if (shards[i].radar_point_cloud_api_contexts == NULL && shards[i].pooled_radar_point_cloud_api_contexts == NULL)
+        {
+            provizio_error("provizio_reuseport_radar_api_receiver_start: Uninitialized shard");
+            return PROVIZIO_E_ARGUMENT;
+        }
+    }
+
+    // Sockets are opened (i.e. bound) in order, so a shard's index is also its socket's index in the group
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+        const int32_t status = provizio_reuseport_radar_api_shard_open(udp_port, options, &shards[i]);
+        if (status != 0)
+        {
+            provizio_reuseport_radar_api_close_shards(shards, i);
+            return status;
+        }
+    }
+
+    int32_t status = provizio_reuseport_radar_api_attach_steering_program(shards[0].connection.sock, num_shards);
+    if (status != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        provizio_reuseport_radar_api_close_shards(shards, num_shards);
+        return status;
+        // LCOV_EXCL_STOP
+    }
+
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+        shards[i].status = 0;
+        shards[i].stop = &out_receiver->stop;
+        status = pthread_create(&shards[i].thread, NULL, &provizio_reuseport_radar_api_shard_thread, &shards[i]);
+        if (status != 0)
+        {
+            // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+            provizio_error("provizio_reuseport_radar_api_receiver_start: Failed to start a shard thread");
+            PROVIZIO__ATOMIC_STORE_UINT32(&out_receiver->stop, 1);
+            provizio_reuseport_radar_api_join_shards(shards, i);
+            provizio_reuseport_radar_api_close_shards(shards, num_shards);
+            return status;
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    out_receiver->shards = shards;
+    out_receiver->num_shards = num_shards;
+    return 0;
+}
+
+int32_t provizio_reuseport_radar_api_receiver_stop(provizio_reuseport_radar_api_receiver *receiver)
+{
+    if (receiver->shards == NULL)
+    {
+        provizio_error("provizio_reuseport_radar_api_receiver_stop: Not started");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    PROVIZIO__ATOMIC_STORE_UINT32(&receiver->stop, 1);
+    provizio_reuseport_radar_api_join_shards(receiver->shards, receiver->num_shards);
+    provizio_reuseport_radar_api_close_shards(receiver->shards, receiver->num_shards);
+
+    int32_t status = 0;
+    for (size_t i = 0; i < receiver->num_shards && status == 0; ++i)
+    {
+        status = receiver->shards[i].status;
+    }
+    receiver->shards = NULL;
+
+    return status;
+}
+
+#else // PROVIZIO__REUSEPORT_RECEIVER_SUPPORTED
+
+// LCOV_EXCL_START: Coverage is collected in Linux only
+int32_t provizio_reuseport_radar_api_receiver_start(uint16_t udp_port,
+                                                    const provizio_radar_api_connection_options *options,
+                                                    provizio_reuseport_radar_api_shard *shards, size_t num_shards,
+                                                    provizio_reuseport_radar_api_receiver *out_receiver)
+{
+    (void)udp_port;
+    (void)options;
+    (void)shards;
+    (void)num_shards;
+    memset(out_receiver, 0, sizeof(provizio_reuseport_radar_api_receiver));
+
+    provizio_error("provizio_reuseport_radar_api_receiver_start: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+
+int32_t provizio_reuseport_radar_api_receiver_stop(provizio_reuseport_radar_api_receiver *receiver)
+{
+    (void)receiver;
+
+    provizio_error("provizio_reuseport_radar_api_receiver_stop: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+// LCOV_EXCL_STOP
+
+#endif // PROVIZIO__REUSEPORT_RECEIVER_SUPPORTED
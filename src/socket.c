@@ -14,6 +14,12 @@
 
 #include "provizio/socket.h"
 
+#include <limits.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#endif
+
 int32_t provizio_sockets_initialize(void)
 {
 #ifdef _WIN32
@@ -65,6 +71,22 @@ int32_t provizio_socket_set_recv_timeout(PROVIZIO__SOCKET sock, uint64_t timeout
     return status;
 }
 
+int32_t provizio_socket_set_non_blocking(PROVIZIO__SOCKET sock, uint8_t non_blocking)
+{
+#ifdef _WIN32
+    u_long mode = non_blocking ? 1 : 0;
+    return (int32_t)ioctlsocket(sock, FIONBIO, &mode);
+#else
+    const int flags = fcntl(sock, F_GETFL, 0);
+    if (flags == -1)
+    {
+        return -1;
+    }
+
+    return (int32_t)fcntl(sock, F_SETFL, non_blocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+#endif
+}
+
 int32_t provizio_socket_enable_address_and_port_reuse(PROVIZIO__SOCKET sock)
 {
     const int enable = 1;
@@ -78,3 +100,26 @@ int32_t provizio_socket_enable_address_and_port_reuse(PROVIZIO__SOCKET sock)
 
     return status;
 }
+
+int32_t provizio_socket_set_recv_buffer_size(PROVIZIO__SOCKET sock, size_t size)
+{
+    const int value = size < (size_t)INT_MAX ? (int)size : INT_MAX;
+#ifdef SO_RCVBUFFORCE
+    if (setsockopt(sock, SOL_SOCKET, SO_RCVBUFFORCE, &value, sizeof(value)) == 0)
+    {
+        return 0;
+    }
+#endif
+
+    return (int32_t)setsockopt(sock, SOL_SOCKET, SO_RCVBUF, (const char *)&value, sizeof(value));
+}
+
+int32_t provizio_socket_get_recv_buffer_size(PROVIZIO__SOCKET sock, size_t *out_size)
+{
+    int value = 0;
+    socklen_t value_size = (socklen_t)sizeof(value);
+    const int32_t status = (int32_t)getsockopt(sock, SOL_SOCKET, SO_RCVBUF, (char *)&value, &value_size);
+    *out_size = status == 0 && value > 0 ? (size_t)value : 0;
+
+    return status;
+}
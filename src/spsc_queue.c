@@ -0,0 +1,120 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/spsc_queue.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "provizio/atomic.h"
+#include "provizio/radar_api/errno.h"
+
+// Positions run over [0, 2 * num_slots), which tells a full queue (num_slots apart) from an empty one (equal), so that
+// all the slots are usable and num_slots doesn't have to be a power of 2
+static uint32_t provizio_spsc_queue_next_position(const provizio_spsc_queue *queue, uint32_t position)
+{
+    ++position;
+    return position == 2 * queue->num_slots ? 0 : position;
+}
+
+static uint32_t provizio_spsc_queue_distance(const provizio_spsc_queue *queue, uint32_t head, uint32_t tail)
+{
+    return tail >= head ? tail - head : tail + 2 * queue->num_slots - head;
+}
+
+static void *provizio_spsc_queue_slot(provizio_spsc_queue *queue, uint32_t position)
+{
+    const uint32_t index = position >= queue->num_slots ? position - queue->num_slots : position;
+    return queue->slots + (size_t)index * queue->slot_size;
+}
+
+int32_t provizio_spsc_queue_init(void *slots, size_t slot_size, size_t num_slots, provizio_spsc_queue *out_queue)
+{
+    memset(out_queue, 0, sizeof(provizio_spsc_queue));
+
+    if (slots == NULL || slot_size == 0 || num_slots == 0 || num_slots > (size_t)(UINT32_MAX / 2))
+    {
+        provizio_error("provizio_spsc_queue_init: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    out_queue->slots = (uint8_t *)slots;
+    out_queue->slot_size = slot_size;
+    out_queue->num_slots = (uint32_t)num_slots;
+
+    return 0;
+}
+
+void *provizio_spsc_queue_back(provizio_spsc_queue *queue)
+{
+    if (queue->slots == NULL)
+    {
+        return NULL;
+    }
+
+    // The producer owns tail, so it's read as is; head is read with acquire to see the slot released by the consumer
+    const uint32_t tail = queue->tail;
+    const uint32_t head = PROVIZIO__ATOMIC_LOAD_UINT32(&queue->head);
+    if (provizio_spsc_queue_distance(queue, head, tail) == queue->num_slots)
+    {
+        return NULL;
+    }
+
+    return provizio_spsc_queue_slot(queue, tail);
+}
+
+void provizio_spsc_queue_push(provizio_spsc_queue *queue)
+{
+    assert(provizio_spsc_queue_back(queue) != NULL);
+
+    // Release makes the item written visible to the consumer prior to the new tail
+    PROVIZIO__ATOMIC_STORE_UINT32(&queue->tail, provizio_spsc_queue_next_position(queue, queue->tail));
+}
+
+void *provizio_spsc_queue_front(provizio_spsc_queue *queue)
+{
+    if (queue->slots == NULL)
+    {
+        return NULL;
+    }
+
+    const uint32_t head = queue->head;
+    const uint32_t tail = PROVIZIO__ATOMIC_LOAD_UINT32(&queue->tail);
+    if (head == tail)
+    {
+        return NULL;
+    }
+
+    return provizio_spsc_queue_slot(queue, head);
+}
+
+void provizio_spsc_queue_pop(provizio_spsc_queue *queue)
+{
+    assert(provizio_spsc_queue_front(queue) != NULL);
+
+    // Release makes sure the item has been read prior to the producer reusing its slot
+    PROVIZIO__ATOMIC_STORE_UINT32(&queue->head, provizio_spsc_queue_next_position(queue, queue->head));
+}
+
+size_t provizio_spsc_queue_size(provizio_spsc_queue *queue)
+{
+    if (queue->slots == NULL)
+    {
+        return 0;
+    }
+
+    const uint32_t head = PROVIZIO__ATOMIC_LOAD_UINT32(&queue->head);
+    const uint32_t tail = PROVIZIO__ATOMIC_LOAD_UINT32(&queue->tail);
+    return provizio_spsc_queue_distance(queue, head, tail);
+}
@@ -0,0 +1,312 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "provizio/radar_api/threaded_receiver.h"
+
+#include <string.h>
+
+#include "provizio/atomic.h"
+#include "provizio/util.h"
+
+#ifndef _WIN32
+#include <poll.h>
+#endif // _WIN32
+
+static int32_t provizio_threaded_radar_api_worker_init_queue(provizio_threaded_radar_packet *queue_slots,
+                                                             size_t queue_length,
+                                                             provizio_threaded_radar_api_worker *out_worker)
+{
+    return provizio_spsc_queue_init(queue_slots, sizeof(provizio_threaded_radar_packet), queue_length,
+                                    &out_worker->queue);
+}
+
+int32_t provizio_threaded_radar_api_worker_init(
+    provizio_radar_point_cloud_api_context *radar_point_cloud_api_contexts, size_t num_radar_point_cloud_api_contexts,
+    provizio_threaded_radar_packet *queue_slots, size_t queue_length, provizio_threaded_radar_api_worker *out_worker)
+{
+    memset(out_worker, 0, sizeof(provizio_threaded_radar_api_worker));
+
+    if (radar_point_cloud_api_contexts == NULL || num_radar_point_cloud_api_contexts == 0)
+    {
+        provizio_error("provizio_threaded_radar_api_worker_init: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    out_worker->contexts.sock = PROVIZIO__INVALID_SOCKET;
+    out_worker->contexts.radar_point_cloud_api_contexts = radar_point_cloud_api_contexts;
+    out_worker->contexts.num_radar_point_cloud_api_contexts = num_radar_point_cloud_api_contexts;
+    return provizio_threaded_radar_api_worker_init_queue(queue_slots, queue_length, out_worker);
+}
+
+int32_t provizio_threaded_radar_api_worker_init_pooled(
+    provizio_pooled_radar_point_cloud_api_context *pooled_radar_point_cloud_api_contexts,
+    size_t num_pooled_radar_point_cloud_api_contexts, provizio_threaded_radar_packet *queue_slots, size_t queue_length,
+    provizio_threaded_radar_api_worker *out_worker)
+{
+    memset(out_worker, 0, sizeof(provizio_threaded_radar_api_worker));
+
+    if (pooled_radar_point_cloud_api_contexts == NULL || num_pooled_radar_point_cloud_api_contexts == 0)
+    {
+        provizio_error("provizio_threaded_radar_api_worker_init_pooled: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    out_worker->contexts.sock = PROVIZIO__INVALID_SOCKET;
+    out_worker->contexts.pooled_radar_point_cloud_api_contexts = pooled_radar_point_cloud_api_contexts;
+    out_worker->contexts.num_pooled_radar_point_cloud_api_contexts = num_pooled_radar_point_cloud_api_contexts;
+    return provizio_threaded_radar_api_worker_init_queue(queue_slots, queue_length, out_worker);
+}
+
+#ifndef _WIN32
+
+static void *provizio_threaded_radar_api_worker_thread(void *arg)
+{
+    provizio_threaded_radar_api_worker *worker = (provizio_threaded_radar_api_worker *)arg;
+
+    for (;;)
+    {
+        const provizio_threaded_radar_packet *packet =
+            (const provizio_threaded_radar_packet *)provizio_spsc_queue_front(&worker->queue);
+        if (packet != NULL)
+        {
+            // Errors are reported by the handling functions, there is no one else to report them to
+            (void)provizio_radar_api_handle_received_packet(&worker->contexts, packet->payload, packet->payload_size,
+                                                            packet->receive_time_ns);
+            provizio_spsc_queue_pop(&worker->queue);
+        }
+        else if (PROVIZIO__ATOMIC_LOAD_UINT32(worker->stop))
+        {
+            // The I/O thread has stopped before the workers, so nothing else can get queued
+            break;
+        }
+        else
+        {
+            provizio_sleep_ns(PROVIZIO__THREADED_RECEIVER_WORKER_IDLE_SLEEP_NS);
+        }
+    }
+
+    return NULL;
+}
+
+// Queues a packet received into the back slot of the worker of worker_index (or to another buffer, if there are no free
+// slots) to the worker of its radar, returns the index of the worker to receive the next packet into the queue of
+static size_t provizio_threaded_radar_api_dispatch_packet(provizio_threaded_radar_api_receiver *receiver,
+                                                          size_t worker_index,
+                                                          const provizio_threaded_radar_packet *packet)
+{
+    const provizio_radar_point_cloud_packet_header *header =
+        (const provizio_radar_point_cloud_packet_header *)packet->payload;
+    if (packet->payload_size < sizeof(provizio_radar_point_cloud_packet_header) ||
+        provizio_get_protocol_field_uint16_t(&header->protocol_header.packet_type) !=
+            PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE)
+    {
+        PROVIZIO__ATOMIC_ADD_UINT32(&receiver->num_skipped_packets, 1);
+        return worker_index;
+    }
+
+    // Same radar always goes to the same worker, so its packets are handled in order by a single thread
+    const uint16_t radar_position_id = provizio_get_protocol_field_uint16_t(&header->radar_position_id);
+    const size_t radar_worker_index = radar_position_id % receiver->num_workers;
+    provizio_threaded_radar_api_worker *worker = &receiver->workers[radar_worker_index];
+
+    provizio_threaded_radar_packet *slot = (provizio_threaded_radar_packet *)provizio_spsc_queue_back(&worker->queue);
+    if (slot == NULL)
+    {
+        // The worker falls behind: dropping this radar's packet doesn't affect radars of other workers
+        PROVIZIO__ATOMIC_ADD_UINT32(&worker->num_dropped_packets, 1);
+        return radar_worker_index;
+    }
+
+    if (slot != packet)
+    {
+        // Received into a slot of another worker (or not into a slot at all), which happens only when the radar
+        // differs from the one of the previous packet, as the packets of a frame are received in a row
+        memcpy(slot->payload, packet->payload, packet->payload_size);
+        slot->payload_size = packet->payload_size;
+        slot->receive_time_ns = packet->receive_time_ns;
+    }
+    provizio_spsc_queue_push(&worker->queue);
+
+    return radar_worker_index;
+}
+
+static void *provizio_threaded_radar_api_io_thread(void *arg)
+{
+    provizio_threaded_radar_api_receiver *receiver = (provizio_threaded_radar_api_receiver *)arg;
+    provizio_threaded_radar_packet fallback_packet; // To receive into when the queue to receive into is full
+    size_t worker_index = 0;                        // Worker of the previous packet, to receive the next one for
+
+    struct pollfd poll_fd;
+    memset(&poll_fd, 0, sizeof(poll_fd));
+    poll_fd.fd = receiver->connection->sock;
+    poll_fd.events = POLLIN;
+    const int poll_timeout_ms = (int)(PROVIZIO__THREADED_RECEIVER_POLL_TIMEOUT_NS / 1000000ULL);
+
+    while (!PROVIZIO__ATOMIC_LOAD_UINT32(&receiver->stop))
+    {
+        // Waiting in poll rather than recv keeps the stop request latency independent of the socket's timeout
+        const int ready = poll(&poll_fd, 1, poll_timeout_ms);
+        if (ready == 0 || (ready < 0 && errno == EINTR))
+        {
+            continue;
+        }
+
+        int32_t status = ready < 0 ? (errno != 0 ? errno : -1) : 0;
+        if (status == 0)
+        {
+            provizio_threaded_radar_api_worker *worker = &receiver->workers[worker_index];
+            provizio_threaded_radar_packet *packet =
+                (provizio_threaded_radar_packet *)provizio_spsc_queue_back(&worker->queue);
+            if (packet == NULL)
+            {
+                packet = &fallback_packet;
+            }
+
+            status = provizio_radar_api_receive_packet_into(receiver->connection, packet->payload,
+                                                            &packet->payload_size, &packet->receive_time_ns);
+            if (status == 0)
+            {
+                worker_index = provizio_threaded_radar_api_dispatch_packet(receiver, worker_index, packet);
+                continue;
+            }
+
+            if (status == PROVIZIO_E_TIMEOUT)
+            {
+                continue; // LCOV_EXCL_LINE: Can't be unit-tested as it depends on the state of the OS
+            }
+        }
+
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        receiver->status = status;
+        provizio_error("provizio_threaded_radar_api_receiver: Failed to receive");
+        break;
+        // LCOV_EXCL_STOP
+    }
+
+    return NULL;
+}
+
+static void provizio_threaded_radar_api_join_workers(provizio_threaded_radar_api_worker *workers, size_t num_workers)
+{
+    for (size_t i = 0; i < num_workers; ++i)
+    {
+        pthread_join(workers[i].thread, NULL);
+    }
+}
+
+int32_t provizio_threaded_radar_api_receiver_start(provizio_radar_api_connection *connection,
+                                                   provizio_threaded_radar_api_worker *workers, size_t num_workers,
+                                                   provizio_threaded_radar_api_receiver *out_receiver)
+{
+    memset(out_receiver, 0, sizeof(provizio_threaded_radar_api_receiver));
+
+    if (connection == NULL || !provizio_socket_valid(connection->sock))
+    {
+        provizio_error("provizio_threaded_radar_api_receiver_start: Not connected");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    if (workers == NULL || num_workers == 0)
+    {
+        provizio_error("provizio_threaded_radar_api_receiver_start: Invalid arguments");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    for (size_t i = 0; i < num_workers; ++i)
+    {
+        if (workers[i].queue.slots == NULL)
+        {
+            provizio_error("provizio_threaded_radar_api_receiver_start: Uninitialized worker");
+            return PROVIZIO_E_ARGUMENT;
+        }
+    }
+
+    for (size_t i = 0; i < num_workers; ++i)
+    {
+        workers[i].stop = &out_receiver->stop;
+        const int status = pthread_create(&workers[i].thread, NULL, &provizio_threaded_radar_api_worker_thread,
+                                          &workers[i]);
+        if (status != 0)
+        {
+            // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+            provizio_error("provizio_threaded_radar_api_receiver_start: Failed to start a worker thread");
+            PROVIZIO__ATOMIC_STORE_UINT32(&out_receiver->stop, 1);
+            provizio_threaded_radar_api_join_workers(workers, i);
+            return (int32_t)status;
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    out_receiver->connection = connection;
+    out_receiver->workers = workers;
+    out_receiver->num_workers = num_workers;
+    const int status =
+        pthread_create(&out_receiver->io_thread, NULL, &provizio_threaded_radar_api_io_thread, out_receiver);
+    if (status != 0)
+    {
+        // LCOV_EXCL_START: Can't be unit-tested as it depends on the state of the OS
+        provizio_error("provizio_threaded_radar_api_receiver_start: Failed to start the I/O thread");
+        PROVIZIO__ATOMIC_STORE_UINT32(&out_receiver->stop, 1);
+        provizio_threaded_radar_api_join_workers(workers, num_workers);
+        out_receiver->workers = NULL;
+        return (int32_t)status;
+        // LCOV_EXCL_STOP
+    }
+
+    return 0;
+}
+
+int32_t provizio_threaded_radar_api_receiver_stop(provizio_threaded_radar_api_receiver *receiver)
+{
+    if (receiver->workers == NULL)
+    {
+        provizio_error("provizio_threaded_radar_api_receiver_stop: Not started");
+        return PROVIZIO_E_ARGUMENT;
+    }
+
+    // The I/O thread stops first, so the workers drain their queues knowing nothing else gets queued
+    PROVIZIO__ATOMIC_STORE_UINT32(&receiver->stop, 1);
+    pthread_join(receiver->io_thread, NULL);
+    provizio_threaded_radar_api_join_workers(receiver->workers, receiver->num_workers);
+    receiver->workers = NULL;
+
+    return receiver->status;
+}
+
+#else // _WIN32
+
+// LCOV_EXCL_START: Coverage is collected in Linux only
+int32_t provizio_threaded_radar_api_receiver_start(provizio_radar_api_connection *connection,
+                                                   provizio_threaded_radar_api_worker *workers, size_t num_workers,
+                                                   provizio_threaded_radar_api_receiver *out_receiver)
+{
+    (void)connection;
+    (void)workers;
+    (void)num_workers;
+    memset(out_receiver, 0, sizeof(provizio_threaded_radar_api_receiver));
+
+    provizio_error("provizio_threaded_radar_api_receiver_start: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+
+int32_t provizio_threaded_radar_api_receiver_stop(provizio_threaded_radar_api_receiver *receiver)
+{
+    (void)receiver;
+
+    provizio_error("provizio_threaded_radar_api_receiver_stop: Not supported on this platform");
+    return PROVIZIO_E_NOT_PERMITTED;
+}
+// LCOV_EXCL_STOP
+
+#endif // _WIN32
@@ -18,6 +18,8 @@
 #include <errno.h>
 #include <string.h>
 
+#include "provizio/atomic.h"
+#include "provizio/simd.h"
 #include "provizio/socket.h"
 
 #define PROVIZIO__IS_ALIGNED(P) (((uintptr_t)(const void *)(P)) % sizeof(*(P)) == 0)
@@ -178,6 +180,119 @@ float provizio_get_protocol_field_float(const float *field)
     return provizio_ntohf(value);
 }
 
+typedef void (*provizio_byte_swap_32_function)(const uint8_t *in, uint8_t *out, size_t count);
+
+static void provizio_byte_swap_32_scalar(const uint8_t *in, uint8_t *out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint8_t *in_word = &in[i * sizeof(uint32_t)];
+        uint8_t *out_word = &out[i * sizeof(uint32_t)];
+
+        // Read all bytes first, so in-place conversion works
+        const uint8_t byte_0 = in_word[0];
+        const uint8_t byte_1 = in_word[1];
+        out_word[0] = in_word[3];
+        out_word[1] = in_word[2];
+        out_word[2] = byte_1;
+        out_word[3] = byte_0;
+    }
+}
+
+#if defined(PROVIZIO__SIMD_X86)
+PROVIZIO__SIMD_TARGET("ssse3") static void provizio_byte_swap_32_ssse3(const uint8_t *in, uint8_t *out, size_t count)
+{
+    const __m128i mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12); // NOLINT
+    const size_t words_per_vector = sizeof(__m128i) / sizeof(uint32_t);
+
+    size_t i = 0;
+    for (; i + words_per_vector <= count; i += words_per_vector)
+    {
+        const __m128i words = _mm_loadu_si128((const __m128i *)&in[i * sizeof(uint32_t)]);
+        _mm_storeu_si128((__m128i *)&out[i * sizeof(uint32_t)], _mm_shuffle_epi8(words, mask));
+    }
+
+    provizio_byte_swap_32_scalar(&in[i * sizeof(uint32_t)], &out[i * sizeof(uint32_t)], count - i);
+}
+
+PROVIZIO__SIMD_TARGET("avx2") static void provizio_byte_swap_32_avx2(const uint8_t *in, uint8_t *out, size_t count)
+{
+    // _mm256_shuffle_epi8 shuffles within each 128 bits lane, so the mask repeats for both lanes
+    const __m256i mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, // NOLINT
+                                          3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12); // NOLINT
+    const size_t words_per_vector = sizeof(__m256i) / sizeof(uint32_t);
+
+    size_t i = 0;
+    for (; i + words_per_vector <= count; i += words_per_vector)
+    {
+        const __m256i words = _mm256_loadu_si256((const __m256i *)&in[i * sizeof(uint32_t)]);
+        _mm256_storeu_si256((__m256i *)&out[i * sizeof(uint32_t)], _mm256_shuffle_epi8(words, mask));
+    }
+
+    provizio_byte_swap_32_ssse3(&in[i * sizeof(uint32_t)], &out[i * sizeof(uint32_t)], count - i);
+}
+#elif defined(PROVIZIO__SIMD_NEON)
+static void provizio_byte_swap_32_neon(const uint8_t *in, uint8_t *out, size_t count)
+{
+    const size_t words_per_vector = sizeof(uint8x16_t) / sizeof(uint32_t);
+
+    size_t i = 0;
+    for (; i + words_per_vector <= count; i += words_per_vector)
+    {
+        vst1q_u8(&out[i * sizeof(uint32_t)], vrev32q_u8(vld1q_u8(&in[i * sizeof(uint32_t)])));
+    }
+
+    provizio_byte_swap_32_scalar(&in[i * sizeof(uint32_t)], &out[i * sizeof(uint32_t)], count - i);
+}
+#endif
+
+static provizio_byte_swap_32_function provizio_select_byte_swap_32(void)
+{
+#if defined(PROVIZIO__SIMD_X86)
+    if (PROVIZIO__SIMD_CPU_SUPPORTS("avx2"))
+    {
+        return &provizio_byte_swap_32_avx2;
+    }
+    if (PROVIZIO__SIMD_CPU_SUPPORTS("ssse3"))
+    {
+        return &provizio_byte_swap_32_ssse3;
+    }
+#elif defined(PROVIZIO__SIMD_NEON)
+    return &provizio_byte_swap_32_neon;
+#endif
+
+    return &provizio_byte_swap_32_scalar; // LCOV_EXCL_LINE: host CPU arch dependent
+}
+
+void provizio_get_protocol_fields_float(const void *fields, void *out_values, size_t count)
+{
+    const float test_value = 1.0F;
+    if (((const char *)(&test_value))[3] == 0)
+    {
+        // LCOV_EXCL_START: host CPU arch dependent
+        // Host uses network byte order for floats already
+        if (out_values != fields)
+        {
+            memmove(out_values, fields, sizeof(float) * count);
+        }
+        return;
+        // LCOV_EXCL_STOP
+    }
+
+    // Selected on the first call. Concurrent first calls may select it more than once, but they all select the same
+    // function, and it's published atomically.
+    static provizio_byte_swap_32_function selected_byte_swap_32 = NULL;
+    provizio_byte_swap_32_function byte_swap_32 =
+        (provizio_byte_swap_32_function)PROVIZIO__ATOMIC_LOAD_POINTER(&selected_byte_swap_32);
+    if (byte_swap_32 == NULL)
+    {
+        byte_swap_32 = provizio_select_byte_swap_32();
+        PROVIZIO__ATOMIC_STORE_POINTER(&selected_byte_swap_32, byte_swap_32);
+    }
+
+    byte_swap_32((const uint8_t *)fields, (uint8_t *)out_values, count);
+}
+
 #ifdef WIN32
 int32_t provizio_gettimeofday(struct timeval *out_timeval)
 {
@@ -224,3 +339,53 @@ float provizio_nanoseconds_to_seconds(int64_t duration_ns)
            milliseconds_in_second;
     // capacity
 }
+
+#ifdef WIN32
+void provizio_sleep_ns(uint64_t duration_ns)
+{
+    const uint64_t nanoseconds_in_millisecond = 1000000ULL;
+    Sleep((DWORD)((duration_ns + nanoseconds_in_millisecond - 1) / nanoseconds_in_millisecond));
+}
+#else
+void provizio_sleep_ns(uint64_t duration_ns)
+{
+    const uint64_t nanoseconds_in_second = 1000000000ULL;
+
+    struct timespec duration;
+    duration.tv_sec = (time_t)(duration_ns / nanoseconds_in_second);
+    duration.tv_nsec = (long)(duration_ns % nanoseconds_in_second);
+    while (nanosleep(&duration, &duration) != 0 && errno == EINTR) // NOLINT: No need to unroll
+    {
+        // Interrupted by a signal, sleeping for the remaining time
+    }
+}
+#endif // WIN32
+
+#ifdef WIN32
+uint64_t provizio_monotonic_time_ns(void)
+{
+    const uint64_t nanoseconds_in_second = 1000000000ULL;
+
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    const uint64_t ticks = (uint64_t)counter.QuadPart;
+    const uint64_t ticks_per_second = (uint64_t)frequency.QuadPart;
+    return ticks / ticks_per_second * nanoseconds_in_second +
+           ticks % ticks_per_second * nanoseconds_in_second / ticks_per_second;
+}
+#else
+uint64_t provizio_monotonic_time_ns(void)
+{
+    const uint64_t nanoseconds_in_second = 1000000000ULL;
+
+    struct timespec now;
+    const int result = clock_gettime(CLOCK_MONOTONIC, &now);
+    assert(result == 0); // CLOCK_MONOTONIC is always supported
+    (void)result;
+
+    return (uint64_t)now.tv_sec * nanoseconds_in_second + (uint64_t)now.tv_nsec;
+}
+#endif // WIN32
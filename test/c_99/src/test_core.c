@@ -15,11 +15,17 @@
 #include "unity/unity.h"
 
 #include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "provizio/atomic.h"
 #include "provizio/radar_api/core.h"
+#include "provizio/radar_api/io_uring_receiver.h"
+#include "provizio/radar_api/reuseport_receiver.h"
+#include "provizio/radar_api/threaded_receiver.h"
 #include "provizio/util.h"
 
 #include "test_point_cloud_callbacks.h"
@@ -364,7 +370,7 @@ static void test_receives_single_radar_point_cloud_from_single_radar(void)
     test_receive_packet_on_packet_sent_callback_data send_test_callback_data;
     memset(&send_test_callback_data, 0, sizeof(send_test_callback_data));
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, &api_context);
     provizio_radar_api_connection connection;
     int32_t status = provizio_open_radar_connection(port_number, 0, 0, &api_context, &connection);
@@ -538,7 +544,7 @@ static void test_receive_radar_point_cloud_frame_indices_overflow(void)
     test_receive_packet_on_packet_sent_callback_data send_test_callback_data;
     memset(&send_test_callback_data, 0, sizeof(send_test_callback_data));
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, &api_context);
     provizio_radar_api_connection connection;
     int32_t status = provizio_open_radar_connection(port_number, 0, 0, &api_context, &connection);
@@ -589,7 +595,7 @@ static void test_receive_radar_point_cloud_frame_position_ids_mismatch(void)
     test_receive_packet_on_packet_sent_callback_data send_test_callback_data;
     memset(&send_test_callback_data, 0, sizeof(send_test_callback_data));
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, &api_context);
     provizio_radar_api_connection connection;
     int32_t status = provizio_open_radar_connection(port_number, 0, 0, &api_context, &connection);
@@ -638,7 +644,7 @@ static void test_receive_radar_point_cloud_drop_obsolete_incomplete_frame(void)
     test_receive_packet_on_packet_sent_callback_data send_test_callback_data;
     memset(&send_test_callback_data, 0, sizeof(send_test_callback_data));
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, &api_context);
     provizio_radar_api_connection connection;
     int32_t status = provizio_open_radar_connection(port_number, 0, 0, &api_context, &connection);
@@ -680,7 +686,7 @@ static void test_receive_radar_point_cloud_too_many_points(void)
     const uint16_t num_points = 200;
     const uint16_t num_extra_points = 2;
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(NULL, NULL, &api_context);
     provizio_radar_api_connection connection;
     int32_t status = provizio_open_radar_connection(port_number, 0, 0, &api_context, &connection);
@@ -786,7 +792,7 @@ static void test_receive_radar_point_cloud_timeout_ok(void)
     test_provizio_radar_point_cloud_callback_data *callback_data =
         (test_provizio_radar_point_cloud_callback_data *)malloc(sizeof(test_provizio_radar_point_cloud_callback_data));
     memset(callback_data, 0, sizeof(test_provizio_radar_point_cloud_callback_data));
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, &api_context);
 
     provizio_radar_api_connection connection;
@@ -823,7 +829,7 @@ static void test_receive_radar_point_cloud_timeout_fails(void)
     const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
     const int32_t thousand = 1000;
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(NULL, NULL, &api_context);
 
     struct timeval time_was;
@@ -856,6 +862,1045 @@ static void test_receive_radar_point_cloud_timeout_fails(void)
     TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
 }
 
+static void test_receive_packets_batched(void)
+{
+    const uint16_t port_number = 10010 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
+    const uint32_t frame_index = 17;
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_id = provizio_radar_position_front_center;
+    const uint16_t radar_range = provizio_radar_range_medium;
+    const uint16_t num_points = 1000;
+    const size_t num_packets = (num_points + PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET - 1) /
+                               PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+    const size_t first_batch_packets = 5;
+
+    test_provizio_radar_point_cloud_callback_data *callback_data =
+        (test_provizio_radar_point_cloud_callback_data *)malloc(sizeof(test_provizio_radar_point_cloud_callback_data));
+    memset(callback_data, 0, sizeof(test_provizio_radar_point_cloud_callback_data));
+
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
+    provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, &api_context);
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_open_radar_connection(port_number, receive_timeout_ns, 0, &api_context, &connection));
+
+    // All packets get queued in the socket prior to receiving any of them
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, timestamp, &radar_position_id,
+                                                     &radar_range, 1, num_points, num_points, NULL, NULL));
+
+    // Receiving no more than requested
+    size_t num_packets_handled = 0;
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_radar_api_receive_packets(&connection, first_batch_packets, &num_packets_handled));
+    TEST_ASSERT_EQUAL_UINT64(first_batch_packets, num_packets_handled);
+    TEST_ASSERT_EQUAL_INT32(0, callback_data->called_times);
+
+    // Receiving all that's left, without waiting for more
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_receive_packets(&connection, 1000, &num_packets_handled));
+    TEST_ASSERT_EQUAL_UINT64(num_packets - first_batch_packets, num_packets_handled);
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT32(frame_index, callback_data->last_point_clouds[0].frame_index);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_clouds[0].num_points_expected);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_clouds[0].num_points_received);
+    TEST_ASSERT_EQUAL_FLOAT(12.33F, // NOLINT
+                            callback_data->last_point_clouds[0].radar_points[0].x_meters);
+
+    // Packets of another radar are all skipped, just like by provizio_radar_api_receive_packet
+    const uint16_t other_radar_position_id = provizio_radar_position_front_left;
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index + 1, timestamp, &other_radar_position_id,
+                                                     &radar_range, 1, num_points, num_points, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED,
+                            provizio_radar_api_receive_packets(&connection, 1000, &num_packets_handled));
+    TEST_ASSERT_EQUAL_UINT64(num_packets, num_packets_handled);
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+
+    // Nothing left
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, provizio_radar_api_receive_packets(&connection, 1000, NULL));
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+
+    free(callback_data);
+}
+
+static void test_provizio_radar_api_receive_packets_fails_as_not_connected(void)
+{
+    provizio_radar_api_connection api_connetion;
+    memset(&api_connetion, 0, sizeof(api_connetion));
+    api_connetion.sock = PROVIZIO__INVALID_SOCKET;
+
+    size_t num_packets_handled = 1;
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_radar_api_receive_packets(&api_connetion, 1, &num_packets_handled));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_receive_packets: Not connected", provizio_test_error);
+    TEST_ASSERT_EQUAL_UINT64(0, num_packets_handled);
+    provizio_set_on_error(NULL);
+}
+
+static void test_provizio_radar_api_receive_packets_fails_as_no_packets_requested(void)
+{
+    const uint16_t port_number = 10020 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_radar_connection(port_number, 0, 0, NULL, &connection));
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_receive_packets(&connection, 0, NULL));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_receive_packets: max_packets can't be 0", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+}
+
+static void test_pooled_radar_point_cloud_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                                                   provizio_pooled_radar_point_cloud_api_context *context)
+{
+    provizio_pooled_radar_point_cloud *last_point_cloud = (provizio_pooled_radar_point_cloud *)context->user_data;
+
+    *last_point_cloud = *point_cloud;
+    last_point_cloud->radar_points = NULL; // Not valid after the callback
+}
+
+static void test_receives_pooled_radar_point_clouds(void)
+{
+    const uint16_t port_number = 10021 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
+    const uint32_t frame_index = 17;
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_ids[2] = {provizio_radar_position_rear_left, provizio_radar_position_rear_right};
+    const uint16_t radar_ranges[2] = {provizio_radar_range_short, provizio_radar_range_long};
+    const uint16_t num_points = 500;
+    const size_t num_radars = sizeof(radar_position_ids) / sizeof(radar_position_ids[0]);
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, num_radars);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    provizio_pooled_radar_point_cloud last_point_cloud;
+    memset(&last_point_cloud, 0, sizeof(last_point_cloud));
+    provizio_pooled_radar_point_cloud_api_context api_contexts[2];
+    provizio_pooled_radar_point_cloud_api_contexts_init(&test_pooled_radar_point_cloud_callback, &last_point_cloud,
+                                                        &pool, api_contexts, num_radars);
+
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_pooled_radars_connection(port_number, receive_timeout_ns, 0, api_contexts,
+                                                                      num_radars, &connection));
+
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, timestamp, radar_position_ids,
+                                                     radar_ranges, num_radars, num_points, num_points, NULL, NULL));
+
+    int32_t status = 0;
+    while (status == 0) // NOLINT: No need to unroll
+    {
+        status = provizio_radar_api_receive_packet(&connection);
+    }
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, status);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+
+    TEST_ASSERT_EQUAL_UINT32(frame_index, last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(radar_position_ids[num_radars - 1], last_point_cloud.radar_position_id);
+    TEST_ASSERT_EQUAL_UINT16(radar_ranges[num_radars - 1], last_point_cloud.radar_range);
+    TEST_ASSERT_EQUAL_UINT16(num_points, last_point_cloud.num_points_expected);
+    TEST_ASSERT_EQUAL_UINT16(num_points, last_point_cloud.num_points_received);
+    TEST_ASSERT_EQUAL_UINT16(radar_position_ids[0], api_contexts[0].radar_position_id);
+    TEST_ASSERT_EQUAL_UINT16(radar_position_ids[1], api_contexts[1].radar_position_id);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(memory);
+}
+
+static void test_receives_pooled_radar_point_clouds_with_connection_options(void)
+{
+    const uint16_t port_number = 10028 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
+    const uint32_t frame_index = 19;
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_id = provizio_radar_position_front_left;
+    const uint16_t radar_range = provizio_radar_range_medium;
+    const uint16_t num_points = 500;
+    const size_t receive_buffer_size = 65536;
+
+    provizio_radar_api_connection_options options;
+    provizio_radar_api_connection_options_init(&options);
+    TEST_ASSERT_EQUAL_UINT64(0, options.receive_buffer_size);
+    TEST_ASSERT_EQUAL_UINT32(0, options.busy_poll_us);
+    TEST_ASSERT_EQUAL_INT32(-1, options.incoming_cpu);
+    TEST_ASSERT_NULL(options.multicast_group);
+    TEST_ASSERT_NULL(options.multicast_interface_address);
+    TEST_ASSERT_NULL(options.bind_interface);
+
+    options.receive_buffer_size = receive_buffer_size;
+#ifdef __linux__
+    options.incoming_cpu = 0;
+#endif // __linux__
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    provizio_pooled_radar_point_cloud last_point_cloud;
+    memset(&last_point_cloud, 0, sizeof(last_point_cloud));
+    provizio_pooled_radar_point_cloud_api_context api_context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_radar_point_cloud_callback, &last_point_cloud,
+                                                       &pool, &api_context);
+
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_pooled_radars_connection_with_options(
+                                   port_number, receive_timeout_ns, 0, &options, &api_context, 1, &connection));
+    // The OS may round the size up (Linux doubles it for bookkeeping), but this size is well within the defaults
+    TEST_ASSERT_TRUE(connection.receive_buffer_size >= receive_buffer_size);
+
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, timestamp, &radar_position_id,
+                                                     &radar_range, 1, num_points, num_points, NULL, NULL));
+
+    int32_t status = 0;
+    while (status == 0) // NOLINT: No need to unroll
+    {
+        status = provizio_radar_api_receive_packet(&connection);
+    }
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, status);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+
+    TEST_ASSERT_EQUAL_UINT32(frame_index, last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(radar_position_id, last_point_cloud.radar_position_id);
+    TEST_ASSERT_EQUAL_UINT16(num_points, last_point_cloud.num_points_received);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(memory);
+}
+
+static void test_open_radars_connection_with_invalid_options_fails(void)
+{
+    const uint16_t port_number = 10029 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_radars_connection(port_number, 0, 0, NULL, 0, &connection));
+    TEST_ASSERT_NOT_EQUAL(0, connection.receive_buffer_size);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radars_connection(&connection));
+
+    provizio_radar_api_connection_options options;
+    provizio_radar_api_connection_options_init(&options);
+    options.multicast_group = "not an address";
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_open_radars_connection_with_options(
+                                                     port_number, 0, 0, &options, NULL, 0, &connection));
+    TEST_ASSERT_EQUAL_STRING("provizio_open_radars_connection: Invalid multicast group or interface address",
+                             provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO__INVALID_SOCKET, connection.sock);
+
+    provizio_radar_api_connection_options_init(&options);
+    options.bind_interface = "provizio_none";
+    TEST_ASSERT_NOT_EQUAL(0, provizio_open_radars_connection_with_options(port_number, 0, 0, &options, NULL, 0,
+                                                                          &connection));
+#ifdef __linux__
+    TEST_ASSERT_EQUAL_STRING("provizio_open_radars_connection: Failed to bind to the network interface",
+                             provizio_test_error);
+#endif // __linux__
+    provizio_set_on_error(NULL);
+}
+
+#ifndef _WIN32
+static void test_records_received_packets(void)
+{
+    const uint16_t port_number = 10031 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
+    const uint32_t frame_index = 21;
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_id = provizio_radar_position_rear_center;
+    const uint16_t radar_range = provizio_radar_range_short;
+    const uint16_t num_points = PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET + 10; // 2 packets
+    const char *path_prefix = "provizio_test_core_packet_log";
+
+    test_provizio_radar_point_cloud_callback_data *callback_data =
+        (test_provizio_radar_point_cloud_callback_data *)malloc(sizeof(test_provizio_radar_point_cloud_callback_data));
+    memset(callback_data, 0, sizeof(test_provizio_radar_point_cloud_callback_data));
+
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
+    provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, &api_context);
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_open_radar_connection(port_number, receive_timeout_ns, 0, &api_context, &connection));
+    provizio_packet_recorder recorder;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_open(path_prefix, 0, 0, &recorder));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_set_packet_recorder(&connection, &recorder));
+
+    // The 1st packet is received by provizio_radar_api_receive_packet, the 2nd by provizio_radar_api_receive_packets
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, timestamp, &radar_position_id,
+                                                     &radar_range, 1, num_points, num_points, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_receive_packet(&connection));
+    size_t num_packets_handled = 0;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_receive_packets(
+                                   &connection, PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE, &num_packets_handled));
+    TEST_ASSERT_EQUAL_UINT64(1, num_packets_handled);
+
+    // Not recorded anymore
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_set_packet_recorder(&connection, NULL));
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index + 1, timestamp, &radar_position_id,
+                                                     &radar_range, 1, 1, 1, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_receive_packet(&connection));
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_close(&recorder));
+    TEST_ASSERT_EQUAL_UINT64(2, recorder.num_records);
+    TEST_ASSERT_EQUAL_INT32(2, callback_data->called_times);
+    free(callback_data);
+
+    char path[256];
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_log_segment_path(path_prefix, 0, path, sizeof(path)));
+    FILE *file = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(file);
+    provizio_packet_log_segment_header header;
+    TEST_ASSERT_EQUAL_UINT64(1, fread(&header, sizeof(header), 1, file));
+    TEST_ASSERT_EQUAL_UINT64(2, header.num_records);
+    TEST_ASSERT_EQUAL_UINT32(1, header.num_index_entries);
+
+    provizio_packet_log_index_entry index_entry;
+    fseek(file, (long)header.index_offset, SEEK_SET);
+    TEST_ASSERT_EQUAL_UINT64(1, fread(&index_entry, sizeof(index_entry), 1, file));
+    TEST_ASSERT_EQUAL_UINT16(radar_position_id, index_entry.radar_position_id);
+    TEST_ASSERT_EQUAL_UINT32(frame_index, index_entry.frame_index);
+    TEST_ASSERT_EQUAL_UINT64(header.records_offset, index_entry.record_offset);
+
+    // Bit-exact payloads along with their source addresses
+    provizio_packet_log_record_header record;
+    provizio_radar_point_cloud_packet packet;
+    fseek(file, (long)header.records_offset, SEEK_SET);
+    TEST_ASSERT_EQUAL_UINT64(1, fread(&record, sizeof(record), 1, file));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(provizio_radar_point_cloud_packet), record.payload_size);
+    TEST_ASSERT_EQUAL_UINT32(inet_addr("127.0.0.1"), record.source_address);
+    TEST_ASSERT_NOT_EQUAL(0, record.source_port);
+    TEST_ASSERT_NOT_EQUAL(0, record.receive_time_ns);
+    TEST_ASSERT_EQUAL_UINT64(1, fread(&packet, record.payload_size, 1, file));
+    TEST_ASSERT_EQUAL_UINT64(timestamp, provizio_get_protocol_field_uint64_t(&packet.header.timestamp));
+    TEST_ASSERT_EQUAL_UINT16(PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET,
+                             provizio_get_protocol_field_uint16_t(&packet.header.num_points_in_packet));
+    fclose(file);
+    remove(path);
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_set_packet_recorder(&connection, &recorder));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_set_packet_recorder: Not connected", provizio_test_error);
+    provizio_set_on_error(NULL);
+}
+#endif // _WIN32
+
+static void test_radar_api_tick_returns_partial_pooled_radar_point_clouds(void)
+{
+    const uint16_t port_number = 10024 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
+    const uint64_t completion_deadline_ns = 1000000ULL; // 1ms, i.e. shorter than the receive timeout
+    const uint32_t frame_index = 18;
+    const uint16_t radar_position_id = provizio_radar_position_front_center;
+    const uint16_t radar_range = provizio_radar_range_medium;
+    const uint16_t num_points = 500;
+    const uint16_t drop_after_num_points = 200;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    provizio_pooled_radar_point_cloud last_point_cloud;
+    memset(&last_point_cloud, 0, sizeof(last_point_cloud));
+    provizio_pooled_radar_point_cloud_api_context api_context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_radar_point_cloud_callback, &last_point_cloud,
+                                                       &pool, &api_context);
+    provizio_pooled_radar_point_cloud_api_context_set_completion_deadline(&api_context, completion_deadline_ns);
+
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_pooled_radars_connection(port_number, receive_timeout_ns, 0, &api_context,
+                                                                      1, &connection));
+
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, 0, &radar_position_id, &radar_range, 1,
+                                                     num_points, drop_after_num_points, NULL, NULL));
+
+    int32_t status = 0;
+    while (status == 0) // NOLINT: No need to unroll
+    {
+        status = provizio_radar_api_receive_packet(&connection);
+    }
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, status);
+    TEST_ASSERT_EQUAL_UINT16(0, last_point_cloud.num_points_expected);
+
+    // The rest of the frame is never sent, so it's returned as partial past the deadline
+    TEST_ASSERT_EQUAL_UINT64(1, provizio_radar_api_tick(&connection));
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_tick(&connection));
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+
+    TEST_ASSERT_EQUAL_UINT32(frame_index, last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(num_points, last_point_cloud.num_points_expected);
+    TEST_ASSERT_TRUE(last_point_cloud.num_points_received > 0 && // NOLINT: clang-tidy doesn't like TEST_ASSERT_TRUE
+                     last_point_cloud.num_points_received < num_points);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(memory);
+}
+
+static void test_receives_pooled_radar_point_clouds_with_receive_timestamps(void)
+{
+    const uint16_t port_number = 10025 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
+    const uint16_t radar_position_id = provizio_radar_position_front_center;
+    const uint16_t radar_range = provizio_radar_range_medium;
+    const uint16_t num_points = 500;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    provizio_pooled_radar_point_cloud last_point_cloud;
+    memset(&last_point_cloud, 0, sizeof(last_point_cloud));
+    provizio_pooled_radar_point_cloud_api_context api_context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_radar_point_cloud_callback, &last_point_cloud,
+                                                       &pool, &api_context);
+
+    provizio_radar_api_connection connection;
+    memset(&connection, 0, sizeof(connection));
+    connection.sock = PROVIZIO__INVALID_SOCKET;
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_enable_receive_timestamps(&connection));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_enable_receive_timestamps: Not connected", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_enable_hardware_receive_timestamps(&connection));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_enable_hardware_receive_timestamps: Not connected",
+                             provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_pooled_radars_connection(port_number, receive_timeout_ns, 0, &api_context,
+                                                                      1, &connection));
+#ifdef __linux__
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_enable_receive_timestamps(&connection));
+
+    struct timeval time_before;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_gettimeofday(&time_before));
+    const uint64_t nanoseconds_in_microsecond = 1000ULL;
+    const uint64_t nanoseconds_in_second = 1000000000ULL;
+    const uint64_t time_before_ns = (uint64_t)time_before.tv_sec * nanoseconds_in_second +
+                                    (uint64_t)time_before.tv_usec * nanoseconds_in_microsecond;
+
+    // Both single packet and batch receiving record receive times
+    for (uint32_t frame_index = 1; frame_index <= 2; ++frame_index)
+    {
+        TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, 0, &radar_position_id, &radar_range,
+                                                         1, num_points, num_points, NULL, NULL));
+
+        int32_t status = 0;
+        while (status == 0) // NOLINT: No need to unroll
+        {
+            status = frame_index == 1 ? provizio_radar_api_receive_packet(&connection)
+                                      : provizio_radar_api_receive_packets(&connection, num_points, NULL);
+        }
+        TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, status);
+
+        TEST_ASSERT_EQUAL_UINT32(frame_index, last_point_cloud.frame_index);
+        TEST_ASSERT_EQUAL_UINT16(num_points, last_point_cloud.num_points_received);
+        // Allowing for 1ms precision of provizio_gettimeofday in Windows
+        TEST_ASSERT_TRUE(last_point_cloud.first_packet_receive_time_ns + // NOLINT: clang-tidy doesn't like it
+                             nanoseconds_in_second / 1000 >=
+                         time_before_ns);
+        TEST_ASSERT_TRUE(last_point_cloud.last_packet_receive_time_ns >= // NOLINT: clang-tidy doesn't like it
+                         last_point_cloud.first_packet_receive_time_ns);
+    }
+
+    // Loopback packets are never timestamped by a NIC, and kernel times are not used instead of them
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_enable_hardware_receive_timestamps(&connection));
+    const uint32_t hardware_timestamps_frame_index = 3;
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, hardware_timestamps_frame_index, 0,
+                                                     &radar_position_id, &radar_range, 1, num_points, num_points, NULL,
+                                                     NULL));
+    int32_t status = 0;
+    while (status == 0) // NOLINT: No need to unroll
+    {
+        status = provizio_radar_api_receive_packet(&connection);
+    }
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, status);
+    TEST_ASSERT_EQUAL_UINT32(hardware_timestamps_frame_index, last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(num_points, last_point_cloud.num_points_received);
+    TEST_ASSERT_EQUAL_UINT64(0, last_point_cloud.first_packet_receive_time_ns);
+    TEST_ASSERT_EQUAL_UINT64(0, last_point_cloud.last_packet_receive_time_ns);
+#else
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_NOT_PERMITTED, provizio_radar_api_enable_receive_timestamps(&connection));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_NOT_PERMITTED,
+                            provizio_radar_api_enable_hardware_receive_timestamps(&connection));
+    provizio_set_on_error(NULL);
+    (void)radar_position_id;
+    (void)radar_range;
+#endif
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+    free(memory);
+}
+
+static void test_non_blocking_connection_drains_pooled_radar_point_clouds(void)
+{
+    const uint16_t port_number = 10026 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 5000000000ULL; // 5s, i.e. way longer than any non-blocking call may take
+    const uint32_t frame_index = 19;
+    const uint16_t radar_position_id = provizio_radar_position_front_center;
+    const uint16_t radar_range = provizio_radar_range_medium;
+    const uint16_t num_points = 500;
+    const size_t num_packets =
+        (num_points + PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET - 1) / PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    provizio_pooled_radar_point_cloud last_point_cloud;
+    memset(&last_point_cloud, 0, sizeof(last_point_cloud));
+    provizio_pooled_radar_point_cloud_api_context api_context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_radar_point_cloud_callback, &last_point_cloud,
+                                                       &pool, &api_context);
+
+    provizio_radar_api_connection connection;
+    memset(&connection, 0, sizeof(connection));
+    connection.sock = PROVIZIO__INVALID_SOCKET;
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_set_non_blocking(&connection, 1));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_set_non_blocking: Not connected", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_drain(&connection, NULL));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_drain: Not connected", provizio_test_error);
+    provizio_set_on_error(NULL);
+    TEST_ASSERT_FALSE(provizio_socket_valid(provizio_radar_api_get_socket(&connection)));
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_pooled_radars_connection(port_number, receive_timeout_ns, 0, &api_context,
+                                                                      1, &connection));
+    TEST_ASSERT_TRUE(provizio_socket_valid(provizio_radar_api_get_socket(&connection))); // NOLINT
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_set_non_blocking(&connection, 1));
+
+    // Nothing to receive yet, which doesn't make it wait
+    const uint64_t start_time_ns = provizio_monotonic_time_ns();
+    size_t num_packets_handled = 1;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, provizio_radar_api_receive_packet(&connection));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, provizio_radar_api_receive_packets(&connection, num_packets, NULL));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_drain(&connection, &num_packets_handled));
+    TEST_ASSERT_EQUAL_UINT64(0, num_packets_handled);
+    TEST_ASSERT_LESS_THAN(receive_timeout_ns, provizio_monotonic_time_ns() - start_time_ns);
+
+    // All the packets queued are handled at once
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, 0, &radar_position_id, &radar_range, 1,
+                                                     num_points, num_points, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_drain(&connection, &num_packets_handled));
+    TEST_ASSERT_EQUAL_UINT64(num_packets, num_packets_handled);
+    TEST_ASSERT_EQUAL_UINT32(frame_index, last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(num_points, last_point_cloud.num_points_received);
+
+    // Draining doesn't wait in blocking mode either
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_set_non_blocking(&connection, 0));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_drain(&connection, &num_packets_handled));
+    TEST_ASSERT_EQUAL_UINT64(0, num_packets_handled);
+    TEST_ASSERT_LESS_THAN(receive_timeout_ns, provizio_monotonic_time_ns() - start_time_ns);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+    free(memory);
+}
+
+static void test_io_uring_receiver_receives_pooled_radar_point_clouds(void)
+{
+    const uint16_t port_number = 10027 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 5000000000ULL; // 5s, not used by the io_uring receiver
+    const uint64_t wait_timeout_ns = 100000000ULL;     // 0.1s
+    const uint32_t frame_index = 20;
+    const uint16_t radar_position_id = provizio_radar_position_front_center;
+    const uint16_t radar_range = provizio_radar_range_medium;
+    const uint16_t num_points = 500;
+    const size_t num_packets =
+        (num_points + PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET - 1) / PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+    const size_t num_buffers = 4; // Fewer than packets in a frame, so the kernel runs out of them in the meantime
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    provizio_pooled_radar_point_cloud last_point_cloud;
+    memset(&last_point_cloud, 0, sizeof(last_point_cloud));
+    provizio_pooled_radar_point_cloud_api_context api_context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_radar_point_cloud_callback, &last_point_cloud,
+                                                       &pool, &api_context);
+
+    provizio_radar_api_connection connection;
+    memset(&connection, 0, sizeof(connection));
+    connection.sock = PROVIZIO__INVALID_SOCKET;
+    provizio_radar_api_io_uring_receiver receiver;
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_io_uring_receiver_init(&connection, 0, &receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_io_uring_receiver_init: Not connected", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_io_uring_receiver_receive(&receiver, 0, NULL));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_io_uring_receiver_receive: Not initialized", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_io_uring_receiver_release(&receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_io_uring_receiver_release: Not initialized", provizio_test_error);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_pooled_radars_connection(port_number, receive_timeout_ns, 0, &api_context,
+                                                                      1, &connection));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_io_uring_receiver_init(&connection, 3, &receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_io_uring_receiver_init: num_buffers must be a power of 2 not greater "
+                             "than PROVIZIO__RADAR_API_IO_URING_MAX_NUM_BUFFERS",
+                             provizio_test_error);
+    const int32_t init_status = provizio_radar_api_io_uring_receiver_init(&connection, num_buffers, &receiver);
+    provizio_set_on_error(NULL);
+    if (init_status == PROVIZIO_E_NOT_PERMITTED)
+    {
+        // io_uring is not supported on this platform or kernel
+        TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+        free(memory);
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT32(0, init_status);
+
+    // Nothing to receive yet
+    size_t num_packets_handled = 1;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, provizio_radar_api_io_uring_receiver_receive(&receiver, 0, NULL));
+    const uint64_t start_time_ns = provizio_monotonic_time_ns();
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT,
+                            provizio_radar_api_io_uring_receiver_receive(&receiver, wait_timeout_ns,
+                                                                         &num_packets_handled));
+    TEST_ASSERT_EQUAL_UINT64(0, num_packets_handled);
+    TEST_ASSERT_LESS_THAN(receive_timeout_ns, provizio_monotonic_time_ns() - start_time_ns);
+
+    // Packets the kernel had no buffers for are received once the buffers are returned
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, 0, &radar_position_id, &radar_range, 1,
+                                                     num_points, num_points, NULL, NULL));
+    size_t total_num_packets_handled = 0;
+    while (total_num_packets_handled < num_packets)
+    {
+        TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_io_uring_receiver_receive(&receiver, wait_timeout_ns,
+                                                                                &num_packets_handled));
+        TEST_ASSERT_LESS_OR_EQUAL(num_packets - total_num_packets_handled, num_packets_handled);
+        total_num_packets_handled += num_packets_handled;
+    }
+    TEST_ASSERT_EQUAL_UINT32(frame_index, last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(num_points, last_point_cloud.num_points_received);
+    TEST_ASSERT_EQUAL_UINT16(radar_position_id, last_point_cloud.radar_position_id);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_io_uring_receiver_release(&receiver));
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_io_uring_receiver_receive(&receiver, 0, NULL));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_io_uring_receiver_receive: Not initialized", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+    free(memory);
+}
+
+static void test_zero_copy_radar_point_cloud_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                                                      provizio_pooled_radar_point_cloud_api_context *context)
+{
+    provizio_pooled_radar_point_cloud *last_point_cloud = (provizio_pooled_radar_point_cloud *)context->user_data;
+
+    size_t num_points = 0;
+    for (size_t i = 0; i < point_cloud->num_spans; ++i)
+    {
+        // Points are kept right in the packet buffers they've been received to
+        TEST_ASSERT_NOT_NULL(provizio_radar_packet_pool_find(
+            context->packet_pool, (const uint8_t *)point_cloud->spans[i].radar_points -
+                                      offsetof(provizio_radar_point_cloud_packet, radar_points)));
+        num_points += point_cloud->spans[i].num_points;
+    }
+    TEST_ASSERT_EQUAL_UINT64(point_cloud->num_points_received, num_points);
+
+    *last_point_cloud = *point_cloud;
+    last_point_cloud->spans = NULL; // Not valid after the callback
+}
+
+static void test_receives_zero_copy_radar_point_clouds(void)
+{
+    const uint16_t port_number = 10022 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
+    const uint32_t frame_index = 18;
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_ids[2] = {provizio_radar_position_rear_left, provizio_radar_position_rear_right};
+    const uint16_t radar_ranges[2] = {provizio_radar_range_short, provizio_radar_range_long};
+    const uint16_t num_points = 500;
+    const size_t num_radars = sizeof(radar_position_ids) / sizeof(radar_position_ids[0]);
+
+    const size_t num_buffers = provizio_radar_packet_pool_num_buffers(num_points, num_radars);
+    provizio_radar_packet_buffer *buffers =
+        (provizio_radar_packet_buffer *)malloc(sizeof(provizio_radar_packet_buffer) * num_buffers);
+    provizio_radar_point_span *spans =
+        (provizio_radar_point_span *)malloc(sizeof(provizio_radar_point_span) * num_buffers);
+    provizio_radar_packet_pool packet_pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_packet_pool_init(buffers, spans, num_buffers, &packet_pool));
+
+    provizio_pooled_radar_point_cloud last_point_cloud;
+    memset(&last_point_cloud, 0, sizeof(last_point_cloud));
+    provizio_pooled_radar_point_cloud_api_context api_contexts[2];
+    provizio_pooled_radar_point_cloud_api_contexts_init_zero_copy(&test_zero_copy_radar_point_cloud_callback,
+                                                                  &last_point_cloud, &packet_pool, api_contexts,
+                                                                  num_radars);
+
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_pooled_radars_connection(port_number, receive_timeout_ns, 0, api_contexts,
+                                                                      num_radars, &connection));
+
+    TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, timestamp, radar_position_ids,
+                                                     radar_ranges, num_radars, num_points, num_points, NULL, NULL));
+
+    int32_t status = 0;
+    while (status == 0) // NOLINT: No need to unroll
+    {
+        status = provizio_radar_api_receive_packets(&connection, PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE, NULL);
+    }
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, status);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+
+    TEST_ASSERT_EQUAL_UINT32(frame_index, last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(radar_position_ids[num_radars - 1], last_point_cloud.radar_position_id);
+    TEST_ASSERT_EQUAL_UINT16(num_points, last_point_cloud.num_points_received);
+    TEST_ASSERT_EQUAL_UINT64((num_points + PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET - 1) /
+                                 PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET,
+                             last_point_cloud.num_spans);
+    TEST_ASSERT_EQUAL_UINT32(num_buffers, packet_pool.num_free_buffers);
+
+    free(spans);
+    free(buffers);
+}
+
+static void test_zero_copy_burst_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                                          provizio_pooled_radar_point_cloud_api_context *context)
+{
+    size_t *num_complete_point_clouds = (size_t *)context->user_data;
+    if (point_cloud->num_points_received == point_cloud->num_points_expected)
+    {
+        ++*num_complete_point_clouds;
+    }
+}
+
+static void test_receives_zero_copy_burst_with_recommended_packet_pool(void)
+{
+    const uint16_t port_number = 10033 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
+    const uint32_t first_frame_index = 30;
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_ids[2] = {provizio_radar_position_rear_left, provizio_radar_position_rear_right};
+    const uint16_t radar_ranges[2] = {provizio_radar_range_short, provizio_radar_range_long};
+    const uint16_t num_points = 500;
+    const size_t num_radars = sizeof(radar_position_ids) / sizeof(radar_position_ids[0]);
+    const size_t num_frames = 4;
+
+    const size_t num_buffers = provizio_radar_packet_pool_num_buffers(num_points, num_radars);
+    provizio_radar_packet_buffer *buffers =
+        (provizio_radar_packet_buffer *)malloc(sizeof(provizio_radar_packet_buffer) * num_buffers);
+    provizio_radar_point_span *spans =
+        (provizio_radar_point_span *)malloc(sizeof(provizio_radar_point_span) * num_buffers);
+    provizio_radar_packet_pool packet_pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_packet_pool_init(buffers, spans, num_buffers, &packet_pool));
+
+    size_t num_complete_point_clouds = 0;
+    provizio_pooled_radar_point_cloud_api_context api_contexts[2];
+    provizio_pooled_radar_point_cloud_api_contexts_init_zero_copy(&test_zero_copy_burst_callback,
+                                                                  &num_complete_point_clouds, &packet_pool,
+                                                                  api_contexts, num_radars);
+
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_pooled_radars_connection(port_number, receive_timeout_ns, 0, api_contexts,
+                                                                      num_radars, &connection));
+
+    // All frames get queued in the socket prior to receiving any of them, so every batch is full. Every other frame is
+    // incomplete, so it keeps its packet buffers until it gets pushed out of the window.
+    for (size_t i = 0; i < num_frames; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, first_frame_index + (uint32_t)i, timestamp,
+                                                         radar_position_ids, radar_ranges, num_radars, num_points,
+                                                         i % 2 == 0 ? num_points / 2 : num_points, NULL, NULL));
+    }
+
+    int32_t status = 0;
+    while (status == 0) // NOLINT: No need to unroll
+    {
+        status = provizio_radar_api_receive_packets(&connection, PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE, NULL);
+    }
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, status);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radar_connection(&connection));
+
+    TEST_ASSERT_EQUAL_UINT64(num_frames / 2 * num_radars, num_complete_point_clouds);
+    for (size_t i = 0; i < num_radars; ++i)
+    {
+        provizio_pooled_radar_point_cloud_api_context_release(&api_contexts[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(num_buffers, packet_pool.num_free_buffers);
+
+    free(spans);
+    free(buffers);
+}
+
+#ifndef _WIN32
+typedef struct test_threaded_receiver_callback_data // NOLINT: it's aligned exactly as it's supposed to
+{
+    pthread_mutex_t *mutex;
+    int32_t called_times;
+    int32_t num_received_at;          // Point clouds with receive times
+    uint16_t radar_position_ids_mask; // Bit per radar_position_id, which point clouds have been handled by this worker
+} test_threaded_receiver_callback_data;
+
+static void test_threaded_receiver_callback(const provizio_radar_point_cloud *point_cloud,
+                                            provizio_radar_point_cloud_api_context *context)
+{
+    test_threaded_receiver_callback_data *data = (test_threaded_receiver_callback_data *)context->user_data;
+
+    pthread_mutex_lock(data->mutex);
+    ++data->called_times;
+    if (point_cloud->first_packet_receive_time_ns != 0 && point_cloud->last_packet_receive_time_ns != 0)
+    {
+        ++data->num_received_at;
+    }
+    data->radar_position_ids_mask |= (uint16_t)(1U << point_cloud->radar_position_id);
+    pthread_mutex_unlock(data->mutex);
+}
+
+static void test_threaded_receiver_receives_sharded_radar_point_clouds(void)
+{
+    enum
+    {
+        num_workers = 2,
+        contexts_per_worker = 2,
+        queue_length = 64,
+        num_frames = 3
+    };
+    const uint16_t port_number = 10022 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL; // 0.1s
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_ids[3] = {provizio_radar_position_front_center, provizio_radar_position_front_left,
+                                            provizio_radar_position_front_right};
+    const uint16_t radar_ranges[3] = {provizio_radar_range_short, provizio_radar_range_medium,
+                                      provizio_radar_range_long};
+    const size_t num_radars = sizeof(radar_position_ids) / sizeof(radar_position_ids[0]);
+    const uint16_t num_points = 200;
+    const char *path_prefix = "provizio_test_threaded_receiver_packet_log";
+
+    pthread_mutex_t mutex;
+    pthread_mutex_init(&mutex, NULL);
+    test_threaded_receiver_callback_data callback_data[num_workers];
+    memset(callback_data, 0, sizeof(callback_data));
+
+    provizio_radar_point_cloud_api_context *contexts = (provizio_radar_point_cloud_api_context *)malloc(
+        sizeof(provizio_radar_point_cloud_api_context) * num_workers * contexts_per_worker);
+    provizio_threaded_radar_packet *queue_slots =
+        (provizio_threaded_radar_packet *)malloc(sizeof(provizio_threaded_radar_packet) * num_workers * queue_length);
+    provizio_threaded_radar_api_worker workers[num_workers];
+    for (size_t i = 0; i < num_workers; ++i)
+    {
+        callback_data[i].mutex = &mutex;
+        provizio_radar_point_cloud_api_contexts_init(&test_threaded_receiver_callback, &callback_data[i],
+                                                     &contexts[i * contexts_per_worker], contexts_per_worker);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_threaded_radar_api_worker_init(&contexts[i * contexts_per_worker],
+                                                                           contexts_per_worker,
+                                                                           &queue_slots[i * queue_length],
+                                                                           queue_length, &workers[i]));
+    }
+
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_open_radars_connection(port_number, receive_timeout_ns, 0, NULL, 0, &connection));
+#ifdef __linux__
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_enable_receive_timestamps(&connection));
+#endif // __linux__
+    provizio_packet_recorder recorder;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_open(path_prefix, 0, 0, &recorder));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_set_packet_recorder(&connection, &recorder));
+    provizio_threaded_radar_api_receiver receiver;
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_threaded_radar_api_receiver_start(&connection, workers, num_workers, &receiver));
+
+    for (uint32_t frame_index = 0; frame_index < num_frames; ++frame_index)
+    {
+        TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, timestamp + frame_index,
+                                                         radar_position_ids, radar_ranges, num_radars, num_points,
+                                                         num_points, NULL, NULL));
+    }
+
+    // Wait for all the point clouds to get handled (up to 5s)
+    const struct timespec sleep_timespec = {0, 10000000}; // 10ms
+    int32_t total_called_times = 0;
+    for (int32_t i = 0; i < 500 && total_called_times < (int32_t)(num_frames * num_radars); ++i) // NOLINT
+    {
+        nanosleep(&sleep_timespec, NULL);
+        pthread_mutex_lock(&mutex);
+        total_called_times = callback_data[0].called_times + callback_data[1].called_times;
+        pthread_mutex_unlock(&mutex);
+    }
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_threaded_radar_api_receiver_stop(&receiver));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radars_connection(&connection));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_close(&recorder));
+    char path[256];
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_log_segment_path(path_prefix, 0, path, sizeof(path)));
+    remove(path);
+
+    // All packets are recorded by the I/O thread
+    const size_t num_packets_per_frame =
+        (num_points + PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET - 1) / PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+    TEST_ASSERT_EQUAL_UINT64(num_frames * num_radars * num_packets_per_frame, recorder.num_records);
+#ifdef __linux__
+    TEST_ASSERT_EQUAL_INT32(num_frames * 2, callback_data[0].num_received_at);
+    TEST_ASSERT_EQUAL_INT32(num_frames, callback_data[1].num_received_at);
+#endif // __linux__
+
+    // radar_position_id % num_workers selects the worker
+    TEST_ASSERT_EQUAL_INT32(num_frames * 2, callback_data[0].called_times);
+    TEST_ASSERT_EQUAL_UINT16((1U << provizio_radar_position_front_center) | (1U << provizio_radar_position_front_right),
+                             callback_data[0].radar_position_ids_mask);
+    TEST_ASSERT_EQUAL_INT32(num_frames, callback_data[1].called_times);
+    TEST_ASSERT_EQUAL_UINT16(1U << provizio_radar_position_front_left, callback_data[1].radar_position_ids_mask);
+    TEST_ASSERT_EQUAL_UINT32(0, PROVIZIO__ATOMIC_LOAD_UINT32(&workers[0].num_dropped_packets));
+    TEST_ASSERT_EQUAL_UINT32(0, PROVIZIO__ATOMIC_LOAD_UINT32(&workers[1].num_dropped_packets));
+    TEST_ASSERT_EQUAL_UINT32(0, PROVIZIO__ATOMIC_LOAD_UINT32(&receiver.num_skipped_packets));
+
+    free(queue_slots);
+    free(contexts);
+    pthread_mutex_destroy(&mutex);
+}
+
+static void test_threaded_receiver_fails_on_invalid_arguments(void)
+{
+    const uint16_t port_number = 10023 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    provizio_threaded_radar_packet queue_slot;
+    static provizio_radar_point_cloud_api_context context; // NOLINT: static to keep the stack small
+    provizio_radar_point_cloud_api_context_init(NULL, NULL, &context);
+    provizio_threaded_radar_api_worker worker;
+    provizio_threaded_radar_api_receiver receiver;
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_threaded_radar_api_worker_init(NULL, 1, &queue_slot, 1,
+                                                                                         &worker));
+    TEST_ASSERT_EQUAL_STRING("provizio_threaded_radar_api_worker_init: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_threaded_radar_api_worker_init_pooled(NULL, 1, &queue_slot,
+                                                                                                1, &worker));
+    TEST_ASSERT_EQUAL_STRING("provizio_threaded_radar_api_worker_init_pooled: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_threaded_radar_api_worker_init(&context, 1, &queue_slot, 0,
+                                                                                         &worker));
+    TEST_ASSERT_EQUAL_STRING("provizio_spsc_queue_init: Invalid arguments", provizio_test_error);
+
+    provizio_radar_api_connection connection;
+    memset(&connection, 0, sizeof(connection));
+    connection.sock = PROVIZIO__INVALID_SOCKET;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_threaded_radar_api_receiver_start(&connection, &worker, 1, &receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_threaded_radar_api_receiver_start: Not connected", provizio_test_error);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_open_radars_connection(port_number, 0, 0, NULL, 0, &connection));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_threaded_radar_api_receiver_start(&connection, &worker, 0, &receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_threaded_radar_api_receiver_start: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_threaded_radar_api_receiver_start(&connection, &worker, 1, &receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_threaded_radar_api_receiver_start: Uninitialized worker", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_threaded_radar_api_receiver_stop(&receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_threaded_radar_api_receiver_stop: Not started", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radars_connection(&connection));
+}
+#endif // _WIN32
+
+#ifdef __linux__
+static void test_reuseport_receiver_steers_radar_point_clouds_to_shards(void)
+{
+    enum
+    {
+        num_shards = 2,
+        contexts_per_shard = 2,
+        num_frames = 3
+    };
+    const uint16_t port_number = 10030 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_ids[3] = {provizio_radar_position_front_center, provizio_radar_position_front_left,
+                                            provizio_radar_position_front_right};
+    const uint16_t radar_ranges[3] = {provizio_radar_range_short, provizio_radar_range_medium,
+                                      provizio_radar_range_long};
+    const size_t num_radars = sizeof(radar_position_ids) / sizeof(radar_position_ids[0]);
+    const uint16_t num_points = 200;
+
+    pthread_mutex_t mutex;
+    pthread_mutex_init(&mutex, NULL);
+    test_threaded_receiver_callback_data callback_data[num_shards];
+    memset(callback_data, 0, sizeof(callback_data));
+
+    provizio_radar_point_cloud_api_context *contexts = (provizio_radar_point_cloud_api_context *)malloc(
+        sizeof(provizio_radar_point_cloud_api_context) * num_shards * contexts_per_shard);
+    provizio_reuseport_radar_api_shard shards[num_shards];
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+        callback_data[i].mutex = &mutex;
+        provizio_radar_point_cloud_api_contexts_init(&test_threaded_receiver_callback, &callback_data[i],
+                                                     &contexts[i * contexts_per_shard], contexts_per_shard);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_reuseport_radar_api_shard_init(&contexts[i * contexts_per_shard],
+                                                                           contexts_per_shard, &shards[i]));
+    }
+
+    provizio_reuseport_radar_api_receiver receiver;
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_reuseport_radar_api_receiver_start(port_number, NULL, shards, num_shards, &receiver));
+
+    // All the radars are sent from the same address and port, so only the steering program can split them by shards
+    for (uint32_t frame_index = 0; frame_index < num_frames; ++frame_index)
+    {
+        TEST_ASSERT_EQUAL_INT32(0, send_test_point_cloud(port_number, frame_index, timestamp + frame_index,
+                                                         radar_position_ids, radar_ranges, num_radars, num_points,
+                                                         num_points, NULL, NULL));
+    }
+
+    // Wait for all the point clouds to get handled (up to 5s)
+    const struct timespec sleep_timespec = {0, 10000000}; // 10ms
+    int32_t total_called_times = 0;
+    for (int32_t i = 0; i < 500 && total_called_times < (int32_t)(num_frames * num_radars); ++i) // NOLINT
+    {
+        nanosleep(&sleep_timespec, NULL);
+        pthread_mutex_lock(&mutex);
+        total_called_times = callback_data[0].called_times + callback_data[1].called_times;
+        pthread_mutex_unlock(&mutex);
+    }
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_reuseport_radar_api_receiver_stop(&receiver));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO__INVALID_SOCKET, shards[0].connection.sock);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO__INVALID_SOCKET, shards[1].connection.sock);
+
+    // radar_position_id % num_shards selects the shard
+    TEST_ASSERT_EQUAL_INT32(num_frames * 2, callback_data[0].called_times);
+    TEST_ASSERT_EQUAL_UINT16((1U << provizio_radar_position_front_center) | (1U << provizio_radar_position_front_right),
+                             callback_data[0].radar_position_ids_mask);
+    TEST_ASSERT_EQUAL_INT32(num_frames, callback_data[1].called_times);
+    TEST_ASSERT_EQUAL_UINT16(1U << provizio_radar_position_front_left, callback_data[1].radar_position_ids_mask);
+
+    free(contexts);
+    pthread_mutex_destroy(&mutex);
+}
+
+static void test_reuseport_receiver_fails_on_invalid_arguments(void)
+{
+    provizio_reuseport_radar_api_shard shard;
+    provizio_reuseport_radar_api_receiver receiver;
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_reuseport_radar_api_shard_init(NULL, 1, &shard));
+    TEST_ASSERT_EQUAL_STRING("provizio_reuseport_radar_api_shard_init: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_reuseport_radar_api_shard_init_pooled(NULL, 1, &shard));
+    TEST_ASSERT_EQUAL_STRING("provizio_reuseport_radar_api_shard_init_pooled: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_reuseport_radar_api_receiver_start(0, NULL, &shard, 0,
+                                                                                             &receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_reuseport_radar_api_receiver_start: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_reuseport_radar_api_receiver_start(0, NULL, &shard, 1,
+                                                                                             &receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_reuseport_radar_api_receiver_start: Uninitialized shard", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_reuseport_radar_api_receiver_stop(&receiver));
+    TEST_ASSERT_EQUAL_STRING("provizio_reuseport_radar_api_receiver_stop: Not started", provizio_test_error);
+    provizio_set_on_error(NULL);
+}
+#endif // __linux__
+
 static void test_provizio_radar_point_cloud_api_contexts_receive_packet_fails_as_not_connected(void)
 {
     provizio_radar_api_connection api_connetion;
@@ -1249,7 +2294,30 @@ int provizio_run_test_core(void)
     RUN_TEST(test_receive_radar_point_cloud_not_enough_contexts);
     RUN_TEST(test_receive_radar_point_cloud_timeout_ok);
     RUN_TEST(test_receive_radar_point_cloud_timeout_fails);
+    RUN_TEST(test_receive_packets_batched);
+    RUN_TEST(test_receives_pooled_radar_point_clouds);
+    RUN_TEST(test_receives_pooled_radar_point_clouds_with_connection_options);
+    RUN_TEST(test_open_radars_connection_with_invalid_options_fails);
+#ifndef _WIN32
+    RUN_TEST(test_records_received_packets);
+#endif // _WIN32
+    RUN_TEST(test_radar_api_tick_returns_partial_pooled_radar_point_clouds);
+    RUN_TEST(test_receives_pooled_radar_point_clouds_with_receive_timestamps);
+    RUN_TEST(test_non_blocking_connection_drains_pooled_radar_point_clouds);
+    RUN_TEST(test_io_uring_receiver_receives_pooled_radar_point_clouds);
+    RUN_TEST(test_receives_zero_copy_radar_point_clouds);
+    RUN_TEST(test_receives_zero_copy_burst_with_recommended_packet_pool);
+#ifndef _WIN32
+    RUN_TEST(test_threaded_receiver_receives_sharded_radar_point_clouds);
+    RUN_TEST(test_threaded_receiver_fails_on_invalid_arguments);
+#endif // _WIN32
+#ifdef __linux__
+    RUN_TEST(test_reuseport_receiver_steers_radar_point_clouds_to_shards);
+    RUN_TEST(test_reuseport_receiver_fails_on_invalid_arguments);
+#endif // __linux__
     RUN_TEST(test_provizio_radar_point_cloud_api_contexts_receive_packet_fails_as_not_connected);
+    RUN_TEST(test_provizio_radar_api_receive_packets_fails_as_not_connected);
+    RUN_TEST(test_provizio_radar_api_receive_packets_fails_as_no_packets_requested);
     RUN_TEST(test_provizio_radar_point_cloud_api_close_fails_as_not_connected);
     RUN_TEST(test_provizio_set_radar_range_ok);
     RUN_TEST(test_provizio_set_radar_range_broadcasting_ok);
@@ -0,0 +1,97 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/histogram.h"
+
+static void test_provizio_histogram_buckets(void)
+{
+    // Small values are exact
+    for (uint64_t value = 0; value < 2 * PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT; ++value)
+    {
+        const size_t bucket_index = provizio_histogram_bucket_index(value);
+        TEST_ASSERT_EQUAL_UINT64(value, provizio_histogram_bucket_lowest_value(bucket_index));
+        TEST_ASSERT_EQUAL_UINT64(value, provizio_histogram_bucket_highest_value(bucket_index));
+    }
+
+    // Larger ones are within the bucket's range, which is narrow relative to the value
+    const uint64_t values[] = {16, 17, 100, 1000, 123456789, 0x8000000000000000ULL, UINT64_MAX};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+        const size_t bucket_index = provizio_histogram_bucket_index(values[i]);
+        const uint64_t lowest_value = provizio_histogram_bucket_lowest_value(bucket_index);
+        const uint64_t highest_value = provizio_histogram_bucket_highest_value(bucket_index);
+        TEST_ASSERT_LESS_THAN(PROVIZIO__HISTOGRAM_BUCKETS_COUNT, bucket_index);
+        TEST_ASSERT_TRUE(lowest_value <= values[i] && values[i] <= highest_value); // NOLINT
+        TEST_ASSERT_LESS_OR_EQUAL(lowest_value / PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT, highest_value - lowest_value);
+    }
+
+    // Buckets are contiguous
+    for (size_t i = 0; i + 1 < PROVIZIO__HISTOGRAM_BUCKETS_COUNT; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT64(provizio_histogram_bucket_highest_value(i) + 1,
+                                 provizio_histogram_bucket_lowest_value(i + 1));
+        TEST_ASSERT_EQUAL_size_t(i, provizio_histogram_bucket_index(provizio_histogram_bucket_lowest_value(i)));
+    }
+    TEST_ASSERT_EQUAL_size_t(PROVIZIO__HISTOGRAM_BUCKETS_COUNT - 1, provizio_histogram_bucket_index(UINT64_MAX));
+}
+
+static void test_provizio_histogram_record_and_percentiles(void)
+{
+    static provizio_histogram histogram; // NOLINT: static to keep the stack small
+    static provizio_histogram snapshot;  // NOLINT: static to keep the stack small
+    memset(&histogram, 0, sizeof(histogram));
+
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_histogram_value_at_percentile(&histogram, 50.0));
+
+    // 1..100
+    for (uint64_t value = 1; value <= 100; ++value)
+    {
+        provizio_histogram_record(&histogram, value);
+    }
+
+    provizio_histogram_snapshot(&histogram, &snapshot);
+    TEST_ASSERT_EQUAL_UINT64(100, snapshot.count);
+    TEST_ASSERT_EQUAL_UINT64(5050, snapshot.sum);
+    TEST_ASSERT_EQUAL_UINT64(100, snapshot.max);
+    TEST_ASSERT_EQUAL_MEMORY(histogram.buckets, snapshot.buckets, sizeof(histogram.buckets));
+
+    // Exact for small values
+    TEST_ASSERT_EQUAL_UINT64(1, provizio_histogram_value_at_percentile(&snapshot, 0.0));
+    TEST_ASSERT_EQUAL_UINT64(1, provizio_histogram_value_at_percentile(&snapshot, 1.0));
+    TEST_ASSERT_EQUAL_UINT64(10, provizio_histogram_value_at_percentile(&snapshot, 10.0));
+
+    // Within the bucket precision for larger ones
+    const uint64_t median = provizio_histogram_value_at_percentile(&snapshot, 50.0);
+    TEST_ASSERT_TRUE(median >= 50 && median < 50 + 50 / PROVIZIO__HISTOGRAM_SUB_BUCKETS_COUNT); // NOLINT
+    const uint64_t p99 = provizio_histogram_value_at_percentile(&snapshot, 99.0);
+    TEST_ASSERT_TRUE(p99 >= 99 && p99 <= 100); // NOLINT
+
+    // Capped by the max value recorded
+    TEST_ASSERT_EQUAL_UINT64(100, provizio_histogram_value_at_percentile(&snapshot, 100.0));
+    TEST_ASSERT_EQUAL_UINT64(100, provizio_histogram_value_at_percentile(&snapshot, 200.0));
+}
+
+int provizio_run_test_histogram(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provizio_histogram_buckets);
+    RUN_TEST(test_provizio_histogram_record_and_percentiles);
+
+    return UNITY_END();
+}
@@ -26,7 +26,17 @@ void tearDown(void) // NOLINT: this exact name is required by the unit testing f
 
 int provizio_run_test_common(void);
 int provizio_run_test_util(void);
+int provizio_run_test_memory_pool(void);
+int provizio_run_test_spsc_queue(void);
+int provizio_run_test_histogram(void);
 int provizio_run_test_radar_point_cloud(void);
+int provizio_run_test_pooled_radar_point_cloud(void);
+int provizio_run_test_radar_packet_pool(void);
+int provizio_run_test_radar_point_cloud_queue(void);
+int provizio_run_test_packet_recorder(void);
+int provizio_run_test_packet_replay(void);
+int provizio_run_test_radar_simulator(void);
+int provizio_run_test_radar_api_arena(void);
 int provizio_run_test_core(void);
 int provizio_run_test_radar_points_accumulation_types(void);
 int provizio_run_test_radar_points_accumulation_filters(void);
@@ -41,7 +51,17 @@ int main(int argc, char *argv[])
 #define PROVIZIO__RUN_TEST(test) result = result ? result : test()
     PROVIZIO__RUN_TEST(provizio_run_test_common);
     PROVIZIO__RUN_TEST(provizio_run_test_util);
+    PROVIZIO__RUN_TEST(provizio_run_test_memory_pool);
+    PROVIZIO__RUN_TEST(provizio_run_test_spsc_queue);
+    PROVIZIO__RUN_TEST(provizio_run_test_histogram);
     PROVIZIO__RUN_TEST(provizio_run_test_radar_point_cloud);
+    PROVIZIO__RUN_TEST(provizio_run_test_radar_packet_pool);
+    PROVIZIO__RUN_TEST(provizio_run_test_pooled_radar_point_cloud);
+    PROVIZIO__RUN_TEST(provizio_run_test_radar_point_cloud_queue);
+    PROVIZIO__RUN_TEST(provizio_run_test_packet_recorder);
+    PROVIZIO__RUN_TEST(provizio_run_test_packet_replay);
+    PROVIZIO__RUN_TEST(provizio_run_test_radar_simulator);
+    PROVIZIO__RUN_TEST(provizio_run_test_radar_api_arena);
     PROVIZIO__RUN_TEST(provizio_run_test_core);
     PROVIZIO__RUN_TEST(provizio_run_test_radar_points_accumulation_types);
     PROVIZIO__RUN_TEST(provizio_run_test_radar_points_accumulation_filters);
@@ -0,0 +1,174 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/memory_pool.h"
+#include "provizio/radar_api/errno.h"
+
+enum
+{
+    test_message_length = 1024
+};
+static char provizio_test_error[test_message_length]; // NOLINT: non-const global by design
+
+static void test_provizio_on_error(const char *error)
+{
+    strncpy(provizio_test_error, error, test_message_length - 1);
+}
+
+static uint8_t *test_align_memory(uint8_t *memory)
+{
+    const size_t misalignment = (size_t)((uintptr_t)memory % PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+    return misalignment != 0 ? memory + PROVIZIO__MEMORY_POOL_UNIT_SIZE - misalignment : memory;
+}
+
+static void test_provizio_memory_pool_init_fails_on_insufficient_memory(void)
+{
+    uint64_t memory[PROVIZIO__MEMORY_POOL_UNIT_SIZE / sizeof(uint64_t)];
+    provizio_memory_pool pool;
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_memory_pool_init(NULL, 1024, &pool)); // NOLINT
+    TEST_ASSERT_EQUAL_STRING("provizio_memory_pool_init: Not enough memory", provizio_test_error);
+    memset(provizio_test_error, 0, sizeof(provizio_test_error));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_memory_pool_init(memory, sizeof(memory), &pool));
+    TEST_ASSERT_EQUAL_STRING("provizio_memory_pool_init: Not enough memory", provizio_test_error);
+    provizio_set_on_error(NULL);
+}
+
+static void test_provizio_memory_pool_allocates_aligned_memory(void)
+{
+    const size_t num_units = 10;
+    uint8_t *memory = (uint8_t *)malloc((num_units + 1) * PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+
+    // Intentionally misaligned
+    uint8_t *misaligned_memory = test_align_memory(memory) + 1;
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_memory_pool_init(misaligned_memory, num_units * PROVIZIO__MEMORY_POOL_UNIT_SIZE, &pool));
+    TEST_ASSERT_EQUAL_UINT64(num_units - 1, pool.num_units);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    uint8_t *allocation_a = (uint8_t *)provizio_memory_pool_allocate(&pool, 1);
+    uint8_t *allocation_b = (uint8_t *)provizio_memory_pool_allocate(&pool, PROVIZIO__MEMORY_POOL_UNIT_SIZE + 1);
+    TEST_ASSERT_NOT_NULL(allocation_a);
+    TEST_ASSERT_NOT_NULL(allocation_b);
+    TEST_ASSERT_EQUAL_UINT64(0, (uintptr_t)allocation_a % PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+    TEST_ASSERT_EQUAL_UINT64(0, (uintptr_t)allocation_b % PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+    TEST_ASSERT_TRUE(allocation_a >= misaligned_memory); // NOLINT: clang-tidy doesn't like TEST_ASSERT_TRUE
+    TEST_ASSERT_TRUE(allocation_b >= allocation_a + PROVIZIO__MEMORY_POOL_UNIT_SIZE); // NOLINT
+    TEST_ASSERT_EQUAL_UINT64(2 + 3, pool.num_units_used); // Allocated units + headers
+
+    // All allocated memory is usable
+    memset(allocation_a, 0xab, 1);                                   // NOLINT
+    memset(allocation_b, 0xcd, PROVIZIO__MEMORY_POOL_UNIT_SIZE + 1); // NOLINT
+
+    provizio_memory_pool_release(&pool, allocation_a);
+    provizio_memory_pool_release(&pool, allocation_b);
+    provizio_memory_pool_release(&pool, NULL);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(memory);
+}
+
+static void test_provizio_memory_pool_out_of_memory_and_out_of_order_release(void)
+{
+    const size_t num_units = 9;
+    const size_t allocation_size = 2 * PROVIZIO__MEMORY_POOL_UNIT_SIZE; // 3 units each, including the header
+    const size_t merged_allocation_size = 2 * allocation_size + PROVIZIO__MEMORY_POOL_UNIT_SIZE; // 2 blocks, 1 header
+    uint8_t *memory = (uint8_t *)malloc((num_units + 1) * PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_memory_pool_init(test_align_memory(memory), num_units * PROVIZIO__MEMORY_POOL_UNIT_SIZE, &pool));
+
+    void *allocation_a = provizio_memory_pool_allocate(&pool, allocation_size);
+    void *allocation_b = provizio_memory_pool_allocate(&pool, allocation_size);
+    void *allocation_c = provizio_memory_pool_allocate(&pool, allocation_size);
+    TEST_ASSERT_NOT_NULL(allocation_a);
+    TEST_ASSERT_NOT_NULL(allocation_b);
+    TEST_ASSERT_NOT_NULL(allocation_c);
+    TEST_ASSERT_EQUAL_UINT64(num_units, pool.num_units_used);
+
+    // Full
+    TEST_ASSERT_NULL(provizio_memory_pool_allocate(&pool, 1));
+
+    // Released out of order
+    provizio_memory_pool_release(&pool, allocation_b);
+    TEST_ASSERT_NULL(provizio_memory_pool_allocate(&pool, merged_allocation_size));
+    provizio_memory_pool_release(&pool, allocation_a);
+
+    // Released blocks get merged
+    void *allocation_d = provizio_memory_pool_allocate(&pool, merged_allocation_size);
+    TEST_ASSERT_EQUAL_PTR(allocation_a, allocation_d);
+    TEST_ASSERT_EQUAL_UINT64(num_units, pool.num_units_used);
+
+    provizio_memory_pool_release(&pool, allocation_c);
+    provizio_memory_pool_release(&pool, allocation_d);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    // The entire pool is available again
+    void *allocation_e = provizio_memory_pool_allocate(&pool, (num_units - 1) * PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+    TEST_ASSERT_EQUAL_PTR(allocation_a, allocation_e);
+    provizio_memory_pool_release(&pool, allocation_e);
+
+    free(memory);
+}
+
+static void test_provizio_memory_pool_required_size(void)
+{
+    const size_t allocation_size = 1000;
+    const size_t num_allocations = 4;
+    const size_t memory_size = provizio_memory_pool_required_size(allocation_size, num_allocations);
+    uint8_t *memory = (uint8_t *)malloc(memory_size);
+
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    void *allocations[4];
+    for (size_t round = 0; round < 3; ++round)
+    {
+        for (size_t i = 0; i < num_allocations; ++i)
+        {
+            allocations[i] = provizio_memory_pool_allocate(&pool, allocation_size - round * 100); // NOLINT
+            TEST_ASSERT_NOT_NULL(allocations[i]);
+        }
+
+        // Release in a different order every time
+        for (size_t i = 0; i < num_allocations; ++i)
+        {
+            provizio_memory_pool_release(&pool, allocations[(i + round) % num_allocations]);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(memory);
+}
+
+int provizio_run_test_memory_pool(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provizio_memory_pool_init_fails_on_insufficient_memory);
+    RUN_TEST(test_provizio_memory_pool_allocates_aligned_memory);
+    RUN_TEST(test_provizio_memory_pool_out_of_memory_and_out_of_order_release);
+    RUN_TEST(test_provizio_memory_pool_required_size);
+
+    return UNITY_END();
+}
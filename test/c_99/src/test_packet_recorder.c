@@ -0,0 +1,287 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/radar_api/packet_recorder.h"
+#include "provizio/radar_api/radar_point_cloud.h"
+#include "provizio/util.h"
+
+enum
+{
+    test_message_length = 1024,
+    test_path_length = 512
+};
+static char provizio_test_error[test_message_length]; // NOLINT: non-const global by design
+
+static const char *const test_path_prefix = "provizio_test_packet_recorder";
+
+static void test_provizio_on_error(const char *error)
+{
+    strncpy(provizio_test_error, error, test_message_length - 1);
+}
+
+// Makes a point cloud packet of num_points (unset) points
+static size_t test_make_point_cloud_packet(uint16_t radar_position_id, uint32_t frame_index, uint16_t num_points,
+                                           provizio_radar_point_cloud_packet *out_packet)
+{
+    memset(out_packet, 0, sizeof(provizio_radar_point_cloud_packet));
+    provizio_set_protocol_field_uint16_t(&out_packet->header.protocol_header.packet_type,
+                                         PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE);
+    provizio_set_protocol_field_uint16_t(&out_packet->header.protocol_header.protocol_version,
+                                         PROVIZIO__RADAR_API_POINT_CLOUD_PROTOCOL_VERSION);
+    provizio_set_protocol_field_uint32_t(&out_packet->header.frame_index, frame_index);
+    provizio_set_protocol_field_uint16_t(&out_packet->header.radar_position_id, radar_position_id);
+    provizio_set_protocol_field_uint16_t(&out_packet->header.num_points_in_packet, num_points);
+    provizio_set_protocol_field_uint16_t(&out_packet->header.total_points_in_frame, num_points);
+    return provizio_radar_point_cloud_packet_size(&out_packet->header);
+}
+
+// Reads a whole segment file, the result is to be freed
+static uint8_t *test_read_segment(uint64_t segment_index, size_t *out_size)
+{
+    char path[test_path_length];
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_log_segment_path(test_path_prefix, segment_index, path, sizeof(path)));
+
+    FILE *file = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(file);
+    fseek(file, 0, SEEK_END);
+    *out_size = (size_t)ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t *data = (uint8_t *)malloc(*out_size);
+    TEST_ASSERT_EQUAL_UINT64(*out_size, fread(data, 1, *out_size, file));
+    fclose(file);
+
+    return data;
+}
+
+static void test_remove_segments(uint64_t num_segments)
+{
+    char path[test_path_length];
+    for (uint64_t i = 0; i < num_segments; ++i)
+    {
+        provizio_packet_log_segment_path(test_path_prefix, i, path, sizeof(path));
+        remove(path);
+    }
+}
+
+static void test_provizio_packet_log_segment_path(void)
+{
+    char path[test_path_length];
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_log_segment_path("drive", 12, path, sizeof(path)));
+    TEST_ASSERT_EQUAL_STRING("drive.000012.plog", path);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_log_segment_path("drive", 1234567, path, sizeof(path)));
+    TEST_ASSERT_EQUAL_STRING("drive.1234567.plog", path);
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_packet_log_segment_path("drive", 12, path, 17));
+    TEST_ASSERT_EQUAL_STRING("provizio_packet_log_segment_path: Insufficient out_path_size", provizio_test_error);
+    provizio_set_on_error(NULL);
+}
+
+#ifndef _WIN32
+static void test_provizio_packet_recorder_records_and_indexes_packets(void)
+{
+    const uint32_t source_address = 0x0100007f; // 127.0.0.1 in network byte order of a little-endian host
+    const uint16_t source_port = 0x3412;
+    const uint64_t receive_time_ns = 0x0123456789abcdef;
+
+    provizio_packet_recorder recorder;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_open(test_path_prefix, 0, 0, &recorder));
+
+    // Radar 1: frame 10 of 2 packets and frame 11, radar 2: frame 10, and a packet that is not a point cloud one
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_sizes[5];
+    packet_sizes[0] = test_make_point_cloud_packet(1, 10, PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET, &packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_append(&recorder, &packet, packet_sizes[0], receive_time_ns,
+                                                               source_address, source_port));
+    packet_sizes[1] = test_make_point_cloud_packet(1, 10, 3, &packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_append(&recorder, &packet, packet_sizes[1], receive_time_ns + 1,
+                                                               source_address, source_port));
+    packet_sizes[2] = test_make_point_cloud_packet(2, 10, 5, &packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_append(&recorder, &packet, packet_sizes[2], receive_time_ns + 2,
+                                                               source_address, source_port));
+    packet_sizes[3] = test_make_point_cloud_packet(1, 11, 7, &packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_append(&recorder, &packet, packet_sizes[3], receive_time_ns + 3,
+                                                               source_address, source_port));
+    const uint8_t other_packet[3] = {1, 2, 3};
+    packet_sizes[4] = sizeof(other_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_append(&recorder, other_packet, packet_sizes[4], 0,
+                                                               source_address, source_port));
+    TEST_ASSERT_EQUAL_UINT64(5, recorder.num_records);
+    TEST_ASSERT_EQUAL_UINT64(1, recorder.num_segments);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_close(&recorder));
+
+    size_t segment_size = 0;
+    uint8_t *segment = test_read_segment(0, &segment_size);
+    const provizio_packet_log_segment_header *header = (const provizio_packet_log_segment_header *)segment;
+    TEST_ASSERT_EQUAL_MEMORY(PROVIZIO__PACKET_LOG_MAGIC, header->magic, PROVIZIO__PACKET_LOG_MAGIC_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(PROVIZIO__PACKET_LOG_VERSION, header->version);
+    TEST_ASSERT_EQUAL_UINT32(PROVIZIO__PACKET_LOG_BYTE_ORDER_MARK, header->byte_order_mark);
+    TEST_ASSERT_EQUAL_UINT64(0, header->segment_index);
+    TEST_ASSERT_EQUAL_UINT64(5, header->num_records);
+    TEST_ASSERT_EQUAL_UINT32(PROVIZIO__PACKET_RECORDER_DEFAULT_MAX_INDEX_ENTRIES, header->max_index_entries);
+    // Truncated to the actual size once finished
+    TEST_ASSERT_EQUAL_UINT64(segment_size, header->records_end_offset);
+
+    // The records are stored as received, with their times and source addresses
+    uint64_t record_offsets[5];
+    uint64_t offset = header->records_offset;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT64(0, offset % PROVIZIO__PACKET_LOG_RECORD_ALIGNMENT);
+        const provizio_packet_log_record_header *record =
+            (const provizio_packet_log_record_header *)(segment + offset);
+        TEST_ASSERT_EQUAL_UINT32(packet_sizes[i], record->payload_size);
+        TEST_ASSERT_EQUAL_UINT32(source_address, record->source_address);
+        TEST_ASSERT_EQUAL_UINT16(source_port, record->source_port);
+        if (i < 4)
+        {
+            TEST_ASSERT_EQUAL_UINT64(receive_time_ns + i, record->receive_time_ns);
+        }
+        else
+        {
+            // The current time is used if unknown
+            TEST_ASSERT_TRUE(record->receive_time_ns > receive_time_ns + i);
+            TEST_ASSERT_EQUAL_MEMORY(other_packet, record + 1, sizeof(other_packet));
+        }
+        record_offsets[i] = offset;
+        offset += record->record_size;
+    }
+    TEST_ASSERT_EQUAL_UINT64(header->records_end_offset, offset);
+
+    // Only the first packets of the frames are indexed
+    const provizio_packet_log_index_entry *index =
+        (const provizio_packet_log_index_entry *)(segment + header->index_offset);
+    TEST_ASSERT_EQUAL_UINT32(3, header->num_index_entries);
+    TEST_ASSERT_EQUAL_UINT16(1, index[0].radar_position_id);
+    TEST_ASSERT_EQUAL_UINT32(10, index[0].frame_index);
+    TEST_ASSERT_EQUAL_UINT64(record_offsets[0], index[0].record_offset);
+    TEST_ASSERT_EQUAL_UINT16(2, index[1].radar_position_id);
+    TEST_ASSERT_EQUAL_UINT32(10, index[1].frame_index);
+    TEST_ASSERT_EQUAL_UINT64(record_offsets[2], index[1].record_offset);
+    TEST_ASSERT_EQUAL_UINT16(1, index[2].radar_position_id);
+    TEST_ASSERT_EQUAL_UINT32(11, index[2].frame_index);
+    TEST_ASSERT_EQUAL_UINT64(record_offsets[3], index[2].record_offset);
+
+    free(segment);
+    test_remove_segments(1);
+}
+
+static void test_provizio_packet_recorder_starts_new_segments(void)
+{
+    const uint32_t max_index_entries = 2;
+    const size_t records_offset = (sizeof(provizio_packet_log_segment_header) +
+                                   max_index_entries * sizeof(provizio_packet_log_index_entry) + 7) &
+                                  ~(size_t)7;
+    const size_t max_record_size =
+        (sizeof(provizio_packet_log_record_header) + PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES + 7) & ~(size_t)7;
+
+    // Fits 2 records of the largest packets
+    provizio_packet_recorder recorder;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_open(test_path_prefix, records_offset + 2 * max_record_size,
+                                                             max_index_entries, &recorder));
+
+    // 5 packets of the same frame: 2 + 2 + 1 records
+    provizio_radar_point_cloud_packet packet;
+    test_make_point_cloud_packet(3, 1, PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET, &packet);
+    uint8_t largest_packet[PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES];
+    memset(largest_packet, 0, sizeof(largest_packet));
+    memcpy(largest_packet, &packet, sizeof(packet));
+    for (size_t i = 0; i < 5; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT32(
+            0, provizio_packet_recorder_append(&recorder, largest_packet, sizeof(largest_packet), 1, 0, 0));
+    }
+    TEST_ASSERT_EQUAL_UINT64(3, recorder.num_segments);
+
+    // 3 radars in a single small packet each: the 2nd one doesn't fit the index of the 3rd segment
+    for (uint16_t radar_position_id = 0; radar_position_id < 3; ++radar_position_id)
+    {
+        const size_t small_packet_size = test_make_point_cloud_packet(radar_position_id, 1, 1, &packet);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_append(&recorder, &packet, small_packet_size, 1, 0, 0));
+    }
+    TEST_ASSERT_EQUAL_UINT64(4, recorder.num_segments);
+    TEST_ASSERT_EQUAL_UINT64(8, recorder.num_records);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_close(&recorder));
+
+    const uint64_t expected_num_records[4] = {2, 2, 2, 2};
+    const uint32_t expected_num_index_entries[4] = {1, 1, 2, 2};
+    for (uint64_t i = 0; i < 4; ++i)
+    {
+        size_t segment_size = 0;
+        uint8_t *segment = test_read_segment(i, &segment_size);
+        const provizio_packet_log_segment_header *header = (const provizio_packet_log_segment_header *)segment;
+        TEST_ASSERT_EQUAL_UINT64(i, header->segment_index);
+        TEST_ASSERT_EQUAL_UINT64(expected_num_records[i], header->num_records);
+        TEST_ASSERT_EQUAL_UINT32(expected_num_index_entries[i], header->num_index_entries);
+        TEST_ASSERT_EQUAL_UINT64(segment_size, header->records_end_offset);
+
+        // A frame continued in a new segment is indexed there as well
+        const provizio_packet_log_index_entry *index =
+            (const provizio_packet_log_index_entry *)(segment + header->index_offset);
+        TEST_ASSERT_EQUAL_UINT64(header->records_offset, index[0].record_offset);
+        free(segment);
+    }
+
+    test_remove_segments(4);
+}
+
+static void test_provizio_packet_recorder_fails_on_invalid_arguments(void)
+{
+    provizio_packet_recorder recorder;
+    const uint8_t packet[1] = {0};
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_packet_recorder_open(NULL, 0, 0, &recorder));
+    TEST_ASSERT_EQUAL_STRING("provizio_packet_recorder_open: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_packet_recorder_open(test_path_prefix, 1024, 0, &recorder));
+    TEST_ASSERT_EQUAL_STRING("provizio_packet_recorder_open: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_packet_recorder_append(&recorder, packet, 1, 0, 0, 0));
+    TEST_ASSERT_EQUAL_STRING("provizio_packet_recorder_append: Not open", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_packet_recorder_close(&recorder));
+    TEST_ASSERT_EQUAL_STRING("provizio_packet_recorder_close: Not open", provizio_test_error);
+
+    TEST_ASSERT_NOT_EQUAL(0, provizio_packet_recorder_open("/provizio_no_such_directory/log", 0, 0, &recorder));
+    TEST_ASSERT_EQUAL_STRING("provizio_packet_recorder: Failed to create a segment file", provizio_test_error);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_open(test_path_prefix, 0, 0, &recorder));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_packet_recorder_append(
+                                                     &recorder, packet, PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES + 1,
+                                                     0, 0, 0));
+    TEST_ASSERT_EQUAL_STRING("provizio_packet_recorder_append: Packet is too large", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_close(&recorder));
+    provizio_set_on_error(NULL);
+
+    test_remove_segments(1);
+}
+#endif // _WIN32
+
+int provizio_run_test_packet_recorder(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provizio_packet_log_segment_path);
+#ifndef _WIN32
+    RUN_TEST(test_provizio_packet_recorder_records_and_indexes_packets);
+    RUN_TEST(test_provizio_packet_recorder_starts_new_segments);
+    RUN_TEST(test_provizio_packet_recorder_fails_on_invalid_arguments);
+#endif // _WIN32
+
+    return UNITY_END();
+}
@@ -0,0 +1,303 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/radar_api/packet_recorder.h"
+#include "provizio/radar_api/packet_replay.h"
+#include "provizio/util.h"
+
+#ifndef _WIN32
+enum
+{
+    test_message_length = 1024,
+    test_path_length = 512
+};
+static char provizio_test_error[test_message_length]; // NOLINT: non-const global by design
+
+static const char *const test_path_prefix = "provizio_test_packet_replay";
+
+static void test_provizio_on_error(const char *error)
+{
+    strncpy(provizio_test_error, error, test_message_length - 1);
+}
+
+typedef struct test_replay_callback_data
+{
+    size_t called_times;
+    uint32_t last_frame_index;
+    uint16_t last_radar_position_id;
+    uint64_t last_receive_time_ns;
+} test_replay_callback_data;
+
+static void test_replay_callback(const provizio_radar_point_cloud *point_cloud,
+                                 provizio_radar_point_cloud_api_context *context)
+{
+    test_replay_callback_data *data = (test_replay_callback_data *)context->user_data;
+    ++data->called_times;
+    data->last_frame_index = point_cloud->frame_index;
+    data->last_radar_position_id = point_cloud->radar_position_id;
+}
+
+static void test_replay_pooled_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                                        provizio_pooled_radar_point_cloud_api_context *context)
+{
+    test_replay_callback_data *data = (test_replay_callback_data *)context->user_data;
+    ++data->called_times;
+    data->last_frame_index = point_cloud->frame_index;
+    data->last_radar_position_id = point_cloud->radar_position_id;
+    data->last_receive_time_ns = point_cloud->first_packet_receive_time_ns;
+}
+
+// Records a packet of num_points_in_packet (unset) points of a frame of total_points_in_frame points
+static void test_record_packet(provizio_packet_recorder *recorder, uint16_t radar_position_id, uint32_t frame_index,
+                               uint16_t total_points_in_frame, uint16_t num_points_in_packet, uint64_t receive_time_ns)
+{
+    provizio_radar_point_cloud_packet packet;
+    memset(&packet, 0, sizeof(packet));
+    provizio_set_protocol_field_uint16_t(&packet.header.protocol_header.packet_type,
+                                         PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE);
+    provizio_set_protocol_field_uint16_t(&packet.header.protocol_header.protocol_version,
+                                         PROVIZIO__RADAR_API_POINT_CLOUD_PROTOCOL_VERSION);
+    provizio_set_protocol_field_uint32_t(&packet.header.frame_index, frame_index);
+    provizio_set_protocol_field_uint16_t(&packet.header.radar_position_id, radar_position_id);
+    provizio_set_protocol_field_uint16_t(&packet.header.num_points_in_packet, num_points_in_packet);
+    provizio_set_protocol_field_uint16_t(&packet.header.total_points_in_frame, total_points_in_frame);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_append(recorder, &packet,
+                                                               provizio_radar_point_cloud_packet_size(&packet.header),
+                                                               receive_time_ns, 0, 0));
+}
+
+// Records a complete single-packet frame of num_points (unset) points
+static void test_record_frame(provizio_packet_recorder *recorder, uint16_t radar_position_id, uint32_t frame_index,
+                              uint16_t num_points, uint64_t receive_time_ns)
+{
+    test_record_packet(recorder, radar_position_id, frame_index, num_points, num_points, receive_time_ns);
+}
+
+static void test_remove_segments(uint64_t num_segments)
+{
+    char path[test_path_length];
+    for (uint64_t i = 0; i < num_segments; ++i)
+    {
+        provizio_packet_log_segment_path(test_path_prefix, i, path, sizeof(path));
+        remove(path);
+    }
+}
+
+static void test_provizio_replay_packet_log_as_fast_as_possible(void)
+{
+    const uint32_t num_frames = 5;
+    const size_t num_radars = 2;
+    const uint16_t radar_position_ids[2] = {provizio_radar_position_front_left, provizio_radar_position_front_right};
+
+    // Small segments, so the log consists of multiple ones
+    provizio_packet_recorder recorder;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_open(test_path_prefix, 4 * 1024, 4, &recorder));
+    for (uint32_t frame_index = 0; frame_index < num_frames; ++frame_index)
+    {
+        for (size_t i = 0; i < num_radars; ++i)
+        {
+            test_record_frame(&recorder, radar_position_ids[i], frame_index, 3, 0);
+        }
+    }
+    const uint8_t other_packet[3] = {1, 2, 3};
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_append(&recorder, other_packet, sizeof(other_packet), 0, 0, 0));
+    const uint64_t num_segments = recorder.num_segments;
+    TEST_ASSERT_TRUE(num_segments > 1);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_close(&recorder));
+
+    test_replay_callback_data callback_data;
+    memset(&callback_data, 0, sizeof(callback_data));
+    provizio_radar_point_cloud_api_context *contexts = (provizio_radar_point_cloud_api_context *)malloc(
+        num_radars * sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_contexts_init(&test_replay_callback, &callback_data, contexts, num_radars);
+
+    provizio_packet_replay_stats stats;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_replay_packet_log(test_path_prefix, 0.0F, contexts, num_radars, &stats));
+    TEST_ASSERT_EQUAL_UINT64(num_frames * num_radars, callback_data.called_times);
+    TEST_ASSERT_EQUAL_UINT32(num_frames - 1, callback_data.last_frame_index);
+    TEST_ASSERT_EQUAL_UINT16(radar_position_ids[1], callback_data.last_radar_position_id);
+    TEST_ASSERT_EQUAL_UINT64(num_segments, stats.num_segments);
+    TEST_ASSERT_EQUAL_UINT64(num_frames * num_radars + 1, stats.num_packets);
+    TEST_ASSERT_EQUAL_UINT64(num_frames * num_radars, stats.num_frames);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.num_failed_packets);
+    TEST_ASSERT_TRUE(stats.frames_per_second > 0.0F);
+    TEST_ASSERT_TRUE(stats.packets_per_second > stats.frames_per_second);
+
+    free(contexts);
+    test_remove_segments(num_segments);
+}
+
+static void test_provizio_replay_packet_log_paced(void)
+{
+    const uint64_t receive_time_ns = 1000000000ULL;
+    const uint64_t frame_interval_ns = 40000000ULL;
+    const uint32_t num_frames = 3;
+    const float speed = 2.0F;
+
+    provizio_packet_recorder recorder;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_open(test_path_prefix, 0, 0, &recorder));
+    for (uint32_t frame_index = 0; frame_index < num_frames; ++frame_index)
+    {
+        test_record_frame(&recorder, provizio_radar_position_rear_left, frame_index, 5,
+                          receive_time_ns + frame_index * frame_interval_ns);
+    }
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_close(&recorder));
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(5, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+    test_replay_callback_data callback_data;
+    memset(&callback_data, 0, sizeof(callback_data));
+    provizio_pooled_radar_point_cloud_api_context *context =
+        (provizio_pooled_radar_point_cloud_api_context *)malloc(sizeof(provizio_pooled_radar_point_cloud_api_context));
+    provizio_pooled_radar_point_cloud_api_context_init(&test_replay_pooled_callback, &callback_data, &pool, context);
+
+    provizio_packet_replay_stats stats;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_replay_packet_log_pooled(test_path_prefix, speed, context, 1, &stats));
+    TEST_ASSERT_EQUAL_UINT64(num_frames, callback_data.called_times);
+    TEST_ASSERT_EQUAL_UINT32(num_frames - 1, callback_data.last_frame_index);
+    // Original receive times are preserved
+    TEST_ASSERT_EQUAL_UINT64(receive_time_ns + (num_frames - 1) * frame_interval_ns,
+                             callback_data.last_receive_time_ns);
+    TEST_ASSERT_EQUAL_UINT64(num_frames, stats.num_frames);
+    // Paced by the receive times: (num_frames - 1) * frame_interval_ns at double speed
+    TEST_ASSERT_TRUE(stats.duration_ns >= (uint64_t)((num_frames - 1) * frame_interval_ns / speed));
+    TEST_ASSERT_TRUE(stats.duration_ns < 10 * (num_frames - 1) * frame_interval_ns);
+
+    free(context);
+    free(memory);
+    test_remove_segments(1);
+}
+
+static void test_provizio_replay_packet_log_counts_frames_returned(void)
+{
+    const uint16_t radar_position_id = provizio_radar_position_rear_left;
+    const size_t num_contexts = 2;
+
+    // Packets of 2 frames of the same radar interleaved, followed by an incomplete frame
+    provizio_packet_recorder recorder;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_open(test_path_prefix, 0, 0, &recorder));
+    test_record_packet(&recorder, radar_position_id, 0, 2, 1, 0);
+    test_record_packet(&recorder, radar_position_id, 1, 2, 1, 0);
+    test_record_packet(&recorder, radar_position_id, 0, 2, 1, 0);
+    test_record_packet(&recorder, radar_position_id, 1, 2, 1, 0);
+    test_record_packet(&recorder, radar_position_id, 2, 2, 1, 0);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_close(&recorder));
+
+    test_replay_callback_data callback_data;
+    memset(&callback_data, 0, sizeof(callback_data));
+    provizio_radar_point_cloud_api_context *contexts = (provizio_radar_point_cloud_api_context *)malloc(
+        num_contexts * sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_contexts_init(&test_replay_callback, &callback_data, contexts, num_contexts);
+
+    provizio_packet_replay_stats stats;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_replay_packet_log(test_path_prefix, 0.0F, contexts, num_contexts, &stats));
+    TEST_ASSERT_EQUAL_UINT64(5, stats.num_packets);
+    TEST_ASSERT_EQUAL_UINT64(2, stats.num_frames);
+    TEST_ASSERT_EQUAL_UINT64(2, callback_data.called_times);
+    TEST_ASSERT_EQUAL_UINT32(1, callback_data.last_frame_index);
+
+    // Callbacks are restored after the replay
+    for (size_t i = 0; i < num_contexts; ++i)
+    {
+        TEST_ASSERT_TRUE(contexts[i].callback == &test_replay_callback);
+        TEST_ASSERT_EQUAL_PTR(&callback_data, contexts[i].user_data);
+    }
+
+    free(contexts);
+    test_remove_segments(1);
+}
+
+static void test_provizio_replay_packet_log_fails_on_invalid_arguments(void)
+{
+    provizio_radar_point_cloud_api_context *context =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context));
+    test_replay_callback_data callback_data;
+    memset(&callback_data, 0, sizeof(callback_data));
+    provizio_radar_point_cloud_api_context_init(&test_replay_callback, &callback_data, context);
+    provizio_packet_replay_stats stats;
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_replay_packet_log(NULL, 0.0F, context, 1, &stats));
+    TEST_ASSERT_EQUAL_STRING("provizio_replay_packet_log: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_replay_packet_log(test_path_prefix, 0.0F, NULL, 1, &stats));
+    TEST_ASSERT_EQUAL_STRING("provizio_replay_packet_log: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_replay_packet_log(test_path_prefix, -1.0F, context, 1, &stats));
+    TEST_ASSERT_EQUAL_STRING("provizio_replay_packet_log: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_replay_packet_log_pooled(test_path_prefix, 0.0F, NULL, 1, &stats));
+    TEST_ASSERT_EQUAL_STRING("provizio_replay_packet_log: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_replay_packet_log(test_path_prefix, 0.0F, context,
+                                                                            PROVIZIO__PACKET_REPLAY_MAX_CONTEXTS + 1,
+                                                                            &stats));
+    TEST_ASSERT_EQUAL_STRING("provizio_replay_packet_log: Too many contexts", provizio_test_error);
+
+    // No such log
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_replay_packet_log(test_path_prefix, 0.0F, context, 1, &stats));
+    TEST_ASSERT_EQUAL_STRING("provizio_replay_packet_log: Failed to open the packet log", provizio_test_error);
+
+    // Not a packet log
+    char path[test_path_length];
+    provizio_packet_log_segment_path(test_path_prefix, 0, path, sizeof(path));
+    FILE *file = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    uint8_t garbage[sizeof(provizio_packet_log_segment_header) * 2];
+    memset(garbage, 0xab, sizeof(garbage));
+    TEST_ASSERT_EQUAL_UINT64(sizeof(garbage), fwrite(garbage, 1, sizeof(garbage), file));
+    fclose(file);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_PROTOCOL,
+                            provizio_replay_packet_log(test_path_prefix, 0.0F, context, 1, &stats));
+    TEST_ASSERT_EQUAL_STRING("provizio_replay_packet_log: Malformed segment", provizio_test_error);
+
+    // Packets that fail to be handled (e.g. of an unknown radar) are counted, but don't stop the replay
+    provizio_packet_recorder recorder;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_open(test_path_prefix, 0, 0, &recorder));
+    test_record_frame(&recorder, provizio_radar_position_front_center, 0, 1, 0);
+    test_record_frame(&recorder, provizio_radar_position_unknown, 0, 1, 0);
+    test_record_frame(&recorder, provizio_radar_position_front_center, 1, 1, 0);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_packet_recorder_close(&recorder));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_replay_packet_log(test_path_prefix, 0.0F, context, 1, &stats));
+    TEST_ASSERT_EQUAL_UINT64(3, stats.num_packets);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.num_failed_packets);
+    TEST_ASSERT_EQUAL_UINT64(2, stats.num_frames);
+    TEST_ASSERT_EQUAL_UINT64(2, callback_data.called_times);
+    provizio_set_on_error(NULL);
+
+    free(context);
+    test_remove_segments(1);
+}
+#endif // _WIN32
+
+int provizio_run_test_packet_replay(void)
+{
+    UNITY_BEGIN();
+
+#ifndef _WIN32
+    RUN_TEST(test_provizio_replay_packet_log_as_fast_as_possible);
+    RUN_TEST(test_provizio_replay_packet_log_paced);
+    RUN_TEST(test_provizio_replay_packet_log_counts_frames_returned);
+    RUN_TEST(test_provizio_replay_packet_log_fails_on_invalid_arguments);
+#endif // _WIN32
+
+    return UNITY_END();
+}
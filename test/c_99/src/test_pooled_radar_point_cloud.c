@@ -0,0 +1,1183 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/radar_api/errno.h"
+#include "provizio/radar_api/pooled_radar_point_cloud.h"
+#include "provizio/util.h"
+
+enum
+{
+    test_message_length = 1024,
+    test_max_points_per_frame = 200,
+    test_num_radars = 2,
+    test_max_window_callbacks = 8
+};
+static char provizio_test_warning[test_message_length]; // NOLINT: non-const global by design
+static char provizio_test_error[test_message_length];   // NOLINT: non-const global by design
+
+static void test_provizio_on_warning(const char *warning)
+{
+    strncpy(provizio_test_warning, warning, test_message_length - 1);
+}
+
+static void test_provizio_on_error(const char *error)
+{
+    strncpy(provizio_test_error, error, test_message_length - 1);
+}
+
+typedef struct test_pooled_callback_data // NOLINT: it's aligned exactly as it's supposed to
+{
+    int32_t called_times;
+    provizio_pooled_radar_point_cloud last_point_cloud; // radar_points and spans are not valid after the callback
+    provizio_radar_point last_points[test_max_points_per_frame];
+    const provizio_radar_point *last_first_span_points;
+} test_pooled_callback_data;
+
+static void test_pooled_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                                 provizio_pooled_radar_point_cloud_api_context *context)
+{
+    test_pooled_callback_data *data = (test_pooled_callback_data *)context->user_data;
+
+    ++data->called_times;
+    data->last_point_cloud = *point_cloud;
+    memcpy(data->last_points, point_cloud->radar_points,
+           sizeof(provizio_radar_point) * point_cloud->num_points_received);
+}
+
+static void test_zero_copy_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                                    provizio_pooled_radar_point_cloud_api_context *context)
+{
+    test_pooled_callback_data *data = (test_pooled_callback_data *)context->user_data;
+
+    TEST_ASSERT_NULL(point_cloud->radar_points);
+    TEST_ASSERT_TRUE(point_cloud->num_spans > 0); // NOLINT: clang-tidy doesn't like TEST_ASSERT_TRUE
+
+    ++data->called_times;
+    data->last_point_cloud = *point_cloud;
+    data->last_first_span_points = point_cloud->spans[0].radar_points;
+
+    size_t num_points = 0;
+    for (size_t i = 0; i < point_cloud->num_spans; ++i)
+    {
+        const provizio_radar_point_span *span = &point_cloud->spans[i];
+        memcpy(&data->last_points[num_points], span->radar_points, sizeof(provizio_radar_point) * span->num_points);
+        num_points += span->num_points;
+    }
+    TEST_ASSERT_EQUAL_UINT64(point_cloud->num_points_received, num_points);
+}
+
+static void test_soa_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                              provizio_pooled_radar_point_cloud_api_context *context)
+{
+    test_pooled_callback_data *data = (test_pooled_callback_data *)context->user_data;
+
+    TEST_ASSERT_NULL(point_cloud->radar_points);
+    TEST_ASSERT_EQUAL_UINT16(point_cloud->num_points_expected, point_cloud->radar_points_soa.capacity);
+    TEST_ASSERT_EQUAL_UINT64(0, (uintptr_t)point_cloud->radar_points_soa.signal_to_noise_ratio %
+                                    PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT);
+
+    ++data->called_times;
+    data->last_point_cloud = *point_cloud;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_points_soa_to_aos(&point_cloud->radar_points_soa,
+                                                                point_cloud->num_points_received, data->last_points));
+}
+
+static float test_point_value(uint32_t frame_index, uint16_t point_index, uint16_t field)
+{
+    return (float)(frame_index * 1000 + point_index) + (float)field * 0.125F; // NOLINT
+}
+
+static size_t make_test_packet(provizio_radar_point_cloud_packet *packet, uint32_t frame_index,
+                               uint16_t radar_position_id, uint16_t total_points_in_frame, uint16_t first_point_index,
+                               uint16_t num_points_in_packet)
+{
+    memset(packet, 0, sizeof(provizio_radar_point_cloud_packet));
+    provizio_set_protocol_field_uint16_t(&packet->header.protocol_header.packet_type,
+                                         PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE);
+    provizio_set_protocol_field_uint16_t(&packet->header.protocol_header.protocol_version,
+                                         PROVIZIO__RADAR_API_POINT_CLOUD_PROTOCOL_VERSION);
+    provizio_set_protocol_field_uint32_t(&packet->header.frame_index, frame_index);
+    provizio_set_protocol_field_uint64_t(&packet->header.timestamp, (uint64_t)frame_index * 100000000ULL); // NOLINT
+    provizio_set_protocol_field_uint16_t(&packet->header.radar_position_id, radar_position_id);
+    provizio_set_protocol_field_uint16_t(&packet->header.total_points_in_frame, total_points_in_frame);
+    provizio_set_protocol_field_uint16_t(&packet->header.num_points_in_packet, num_points_in_packet);
+    provizio_set_protocol_field_uint16_t(&packet->header.radar_range, provizio_radar_range_medium);
+
+    for (uint16_t i = 0; i < num_points_in_packet; ++i)
+    {
+        const uint16_t point_index = (uint16_t)(first_point_index + i);
+        provizio_radar_point *point = &packet->radar_points[i];
+        provizio_set_protocol_field_float(&point->x_meters, test_point_value(frame_index, point_index, 0));
+        provizio_set_protocol_field_float(&point->y_meters, test_point_value(frame_index, point_index, 1));
+        provizio_set_protocol_field_float(&point->z_meters, test_point_value(frame_index, point_index, 2));
+        provizio_set_protocol_field_float(&point->radar_relative_radial_velocity_m_s,
+                                          test_point_value(frame_index, point_index, 3));
+        provizio_set_protocol_field_float(&point->signal_to_noise_ratio, test_point_value(frame_index, point_index, 4));
+        provizio_set_protocol_field_float(&point->ground_relative_radial_velocity_m_s,
+                                          test_point_value(frame_index, point_index, 5));
+    }
+
+    return provizio_radar_point_cloud_packet_size(&packet->header);
+}
+
+static void test_pooled_radar_point_cloud_receives_complete_frame(void)
+{
+    const uint32_t frame_index = 7;
+    const uint16_t num_points = 150;
+    const uint16_t points_per_packet = 60;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(test_max_points_per_frame, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_callback, callback_data, &pool, &context);
+
+    provizio_radar_point_cloud_packet packet;
+    for (uint16_t first_point = 0; first_point < num_points; first_point += points_per_packet)
+    {
+        const uint16_t points_in_packet =
+            (uint16_t)(num_points - first_point < points_per_packet ? num_points - first_point : points_per_packet);
+        const size_t packet_size = make_test_packet(&packet, frame_index, provizio_radar_position_front_left,
+                                                    num_points, first_point, points_in_packet);
+
+        TEST_ASSERT_EQUAL_INT32(0, callback_data->called_times);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+
+        // Only as much memory as required by the frame is taken from the pool
+        TEST_ASSERT_TRUE(pool.num_units_used == 0 || // NOLINT: clang-tidy doesn't like TEST_ASSERT_TRUE
+                         pool.num_units_used * PROVIZIO__MEMORY_POOL_UNIT_SIZE <
+                             sizeof(provizio_radar_point) * num_points + 2 * PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+    }
+
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT32(frame_index, callback_data->last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)frame_index * 100000000ULL, callback_data->last_point_cloud.timestamp); // NOLINT
+    TEST_ASSERT_EQUAL_UINT16(provizio_radar_position_front_left, callback_data->last_point_cloud.radar_position_id);
+    TEST_ASSERT_EQUAL_UINT16(provizio_radar_range_medium, callback_data->last_point_cloud.radar_range);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_cloud.num_points_expected);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_cloud.num_points_received);
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(frame_index, i, 0), callback_data->last_points[i].x_meters);
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(frame_index, i, 4),
+                                callback_data->last_points[i].signal_to_noise_ratio);
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(frame_index, i, 5),
+                                callback_data->last_points[i].ground_relative_radial_velocity_m_s);
+    }
+
+    // The memory is returned to the pool
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(callback_data);
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_returns_partial_frames(void)
+{
+    const uint16_t num_points = 100;
+    const uint16_t points_per_packet = 10;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(test_max_points_per_frame, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_callback, callback_data, &pool, &context);
+
+    // Partial frames 1 and 2
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_size =
+        make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size = make_test_packet(&packet, 2, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_INT32(0, callback_data->called_times);
+
+    // Frame 3 makes frame 1 returned as partial
+    packet_size = make_test_packet(&packet, 3, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT32(1, callback_data->last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_cloud.num_points_expected);
+    TEST_ASSERT_EQUAL_UINT16(points_per_packet, callback_data->last_point_cloud.num_points_received);
+    TEST_ASSERT_EQUAL_FLOAT(test_point_value(1, points_per_packet - 1, 0),
+                            callback_data->last_points[points_per_packet - 1].x_meters);
+
+    // Frame 1 is obsolete now
+    packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, points_per_packet,
+                                   points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED,
+                            provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+
+    // Packets of other radars are skipped
+    packet_size = make_test_packet(&packet, 3, provizio_radar_position_rear_left, num_points, points_per_packet,
+                                   points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED,
+                            provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+
+    // Releasing the context returns all the memory to the pool without calling the callback
+    TEST_ASSERT_TRUE(pool.num_units_used > 0); // NOLINT: clang-tidy doesn't like TEST_ASSERT_TRUE
+    provizio_pooled_radar_point_cloud_api_context_release(&context);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+
+    free(callback_data);
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_out_of_memory(void)
+{
+    const uint16_t num_points = 100;
+    const uint16_t points_per_packet = 10;
+
+    // Enough for a single frame only
+    const size_t memory_size =
+        sizeof(provizio_radar_point) * num_points + 3 * PROVIZIO__MEMORY_POOL_UNIT_SIZE; // NOLINT
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context contexts[test_num_radars];
+    provizio_pooled_radar_point_cloud_api_contexts_init(&test_pooled_callback, callback_data, &pool, contexts,
+                                                        test_num_radars);
+
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_size =
+        make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_handle_pooled_radars_point_cloud_packet(contexts, test_num_radars, &packet, packet_size));
+
+    // Another radar can't get memory for its frame
+    provizio_set_on_error(&test_provizio_on_error);
+    packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_right, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_OUT_OF_MEMORY, provizio_handle_pooled_radars_point_cloud_packet(
+                                                          contexts, test_num_radars, &packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING("provizio_get_pooled_point_cloud_being_received: Out of pool memory", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    // A newer frame of the same radar makes its older partial frame returned to free up memory
+    packet_size = make_test_packet(&packet, 2, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_handle_pooled_radars_point_cloud_packet(contexts, test_num_radars, &packet, packet_size));
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT32(1, callback_data->last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(points_per_packet, callback_data->last_point_cloud.num_points_received);
+
+    provizio_pooled_radar_point_cloud_api_context_release(&contexts[0]);
+    provizio_pooled_radar_point_cloud_api_context_release(&contexts[1]);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(callback_data);
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_multiple_radars(void)
+{
+    const uint16_t num_points = 20;
+    const uint16_t radar_position_ids[test_num_radars + 1] = {
+        provizio_radar_position_front_left, provizio_radar_position_front_right, provizio_radar_position_rear_left};
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(test_max_points_per_frame, test_num_radars);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context contexts[test_num_radars];
+    provizio_pooled_radar_point_cloud_api_contexts_init(&test_pooled_callback, callback_data, &pool, contexts,
+                                                        test_num_radars);
+
+    provizio_radar_point_cloud_packet packet;
+    for (size_t i = 0; i < test_num_radars; ++i)
+    {
+        const size_t packet_size = make_test_packet(&packet, 1, radar_position_ids[i], num_points, 0, num_points);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_possible_pooled_radars_point_cloud_packet(
+                                       contexts, test_num_radars, &packet, packet_size));
+        TEST_ASSERT_EQUAL_INT32(i + 1, callback_data->called_times);
+        TEST_ASSERT_EQUAL_UINT16(radar_position_ids[i], callback_data->last_point_cloud.radar_position_id);
+        TEST_ASSERT_EQUAL_UINT16(radar_position_ids[i], contexts[i].radar_position_id);
+    }
+
+    // Out of contexts
+    provizio_set_on_error(&test_provizio_on_error);
+    size_t packet_size = make_test_packet(&packet, 1, radar_position_ids[test_num_radars], num_points, 0, num_points);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_OUT_OF_CONTEXTS, provizio_handle_possible_pooled_radars_point_cloud_packet(
+                                                            contexts, test_num_radars, &packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING(
+        "provizio_get_pooled_radar_point_cloud_api_context_by_position_id: Out of available contexts",
+        provizio_test_error);
+
+    // Bad packets
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_PROTOCOL, provizio_handle_pooled_radars_point_cloud_packet(
+                                                     contexts, test_num_radars, &packet, packet_size - 1));
+    TEST_ASSERT_EQUAL_STRING("provizio_check_radar_point_cloud_packet: incorrect packet_size", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_PROTOCOL,
+                            provizio_handle_pooled_radar_point_cloud_packet(contexts, &packet, packet_size - 1));
+
+    provizio_set_protocol_field_uint16_t(&packet.header.protocol_header.protocol_version,
+                                         PROVIZIO__RADAR_API_POINT_CLOUD_PROTOCOL_VERSION + 1);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_PROTOCOL, provizio_handle_possible_pooled_radars_point_cloud_packet(
+                                                     contexts, test_num_radars, &packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING("provizio_handle_possible_pooled_radars_point_cloud_packet: Incompatible protocol version",
+                             provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    // Not a point cloud packet
+    provizio_set_protocol_field_uint16_t(&packet.header.protocol_header.packet_type,
+                                         PROVIZIO__RADAR_API_SET_RANGE_PACKET_TYPE);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED, provizio_handle_possible_pooled_radars_point_cloud_packet(
+                                                    contexts, test_num_radars, &packet, packet_size));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED, provizio_handle_possible_pooled_radars_point_cloud_packet(
+                                                    contexts, test_num_radars, &packet, sizeof(packet.header) - 1));
+
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(callback_data);
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_protocol_errors(void)
+{
+    const uint16_t num_points = 20;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(test_max_points_per_frame, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_callback, callback_data, &pool, &context);
+
+    provizio_set_on_error(&test_provizio_on_error);
+    provizio_set_on_warning(&test_provizio_on_warning);
+
+    // Empty frame
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_left, 0, 0, 0);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED,
+                            provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+
+    // Too many points
+    packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, 0, num_points / 2);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, 0, num_points);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_PROTOCOL,
+                            provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING("provizio_handle_pooled_radar_point_cloud_packet_checked: Too many points received",
+                             provizio_test_error);
+
+    // Mismatching frame details
+    packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points + 1, 0, 1);
+    provizio_set_protocol_field_uint16_t(&packet.header.radar_range, provizio_radar_range_long);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING("provizio_get_pooled_point_cloud_being_received: radar_range mismatch across different "
+                             "packets of the same frame",
+                             provizio_test_warning);
+    packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points + 1, 0, 1);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING("provizio_get_pooled_point_cloud_being_received: num_points_expected mismatch across "
+                             "different packets of the same frame",
+                             provizio_test_warning);
+
+    // Frame indices overflow
+    packet_size = make_test_packet(&packet, 0xfffffff0, provizio_radar_position_front_left, num_points, 0, 1);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, 0, 1);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING(
+        "provizio_get_pooled_point_cloud_being_received: frame indices overflow detected - resetting API state",
+        provizio_test_warning);
+    TEST_ASSERT_EQUAL_UINT32(1, context.impl.latest_frame);
+
+    // Assigning
+    TEST_ASSERT_EQUAL_INT32(0, provizio_pooled_radar_point_cloud_api_context_assign(
+                                   &context, provizio_radar_position_front_left));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_NOT_PERMITTED, provizio_pooled_radar_point_cloud_api_context_assign(
+                                                          &context, provizio_radar_position_front_right));
+    TEST_ASSERT_EQUAL_STRING("provizio_pooled_radar_point_cloud_api_context_assign: already assigned",
+                             provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_pooled_radar_point_cloud_api_context_assign(
+                                                     &context, provizio_radar_position_unknown));
+    TEST_ASSERT_EQUAL_STRING("provizio_pooled_radar_point_cloud_api_context_assign: can't assign to "
+                             "provizio_radar_position_unknown",
+                             provizio_test_error);
+
+    provizio_set_on_warning(NULL);
+    provizio_set_on_error(NULL);
+
+    provizio_pooled_radar_point_cloud_api_context_release(&context);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(callback_data);
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_soa_receives_complete_frame(void)
+{
+    const uint32_t frame_index = 8;
+    const uint16_t num_points = 150;
+    const uint16_t points_per_packet = 60;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(test_max_points_per_frame, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context contexts[test_num_radars];
+    provizio_pooled_radar_point_cloud_api_contexts_init_soa(&test_soa_callback, callback_data, &pool, contexts,
+                                                            test_num_radars);
+
+    provizio_radar_point_cloud_packet packet;
+    for (uint16_t first_point = 0; first_point < num_points; first_point += points_per_packet)
+    {
+        const uint16_t points_in_packet =
+            (uint16_t)(num_points - first_point < points_per_packet ? num_points - first_point : points_per_packet);
+        const size_t packet_size = make_test_packet(&packet, frame_index, provizio_radar_position_front_right,
+                                                    num_points, first_point, points_in_packet);
+
+        TEST_ASSERT_EQUAL_INT32(0, callback_data->called_times);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_possible_pooled_radars_point_cloud_packet(contexts, test_num_radars,
+                                                                                             &packet, packet_size));
+    }
+
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT32(frame_index, callback_data->last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(provizio_radar_position_front_right, callback_data->last_point_cloud.radar_position_id);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_cloud.num_points_received);
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(frame_index, i, 0), callback_data->last_points[i].x_meters);
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(frame_index, i, 3),
+                                callback_data->last_points[i].radar_relative_radial_velocity_m_s);
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(frame_index, i, 5),
+                                callback_data->last_points[i].ground_relative_radial_velocity_m_s);
+    }
+
+    // The memory is returned to the pool
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(callback_data);
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_zero_copy_receives_complete_frame(void)
+{
+    const uint32_t frame_index = 9;
+    const uint16_t num_points = 150;
+    const uint16_t points_per_packet = 60;
+
+    const size_t num_buffers = provizio_radar_packet_pool_num_buffers(test_max_points_per_frame, 1);
+    provizio_radar_packet_buffer *buffers =
+        (provizio_radar_packet_buffer *)malloc(sizeof(provizio_radar_packet_buffer) * num_buffers);
+    provizio_radar_point_span *spans =
+        (provizio_radar_point_span *)malloc(sizeof(provizio_radar_point_span) * num_buffers);
+    provizio_radar_packet_pool packet_pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_packet_pool_init(buffers, spans, num_buffers, &packet_pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init_zero_copy(&test_zero_copy_callback, callback_data, &packet_pool,
+                                                                 &context);
+
+    // The 1st packet is received directly to the packet pool, so it's never copied
+    provizio_radar_packet_buffer *first_buffer = provizio_radar_packet_pool_acquire(&packet_pool);
+    provizio_radar_point_cloud_packet *first_packet = (provizio_radar_point_cloud_packet *)first_buffer->payload;
+    size_t packet_size = make_test_packet(first_packet, frame_index, provizio_radar_position_front_left, num_points, 0,
+                                          points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, first_packet, packet_size));
+    TEST_ASSERT_EQUAL_UINT32(num_buffers - 1, packet_pool.num_free_buffers);
+
+    // The 2nd one is copied to the packet pool, as it's not there yet
+    provizio_radar_point_cloud_packet packet;
+    packet_size = make_test_packet(&packet, frame_index, provizio_radar_position_front_left, num_points,
+                                   points_per_packet, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_UINT32(num_buffers - 2, packet_pool.num_free_buffers);
+    TEST_ASSERT_EQUAL_INT32(0, callback_data->called_times);
+
+    // The last one completes the frame
+    provizio_radar_packet_buffer *last_buffer = provizio_radar_packet_pool_acquire(&packet_pool);
+    provizio_radar_point_cloud_packet *last_packet = (provizio_radar_point_cloud_packet *)last_buffer->payload;
+    packet_size = make_test_packet(last_packet, frame_index, provizio_radar_position_front_left, num_points,
+                                   2 * points_per_packet, num_points - 2 * points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, last_packet, packet_size));
+
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT32(frame_index, callback_data->last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(provizio_radar_position_front_left, callback_data->last_point_cloud.radar_position_id);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_cloud.num_points_expected);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_cloud.num_points_received);
+    TEST_ASSERT_EQUAL_UINT64(3, callback_data->last_point_cloud.num_spans);
+    TEST_ASSERT_EQUAL_PTR(first_packet->radar_points, callback_data->last_first_span_points);
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(frame_index, i, 0), callback_data->last_points[i].x_meters);
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(frame_index, i, 4),
+                                callback_data->last_points[i].signal_to_noise_ratio);
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(frame_index, i, 5),
+                                callback_data->last_points[i].ground_relative_radial_velocity_m_s);
+    }
+
+    // All buffers are returned to the pool
+    TEST_ASSERT_EQUAL_UINT32(num_buffers, packet_pool.num_free_buffers);
+
+    free(callback_data);
+    free(spans);
+    free(buffers);
+}
+
+static void test_pooled_radar_point_cloud_zero_copy_errors(void)
+{
+    const uint16_t num_points = 100;
+    const uint16_t points_per_packet = 10;
+    enum
+    {
+        num_buffers = 2
+    };
+
+    provizio_radar_packet_buffer *buffers =
+        (provizio_radar_packet_buffer *)malloc(sizeof(provizio_radar_packet_buffer) * num_buffers);
+    provizio_radar_point_span spans[num_buffers];
+    provizio_radar_packet_pool packet_pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_packet_pool_init(buffers, spans, num_buffers, &packet_pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context contexts[test_num_radars];
+    provizio_pooled_radar_point_cloud_api_contexts_init_zero_copy(&test_zero_copy_callback, callback_data, &packet_pool,
+                                                                  contexts, test_num_radars);
+
+    provizio_set_on_error(&test_provizio_on_error);
+
+    // Protocol version 1 is not supported, but the buffer is still returned to the pool
+    provizio_radar_point_cloud_packet *packet =
+        (provizio_radar_point_cloud_packet *)provizio_radar_packet_pool_acquire(&packet_pool)->payload;
+    size_t packet_size =
+        make_test_packet(packet, 1, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    provizio_set_protocol_field_uint16_t(&packet->header.protocol_header.protocol_version, 1);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_PROTOCOL, provizio_handle_possible_pooled_radars_point_cloud_packet(
+                                                     contexts, test_num_radars, packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING(
+        "provizio_handle_pooled_radar_point_cloud_packet_checked: Zero-copy mode requires protocol version 2+",
+        provizio_test_error);
+    TEST_ASSERT_EQUAL_UINT32(num_buffers, packet_pool.num_free_buffers);
+
+    // Non-point cloud packets are skipped, and their buffers are returned to the pool too
+    packet = (provizio_radar_point_cloud_packet *)provizio_radar_packet_pool_acquire(&packet_pool)->payload;
+    packet_size = make_test_packet(packet, 1, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    provizio_set_protocol_field_uint16_t(&packet->header.protocol_header.packet_type,
+                                         PROVIZIO__RADAR_API_SET_RANGE_PACKET_TYPE);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED, provizio_handle_possible_pooled_radars_point_cloud_packet(
+                                                    contexts, test_num_radars, packet, packet_size));
+    TEST_ASSERT_EQUAL_UINT32(num_buffers, packet_pool.num_free_buffers);
+
+    // A partial frame of the 1st radar takes all the buffers
+    provizio_radar_point_cloud_packet stack_packet;
+    for (uint16_t i = 0; i < num_buffers; ++i)
+    {
+        packet_size = make_test_packet(&stack_packet, 1, provizio_radar_position_front_left, num_points,
+                                       (uint16_t)(i * points_per_packet), points_per_packet);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radars_point_cloud_packet(contexts, test_num_radars,
+                                                                                    &stack_packet, packet_size));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, packet_pool.num_free_buffers);
+
+    // So the 2nd radar is out of buffers
+    packet_size =
+        make_test_packet(&stack_packet, 1, provizio_radar_position_front_right, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_OUT_OF_MEMORY, provizio_handle_pooled_radars_point_cloud_packet(
+                                                          contexts, test_num_radars, &stack_packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING("provizio_handle_pooled_radar_point_cloud_packet_checked: Out of packet buffers",
+                             provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    // A newer frame of the 1st radar makes its older partial frame returned to free up buffers
+    packet_size =
+        make_test_packet(&stack_packet, 2, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_handle_pooled_radars_point_cloud_packet(contexts, test_num_radars, &stack_packet, packet_size));
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT32(1, callback_data->last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(num_buffers * points_per_packet, callback_data->last_point_cloud.num_points_received);
+    TEST_ASSERT_EQUAL_UINT64(num_buffers, callback_data->last_point_cloud.num_spans);
+    TEST_ASSERT_EQUAL_FLOAT(test_point_value(1, num_buffers * points_per_packet - 1, 0),
+                            callback_data->last_points[num_buffers * points_per_packet - 1].x_meters);
+    TEST_ASSERT_EQUAL_UINT32(num_buffers - 1, packet_pool.num_free_buffers);
+
+    // Releasing contexts returns their buffers
+    provizio_pooled_radar_point_cloud_api_context_release(&contexts[0]);
+    provizio_pooled_radar_point_cloud_api_context_release(&contexts[1]);
+    TEST_ASSERT_EQUAL_UINT32(num_buffers, packet_pool.num_free_buffers);
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+
+    free(callback_data);
+    free(buffers);
+}
+
+static void test_pooled_radar_point_cloud_dispatch_table(void)
+{
+    const uint16_t num_points = 20;
+    const uint16_t radar_position_ids[test_num_radars] = {provizio_radar_position_custom + 42, // NOLINT
+                                                          provizio_radar_position_rear_center};
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(test_max_points_per_frame, test_num_radars);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context contexts[test_num_radars];
+    provizio_pooled_radar_point_cloud_api_contexts_init(&test_pooled_callback, callback_data, &pool, contexts,
+                                                        test_num_radars);
+
+    static provizio_radar_api_contexts_dispatch_table dispatch_table; // NOLINT: static as it's large
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_pooled_radar_point_cloud_api_contexts_set_dispatch_table(contexts, 0, NULL));
+    TEST_ASSERT_EQUAL_STRING(
+        "provizio_pooled_radar_point_cloud_api_contexts_set_dispatch_table: Invalid number of contexts",
+        provizio_test_error);
+    provizio_set_on_error(NULL);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_pooled_radar_point_cloud_api_contexts_set_dispatch_table(
+                                   contexts, test_num_radars, &dispatch_table));
+
+    provizio_radar_point_cloud_packet packet;
+    for (uint32_t frame_index = 1; frame_index <= 2; ++frame_index)
+    {
+        for (size_t i = 0; i < test_num_radars; ++i)
+        {
+            const size_t packet_size =
+                make_test_packet(&packet, frame_index, radar_position_ids[i], num_points, 0, num_points);
+            TEST_ASSERT_EQUAL_INT32(0, provizio_handle_possible_pooled_radars_point_cloud_packet(
+                                           contexts, test_num_radars, &packet, packet_size));
+            TEST_ASSERT_EQUAL_UINT16(radar_position_ids[i], callback_data->last_point_cloud.radar_position_id);
+            TEST_ASSERT_EQUAL_UINT32(frame_index, callback_data->last_point_cloud.frame_index);
+            TEST_ASSERT_EQUAL_UINT16(radar_position_ids[i], contexts[i].radar_position_id);
+            TEST_ASSERT_EQUAL_UINT16(i + 1, dispatch_table.context_indices[radar_position_ids[i]]);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT32(2 * test_num_radars, callback_data->called_times);
+
+    free(callback_data);
+    free(memory);
+}
+
+typedef struct test_window_callback_data
+{
+    int32_t called_times;
+    uint32_t frame_indices[test_max_window_callbacks];
+    uint16_t num_points_received[test_max_window_callbacks];
+} test_window_callback_data;
+
+static void test_window_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                                 provizio_pooled_radar_point_cloud_api_context *context)
+{
+    test_window_callback_data *data = (test_window_callback_data *)context->user_data;
+
+    data->frame_indices[data->called_times] = point_cloud->frame_index;
+    data->num_points_received[data->called_times] = point_cloud->num_points_received;
+    ++data->called_times;
+}
+
+static void test_pooled_radar_point_cloud_window(void)
+{
+    enum
+    {
+        window_size = 4
+    };
+    const uint16_t num_points = 20;
+    const uint16_t points_per_packet = 10;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_window_pool_size(num_points, 1, window_size);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_window_callback_data callback_data;
+    memset(&callback_data, 0, sizeof(callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_window_callback, &callback_data, &pool, &context);
+    provizio_pooled_radar_point_cloud_slot slots[window_size];
+    TEST_ASSERT_EQUAL_INT32(0, provizio_pooled_radar_point_cloud_api_context_set_window(&context, slots, window_size));
+
+    // First halves of 4 interleaved frames, no frames are returned as partial
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_size = 0;
+    for (uint32_t frame_index = 1; frame_index <= window_size; ++frame_index)
+    {
+        packet_size = make_test_packet(&packet, frame_index, provizio_radar_position_front_left, num_points, 0,
+                                       points_per_packet);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    }
+    TEST_ASSERT_EQUAL_INT32(0, callback_data.called_times);
+
+    // Complete frames 3 and 2 are kept until frame 1 is complete, then all 3 are returned in order
+    const uint32_t completion_order[] = {3, 2, 1};
+    for (size_t i = 0; i < sizeof(completion_order) / sizeof(completion_order[0]); ++i)
+    {
+        TEST_ASSERT_EQUAL_INT32(0, callback_data.called_times);
+        packet_size = make_test_packet(&packet, completion_order[i], provizio_radar_position_front_left, num_points,
+                                       points_per_packet, points_per_packet);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    }
+    TEST_ASSERT_EQUAL_INT32(3, callback_data.called_times);
+    for (int32_t i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT32(i + 1, callback_data.frame_indices[i]);
+        TEST_ASSERT_EQUAL_UINT16(num_points, callback_data.num_points_received[i]);
+    }
+
+    // Frame 8 makes frame 4 fall out of the window, so it's returned as partial
+    packet_size =
+        make_test_packet(&packet, 8, provizio_radar_position_front_left, num_points, 0, points_per_packet); // NOLINT
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_INT32(4, callback_data.called_times);
+    TEST_ASSERT_EQUAL_UINT32(4, callback_data.frame_indices[3]);
+    TEST_ASSERT_EQUAL_UINT16(points_per_packet, callback_data.num_points_received[3]);
+
+    // Frame 4 is obsolete now, while frame 5 is still in the window
+    packet_size = make_test_packet(&packet, 4, provizio_radar_position_front_left, num_points, points_per_packet,
+                                   points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED,
+                            provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size =
+        make_test_packet(&packet, 5, provizio_radar_position_front_left, num_points, 0, points_per_packet); // NOLINT
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_INT32(4, callback_data.called_times);
+
+    // Releasing the context returns all the memory to the pool without calling the callback
+    provizio_pooled_radar_point_cloud_api_context_release(&context);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+    TEST_ASSERT_EQUAL_INT32(4, callback_data.called_times);
+
+    // Invalid arguments
+    provizio_set_on_error(&test_provizio_on_error);
+    memset(provizio_test_error, 0, sizeof(provizio_test_error));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_pooled_radar_point_cloud_api_context_set_window(&context, slots, 0));
+    TEST_ASSERT_EQUAL_STRING("provizio_pooled_radar_point_cloud_api_context_set_window: Invalid arguments",
+                             provizio_test_error);
+    memset(provizio_test_error, 0, sizeof(provizio_test_error));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_pooled_radar_point_cloud_api_context_set_window(&context, NULL, window_size));
+    TEST_ASSERT_EQUAL_STRING("provizio_pooled_radar_point_cloud_api_context_set_window: Invalid arguments",
+                             provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_ordered_reassembly(void)
+{
+    const uint16_t chunk_size = PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+    const uint16_t last_chunk_size = 5;
+    const uint16_t num_points = (uint16_t)(2 * chunk_size + last_chunk_size);
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_callback, callback_data, &pool, &context);
+
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, 0, chunk_size);
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_NOT_PERMITTED,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 0));
+    TEST_ASSERT_EQUAL_STRING("provizio_handle_pooled_radar_point_cloud_packet_chunk: Ordered reassembly is not enabled",
+                             provizio_test_error);
+    provizio_set_on_error(NULL);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_pooled_radar_point_cloud_api_context_enable_ordered_reassembly(&context));
+
+    // Packets with no known positions are rejected
+    packet_size = make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, 2 * chunk_size,
+                                   last_chunk_size);
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_NOT_PERMITTED,
+                            provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_STRING("provizio_handle_pooled_radar_point_cloud_packet_checked: Ordered reassembly requires "
+                             "chunk indices, see provizio_handle_pooled_radar_point_cloud_packet_chunk",
+                             provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    // Frame 1: the last (shorter) packet comes first, yet it's placed at the end and its duplicate is dropped
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 2));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 2));
+    for (uint16_t first_point = 0; first_point < 2 * chunk_size; first_point += chunk_size)
+    {
+        TEST_ASSERT_EQUAL_INT32(0, callback_data->called_times);
+        packet_size =
+            make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, first_point, chunk_size);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet,
+                                                                                         packet_size,
+                                                                                         first_point / chunk_size));
+    }
+    TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_cloud.num_points_received);
+    TEST_ASSERT_NOT_NULL(callback_data->last_point_cloud.received_chunks);
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(1, i, 0), callback_data->last_points[i].x_meters);
+    }
+
+    // Frame 2: packets with known positions are placed correctly in any order and duplicates are dropped
+    const uint32_t chunks_order[] = {2, 1, 1, 0};
+    const int32_t expected_status[] = {0, 0, PROVIZIO_E_SKIPPED, 0};
+    for (size_t i = 0; i < sizeof(chunks_order) / sizeof(chunks_order[0]); ++i)
+    {
+        TEST_ASSERT_EQUAL_INT32(1, callback_data->called_times);
+        const uint16_t first_point = (uint16_t)(chunks_order[i] * chunk_size);
+        packet_size = make_test_packet(&packet, 2, provizio_radar_position_front_left, num_points, first_point,
+                                       chunks_order[i] == 2 ? last_chunk_size : chunk_size);
+        TEST_ASSERT_EQUAL_INT32(expected_status[i], provizio_handle_pooled_radar_point_cloud_packet_chunk(
+                                                        &context, &packet, packet_size, chunks_order[i]));
+    }
+    TEST_ASSERT_EQUAL_INT32(2, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT32(2, callback_data->last_point_cloud.frame_index);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data->last_point_cloud.num_points_received);
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(test_point_value(2, i, 0), callback_data->last_points[i].x_meters);
+    }
+
+    // Packets that don't fit the chunks are rejected
+    packet_size = make_test_packet(&packet, 3, provizio_radar_position_front_left, num_points, 0, last_chunk_size);
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_PROTOCOL,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 0));
+    TEST_ASSERT_EQUAL_STRING("provizio_check_pooled_chunk_index: Packet doesn't fit the chunks of the frame",
+                             provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_PROTOCOL,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 3));
+
+    // Not supported in zero-copy mode
+    provizio_radar_packet_buffer buffers[1];
+    provizio_radar_point_span spans[1];
+    provizio_radar_packet_pool packet_pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_packet_pool_init(buffers, spans, 1, &packet_pool));
+    provizio_pooled_radar_point_cloud_api_context_release(&context);
+    provizio_pooled_radar_point_cloud_api_context_init_zero_copy(&test_zero_copy_callback, callback_data, &packet_pool,
+                                                                 &context);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_NOT_PERMITTED,
+                            provizio_pooled_radar_point_cloud_api_context_enable_ordered_reassembly(&context));
+    TEST_ASSERT_EQUAL_STRING(
+        "provizio_pooled_radar_point_cloud_api_context_enable_ordered_reassembly: Not supported in zero-copy mode",
+        provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    free(callback_data);
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_completion_deadline(void)
+{
+    enum
+    {
+        window_size = 3
+    };
+    const uint64_t deadline_ns = 10000000ULL; // 10ms
+    const uint16_t num_points = 20;
+    const uint16_t points_per_packet = 10;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_window_pool_size(num_points, 1, window_size);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_window_callback_data callback_data;
+    memset(&callback_data, 0, sizeof(callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_window_callback, &callback_data, &pool, &context);
+    provizio_pooled_radar_point_cloud_slot slots[window_size];
+    TEST_ASSERT_EQUAL_INT32(0, provizio_pooled_radar_point_cloud_api_context_set_window(&context, slots, window_size));
+
+    // No deadline set
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_pooled_radar_point_cloud_api_context_tick(&context));
+    provizio_pooled_radar_point_cloud_api_context_set_completion_deadline(&context, deadline_ns);
+
+    // Frame 1 is partial, while complete frame 2 waits for it
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_size =
+        make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size = make_test_packet(&packet, 2, provizio_radar_position_front_left, num_points, 0, num_points);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_pooled_radar_point_cloud_api_contexts_tick(&context, 1));
+    TEST_ASSERT_EQUAL_INT32(0, callback_data.called_times);
+
+    // Past the deadline frame 1 is returned as partial, followed by frame 2
+    provizio_sleep_ns(deadline_ns);
+    TEST_ASSERT_EQUAL_UINT64(1, provizio_pooled_radar_point_cloud_api_contexts_tick(&context, 1));
+    TEST_ASSERT_EQUAL_INT32(2, callback_data.called_times);
+    TEST_ASSERT_EQUAL_UINT32(1, callback_data.frame_indices[0]);
+    TEST_ASSERT_EQUAL_UINT16(points_per_packet, callback_data.num_points_received[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, callback_data.frame_indices[1]);
+    TEST_ASSERT_EQUAL_UINT16(num_points, callback_data.num_points_received[1]);
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_pooled_radar_point_cloud_api_context_tick(&context));
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_stats(void)
+{
+    const uint16_t num_points = 20;
+    const uint16_t points_per_packet = 10;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_callback, callback_data, &pool, &context);
+
+    static provizio_pooled_radar_point_cloud_stats stats;    // NOLINT: static to keep the stack small
+    static provizio_pooled_radar_point_cloud_stats snapshot; // NOLINT: static to keep the stack small
+    memset(&stats, 0, sizeof(stats));
+    provizio_pooled_radar_point_cloud_api_context_set_stats(&context, &stats);
+
+    // Partial frame 1, complete frame 2 and an empty frame 3
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_size =
+        make_test_packet(&packet, 1, provizio_radar_position_front_left, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size = make_test_packet(&packet, 2, provizio_radar_position_front_left, num_points, 0, num_points);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size = make_test_packet(&packet, 3, provizio_radar_position_front_left, 0, 0, 0);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED,
+                            provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_INT32(2, callback_data->called_times);
+
+    provizio_pooled_radar_point_cloud_stats_snapshot(&stats, &snapshot);
+    TEST_ASSERT_EQUAL_UINT64(3, snapshot.num_packets_received);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_packets_skipped);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_frames_complete);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_frames_partial);
+    TEST_ASSERT_EQUAL_UINT64(2, snapshot.points_per_frame.count);
+    TEST_ASSERT_EQUAL_UINT64(points_per_packet + num_points, snapshot.points_per_frame.sum);
+    TEST_ASSERT_EQUAL_UINT64(points_per_packet, provizio_histogram_value_at_percentile(&snapshot.points_per_frame, 50));
+    TEST_ASSERT_EQUAL_UINT64(num_points, provizio_histogram_value_at_percentile(&snapshot.points_per_frame, 100));
+    TEST_ASSERT_EQUAL_UINT64(2, snapshot.reassembly_duration_ns.count);
+    TEST_ASSERT_EQUAL_UINT64(2, snapshot.callback_duration_ns.count);
+
+    // No more stats once unset
+    provizio_pooled_radar_point_cloud_api_context_set_stats(&context, NULL);
+    packet_size = make_test_packet(&packet, 4, provizio_radar_position_front_left, num_points, 0, num_points);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_INT32(3, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT64(3, stats.num_packets_received);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.num_frames_complete);
+
+    free(callback_data);
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_loss_stats(void)
+{
+    const uint16_t num_points = 20;
+    const uint16_t points_per_packet = 10;
+    const uint16_t radar_position_id = provizio_radar_position_front_left;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_callback, callback_data, &pool, &context);
+
+    static provizio_pooled_radar_point_cloud_stats stats;    // NOLINT: static to keep the stack small
+    static provizio_pooled_radar_point_cloud_stats snapshot; // NOLINT: static to keep the stack small
+    memset(&stats, 0, sizeof(stats));
+    provizio_pooled_radar_point_cloud_api_context_set_stats(&context, &stats);
+
+    // Frames 11 and 12 are missing after frame 10...
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_size = make_test_packet(&packet, 10, radar_position_id, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size = make_test_packet(&packet, 13, radar_position_id, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_UINT64(2, stats.num_frames_missing);
+
+    // ...till frame 11 arrives late (making partial frame 10 returned)
+    packet_size = make_test_packet(&packet, 11, radar_position_id, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    TEST_ASSERT_EQUAL_UINT64(1, stats.num_frames_missing);
+
+    // A late packet of a frame received before is not a missing frame
+    packet_size = make_test_packet(&packet, 10, radar_position_id, num_points, points_per_packet, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED,
+                            provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+
+    // Completing frame 13 returns partial frame 11 first
+    packet_size = make_test_packet(&packet, 13, radar_position_id, num_points, points_per_packet, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+
+    // A packet with more points than missing in frame 14
+    packet_size = make_test_packet(&packet, 14, radar_position_id, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size = make_test_packet(&packet, 14, radar_position_id, num_points, 0, num_points);
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_PROTOCOL,
+                            provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    provizio_set_on_error(NULL);
+    TEST_ASSERT_EQUAL_INT32(3, callback_data->called_times);
+
+    provizio_pooled_radar_point_cloud_stats_snapshot(&stats, &snapshot);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_frames_missing);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_frames_complete);
+    TEST_ASSERT_EQUAL_UINT64(2, snapshot.num_frames_partial);
+    TEST_ASSERT_EQUAL_UINT64(2 * (num_points - points_per_packet), snapshot.num_points_lost);
+    TEST_ASSERT_EQUAL_UINT64(2, snapshot.num_packets_out_of_order);
+    TEST_ASSERT_EQUAL_UINT64(0, snapshot.num_packets_duplicate); // Too many points is a protocol error instead
+    TEST_ASSERT_EQUAL_UINT64(0, snapshot.num_frame_index_resets);
+
+    // Frame indices wrap around
+    packet_size = make_test_packet(&packet, 0xfffffff0, radar_position_id, num_points, 0, points_per_packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    packet_size = make_test_packet(&packet, 1, radar_position_id, num_points, 0, points_per_packet);
+    provizio_set_on_warning(&test_provizio_on_warning);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(&context, &packet, packet_size));
+    provizio_set_on_warning(NULL);
+    provizio_pooled_radar_point_cloud_stats_snapshot(&stats, &snapshot);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_frame_index_resets);
+    TEST_ASSERT_EQUAL_UINT64(2, snapshot.num_packets_out_of_order); // Not out of order after the reset
+
+    provizio_pooled_radar_point_cloud_api_context_release(&context);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(callback_data);
+    free(memory);
+}
+
+static void test_pooled_radar_point_cloud_reordering_stats(void)
+{
+    const uint16_t chunk_size = PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+    const uint16_t last_chunk_size = 5;
+    const uint16_t num_points = (uint16_t)(2 * chunk_size + last_chunk_size);
+    const uint16_t radar_position_id = provizio_radar_position_front_left;
+
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+
+    test_pooled_callback_data *callback_data = (test_pooled_callback_data *)malloc(sizeof(test_pooled_callback_data));
+    memset(callback_data, 0, sizeof(test_pooled_callback_data));
+    provizio_pooled_radar_point_cloud_api_context context;
+    provizio_pooled_radar_point_cloud_api_context_init(&test_pooled_callback, callback_data, &pool, &context);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_pooled_radar_point_cloud_api_context_enable_ordered_reassembly(&context));
+
+    static provizio_pooled_radar_point_cloud_stats stats; // NOLINT: static to keep the stack small
+    memset(&stats, 0, sizeof(stats));
+    provizio_pooled_radar_point_cloud_api_context_set_stats(&context, &stats);
+
+    // Chunks of frame 1 are swapped
+    provizio_radar_point_cloud_packet packet;
+    size_t packet_size = make_test_packet(&packet, 1, radar_position_id, num_points, chunk_size, chunk_size);
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 1));
+    packet_size = make_test_packet(&packet, 1, radar_position_id, num_points, 0, chunk_size);
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 0));
+    TEST_ASSERT_EQUAL_UINT64(1, stats.num_packets_out_of_order);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 0));
+    TEST_ASSERT_EQUAL_UINT64(1, stats.num_packets_duplicate);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.num_packets_out_of_order); // Not accounted as a duplicate
+    packet_size = make_test_packet(&packet, 1, radar_position_id, num_points, 2 * chunk_size, last_chunk_size);
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 2));
+    TEST_ASSERT_EQUAL_UINT64(1, stats.num_packets_out_of_order);
+
+    // Frame 2 falls behind frame 3 after its first packet, yet the rest of its packets come in order
+    packet_size = make_test_packet(&packet, 2, radar_position_id, num_points, 0, chunk_size);
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 0));
+    packet_size = make_test_packet(&packet, 3, radar_position_id, num_points, 0, chunk_size);
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 0));
+    packet_size = make_test_packet(&packet, 2, radar_position_id, num_points, chunk_size, chunk_size);
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 1));
+    packet_size = make_test_packet(&packet, 2, radar_position_id, num_points, 2 * chunk_size, last_chunk_size);
+    TEST_ASSERT_EQUAL_INT32(0,
+                            provizio_handle_pooled_radar_point_cloud_packet_chunk(&context, &packet, packet_size, 2));
+    TEST_ASSERT_EQUAL_UINT64(2, stats.num_packets_out_of_order);
+    TEST_ASSERT_EQUAL_INT32(2, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT64(2, stats.num_frames_complete);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.num_frames_missing);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.num_packets_duplicate);
+
+    provizio_pooled_radar_point_cloud_api_context_release(&context);
+    TEST_ASSERT_EQUAL_UINT64(0, pool.num_units_used);
+
+    free(callback_data);
+    free(memory);
+}
+
+int provizio_run_test_pooled_radar_point_cloud(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pooled_radar_point_cloud_receives_complete_frame);
+    RUN_TEST(test_pooled_radar_point_cloud_returns_partial_frames);
+    RUN_TEST(test_pooled_radar_point_cloud_out_of_memory);
+    RUN_TEST(test_pooled_radar_point_cloud_multiple_radars);
+    RUN_TEST(test_pooled_radar_point_cloud_protocol_errors);
+    RUN_TEST(test_pooled_radar_point_cloud_soa_receives_complete_frame);
+    RUN_TEST(test_pooled_radar_point_cloud_zero_copy_receives_complete_frame);
+    RUN_TEST(test_pooled_radar_point_cloud_zero_copy_errors);
+    RUN_TEST(test_pooled_radar_point_cloud_dispatch_table);
+    RUN_TEST(test_pooled_radar_point_cloud_window);
+    RUN_TEST(test_pooled_radar_point_cloud_ordered_reassembly);
+    RUN_TEST(test_pooled_radar_point_cloud_completion_deadline);
+    RUN_TEST(test_pooled_radar_point_cloud_stats);
+    RUN_TEST(test_pooled_radar_point_cloud_loss_stats);
+    RUN_TEST(test_pooled_radar_point_cloud_reordering_stats);
+
+    return UNITY_END();
+}
@@ -0,0 +1,446 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/radar_api/errno.h"
+#include "provizio/radar_api/radar_api_arena.h"
+#include "provizio/radar_api/radar_points_accumulation.h"
+#include "provizio/radar_api/radar_simulator.h"
+
+enum
+{
+    test_message_length = 1024
+};
+static char provizio_test_error[test_message_length]; // NOLINT: non-const global by design
+
+static void test_provizio_on_error(const char *error)
+{
+    strncpy(provizio_test_error, error, test_message_length - 1);
+}
+
+typedef struct test_arena_frames_data
+{
+    size_t called_times[3];
+    uint16_t last_num_points_received;
+    uint8_t soa;
+    provizio_radar_api_arena *arena; // To accumulate received point clouds in, if set
+} test_arena_frames_data;
+
+// Fix of a radar that moves 1m East every frame
+static void test_arena_fix(uint32_t frame_index, provizio_enu_fix *out_fix)
+{
+    memset(out_fix, 0, sizeof(provizio_enu_fix));
+    provizio_quaternion_set_identity(&out_fix->orientation);
+    out_fix->position.east_meters = (float)frame_index;
+}
+
+static void test_arena_frame_callback(const provizio_pooled_radar_point_cloud *point_cloud,
+                                      provizio_pooled_radar_point_cloud_api_context *context)
+{
+    test_arena_frames_data *data = (test_arena_frames_data *)context->user_data;
+    TEST_ASSERT_TRUE(point_cloud->radar_position_id < 3);
+    ++data->called_times[point_cloud->radar_position_id];
+    data->last_num_points_received = point_cloud->num_points_received;
+    if (data->soa)
+    {
+        TEST_ASSERT_NULL(point_cloud->radar_points);
+        TEST_ASSERT_NOT_NULL(point_cloud->radar_points_soa.x_meters);
+    }
+    else
+    {
+        TEST_ASSERT_NOT_NULL(point_cloud->radar_points);
+    }
+
+    if (data->arena != NULL)
+    {
+        provizio_enu_fix fix;
+        test_arena_fix(point_cloud->frame_index, &fix);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_arena_accumulate(
+                                       data->arena, (size_t)(context - data->arena->contexts), point_cloud, &fix));
+    }
+}
+
+static int32_t test_arena_on_packet(const provizio_radar_point_cloud_packet *packet, size_t packet_size,
+                                    void *user_data)
+{
+    provizio_radar_api_arena *arena = (provizio_radar_api_arena *)user_data;
+    return provizio_handle_pooled_radars_point_cloud_packet(
+        arena->contexts, arena->config.max_radars, (provizio_radar_point_cloud_packet *)packet, packet_size);
+}
+
+static void test_provizio_radar_api_arena_required_size(void)
+{
+    provizio_radar_api_arena_config config;
+    provizio_radar_api_arena_config_init(&config);
+    TEST_ASSERT_EQUAL_UINT64(1, config.max_radars);
+    TEST_ASSERT_EQUAL_UINT16(PROVIZIO__MAX_RADAR_POINTS_IN_POINT_CLOUD, config.max_points_per_frame);
+    TEST_ASSERT_EQUAL_UINT64(0, config.window_size);
+    TEST_ASSERT_EQUAL_UINT64(0, config.history_depth);
+    TEST_ASSERT_EQUAL_INT(provizio_pooled_radar_point_cloud_layout_aos, config.layout);
+
+    config.max_points_per_frame = 1000; // NOLINT
+    const size_t base_size = provizio_radar_api_arena_required_size(&config);
+    TEST_ASSERT_TRUE(base_size >= sizeof(provizio_pooled_radar_point_cloud_api_context) +
+                                      provizio_pooled_radar_point_cloud_pool_size(config.max_points_per_frame, 1));
+    // Way smaller than the non-pooled context, as points are stored right-sized
+    TEST_ASSERT_TRUE(base_size < sizeof(provizio_radar_point_cloud_api_context) / 10); // NOLINT
+
+    // Every limit adds to the required size
+    config.max_points_per_frame = 2000; // NOLINT
+    const size_t more_points_size = provizio_radar_api_arena_required_size(&config);
+    TEST_ASSERT_TRUE(more_points_size > base_size);
+    config.max_radars = 2;
+    const size_t more_radars_size = provizio_radar_api_arena_required_size(&config);
+    TEST_ASSERT_TRUE(more_radars_size > more_points_size);
+    config.window_size = 4;
+    const size_t window_size = provizio_radar_api_arena_required_size(&config);
+    TEST_ASSERT_TRUE(window_size >= more_radars_size + 2 * 4 * sizeof(provizio_pooled_radar_point_cloud_slot));
+    // Accumulated point clouds are right-sized too
+    config.history_depth = 3;
+    const size_t history_size = provizio_radar_api_arena_required_size(&config);
+    TEST_ASSERT_TRUE(history_size >= window_size + 2 * 3 * (sizeof(provizio_radar_api_arena_accumulated_point_cloud) +
+                                                           config.max_points_per_frame * sizeof(provizio_radar_point)));
+    // Way smaller than the same number of provizio_accumulated_radar_point_cloud, which embed full-size point clouds
+    const size_t full_size_history_size = 2 * 3 * sizeof(provizio_accumulated_radar_point_cloud);
+    TEST_ASSERT_TRUE(history_size - window_size < full_size_history_size / 10); // NOLINT
+
+    // Invalid configs
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_arena_required_size(NULL));
+    config.max_radars = 0;
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_arena_required_size(&config));
+    config.max_radars = (size_t)UINT16_MAX + 1;
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_arena_required_size(&config));
+    config.max_radars = 1;
+    config.max_points_per_frame = 0;
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_arena_required_size(&config));
+    config.max_points_per_frame = 1;
+    config.window_size = (size_t)UINT16_MAX + 1;
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_arena_required_size(&config));
+    config.window_size = 0;
+    config.history_depth = SIZE_MAX;
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_arena_required_size(&config));
+    config.history_depth = 0;
+    config.layout = (provizio_pooled_radar_point_cloud_layout)2;
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_arena_required_size(&config));
+}
+
+static void test_provizio_radar_api_arena_receives_and_accumulates(void)
+{
+    const size_t num_radars = 3;
+    const uint16_t num_points = 3 * PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET + 7;
+    const size_t history_depth = 4;
+    const size_t num_frames = 6;
+
+    for (int soa = 0; soa < 2; ++soa)
+    {
+        provizio_radar_api_arena_config config;
+        provizio_radar_api_arena_config_init(&config);
+        config.max_radars = num_radars;
+        config.max_points_per_frame = num_points;
+        config.window_size = 2;
+        config.history_depth = history_depth;
+        config.layout =
+            soa ? provizio_pooled_radar_point_cloud_layout_soa : provizio_pooled_radar_point_cloud_layout_aos;
+
+        // Misaligned on purpose
+        const size_t memory_size = provizio_radar_api_arena_required_size(&config);
+        uint8_t *memory_block = (uint8_t *)malloc(memory_size + 1);
+        void *memory = memory_block + 1;
+        memset(memory, 0xff, memory_size); // NOLINT: Everything is expected to be initialized by the arena
+
+        test_arena_frames_data frames_data;
+        memset(&frames_data, 0, sizeof(frames_data));
+        frames_data.soa = (uint8_t)soa;
+        provizio_radar_api_arena arena;
+        frames_data.arena = &arena;
+        TEST_ASSERT_EQUAL_INT32(
+            0, provizio_radar_api_arena_init(&config, &test_arena_frame_callback, &frames_data, memory, memory_size,
+                                             &arena));
+
+        // All parts are carved out of the memory block, aligned and not overlapping
+        const uint8_t *begin = (const uint8_t *)memory;
+        const uint8_t *end = begin + memory_size;
+        TEST_ASSERT_EQUAL_UINT64(0, (uintptr_t)arena.contexts % PROVIZIO__MEMORY_POOL_UNIT_SIZE);
+        TEST_ASSERT_TRUE((const uint8_t *)arena.contexts >= begin);
+        TEST_ASSERT_TRUE((const uint8_t *)&arena.contexts[num_radars] <= (const uint8_t *)arena.slots);
+        TEST_ASSERT_TRUE((const uint8_t *)&arena.slots[num_radars * config.window_size] <=
+                         (const uint8_t *)arena.accumulations);
+        TEST_ASSERT_TRUE((const uint8_t *)&arena.accumulations[num_radars] <=
+                         (const uint8_t *)arena.accumulations[0].point_clouds);
+        TEST_ASSERT_TRUE((const uint8_t *)&arena.accumulations[0].point_clouds[num_radars * history_depth] <=
+                         (const uint8_t *)arena.accumulations[0].point_clouds[0].radar_points);
+        TEST_ASSERT_TRUE((const uint8_t *)&arena.accumulations[num_radars - 1]
+                                 .point_clouds[history_depth - 1]
+                                 .radar_points[num_points] <= arena.pool.memory);
+        TEST_ASSERT_TRUE(arena.pool.memory + arena.pool.num_units * PROVIZIO__MEMORY_POOL_UNIT_SIZE <= end);
+        for (size_t i = 0; i < num_radars; ++i)
+        {
+            TEST_ASSERT_EQUAL_PTR(&arena.pool, arena.contexts[i].pool);
+            TEST_ASSERT_EQUAL_PTR(&arena.slots[i * config.window_size], arena.contexts[i].impl.window);
+            TEST_ASSERT_EQUAL_UINT32(config.window_size, arena.contexts[i].impl.window_size);
+            TEST_ASSERT_EQUAL_INT(config.layout, arena.contexts[i].layout);
+            TEST_ASSERT_NULL(provizio_radar_api_arena_get_accumulated_point_cloud(&arena, i, 0));
+        }
+
+        // The pool is large enough to receive interleaved frames of all radars
+        provizio_radar_simulator_options options;
+        provizio_radar_simulator_options_init(&options);
+        options.num_radars = num_radars;
+        for (size_t i = 0; i < num_radars; ++i)
+        {
+            options.radar_position_ids[i] = (uint16_t)i;
+        }
+        options.num_points_per_frame = num_points;
+        provizio_radar_simulator simulator;
+        TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_init(&options, &simulator));
+        for (size_t i = 0; i < num_frames; ++i)
+        {
+            TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_make_frame(&simulator, &test_arena_on_packet, &arena));
+        }
+        for (size_t i = 0; i < num_radars; ++i)
+        {
+            TEST_ASSERT_EQUAL_UINT64(num_frames, frames_data.called_times[i]);
+        }
+        TEST_ASSERT_EQUAL_UINT16(num_points, frames_data.last_num_points_received);
+
+        // Every radar keeps its own history_depth latest point clouds, from newest to oldest
+        provizio_radar_point *transformed_points =
+            (provizio_radar_point *)malloc(sizeof(provizio_radar_point) * num_points * history_depth);
+        for (size_t i = 0; i < num_radars; ++i)
+        {
+            for (size_t age = 0; age < history_depth; ++age)
+            {
+                const provizio_radar_api_arena_accumulated_point_cloud *accumulated_cloud =
+                    provizio_radar_api_arena_get_accumulated_point_cloud(&arena, i, age);
+                TEST_ASSERT_NOT_NULL(accumulated_cloud);
+                TEST_ASSERT_EQUAL_UINT32(num_frames - 1 - age, accumulated_cloud->frame_index);
+                TEST_ASSERT_EQUAL_UINT16(i, accumulated_cloud->radar_position_id);
+                TEST_ASSERT_EQUAL_UINT16(num_points, accumulated_cloud->num_points);
+                TEST_ASSERT_EQUAL_FLOAT((float)(num_frames - 1 - age),
+                                        accumulated_cloud->fix_when_received.position.east_meters);
+            }
+            TEST_ASSERT_NULL(provizio_radar_api_arena_get_accumulated_point_cloud(&arena, i, history_depth));
+
+            // Points of older point clouds are seen further behind, as the radar has moved East since
+            provizio_enu_fix current_fix;
+            test_arena_fix((uint32_t)(num_frames - 1), &current_fix);
+            TEST_ASSERT_EQUAL_UINT64(num_points * history_depth,
+                                     provizio_radar_api_arena_transform_accumulated_points(
+                                         &arena, i, &current_fix, transformed_points, num_points * history_depth));
+            for (size_t age = 0; age < history_depth; ++age)
+            {
+                const provizio_radar_api_arena_accumulated_point_cloud *accumulated_cloud =
+                    provizio_radar_api_arena_get_accumulated_point_cloud(&arena, i, age);
+                TEST_ASSERT_FLOAT_WITHIN(0.001F, accumulated_cloud->radar_points[0].x_meters - (float)age, // NOLINT
+                                         transformed_points[age * num_points].x_meters);
+                TEST_ASSERT_FLOAT_WITHIN(0.001F, accumulated_cloud->radar_points[0].y_meters, // NOLINT
+                                         transformed_points[age * num_points].y_meters);
+            }
+            TEST_ASSERT_EQUAL_UINT64(1, provizio_radar_api_arena_transform_accumulated_points(
+                                            &arena, i, &current_fix, transformed_points, 1));
+        }
+        free(transformed_points);
+
+        provizio_radar_api_arena_release(&arena);
+        TEST_ASSERT_EQUAL_UINT64(0, arena.pool.num_units_used);
+
+        free(memory_block);
+    }
+}
+
+static void test_provizio_radar_api_arena_built_in_slots(void)
+{
+    provizio_radar_api_arena_config config;
+    provizio_radar_api_arena_config_init(&config);
+    config.max_points_per_frame = PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+
+    const size_t memory_size = provizio_radar_api_arena_required_size(&config);
+    void *memory = malloc(memory_size);
+    provizio_radar_api_arena arena;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_arena_init(&config, &test_arena_frame_callback, NULL, memory,
+                                                             memory_size, &arena));
+    TEST_ASSERT_NULL(arena.slots);
+    TEST_ASSERT_NULL(arena.accumulations);
+    TEST_ASSERT_NULL(arena.contexts[0].impl.window);
+    TEST_ASSERT_EQUAL_PTR(&arena.pool, arena.contexts[0].pool);
+
+    // Nowhere to accumulate
+    provizio_pooled_radar_point_cloud point_cloud;
+    memset(&point_cloud, 0, sizeof(point_cloud));
+    provizio_enu_fix fix;
+    test_arena_fix(0, &fix);
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_arena_accumulate(&arena, 0, &point_cloud, &fix));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_accumulate: Invalid arguments", provizio_test_error);
+    TEST_ASSERT_NULL(provizio_radar_api_arena_get_accumulated_point_cloud(&arena, 0, 0));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_get_accumulated_point_cloud: Invalid arguments",
+                             provizio_test_error);
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_arena_transform_accumulated_points(&arena, 0, &fix, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_transform_accumulated_points: Invalid arguments",
+                             provizio_test_error);
+    provizio_radar_api_arena_reset_accumulation(&arena, 0);
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_reset_accumulation: Invalid arguments", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    provizio_radar_api_arena_release(&arena);
+    free(memory);
+}
+
+static void test_provizio_radar_api_arena_fails_on_invalid_arguments(void)
+{
+    provizio_radar_api_arena_config config;
+    provizio_radar_api_arena_config_init(&config);
+    config.max_radars = 2;
+    config.max_points_per_frame = PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+    config.window_size = 3;
+
+    const size_t memory_size = provizio_radar_api_arena_required_size(&config);
+    void *memory = malloc(memory_size);
+    provizio_radar_api_arena arena;
+
+    provizio_set_on_error(&test_provizio_on_error);
+
+    // A byte less than the required size is not enough (regardless of the alignment)
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_arena_init(&config, &test_arena_frame_callback,
+                                                                               NULL, memory, memory_size - 1, &arena));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_init: Not enough memory", provizio_test_error);
+    TEST_ASSERT_NULL(arena.contexts);
+
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_arena_init(&config, &test_arena_frame_callback,
+                                                                               NULL, NULL, memory_size, &arena));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_init: Not enough memory", provizio_test_error);
+
+    memset(provizio_test_error, 0, sizeof(provizio_test_error));
+    config.max_radars = 0;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_arena_init(&config, &test_arena_frame_callback,
+                                                                               NULL, memory, memory_size, &arena));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_init: Invalid config", provizio_test_error);
+
+    provizio_set_on_error(NULL);
+
+    free(memory);
+}
+
+static void test_provizio_radar_api_arena_accumulation_order(void)
+{
+    const uint16_t num_points = 10;
+
+    provizio_radar_api_arena_config config;
+    provizio_radar_api_arena_config_init(&config);
+    config.max_radars = 2;
+    config.max_points_per_frame = num_points;
+    config.history_depth = 3;
+
+    const size_t memory_size = provizio_radar_api_arena_required_size(&config);
+    void *memory = malloc(memory_size);
+    provizio_radar_api_arena arena;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_arena_init(&config, &test_arena_frame_callback, NULL, memory,
+                                                             memory_size, &arena));
+
+    provizio_radar_point radar_points[11];
+    memset(radar_points, 0, sizeof(radar_points));
+    provizio_pooled_radar_point_cloud point_cloud;
+    memset(&point_cloud, 0, sizeof(point_cloud));
+    point_cloud.radar_points = radar_points;
+    point_cloud.num_points_expected = point_cloud.num_points_received = num_points;
+    point_cloud.frame_index = 10; // NOLINT
+    provizio_enu_fix fix;
+    test_arena_fix(point_cloud.frame_index, &fix);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_arena_accumulate(&arena, 1, &point_cloud, &fix));
+
+    provizio_set_on_error(&test_provizio_on_error);
+
+    // Older (or same) frames can't be accumulated after newer ones
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_arena_accumulate(&arena, 1, &point_cloud, &fix));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_accumulate: Can't accumulate an older point cloud after a newer "
+                             "one",
+                             provizio_test_error);
+
+    // Neither frames of more than config.max_points_per_frame points, nor invalid fixes
+    point_cloud.frame_index = 11; // NOLINT
+    point_cloud.num_points_expected = point_cloud.num_points_received = num_points + 1;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_arena_accumulate(&arena, 1, &point_cloud, &fix));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_accumulate: Invalid arguments", provizio_test_error);
+    point_cloud.num_points_expected = point_cloud.num_points_received = num_points;
+    fix.orientation.w = 0.0F;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_api_arena_accumulate(&arena, 1, &point_cloud, &fix));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_accumulate: fix_when_received->orientation is not a valid "
+                             "rotation",
+                             provizio_test_error);
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_api_arena_transform_accumulated_points(&arena, 1, &fix, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_api_arena_transform_accumulated_points: current_fix->orientation is not "
+                             "a valid rotation",
+                             provizio_test_error);
+    test_arena_fix(point_cloud.frame_index, &fix);
+
+    provizio_set_on_error(NULL);
+
+    // Empty frames are skipped
+    point_cloud.num_points_received = 0;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_SKIPPED, provizio_radar_api_arena_accumulate(&arena, 1, &point_cloud, &fix));
+    point_cloud.num_points_received = num_points;
+    TEST_ASSERT_NULL(provizio_radar_api_arena_get_accumulated_point_cloud(&arena, 1, 1));
+
+    // Frame indices overflow resets accumulation
+    point_cloud.frame_index = UINT32_MAX;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_arena_accumulate(&arena, 1, &point_cloud, &fix));
+    TEST_ASSERT_NOT_NULL(provizio_radar_api_arena_get_accumulated_point_cloud(&arena, 1, 1));
+    point_cloud.frame_index = 0;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_arena_accumulate(&arena, 1, &point_cloud, &fix));
+    TEST_ASSERT_EQUAL_UINT32(0, provizio_radar_api_arena_get_accumulated_point_cloud(&arena, 1, 0)->frame_index);
+    TEST_ASSERT_NULL(provizio_radar_api_arena_get_accumulated_point_cloud(&arena, 1, 1));
+
+    // The other context is not affected, and accumulation can be reset explicitly
+    TEST_ASSERT_NULL(provizio_radar_api_arena_get_accumulated_point_cloud(&arena, 0, 0));
+    provizio_radar_api_arena_reset_accumulation(&arena, 1);
+    TEST_ASSERT_NULL(provizio_radar_api_arena_get_accumulated_point_cloud(&arena, 1, 0));
+
+    // Points of zero-copy point clouds are gathered from their spans
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        radar_points[i].x_meters = (float)i;
+    }
+    provizio_radar_point_span spans[2] = {{&radar_points[0], 4}, {&radar_points[4], num_points - 4}};
+    point_cloud.radar_points = NULL;
+    point_cloud.spans = spans;
+    point_cloud.num_spans = 2;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_api_arena_accumulate(&arena, 1, &point_cloud, &fix));
+    const provizio_radar_api_arena_accumulated_point_cloud *accumulated_cloud =
+        provizio_radar_api_arena_get_accumulated_point_cloud(&arena, 1, 0);
+    TEST_ASSERT_EQUAL_UINT16(num_points, accumulated_cloud->num_points);
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        TEST_ASSERT_EQUAL_FLOAT((float)i, accumulated_cloud->radar_points[i].x_meters);
+    }
+
+    provizio_radar_api_arena_release(&arena);
+    free(memory);
+}
+
+int provizio_run_test_radar_api_arena(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provizio_radar_api_arena_required_size);
+    RUN_TEST(test_provizio_radar_api_arena_receives_and_accumulates);
+    RUN_TEST(test_provizio_radar_api_arena_built_in_slots);
+    RUN_TEST(test_provizio_radar_api_arena_fails_on_invalid_arguments);
+    RUN_TEST(test_provizio_radar_api_arena_accumulation_order);
+
+    return UNITY_END();
+}
@@ -0,0 +1,117 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/radar_api/core.h"
+#include "provizio/radar_api/errno.h"
+#include "provizio/radar_api/radar_packet_pool.h"
+
+enum
+{
+    test_message_length = 1024,
+    test_num_buffers = 3
+};
+static char provizio_test_error[test_message_length]; // NOLINT: non-const global by design
+
+static void test_provizio_on_error(const char *error)
+{
+    strncpy(provizio_test_error, error, test_message_length - 1);
+}
+
+static void test_provizio_radar_packet_pool_init_fails_on_invalid_arguments(void)
+{
+    provizio_radar_packet_buffer buffers[1];
+    provizio_radar_point_span spans[1];
+    provizio_radar_packet_pool pool;
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_packet_pool_init(buffers, spans, 0, &pool));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_packet_pool_init: Invalid arguments", provizio_test_error);
+    memset(provizio_test_error, 0, sizeof(provizio_test_error));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_packet_pool_init(buffers, NULL, 1, &pool));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_packet_pool_init: Invalid arguments", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    // Nothing to acquire from a pool failed to initialize
+    TEST_ASSERT_NULL(provizio_radar_packet_pool_acquire(&pool));
+}
+
+static void test_provizio_radar_packet_pool_acquire_release_find(void)
+{
+    static provizio_radar_packet_buffer buffers[test_num_buffers]; // NOLINT: static to keep the stack small
+    provizio_radar_point_span spans[test_num_buffers];
+    provizio_radar_packet_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_packet_pool_init(buffers, spans, test_num_buffers, &pool));
+    TEST_ASSERT_EQUAL_UINT32(test_num_buffers, pool.num_free_buffers);
+
+    provizio_radar_packet_buffer *acquired[test_num_buffers];
+    for (size_t i = 0; i < test_num_buffers; ++i)
+    {
+        acquired[i] = provizio_radar_packet_pool_acquire(&pool);
+        TEST_ASSERT_NOT_NULL(acquired[i]);
+        TEST_ASSERT_EQUAL_PTR(acquired[i], provizio_radar_packet_pool_find(&pool, acquired[i]->payload));
+    }
+    TEST_ASSERT_NULL(provizio_radar_packet_pool_acquire(&pool));
+    TEST_ASSERT_EQUAL_UINT32(0, pool.num_free_buffers);
+
+    // Only payloads of the pool's buffers are found
+    uint8_t other_payload[PROVIZIO__MAX_PAYLOAD_PER_UDP_PACKET_BYTES];
+    TEST_ASSERT_NULL(provizio_radar_packet_pool_find(&pool, other_payload));
+    TEST_ASSERT_NULL(provizio_radar_packet_pool_find(&pool, acquired[0]->payload + 1));
+    TEST_ASSERT_NULL(provizio_radar_packet_pool_find(NULL, acquired[0]->payload));
+
+    // Released in any order and acquired again
+    provizio_radar_packet_pool_release(&pool, acquired[1]);
+    provizio_radar_packet_pool_release(&pool, acquired[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, pool.num_free_buffers);
+    TEST_ASSERT_EQUAL_PTR(acquired[0], provizio_radar_packet_pool_acquire(&pool));
+    TEST_ASSERT_EQUAL_PTR(acquired[1], provizio_radar_packet_pool_acquire(&pool));
+    TEST_ASSERT_NULL(provizio_radar_packet_pool_acquire(&pool));
+
+    for (size_t i = 0; i < test_num_buffers; ++i)
+    {
+        provizio_radar_packet_pool_release(&pool, acquired[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(test_num_buffers, pool.num_free_buffers);
+}
+
+static void test_provizio_radar_packet_pool_num_buffers(void)
+{
+    const uint16_t points_in_two_packets = 2 * PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+
+    const size_t batch_size = PROVIZIO__RADAR_API_RECEIVE_PACKETS_BATCH_SIZE;
+
+    // 3 radars, 2 frames being received per radar + a batch of buffers to receive into
+    TEST_ASSERT_EQUAL_UINT64(3 * 2 * 3 + batch_size,
+                             provizio_radar_packet_pool_num_buffers(points_in_two_packets + 1, 3));
+    TEST_ASSERT_EQUAL_UINT64(3 * 2 * 2 + batch_size, provizio_radar_packet_pool_num_buffers(points_in_two_packets, 3));
+
+    // 3 radars, 4 frames being received per radar + a batch of buffers to receive into
+    TEST_ASSERT_EQUAL_UINT64(3 * 4 * 2 + batch_size,
+                             provizio_radar_packet_pool_window_num_buffers(points_in_two_packets, 3, 4));
+}
+
+int provizio_run_test_radar_packet_pool(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provizio_radar_packet_pool_init_fails_on_invalid_arguments);
+    RUN_TEST(test_provizio_radar_packet_pool_acquire_release_find);
+    RUN_TEST(test_provizio_radar_packet_pool_num_buffers);
+
+    return UNITY_END();
+}
@@ -248,7 +248,7 @@ static void test_provizio_check_radar_point_cloud_packet(void)
         (test_provizio_radar_point_cloud_callback_data *)malloc(sizeof(test_provizio_radar_point_cloud_callback_data));
     memset(callback_data, 0, sizeof(test_provizio_radar_point_cloud_callback_data));
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, &api_context);
 
     provizio_radar_point_cloud_packet packet;
@@ -332,7 +332,7 @@ static void test_provizio_handle_radar_point_cloud_packet_warnings(void)
     const uint16_t radar_position_id = provizio_radar_position_front_center;
     const uint16_t num_points = 4;
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(NULL, NULL, &api_context);
 
     provizio_radar_point_cloud_packet packet;
@@ -394,7 +394,7 @@ static void test_provizio_radar_point_cloud_api_context_assign(void)
     const uint16_t radar_position_id = provizio_radar_position_front_left;
     const uint16_t num_points = 20;
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(NULL, NULL, &api_context);
 
     TEST_ASSERT_EQUAL_INT32(0, provizio_radar_point_cloud_api_context_assign(&api_context, radar_position_id));
@@ -499,7 +499,7 @@ static void test_provizio_handle_possible_radar_point_cloud_packet_ok(void)
     provizio_set_protocol_field_uint16_t(&packet.header.total_points_in_frame, num_points);
     provizio_set_protocol_field_uint16_t(&packet.header.num_points_in_packet, points_in_packet);
 
-    provizio_radar_point_cloud_api_context api_context;
+    static provizio_radar_point_cloud_api_context api_context; // NOLINT: static to keep the stack small
     provizio_radar_point_cloud_api_context_init(NULL, NULL, &api_context);
 
     TEST_ASSERT_EQUAL_INT32(0, provizio_handle_possible_radar_point_cloud_packet(
@@ -542,6 +542,105 @@ static void test_provizio_handle_possible_radars_point_cloud_packet_ok(void)
     free(api_contexts);
 }
 
+static void test_provizio_handle_radar_point_cloud_packet_resets_returned_point_cloud(void)
+{
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_id = provizio_radar_position_front_right;
+    const uint16_t radar_range = provizio_radar_range_long;
+    const uint16_t num_points[3] = {30, 10, 20};
+
+    test_provizio_radar_point_cloud_callback_data *callback_data =
+        (test_provizio_radar_point_cloud_callback_data *)malloc(sizeof(test_provizio_radar_point_cloud_callback_data));
+    memset(callback_data, 0, sizeof(test_provizio_radar_point_cloud_callback_data));
+
+    provizio_radar_point_cloud_api_context *api_context =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, api_context);
+
+    provizio_radar_point_cloud_packet packet;
+    for (uint32_t frame_index = 0; frame_index < 3; ++frame_index) // NOLINT: Don't unroll the loop
+    {
+        // Frames of fewer points follow ones of more points, reusing the same point clouds being received
+        TEST_ASSERT_EQUAL_INT32(0, create_test_pointcloud_packet(&packet, frame_index, timestamp, radar_position_id,
+                                                                 radar_range, num_points[frame_index],
+                                                                 num_points[frame_index]));
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radar_point_cloud_packet(
+                                       api_context, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+
+        TEST_ASSERT_EQUAL_INT32(frame_index + 1, callback_data->called_times);
+        const provizio_radar_point_cloud *point_cloud = &callback_data->last_point_clouds[0];
+        TEST_ASSERT_EQUAL_UINT32(frame_index, point_cloud->frame_index);
+        TEST_ASSERT_EQUAL_UINT16(num_points[frame_index], point_cloud->num_points_received);
+        TEST_ASSERT_NOT_EQUAL(0.0F, point_cloud->radar_points[num_points[frame_index] - 1].signal_to_noise_ratio);
+
+        // No leftovers of previous frames
+        for (uint16_t i = num_points[frame_index]; i < num_points[0]; ++i)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(0.0F, point_cloud->radar_points[i].x_meters);
+            TEST_ASSERT_EQUAL_FLOAT(0.0F, point_cloud->radar_points[i].signal_to_noise_ratio);
+            TEST_ASSERT_EQUAL_FLOAT(0.0F, point_cloud->radar_points[i].ground_relative_radial_velocity_m_s);
+        }
+    }
+
+    // All point clouds being received are reset after being returned
+    for (size_t i = 0; i < PROVIZIO__RADAR_POINT_CLOUD_API_CONTEXT_IMPL_POINT_CLOUDS_BEING_RECEIVED_COUNT; ++i)
+    {
+        const provizio_radar_point_cloud *point_cloud = &api_context->impl.point_clouds_being_received[i];
+        TEST_ASSERT_EQUAL_UINT32(0, point_cloud->frame_index);
+        TEST_ASSERT_EQUAL_UINT64(0, point_cloud->timestamp);
+        TEST_ASSERT_EQUAL_UINT16(0, point_cloud->num_points_expected);
+        TEST_ASSERT_EQUAL_UINT16(0, point_cloud->num_points_received);
+        TEST_ASSERT_EQUAL_FLOAT(0.0F, point_cloud->radar_points[0].x_meters);
+        TEST_ASSERT_EQUAL_FLOAT(0.0F, point_cloud->radar_points[num_points[0] - 1].x_meters);
+    }
+
+    free(api_context);
+    free(callback_data);
+}
+
+static void test_provizio_handle_possible_radars_point_cloud_packet_received_at(void)
+{
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_id = provizio_radar_position_front_left;
+    const uint16_t radar_range = provizio_radar_range_short;
+    const uint16_t num_points = 20;
+    const uint16_t points_in_packet = 10;
+    const uint64_t receive_times_ns[2] = {2000, 1000}; // Out of order, as may happen with NIC timestamps
+
+    test_provizio_radar_point_cloud_callback_data *callback_data =
+        (test_provizio_radar_point_cloud_callback_data *)malloc(sizeof(test_provizio_radar_point_cloud_callback_data));
+    memset(callback_data, 0, sizeof(test_provizio_radar_point_cloud_callback_data));
+
+    provizio_radar_point_cloud_api_context *api_context =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, api_context);
+
+    provizio_radar_point_cloud_packet packet;
+    for (uint32_t frame_index = 0; frame_index < 2; ++frame_index) // NOLINT: Don't unroll the loop
+    {
+        TEST_ASSERT_EQUAL_INT32(0, create_test_pointcloud_packet(&packet, frame_index, timestamp, radar_position_id,
+                                                                 radar_range, num_points, points_in_packet));
+        for (size_t i = 0; i < 2; ++i) // NOLINT: Don't unroll the loop
+        {
+            // The second frame is handled with unknown receive times
+            TEST_ASSERT_EQUAL_INT32(0, provizio_handle_possible_radars_point_cloud_packet_received_at(
+                                           api_context, 1, &packet,
+                                           provizio_radar_point_cloud_packet_size(&packet.header),
+                                           frame_index == 0 ? receive_times_ns[i] : 0));
+        }
+
+        TEST_ASSERT_EQUAL_INT32(frame_index + 1, callback_data->called_times);
+        const provizio_radar_point_cloud *point_cloud = &callback_data->last_point_clouds[0];
+        TEST_ASSERT_EQUAL_UINT32(frame_index, point_cloud->frame_index);
+        TEST_ASSERT_EQUAL_UINT16(num_points, point_cloud->num_points_received);
+        TEST_ASSERT_EQUAL_UINT64(frame_index == 0 ? receive_times_ns[1] : 0, point_cloud->first_packet_receive_time_ns);
+        TEST_ASSERT_EQUAL_UINT64(frame_index == 0 ? receive_times_ns[0] : 0, point_cloud->last_packet_receive_time_ns);
+    }
+
+    free(api_context);
+    free(callback_data);
+}
+
 static void test_provizio_handle_possible_radars_point_cloud_packet_ground_velocity(void)
 {
     const uint32_t frame_index = 1000;
@@ -655,6 +754,345 @@ static void test_provizio_handle_possible_radars_point_cloud_packet_v1(void)
     free(callback_data);
 }
 
+static void test_provizio_radar_points_soa_init(void)
+{
+    const uint16_t capacity = 10;
+    const size_t memory_size = provizio_radar_points_soa_required_size(capacity);
+    uint8_t *memory = (uint8_t *)malloc(memory_size + 1);
+    provizio_radar_points_soa points;
+
+    // Misaligned memory is fine as long as its size is enough
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_points_soa_init(memory + 1, memory_size, capacity, &points));
+    TEST_ASSERT_EQUAL_UINT16(capacity, points.capacity);
+    const float *columns[] = {points.x_meters,
+                              points.y_meters,
+                              points.z_meters,
+                              points.radar_relative_radial_velocity_m_s,
+                              points.signal_to_noise_ratio,
+                              points.ground_relative_radial_velocity_m_s};
+    for (size_t i = 0; i < sizeof(columns) / sizeof(columns[0]); ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT64(0, (uintptr_t)columns[i] % PROVIZIO__RADAR_POINTS_SOA_ALIGNMENT);
+        TEST_ASSERT_TRUE((const uint8_t *)columns[i] >= memory + 1); // NOLINT: clang-tidy doesn't like TEST_ASSERT_TRUE
+        TEST_ASSERT_TRUE((const uint8_t *)(columns[i] + capacity) <= memory + 1 + memory_size); // NOLINT
+    }
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_radar_points_soa_init(memory, sizeof(float) * capacity, capacity, &points));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_points_soa_init: Not enough memory", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    free(memory);
+}
+
+static void test_provizio_radar_points_soa_conversions(void)
+{
+    enum
+    {
+        num_points = 50,
+        capacity = 2 * num_points
+    };
+
+    provizio_radar_point_cloud_packet packet;
+    TEST_ASSERT_EQUAL_INT32(0, create_test_pointcloud_packet(&packet, 1, 2, provizio_radar_position_front_center,
+                                                             provizio_radar_range_short, num_points, num_points));
+    provizio_radar_point aos_points[capacity];
+    TEST_ASSERT_EQUAL_INT32(0, provizio_get_radar_point_cloud_packet_points(&packet, aos_points));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_get_radar_point_cloud_packet_points(&packet, &aos_points[num_points]));
+
+    const size_t memory_size = provizio_radar_points_soa_required_size(capacity);
+    void *memory = malloc(memory_size);
+    provizio_radar_points_soa soa_points;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_points_soa_init(memory, memory_size, capacity, &soa_points));
+
+    // Packet points are scattered to columns, starting at any index
+    TEST_ASSERT_EQUAL_INT32(0, provizio_get_radar_point_cloud_packet_points_soa(&packet, &soa_points, 0));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_get_radar_point_cloud_packet_points_soa(&packet, &soa_points, num_points));
+    for (uint16_t i = 0; i < capacity; ++i)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(aos_points[i].x_meters, soa_points.x_meters[i]);
+        TEST_ASSERT_EQUAL_FLOAT(aos_points[i].y_meters, soa_points.y_meters[i]);
+        TEST_ASSERT_EQUAL_FLOAT(aos_points[i].z_meters, soa_points.z_meters[i]);
+        TEST_ASSERT_EQUAL_FLOAT(aos_points[i].radar_relative_radial_velocity_m_s,
+                                soa_points.radar_relative_radial_velocity_m_s[i]);
+        TEST_ASSERT_EQUAL_FLOAT(aos_points[i].signal_to_noise_ratio, soa_points.signal_to_noise_ratio[i]);
+        TEST_ASSERT_EQUAL_FLOAT(aos_points[i].ground_relative_radial_velocity_m_s,
+                                soa_points.ground_relative_radial_velocity_m_s[i]);
+    }
+
+    // SoA -> AoS -> SoA
+    provizio_radar_point converted_points[capacity];
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_points_soa_to_aos(&soa_points, capacity, converted_points));
+    TEST_ASSERT_EQUAL_MEMORY(aos_points, converted_points, sizeof(aos_points));
+    memset(memory, 0, memory_size);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_points_aos_to_soa(converted_points, capacity, &soa_points));
+    TEST_ASSERT_EQUAL_FLOAT(aos_points[capacity - 1].x_meters, soa_points.x_meters[capacity - 1]);
+    TEST_ASSERT_EQUAL_FLOAT(aos_points[capacity - 1].ground_relative_radial_velocity_m_s,
+                            soa_points.ground_relative_radial_velocity_m_s[capacity - 1]);
+
+    // Not enough capacity
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_get_radar_point_cloud_packet_points_soa(&packet, &soa_points, num_points + 1));
+    TEST_ASSERT_EQUAL_STRING("provizio_get_radar_point_cloud_packet_points_soa: Not enough capacity",
+                             provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_radar_points_aos_to_soa(converted_points, capacity + 1, &soa_points));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_points_aos_to_soa: Not enough capacity", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_radar_points_soa_to_aos(&soa_points, capacity + 1, converted_points));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_points_soa_to_aos: Not enough points", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    free(memory);
+}
+
+static void test_provizio_get_radar_point_cloud_packet_points_soa_v1(void)
+{
+    const uint16_t num_points = 72;
+
+    provizio_radar_point_cloud_packet_protocol_v1 packet;
+    TEST_ASSERT_EQUAL_INT32(0, create_test_pointcloud_packet_v1(&packet, 1, 2, provizio_radar_position_rear_left,
+                                                                provizio_radar_range_long, num_points, num_points));
+
+    const size_t memory_size = provizio_radar_points_soa_required_size(num_points);
+    void *memory = malloc(memory_size);
+    provizio_radar_points_soa soa_points;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_points_soa_init(memory, memory_size, num_points, &soa_points));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_get_radar_point_cloud_packet_points_soa(
+                                   (const provizio_radar_point_cloud_packet *)&packet, &soa_points, 0));
+
+    for (uint16_t i = 0; i < num_points; ++i)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(provizio_get_protocol_field_float(&packet.radar_points[i].x_meters),
+                                soa_points.x_meters[i]);
+        TEST_ASSERT_EQUAL_FLOAT(provizio_get_protocol_field_float(&packet.radar_points[i].signal_to_noise_ratio),
+                                soa_points.signal_to_noise_ratio[i]);
+        TEST_ASSERT_EQUAL_FLOAT(nanf(""), soa_points.ground_relative_radial_velocity_m_s[i]);
+    }
+
+    free(memory);
+}
+
+static void test_provizio_radar_point_cloud_api_contexts_dispatch_table(void)
+{
+    enum
+    {
+        num_contexts = 3
+    };
+    const uint16_t radar_position_ids[num_contexts + 1] = {
+        provizio_radar_position_custom + 7, provizio_radar_position_front_left, provizio_radar_position_custom + 3,
+        provizio_radar_position_custom + 1000}; // NOLINT: magic numbers are fine in tests
+    const uint16_t num_points = 10;
+
+    static provizio_radar_api_contexts_dispatch_table dispatch_table; // NOLINT: static as it's large
+    provizio_radar_point_cloud_api_context *api_contexts =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context) * num_contexts);
+    TEST_ASSERT_NOT_EQUAL(NULL, api_contexts);
+    test_provizio_radar_point_cloud_callback_data *callback_data =
+        (test_provizio_radar_point_cloud_callback_data *)malloc(sizeof(test_provizio_radar_point_cloud_callback_data));
+    TEST_ASSERT_NOT_EQUAL(NULL, callback_data);
+    memset(callback_data, 0, sizeof(test_provizio_radar_point_cloud_callback_data));
+    provizio_radar_point_cloud_api_contexts_init(&test_provizio_radar_point_cloud_callback, callback_data, api_contexts,
+                                                 num_contexts);
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_point_cloud_api_contexts_set_dispatch_table(
+                                                     api_contexts, 0, &dispatch_table));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_point_cloud_api_contexts_set_dispatch_table: Invalid number of contexts",
+                             provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_radar_point_cloud_api_contexts_set_dispatch_table(api_contexts, num_contexts, &dispatch_table));
+
+    // Contexts get assigned as radars are first seen
+    provizio_radar_point_cloud_packet packet;
+    for (uint32_t frame_index = 1; frame_index <= 2; ++frame_index)
+    {
+        for (uint16_t i = 0; i < num_contexts; ++i)
+        {
+            create_test_pointcloud_packet(&packet, frame_index, 0, radar_position_ids[i], provizio_radar_range_medium,
+                                          num_points, num_points);
+            TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radars_point_cloud_packet(
+                                           api_contexts, num_contexts, &packet,
+                                           provizio_radar_point_cloud_packet_size(&packet.header)));
+            TEST_ASSERT_EQUAL_UINT16(radar_position_ids[i], api_contexts[i].radar_position_id);
+            TEST_ASSERT_EQUAL_UINT32(frame_index, api_contexts[i].impl.latest_frame);
+            TEST_ASSERT_EQUAL_UINT16(radar_position_ids[i], callback_data->last_point_clouds[0].radar_position_id);
+            TEST_ASSERT_EQUAL_UINT16(i + 1, dispatch_table.context_indices[radar_position_ids[i]]);
+        }
+    }
+
+    // Out of contexts
+    create_test_pointcloud_packet(&packet, 1, 0, radar_position_ids[num_contexts], provizio_radar_range_medium,
+                                  num_points, num_points);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_OUT_OF_CONTEXTS, provizio_handle_radars_point_cloud_packet(
+                                                            api_contexts, num_contexts, &packet,
+                                                            provizio_radar_point_cloud_packet_size(&packet.header)));
+    TEST_ASSERT_EQUAL_STRING("provizio_get_radar_point_cloud_api_context_by_position_id: Out of available contexts",
+                             provizio_test_error);
+    TEST_ASSERT_EQUAL_UINT16(0, dispatch_table.context_indices[radar_position_ids[num_contexts]]);
+    provizio_set_on_error(NULL);
+
+    // A stale entry (pointing to a context of another radar) gets corrected
+    dispatch_table.context_indices[radar_position_ids[0]] = 3;
+    create_test_pointcloud_packet(&packet, 3, 0, radar_position_ids[0], provizio_radar_range_medium, num_points,
+                                  num_points);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radars_point_cloud_packet(
+                                   api_contexts, num_contexts, &packet,
+                                   provizio_radar_point_cloud_packet_size(&packet.header)));
+    TEST_ASSERT_EQUAL_UINT32(3, api_contexts[0].impl.latest_frame);
+    TEST_ASSERT_EQUAL_UINT32(2, api_contexts[2].impl.latest_frame);
+    TEST_ASSERT_EQUAL_UINT16(1, dispatch_table.context_indices[radar_position_ids[0]]);
+
+    // Frame indices wrapping around reset the first context, which keeps the dispatch table
+    const uint32_t large_frame_index = 0xfffffff0;
+    provizio_set_on_warning(&test_provizio_on_warning);
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        create_test_pointcloud_packet(&packet, i == 0 ? large_frame_index : 1, 0, radar_position_ids[0],
+                                      provizio_radar_range_medium, num_points, num_points);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radars_point_cloud_packet(
+                                       api_contexts, num_contexts, &packet,
+                                       provizio_radar_point_cloud_packet_size(&packet.header)));
+    }
+    provizio_set_on_warning(NULL);
+    TEST_ASSERT_EQUAL_STRING(
+        "provizio_get_point_cloud_being_received: frame indices overflow detected - resetting API state",
+        provizio_test_warning);
+    TEST_ASSERT_EQUAL_PTR(&dispatch_table, api_contexts[0].dispatch_table);
+    TEST_ASSERT_EQUAL_UINT32(1, api_contexts[0].impl.latest_frame);
+    TEST_ASSERT_EQUAL_UINT16(radar_position_ids[0], api_contexts[0].radar_position_id);
+    TEST_ASSERT_EQUAL_UINT16(1, dispatch_table.context_indices[radar_position_ids[0]]);
+
+    free(callback_data);
+    free(api_contexts);
+}
+
+static void test_provizio_radar_point_cloud_completion_deadline(void)
+{
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint64_t deadline_ns = 10000000ULL; // 10ms
+    const uint16_t radar_position_id = provizio_radar_position_front_left;
+    const uint16_t radar_range = provizio_radar_range_short;
+    const uint16_t num_points = 20;
+    const uint16_t points_in_packet = 10;
+
+    test_provizio_radar_point_cloud_callback_data *callback_data =
+        (test_provizio_radar_point_cloud_callback_data *)malloc(sizeof(test_provizio_radar_point_cloud_callback_data));
+    memset(callback_data, 0, sizeof(test_provizio_radar_point_cloud_callback_data));
+
+    provizio_radar_point_cloud_api_context *api_context =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, api_context);
+
+    // No deadline set
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_point_cloud_api_context_tick(api_context));
+    provizio_radar_point_cloud_api_context_set_completion_deadline(api_context, deadline_ns);
+
+    // Frames 1 and 2 are both partial
+    provizio_radar_point_cloud_packet packet;
+    for (uint32_t frame_index = 1; frame_index <= 2; ++frame_index) // NOLINT: Don't unroll the loop
+    {
+        TEST_ASSERT_EQUAL_INT32(0, create_test_pointcloud_packet(&packet, frame_index, timestamp, radar_position_id,
+                                                                 radar_range, num_points, points_in_packet));
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radar_point_cloud_packet(
+                                       api_context, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+    }
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_point_cloud_api_contexts_tick(api_context, 1));
+    TEST_ASSERT_EQUAL_INT32(0, callback_data->called_times);
+
+    // Past the deadline both are returned as partial in order of frames
+    provizio_sleep_ns(deadline_ns);
+    TEST_ASSERT_EQUAL_UINT64(2, provizio_radar_point_cloud_api_contexts_tick(api_context, 1));
+    TEST_ASSERT_EQUAL_INT32(2, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT32(1, callback_data->last_point_clouds[1].frame_index);
+    TEST_ASSERT_EQUAL_UINT32(2, callback_data->last_point_clouds[0].frame_index);
+    TEST_ASSERT_EQUAL_UINT16(points_in_packet, callback_data->last_point_clouds[0].num_points_received);
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_radar_point_cloud_api_context_tick(api_context));
+
+    free(api_context);
+    free(callback_data);
+}
+
+static void test_provizio_radar_point_cloud_stats(void)
+{
+    const uint64_t timestamp = 0x0123456789abcdef;
+    const uint16_t radar_position_id = provizio_radar_position_front_left;
+    const uint16_t radar_range = provizio_radar_range_short;
+    const uint16_t num_points = 20;
+    const uint16_t points_in_packet = 10;
+    const uint32_t frame_indices[] = {10, 13, 11, 13, 14}; // Frames 11 and 12 are missing, till frame 11 arrives late
+    const uint16_t total_points[] = {num_points, num_points, num_points, num_points, 0};
+
+    test_provizio_radar_point_cloud_callback_data *callback_data =
+        (test_provizio_radar_point_cloud_callback_data *)malloc(sizeof(test_provizio_radar_point_cloud_callback_data));
+    memset(callback_data, 0, sizeof(test_provizio_radar_point_cloud_callback_data));
+
+    provizio_radar_point_cloud_api_context *api_context =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_context_init(&test_provizio_radar_point_cloud_callback, callback_data, api_context);
+
+    static provizio_radar_point_cloud_stats stats;    // NOLINT: static to keep the stack small
+    static provizio_radar_point_cloud_stats snapshot; // NOLINT: static to keep the stack small
+    memset(&stats, 0, sizeof(stats));
+    provizio_radar_point_cloud_api_context_set_stats(api_context, &stats);
+
+    provizio_radar_point_cloud_packet packet;
+    for (size_t i = 0; i < sizeof(frame_indices) / sizeof(frame_indices[0]); ++i) // NOLINT: Don't unroll the loop
+    {
+        TEST_ASSERT_EQUAL_INT32(0, create_test_pointcloud_packet(&packet, frame_indices[i], timestamp,
+                                                                 radar_position_id, radar_range, total_points[i],
+                                                                 total_points[i] > 0 ? points_in_packet : 0));
+        TEST_ASSERT_EQUAL_INT32(total_points[i] > 0 ? 0 : PROVIZIO_E_SKIPPED,
+                                provizio_handle_radar_point_cloud_packet(
+                                    api_context, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+    }
+
+    // Partial frames 10 and 11 are returned before complete frame 13
+    TEST_ASSERT_EQUAL_INT32(3, callback_data->called_times);
+    provizio_radar_point_cloud_stats_snapshot(&stats, &snapshot);
+    TEST_ASSERT_EQUAL_UINT64(5, snapshot.num_packets_received);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_packets_skipped);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_frames_complete);
+    TEST_ASSERT_EQUAL_UINT64(2, snapshot.num_frames_partial);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_frames_missing);
+    TEST_ASSERT_EQUAL_UINT64(2 * (num_points - points_in_packet), snapshot.num_points_lost);
+    TEST_ASSERT_EQUAL_UINT64(1, snapshot.num_packets_out_of_order); // Frame 11 after 13
+    TEST_ASSERT_EQUAL_UINT64(0, snapshot.num_packets_duplicate);
+    TEST_ASSERT_EQUAL_UINT64(3, snapshot.points_per_frame.count);
+    TEST_ASSERT_EQUAL_UINT64(2 * points_in_packet + num_points, snapshot.points_per_frame.sum);
+    TEST_ASSERT_EQUAL_UINT64(3, snapshot.reassembly_duration_ns.count);
+    TEST_ASSERT_EQUAL_UINT64(3, snapshot.callback_duration_ns.count);
+
+    // Frame indices wrap around, yet stats are kept
+    TEST_ASSERT_EQUAL_INT32(0, create_test_pointcloud_packet(&packet, 0xfffffff0, timestamp, radar_position_id,
+                                                             radar_range, num_points, num_points));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radar_point_cloud_packet(
+                                   api_context, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+    TEST_ASSERT_EQUAL_INT32(0, create_test_pointcloud_packet(&packet, 0, timestamp, radar_position_id, radar_range,
+                                                             num_points, num_points));
+    provizio_set_on_warning(&test_provizio_on_warning);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radar_point_cloud_packet(
+                                   api_context, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+    provizio_set_on_warning(NULL);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.num_frame_index_resets);
+    TEST_ASSERT_EQUAL_UINT64(3, stats.num_frames_complete);
+
+    // No more stats once unset
+    provizio_radar_point_cloud_api_context_set_stats(api_context, NULL);
+    TEST_ASSERT_EQUAL_INT32(0, create_test_pointcloud_packet(&packet, 1, timestamp, radar_position_id, radar_range,
+                                                             num_points, num_points));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radar_point_cloud_packet(
+                                   api_context, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+    TEST_ASSERT_EQUAL_INT32(6, callback_data->called_times);
+    TEST_ASSERT_EQUAL_UINT64(7, stats.num_packets_received);
+    TEST_ASSERT_EQUAL_UINT64(3, stats.num_frames_complete);
+
+    free(api_context);
+    free(callback_data);
+}
+
 int provizio_run_test_radar_point_cloud(void)
 {
     memset(provizio_test_warning, 0, sizeof(provizio_test_warning));
@@ -673,8 +1111,16 @@ int provizio_run_test_radar_point_cloud(void)
     RUN_TEST(test_provizio_handle_possible_radar_point_cloud_packet_ok);
     RUN_TEST(test_provizio_handle_possible_radars_point_cloud_packet_ok);
     RUN_TEST(test_provizio_handle_possible_radars_point_cloud_packet_ground_velocity);
+    RUN_TEST(test_provizio_handle_radar_point_cloud_packet_resets_returned_point_cloud);
+    RUN_TEST(test_provizio_handle_possible_radars_point_cloud_packet_received_at);
     RUN_TEST(test_provizio_handle_possible_radars_point_cloud_packet_v1);
     RUN_TEST(test_provizio_check_radar_point_cloud_packet_v1);
+    RUN_TEST(test_provizio_radar_points_soa_init);
+    RUN_TEST(test_provizio_radar_points_soa_conversions);
+    RUN_TEST(test_provizio_get_radar_point_cloud_packet_points_soa_v1);
+    RUN_TEST(test_provizio_radar_point_cloud_api_contexts_dispatch_table);
+    RUN_TEST(test_provizio_radar_point_cloud_completion_deadline);
+    RUN_TEST(test_provizio_radar_point_cloud_stats);
 
     return UNITY_END();
 }
@@ -0,0 +1,265 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/radar_api/errno.h"
+#include "provizio/radar_api/radar_point_cloud_queue.h"
+#include "provizio/util.h"
+
+enum
+{
+    test_message_length = 1024,
+    test_num_slots = 2,
+    test_num_points = 10
+};
+static char provizio_test_error[test_message_length]; // NOLINT: non-const global by design
+
+static void test_provizio_on_error(const char *error)
+{
+    strncpy(provizio_test_error, error, test_message_length - 1);
+}
+
+static void make_test_packet(const uint32_t frame_index, const uint16_t radar_position_id,
+                             provizio_radar_point_cloud_packet *out_packet)
+{
+    memset(out_packet, 0, sizeof(provizio_radar_point_cloud_packet));
+    provizio_set_protocol_field_uint16_t(&out_packet->header.protocol_header.packet_type,
+                                         PROVIZIO__RADAR_API_POINT_CLOUD_PACKET_TYPE);
+    provizio_set_protocol_field_uint16_t(&out_packet->header.protocol_header.protocol_version,
+                                         PROVIZIO__RADAR_API_POINT_CLOUD_PROTOCOL_VERSION);
+    provizio_set_protocol_field_uint32_t(&out_packet->header.frame_index, frame_index);
+    provizio_set_protocol_field_uint16_t(&out_packet->header.radar_position_id, radar_position_id);
+    provizio_set_protocol_field_uint16_t(&out_packet->header.total_points_in_frame, test_num_points);
+    provizio_set_protocol_field_uint16_t(&out_packet->header.num_points_in_packet, test_num_points);
+    for (uint16_t i = 0; i < test_num_points; ++i)
+    {
+        provizio_set_protocol_field_float(&out_packet->radar_points[i].x_meters, (float)(frame_index + i));
+    }
+}
+
+static void test_provizio_radar_point_cloud_queue_init_fails_on_invalid_arguments(void)
+{
+    provizio_radar_point_cloud_queue queue;
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_point_cloud_queue_init(NULL, 1, &queue));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_point_cloud_queue_init: Invalid arguments", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    // Nothing to pop from a queue failed to initialize
+    const provizio_radar_point_cloud *point_cloud = NULL;
+    TEST_ASSERT_NULL(provizio_radar_point_cloud_queue_try_pop(&queue));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, provizio_radar_point_cloud_queue_pop(&queue, 0, &point_cloud));
+    TEST_ASSERT_NULL(point_cloud);
+}
+
+static void test_provizio_radar_point_cloud_queue_publishes_instead_of_callback(void)
+{
+    const uint16_t radar_position_ids[2] = {provizio_radar_position_rear_left, provizio_radar_position_rear_right};
+
+    provizio_radar_point_cloud *slots =
+        (provizio_radar_point_cloud *)malloc(sizeof(provizio_radar_point_cloud) * test_num_slots);
+    provizio_radar_point_cloud_api_context *contexts =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context) * 2);
+    provizio_radar_point_cloud_packet packet;
+
+    provizio_radar_point_cloud_queue queue;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_point_cloud_queue_init(slots, test_num_slots, &queue));
+    provizio_radar_point_cloud_api_contexts_init_queued(&queue, contexts, 2);
+
+    // Each packet is a complete frame, so it's published right away
+    for (size_t i = 0; i < 2; ++i)
+    {
+        make_test_packet(17, radar_position_ids[i], &packet);
+        TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radars_point_cloud_packet(
+                                       contexts, 2, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+    }
+
+    // The queue is full, so the next one is dropped
+    make_test_packet(18, radar_position_ids[0], &packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radars_point_cloud_packet(
+                                   contexts, 2, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+    TEST_ASSERT_EQUAL_UINT32(1, queue.num_dropped_point_clouds);
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const provizio_radar_point_cloud *point_cloud = provizio_radar_point_cloud_queue_try_pop(&queue);
+        TEST_ASSERT_NOT_NULL(point_cloud);
+        TEST_ASSERT_EQUAL_UINT32(17, point_cloud->frame_index);
+        TEST_ASSERT_EQUAL_UINT16(radar_position_ids[i], point_cloud->radar_position_id);
+        TEST_ASSERT_EQUAL_UINT16(test_num_points, point_cloud->num_points_expected);
+        TEST_ASSERT_EQUAL_UINT16(test_num_points, point_cloud->num_points_received);
+        TEST_ASSERT_EQUAL_FLOAT(17.0F, point_cloud->radar_points[0].x_meters);
+        TEST_ASSERT_EQUAL_FLOAT(17.0F + test_num_points - 1, point_cloud->radar_points[test_num_points - 1].x_meters);
+
+        // Still the same until released
+        TEST_ASSERT_EQUAL_PTR(point_cloud, provizio_radar_point_cloud_queue_try_pop(&queue));
+        provizio_radar_point_cloud_queue_release(&queue);
+    }
+    TEST_ASSERT_NULL(provizio_radar_point_cloud_queue_try_pop(&queue));
+
+    free(contexts);
+    free(slots);
+}
+
+static void test_provizio_radar_point_cloud_queue_of_pooled_slots(void)
+{
+    const uint16_t radar_position_id = provizio_radar_position_front_left;
+    provizio_pooled_radar_point_cloud slots[test_num_slots];
+    provizio_radar_point points[test_num_slots * test_num_points];
+    provizio_radar_point_cloud_packet packet;
+
+    provizio_radar_point_cloud_queue queue;
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_radar_point_cloud_queue_init_pooled(slots, points, test_num_slots, 0, &queue));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_point_cloud_queue_init_pooled: Invalid arguments", provizio_test_error);
+    provizio_set_on_error(NULL);
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_radar_point_cloud_queue_init_pooled(slots, points, test_num_slots, test_num_points, &queue));
+
+    // Published by a classic context
+    provizio_radar_point_cloud_api_context *context =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_context_init_queued(&queue, context);
+    make_test_packet(17, radar_position_id, &packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radar_point_cloud_packet(
+                                   context, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+
+    // Published by a pooled context, points of which are stored as columns
+    const size_t memory_size = provizio_pooled_radar_point_cloud_pool_size(test_num_points, 1);
+    void *memory = malloc(memory_size);
+    provizio_memory_pool pool;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_memory_pool_init(memory, memory_size, &pool));
+    provizio_pooled_radar_point_cloud_api_context pooled_context;
+    provizio_pooled_radar_point_cloud_api_context_init_soa(&provizio_pooled_radar_point_cloud_queue_publish, &queue,
+                                                           &pool, &pooled_context);
+    make_test_packet(18, radar_position_id, &packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_pooled_radar_point_cloud_packet(
+                                   &pooled_context, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+
+    for (uint32_t frame_index = 17; frame_index <= 18; ++frame_index)
+    {
+        const provizio_pooled_radar_point_cloud *point_cloud = NULL;
+        TEST_ASSERT_EQUAL_INT32(0, provizio_radar_point_cloud_queue_pop_pooled(&queue, 0, &point_cloud));
+        TEST_ASSERT_NOT_NULL(point_cloud);
+        TEST_ASSERT_EQUAL_UINT32(frame_index, point_cloud->frame_index);
+        TEST_ASSERT_EQUAL_UINT16(radar_position_id, point_cloud->radar_position_id);
+        TEST_ASSERT_EQUAL_UINT16(test_num_points, point_cloud->num_points_received);
+        for (uint16_t i = 0; i < test_num_points; ++i)
+        {
+            TEST_ASSERT_EQUAL_FLOAT((float)(frame_index + i), point_cloud->radar_points[i].x_meters);
+        }
+        TEST_ASSERT_NULL(point_cloud->spans);
+        TEST_ASSERT_NULL(point_cloud->received_chunks);
+        provizio_radar_point_cloud_queue_release(&queue);
+    }
+    TEST_ASSERT_NULL(provizio_radar_point_cloud_queue_try_pop_pooled(&queue));
+
+    // Point clouds that don't fit a slot are dropped
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_point_cloud_queue_init_pooled(slots, points, test_num_slots,
+                                                                            test_num_points - 1, &queue));
+    make_test_packet(19, radar_position_id, &packet);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_handle_radar_point_cloud_packet(
+                                   context, &packet, provizio_radar_point_cloud_packet_size(&packet.header)));
+    TEST_ASSERT_EQUAL_UINT32(1, queue.num_dropped_point_clouds);
+    TEST_ASSERT_NULL(provizio_radar_point_cloud_queue_try_pop_pooled(&queue));
+
+    provizio_pooled_radar_point_cloud_api_context_release(&pooled_context);
+    free(memory);
+    free(context);
+}
+
+typedef struct test_publisher_thread_data // NOLINT: it's aligned exactly as it's supposed to
+{
+    provizio_radar_point_cloud_api_context *context;
+    uint32_t num_frames;
+} test_publisher_thread_data;
+
+static void *test_publisher_thread(void *arg)
+{
+    test_publisher_thread_data *data = (test_publisher_thread_data *)arg;
+    provizio_radar_point_cloud_packet packet;
+
+    for (uint32_t frame_index = 0; frame_index < data->num_frames; ++frame_index)
+    {
+        // Letting the consumer wait for some of the frames
+        provizio_sleep_ns(1000000ULL); // 1ms
+
+        make_test_packet(frame_index, provizio_radar_position_front_center, &packet);
+        provizio_handle_radar_point_cloud_packet(data->context, &packet,
+                                                 provizio_radar_point_cloud_packet_size(&packet.header));
+    }
+
+    return NULL;
+}
+
+static void test_provizio_radar_point_cloud_queue_pop_waits_for_point_clouds(void)
+{
+    const uint64_t timeout_ns = 5000000000ULL; // 5s
+    const uint32_t num_frames = 10;
+
+    // Enough slots for all frames, so that none of them is dropped, even if the consumer thread is slow to start
+    provizio_radar_point_cloud *slots =
+        (provizio_radar_point_cloud *)malloc(sizeof(provizio_radar_point_cloud) * num_frames);
+    provizio_radar_point_cloud_api_context *context =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context));
+
+    provizio_radar_point_cloud_queue queue;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_point_cloud_queue_init(slots, num_frames, &queue));
+    provizio_radar_point_cloud_api_context_init_queued(&queue, context);
+
+    test_publisher_thread_data thread_data;
+    thread_data.context = context;
+    thread_data.num_frames = num_frames;
+    pthread_t publisher;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&publisher, NULL, &test_publisher_thread, &thread_data));
+
+    // Point clouds arrive in order
+    for (uint32_t frame_index = 0; frame_index < num_frames; ++frame_index)
+    {
+        const provizio_radar_point_cloud *point_cloud = NULL;
+        TEST_ASSERT_EQUAL_INT32(0, provizio_radar_point_cloud_queue_pop(&queue, timeout_ns, &point_cloud));
+        TEST_ASSERT_NOT_NULL(point_cloud);
+        TEST_ASSERT_EQUAL_UINT32(frame_index, point_cloud->frame_index);
+        provizio_radar_point_cloud_queue_release(&queue);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(publisher, NULL));
+
+    // Nothing else gets published
+    const provizio_radar_point_cloud *point_cloud = NULL;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_TIMEOUT, provizio_radar_point_cloud_queue_pop(&queue, 1000000ULL, &point_cloud));
+    TEST_ASSERT_NULL(point_cloud);
+
+    free(context);
+    free(slots);
+}
+
+int provizio_run_test_radar_point_cloud_queue(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provizio_radar_point_cloud_queue_init_fails_on_invalid_arguments);
+    RUN_TEST(test_provizio_radar_point_cloud_queue_publishes_instead_of_callback);
+    RUN_TEST(test_provizio_radar_point_cloud_queue_of_pooled_slots);
+    RUN_TEST(test_provizio_radar_point_cloud_queue_pop_waits_for_point_clouds);
+
+    return UNITY_END();
+}
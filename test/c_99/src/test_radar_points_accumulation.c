@@ -1437,6 +1437,147 @@ static void test_provizio_accumulated_radar_point_cloud_iterator_get_point_end(v
     free(accumulated_point_clouds);
 }
 
+static void test_provizio_transform_radar_points(void)
+{
+    enum
+    {
+        num_points = 15 // 8 + 4 + 3, so that all batch sizes and remainders after vectorized parts are tested as well
+    };
+    const float epsilon = 0.0001F;
+
+    provizio_radar_point points[num_points];
+    memset(points, 0, sizeof(points));
+    for (size_t i = 0; i < num_points; ++i)
+    {
+        points[i].x_meters = 1.0F + (float)i;                      // NOLINT: magic numbers are fine in tests
+        points[i].y_meters = -2.0F * (float)i;                     // NOLINT: magic numbers are fine in tests
+        points[i].z_meters = 0.5F * (float)i;                      // NOLINT: magic numbers are fine in tests
+        points[i].radar_relative_radial_velocity_m_s = (float)i;   // NOLINT: magic numbers are fine in tests
+        points[i].signal_to_noise_ratio = 10.0F + (float)i;        // NOLINT: magic numbers are fine in tests
+        points[i].ground_relative_radial_velocity_m_s = -(float)i; // NOLINT: magic numbers are fine in tests
+    }
+
+    provizio_quaternion rotation;
+    provizio_quaternion_set_euler_angles((float)M_PI / 7.0F, 0.0F, (float)M_PI / 3.0F, &rotation); // NOLINT
+    quat rotation_quat = {rotation.x, rotation.y, rotation.z, rotation.w};
+    mat4x4 rotation_matrix;
+    mat4x4_from_quat(rotation_matrix, rotation_quat);
+    mat4x4 transformation_matrix;
+    mat4x4_translate(transformation_matrix, 10.0F, -5.0F, 1.0F); // NOLINT
+    mat4x4_mul(transformation_matrix, transformation_matrix, rotation_matrix);
+
+    provizio_radar_point transformed_points[num_points];
+    provizio_transform_radar_points((const float *)transformation_matrix, points, num_points, transformed_points);
+    for (size_t i = 0; i < num_points; ++i)
+    {
+        vec4 expected = {0};
+        vec4 in_vec = {points[i].x_meters, points[i].y_meters, points[i].z_meters, 1.0F};
+        mat4x4_mul_vec4(expected, transformation_matrix, in_vec);
+
+        TEST_ASSERT_FLOAT_WITHIN(epsilon, expected[0], transformed_points[i].x_meters);
+        TEST_ASSERT_FLOAT_WITHIN(epsilon, expected[1], transformed_points[i].y_meters);
+        TEST_ASSERT_FLOAT_WITHIN(epsilon, expected[2], transformed_points[i].z_meters);
+        TEST_ASSERT_EQUAL_FLOAT(points[i].radar_relative_radial_velocity_m_s,
+                                transformed_points[i].radar_relative_radial_velocity_m_s);
+        TEST_ASSERT_EQUAL_FLOAT(points[i].signal_to_noise_ratio, transformed_points[i].signal_to_noise_ratio);
+        TEST_ASSERT_EQUAL_FLOAT(points[i].ground_relative_radial_velocity_m_s,
+                                transformed_points[i].ground_relative_radial_velocity_m_s);
+    }
+
+    // In place
+    provizio_transform_radar_points((const float *)transformation_matrix, points, num_points, points);
+    TEST_ASSERT_EQUAL_INT32(0, memcmp(points, transformed_points, sizeof(points))); // NOLINT
+}
+
+static void test_provizio_transform_accumulated_radar_points(void)
+{
+    enum
+    {
+        num_accumulated_point_clouds = 3,
+        max_points = 8
+    };
+
+    provizio_accumulated_radar_point_cloud *accumulated_point_clouds = (provizio_accumulated_radar_point_cloud *)malloc(
+        sizeof(provizio_accumulated_radar_point_cloud) * num_accumulated_point_clouds);
+    provizio_radar_point_cloud *point_cloud = (provizio_radar_point_cloud *)malloc(sizeof(provizio_radar_point_cloud));
+    provizio_radar_point_cloud *transformed_point_cloud =
+        (provizio_radar_point_cloud *)malloc(sizeof(provizio_radar_point_cloud));
+    provizio_accumulated_radar_point_clouds_init(accumulated_point_clouds, num_accumulated_point_clouds);
+
+    // 2 point clouds: 2 points captured at fix_0, then 3 points captured at fix_1
+    provizio_enu_fix fixes[2];
+    memset(fixes, 0, sizeof(fixes));
+    provizio_quaternion_set_euler_angles(0.0F, 0.0F, (float)M_PI / 2.0F, &fixes[0].orientation); // NOLINT
+    provizio_quaternion_set_euler_angles(0.1F, 0.0F, (float)M_PI / 4.0F, &fixes[1].orientation); // NOLINT
+    fixes[1].position.east_meters = 5.0F;                                                        // NOLINT
+
+    provizio_accumulated_radar_point_cloud_iterator iterator = {0, 0};
+    for (uint16_t cloud = 0; cloud < 2; ++cloud)
+    {
+        memset(point_cloud, 0, sizeof(provizio_radar_point_cloud));
+        point_cloud->frame_index = cloud + 1;
+        point_cloud->num_points_expected = point_cloud->num_points_received = (uint16_t)(2 + cloud);
+        for (uint16_t i = 0; i < point_cloud->num_points_received; ++i)
+        {
+            point_cloud->radar_points[i].x_meters = 10.0F + (float)i;        // NOLINT: magic numbers are fine in tests
+            point_cloud->radar_points[i].y_meters = (float)(cloud * 10 + i); // NOLINT: magic numbers are fine in tests
+            point_cloud->radar_points[i].z_meters = 1.0F;                    // NOLINT: magic numbers are fine in tests
+            point_cloud->radar_points[i].signal_to_noise_ratio = 5.0F;       // NOLINT: magic numbers are fine in tests
+        }
+        iterator = provizio_accumulate_radar_point_cloud(point_cloud, &fixes[cloud], accumulated_point_clouds,
+                                                         num_accumulated_point_clouds, NULL, NULL);
+    }
+
+    provizio_enu_fix current_fix;
+    memset(&current_fix, 0, sizeof(current_fix));
+    provizio_quaternion_set_euler_angles(0.0F, 0.0F, (float)M_PI, &current_fix.orientation); // NOLINT
+    current_fix.position.north_meters = 3.0F;                                                 // NOLINT
+
+    // All points, from newest to oldest, transformed same way as get_point_cloud transforms them
+    provizio_radar_point out_points[max_points];
+    TEST_ASSERT_EQUAL_size_t(5, provizio_transform_accumulated_radar_points(&iterator, &current_fix,
+                                                                            accumulated_point_clouds,
+                                                                            num_accumulated_point_clouds, out_points,
+                                                                            max_points));
+    provizio_accumulated_radar_point_cloud_iterator cloud_iterator = iterator;
+    provizio_accumulated_radar_point_cloud_iterator_get_point_cloud(&cloud_iterator, &current_fix,
+                                                                    accumulated_point_clouds,
+                                                                    num_accumulated_point_clouds,
+                                                                    transformed_point_cloud, NULL);
+    TEST_ASSERT_EQUAL_INT32(0, memcmp(&out_points[0], transformed_point_cloud->radar_points, // NOLINT
+                                      sizeof(provizio_radar_point) * 3));
+    provizio_accumulated_radar_point_cloud_iterator_next_point_cloud(&cloud_iterator, accumulated_point_clouds,
+                                                                     num_accumulated_point_clouds);
+    provizio_accumulated_radar_point_cloud_iterator_get_point_cloud(&cloud_iterator, &current_fix,
+                                                                    accumulated_point_clouds,
+                                                                    num_accumulated_point_clouds,
+                                                                    transformed_point_cloud, NULL);
+    TEST_ASSERT_EQUAL_INT32(0, memcmp(&out_points[3], transformed_point_cloud->radar_points, // NOLINT
+                                      sizeof(provizio_radar_point) * 2));
+
+    // Not enough space for all points
+    TEST_ASSERT_EQUAL_size_t(4, provizio_transform_accumulated_radar_points(&iterator, &current_fix,
+                                                                            accumulated_point_clouds,
+                                                                            num_accumulated_point_clouds, out_points,
+                                                                            4));
+
+    // Invalid current_fix
+    memset(&current_fix.orientation, 0, sizeof(current_fix.orientation));
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_size_t(0, provizio_transform_accumulated_radar_points(&iterator, &current_fix,
+                                                                            accumulated_point_clouds,
+                                                                            num_accumulated_point_clouds, out_points,
+                                                                            max_points));
+    TEST_ASSERT_EQUAL_STRING(
+        "provizio_transform_accumulated_radar_points: current_fix->orientation is not a valid rotation",
+        provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    free(transformed_point_cloud);
+    free(point_cloud);
+    free(accumulated_point_clouds);
+}
+
 int provizio_run_test_points_accumulation(void)
 {
     memset(provizio_test_error, 0, sizeof(provizio_test_error));
@@ -1461,6 +1602,8 @@ int provizio_run_test_points_accumulation(void)
     RUN_TEST(test_provizio_accumulated_radar_point_cloud_iterator_next_point_end);
     RUN_TEST(test_provizio_accumulated_radar_point_cloud_iterator_get_point_cloud_end);
     RUN_TEST(test_provizio_accumulated_radar_point_cloud_iterator_get_point_end);
+    RUN_TEST(test_provizio_transform_radar_points);
+    RUN_TEST(test_provizio_transform_accumulated_radar_points);
 
     return UNITY_END();
 }
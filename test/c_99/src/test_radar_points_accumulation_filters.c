@@ -488,6 +488,68 @@ void test_provizio_radar_points_accumulation_filter_static_move_down(void)
     free(point_cloud);
 }
 
+void test_provizio_radar_points_accumulation_filter_static_accumulating(void)
+{
+    const float default_signal_to_noise_ratio = 10.0F;
+    const size_t num_accumulated_clouds = 15;
+    const size_t num_frames = 40; // Wraps accumulated_point_clouds around more than once
+    const uint64_t time_between_frames_ns = 100000000ULL; // 0.1s in nanoseconds
+    const float ego_velocity_m_s = 10.0F;
+    const float ego_move_per_frame_m = 1.0F; // As time_between_frames = 0.1s
+
+    // Ego goes East at a constant velocity, the radar is forward-looking (i.e. = ego). Unlike the tests above, the
+    // filter is applied by provizio_accumulate_radar_point_cloud_static, i.e. while the point cloud is accumulated.
+    provizio_enu_fix fix_when_received;
+    memset(&fix_when_received, 0, sizeof(provizio_enu_fix));
+    provizio_quaternion_set_identity(&fix_when_received.orientation);
+
+    provizio_radar_point_cloud *point_cloud = malloc(sizeof(provizio_radar_point_cloud));
+    memset(point_cloud, 0, sizeof(provizio_radar_point_cloud));
+    point_cloud->num_points_received = point_cloud->num_points_expected = 3;
+    // 2 static points and a moving one
+    point_cloud->radar_points[0].y_meters = 1.0F;
+    point_cloud->radar_points[0].radar_relative_radial_velocity_m_s = -ego_velocity_m_s;
+    point_cloud->radar_points[1].y_meters = -1.0F;
+    point_cloud->radar_points[1].radar_relative_radial_velocity_m_s = -ego_velocity_m_s;
+    point_cloud->radar_points[2].x_meters = 1.0F;
+    point_cloud->radar_points[2].radar_relative_radial_velocity_m_s = -ego_velocity_m_s + 10.0F; // NOLINT
+    for (size_t i = 0; i < 3; ++i)
+    {
+        point_cloud->radar_points[i].signal_to_noise_ratio = default_signal_to_noise_ratio;
+    }
+
+    provizio_accumulated_radar_point_cloud *accumulated_point_clouds =
+        malloc(num_accumulated_clouds * sizeof(provizio_accumulated_radar_point_cloud));
+    provizio_accumulated_radar_point_clouds_init(accumulated_point_clouds, num_accumulated_clouds);
+
+    for (size_t i = 0; i < num_frames; ++i)
+    {
+        provizio_accumulated_radar_point_cloud_iterator iterator = provizio_accumulate_radar_point_cloud_static(
+            point_cloud, &fix_when_received, accumulated_point_clouds, num_accumulated_clouds);
+
+        const provizio_accumulated_radar_point_cloud *accumulated_cloud =
+            provizio_accumulated_radar_point_cloud_iterator_get_point_cloud(&iterator, NULL, accumulated_point_clouds,
+                                                                            num_accumulated_clouds, NULL, NULL);
+        TEST_ASSERT_NOT_NULL(accumulated_cloud);
+        TEST_ASSERT_EQUAL_UINT32(point_cloud->frame_index, accumulated_cloud->point_cloud.frame_index);
+        TEST_ASSERT_EQUAL_FLOAT(fix_when_received.position.east_meters,
+                                accumulated_cloud->fix_when_received.position.east_meters);
+        if (i >= 10) // NOLINT: As soon as there is 1 second of ego positions history
+        {
+            TEST_ASSERT_EQUAL_UINT16(2, accumulated_cloud->point_cloud.num_points_received);
+            TEST_ASSERT_EQUAL_FLOAT(1.0F, accumulated_cloud->point_cloud.radar_points[0].y_meters);
+            TEST_ASSERT_EQUAL_FLOAT(-1.0F, accumulated_cloud->point_cloud.radar_points[1].y_meters);
+        }
+
+        fix_when_received.position.east_meters += ego_move_per_frame_m;
+        ++point_cloud->frame_index;
+        point_cloud->timestamp += time_between_frames_ns;
+    }
+
+    free(accumulated_point_clouds);
+    free(point_cloud);
+}
+
 int provizio_run_test_radar_points_accumulation_filters(void)
 {
     UNITY_BEGIN();
@@ -500,6 +562,7 @@ int provizio_run_test_radar_points_accumulation_filters(void)
     RUN_TEST(test_provizio_radar_points_accumulation_filter_static_rear_corner_radar);
     RUN_TEST(test_provizio_radar_points_accumulation_filter_static_move_up);
     RUN_TEST(test_provizio_radar_points_accumulation_filter_static_move_down);
+    RUN_TEST(test_provizio_radar_points_accumulation_filter_static_accumulating);
 
     return UNITY_END();
 }
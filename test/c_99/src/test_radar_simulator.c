@@ -0,0 +1,283 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/radar_api/core.h"
+#include "provizio/radar_api/radar_simulator.h"
+#include "provizio/util.h"
+
+enum
+{
+    test_message_length = 1024,
+    test_max_packets = 64
+};
+static char provizio_test_error[test_message_length]; // NOLINT: non-const global by design
+
+static void test_provizio_on_error(const char *error)
+{
+    strncpy(provizio_test_error, error, test_message_length - 1);
+}
+
+typedef struct test_simulator_frames_data
+{
+    size_t called_times;
+    uint16_t last_num_points_received;
+    uint16_t last_radar_range;
+    uint32_t last_frame_index;
+} test_simulator_frames_data;
+
+static void test_simulator_frame_callback(const provizio_radar_point_cloud *point_cloud,
+                                          provizio_radar_point_cloud_api_context *context)
+{
+    test_simulator_frames_data *data = (test_simulator_frames_data *)context->user_data;
+    ++data->called_times;
+    data->last_num_points_received = point_cloud->num_points_received;
+    data->last_radar_range = point_cloud->radar_range;
+    data->last_frame_index = point_cloud->frame_index;
+}
+
+typedef struct test_simulator_packets_data
+{
+    provizio_radar_point_cloud_api_context *contexts;
+    size_t num_contexts;
+    size_t num_packets;
+    uint16_t radar_position_ids[test_max_packets];
+    uint16_t num_points[test_max_packets];
+} test_simulator_packets_data;
+
+static int32_t test_simulator_on_packet(const provizio_radar_point_cloud_packet *packet, size_t packet_size,
+                                        void *user_data)
+{
+    test_simulator_packets_data *data = (test_simulator_packets_data *)user_data;
+    TEST_ASSERT_EQUAL_UINT64(provizio_radar_point_cloud_packet_size(&packet->header), packet_size);
+    if (data->num_packets < test_max_packets)
+    {
+        data->radar_position_ids[data->num_packets] =
+            provizio_get_protocol_field_uint16_t(&packet->header.radar_position_id);
+        data->num_points[data->num_packets] =
+            provizio_get_protocol_field_uint16_t(&packet->header.num_points_in_packet);
+    }
+    ++data->num_packets;
+
+    return data->contexts != NULL
+               ? provizio_handle_radars_point_cloud_packet(data->contexts, data->num_contexts,
+                                                           (provizio_radar_point_cloud_packet *)packet, packet_size)
+               : 0;
+}
+
+static void test_provizio_radar_simulator_makes_frames(void)
+{
+    const uint16_t num_points = 2 * PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET + 5;
+    const size_t num_radars = 2;
+
+    provizio_radar_simulator_options options;
+    provizio_radar_simulator_options_init(&options);
+    TEST_ASSERT_EQUAL_UINT64(1, options.num_radars);
+    TEST_ASSERT_EQUAL_UINT16(provizio_radar_position_front_center, options.radar_position_ids[0]);
+    TEST_ASSERT_EQUAL_UINT16(PROVIZIO__RADAR_SIMULATOR_DEFAULT_POINTS_PER_FRAME, options.num_points_per_frame);
+    options.num_radars = num_radars;
+    options.radar_position_ids[0] = provizio_radar_position_front_left;
+    options.radar_position_ids[1] = provizio_radar_position_front_right;
+    options.radar_range = provizio_radar_range_long;
+    options.num_points_per_frame = num_points;
+
+    test_simulator_frames_data frames_data;
+    memset(&frames_data, 0, sizeof(frames_data));
+    test_simulator_packets_data packets_data;
+    memset(&packets_data, 0, sizeof(packets_data));
+    packets_data.num_contexts = num_radars;
+    packets_data.contexts = (provizio_radar_point_cloud_api_context *)malloc(
+        num_radars * sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_contexts_init(&test_simulator_frame_callback, &frames_data, packets_data.contexts,
+                                                 num_radars);
+
+    provizio_radar_simulator simulator;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_init(&options, &simulator));
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_radar_simulator_make_frame(&simulator, &test_simulator_on_packet, &packets_data));
+
+    // 3 packets per radar, interleaved
+    TEST_ASSERT_EQUAL_UINT64(6, packets_data.num_packets);
+    for (size_t i = 0; i < 6; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT16(options.radar_position_ids[i % 2], packets_data.radar_position_ids[i]);
+        TEST_ASSERT_EQUAL_UINT16(i < 4 ? PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET : 5, packets_data.num_points[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT64(num_radars, frames_data.called_times);
+    TEST_ASSERT_EQUAL_UINT16(num_points, frames_data.last_num_points_received);
+    TEST_ASSERT_EQUAL_UINT16(provizio_radar_range_long, frames_data.last_radar_range);
+    TEST_ASSERT_EQUAL_UINT32(0, frames_data.last_frame_index);
+
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_radar_simulator_make_frame(&simulator, &test_simulator_on_packet, &packets_data));
+    TEST_ASSERT_EQUAL_UINT64(2 * num_radars, frames_data.called_times);
+    TEST_ASSERT_EQUAL_UINT32(1, frames_data.last_frame_index);
+    TEST_ASSERT_EQUAL_UINT64(2 * num_radars, simulator.stats.num_frames);
+    TEST_ASSERT_EQUAL_UINT64(12, simulator.stats.num_packets);
+    TEST_ASSERT_EQUAL_UINT64(0, simulator.stats.num_packets_lost + simulator.stats.num_packets_duplicated +
+                                    simulator.stats.num_packets_reordered);
+
+    free(packets_data.contexts);
+}
+
+static void test_provizio_radar_simulator_reorders_duplicates_and_loses_packets(void)
+{
+    provizio_radar_simulator_options options;
+    provizio_radar_simulator_options_init(&options);
+    options.num_points_per_frame = 3 * PROVIZIO__MAX_RADAR_POINTS_PER_UDP_PACKET;
+
+    test_simulator_frames_data frames_data;
+    memset(&frames_data, 0, sizeof(frames_data));
+    test_simulator_packets_data packets_data;
+    memset(&packets_data, 0, sizeof(packets_data));
+    packets_data.num_contexts = 1;
+    packets_data.contexts =
+        (provizio_radar_point_cloud_api_context *)malloc(sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_context_init(&test_simulator_frame_callback, &frames_data, packets_data.contexts);
+
+    // Every other packet is emitted after the next one, the last one at the end of the frame: still a complete frame
+    provizio_radar_simulator simulator;
+    options.reorder_probability = 1.0F;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_init(&options, &simulator));
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_radar_simulator_make_frame(&simulator, &test_simulator_on_packet, &packets_data));
+    TEST_ASSERT_EQUAL_UINT64(3, packets_data.num_packets);
+    TEST_ASSERT_EQUAL_UINT64(2, simulator.stats.num_packets_reordered);
+    TEST_ASSERT_EQUAL_UINT64(1, frames_data.called_times);
+    TEST_ASSERT_EQUAL_UINT16(options.num_points_per_frame, frames_data.last_num_points_received);
+
+    // Every packet is emitted twice, one after another
+    free(packets_data.contexts);
+    packets_data.contexts = NULL;
+    packets_data.num_packets = 0;
+    options.reorder_probability = 0.0F;
+    options.duplicate_probability = 1.0F;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_init(&options, &simulator));
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_radar_simulator_make_frame(&simulator, &test_simulator_on_packet, &packets_data));
+    TEST_ASSERT_EQUAL_UINT64(6, packets_data.num_packets);
+    TEST_ASSERT_EQUAL_UINT64(3, simulator.stats.num_packets_duplicated);
+    for (size_t i = 0; i < 6; i += 2)
+    {
+        TEST_ASSERT_EQUAL_UINT16(packets_data.num_points[i], packets_data.num_points[i + 1]);
+    }
+
+    // Every packet is lost
+    packets_data.num_packets = 0;
+    options.duplicate_probability = 0.0F;
+    options.loss_probability = 1.0F;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_init(&options, &simulator));
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_radar_simulator_make_frame(&simulator, &test_simulator_on_packet, &packets_data));
+    TEST_ASSERT_EQUAL_UINT64(0, packets_data.num_packets);
+    TEST_ASSERT_EQUAL_UINT64(3, simulator.stats.num_packets_lost);
+    TEST_ASSERT_EQUAL_UINT64(1, simulator.stats.num_frames);
+}
+
+static void test_provizio_radar_simulator_sends_frames_over_loopback(void)
+{
+    const uint16_t port_number = 10032 + PROVIZIO__RADAR_API_DEFAULT_PORT;
+    const uint64_t receive_timeout_ns = 100000000ULL;
+    const size_t num_radars = 3;
+    const uint64_t num_frames = 4;
+
+    test_simulator_frames_data frames_data;
+    memset(&frames_data, 0, sizeof(frames_data));
+    provizio_radar_point_cloud_api_context *contexts = (provizio_radar_point_cloud_api_context *)malloc(
+        num_radars * sizeof(provizio_radar_point_cloud_api_context));
+    provizio_radar_point_cloud_api_contexts_init(&test_simulator_frame_callback, &frames_data, contexts, num_radars);
+    provizio_radar_api_connection connection;
+    TEST_ASSERT_EQUAL_INT32(
+        0, provizio_open_radars_connection(port_number, receive_timeout_ns, 0, contexts, num_radars, &connection));
+
+    provizio_radar_simulator_options options;
+    provizio_radar_simulator_options_init(&options);
+    options.num_radars = num_radars;
+    for (size_t i = 0; i < num_radars; ++i)
+    {
+        options.radar_position_ids[i] = (uint16_t)i;
+    }
+    options.num_points_per_frame = 300;
+    options.frame_rate = 100.0F;
+
+    provizio_radar_simulator simulator;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_open(&options, NULL, port_number, &simulator));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_send_frames(&simulator, num_frames, NULL));
+    TEST_ASSERT_EQUAL_UINT64(num_radars * num_frames, simulator.stats.num_frames);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_close(&simulator));
+
+    // Stops at once if requested
+    const uint32_t stop = 1;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_open(&options, NULL, port_number, &simulator));
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_send_frames(&simulator, 0, &stop));
+    TEST_ASSERT_EQUAL_UINT64(0, simulator.stats.num_frames);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_close(&simulator));
+
+    size_t num_packets_handled = 0;
+    while (provizio_radar_api_receive_packets(&connection, SIZE_MAX, &num_packets_handled) == 0)
+    {
+    }
+    TEST_ASSERT_EQUAL_UINT64(num_radars * num_frames, frames_data.called_times);
+    TEST_ASSERT_EQUAL_UINT32(num_frames - 1, frames_data.last_frame_index);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_close_radars_connection(&connection));
+    free(contexts);
+}
+
+static void test_provizio_radar_simulator_fails_on_invalid_arguments(void)
+{
+    provizio_radar_simulator_options options;
+    provizio_radar_simulator simulator;
+
+    provizio_set_on_error(&test_provizio_on_error);
+    provizio_radar_simulator_options_init(&options);
+    options.num_radars = 0;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_simulator_init(&options, &simulator));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_simulator_init: Invalid options", provizio_test_error);
+    provizio_radar_simulator_options_init(&options);
+    options.loss_probability = 1.5F;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_simulator_init(&options, &simulator));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_simulator_init: Invalid options", provizio_test_error);
+    provizio_radar_simulator_options_init(&options);
+    options.frame_rate = -1.0F;
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_simulator_open(&options, NULL, 0, &simulator));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_simulator_init: Invalid options", provizio_test_error);
+
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT,
+                            provizio_radar_simulator_open(NULL, "not an address", 0, &simulator));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_simulator_open: Invalid target address", provizio_test_error);
+
+    TEST_ASSERT_EQUAL_INT32(0, provizio_radar_simulator_init(NULL, &simulator));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_simulator_send_frames(&simulator, 1, NULL));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_simulator_send_frames: Not open", provizio_test_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_radar_simulator_close(&simulator));
+    TEST_ASSERT_EQUAL_STRING("provizio_radar_simulator_close: Not open", provizio_test_error);
+    provizio_set_on_error(NULL);
+}
+
+int provizio_run_test_radar_simulator(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provizio_radar_simulator_makes_frames);
+    RUN_TEST(test_provizio_radar_simulator_reorders_duplicates_and_loses_packets);
+    RUN_TEST(test_provizio_radar_simulator_sends_frames_over_loopback);
+    RUN_TEST(test_provizio_radar_simulator_fails_on_invalid_arguments);
+
+    return UNITY_END();
+}
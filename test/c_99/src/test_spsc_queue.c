@@ -0,0 +1,155 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#include "unity/unity.h"
+
+#include "provizio/radar_api/errno.h"
+#include "provizio/spsc_queue.h"
+
+enum
+{
+    test_message_length = 1024,
+    test_num_slots = 3,
+    test_num_items_transferred = 10000
+};
+static char provizio_test_error[test_message_length]; // NOLINT: non-const global by design
+
+static void test_provizio_on_error(const char *error)
+{
+    strncpy(provizio_test_error, error, test_message_length - 1);
+}
+
+static void test_provizio_spsc_queue_init_fails_on_invalid_arguments(void)
+{
+    uint32_t slots[1];
+    provizio_spsc_queue queue;
+
+    provizio_set_on_error(&test_provizio_on_error);
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_spsc_queue_init(slots, sizeof(uint32_t), 0, &queue));
+    TEST_ASSERT_EQUAL_STRING("provizio_spsc_queue_init: Invalid arguments", provizio_test_error);
+    memset(provizio_test_error, 0, sizeof(provizio_test_error));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_spsc_queue_init(slots, 0, 1, &queue));
+    TEST_ASSERT_EQUAL_STRING("provizio_spsc_queue_init: Invalid arguments", provizio_test_error);
+    memset(provizio_test_error, 0, sizeof(provizio_test_error));
+    TEST_ASSERT_EQUAL_INT32(PROVIZIO_E_ARGUMENT, provizio_spsc_queue_init(NULL, sizeof(uint32_t), 1, &queue));
+    TEST_ASSERT_EQUAL_STRING("provizio_spsc_queue_init: Invalid arguments", provizio_test_error);
+    provizio_set_on_error(NULL);
+
+    // A queue failed to initialize is both empty and full
+    TEST_ASSERT_NULL(provizio_spsc_queue_back(&queue));
+    TEST_ASSERT_NULL(provizio_spsc_queue_front(&queue));
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_spsc_queue_size(&queue));
+}
+
+static void test_provizio_spsc_queue_push_pop(void)
+{
+    uint32_t slots[test_num_slots];
+    provizio_spsc_queue queue;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_spsc_queue_init(slots, sizeof(uint32_t), test_num_slots, &queue));
+    TEST_ASSERT_NULL(provizio_spsc_queue_front(&queue));
+
+    // Going around the ring a few times, keeping the order of items
+    uint32_t next_to_push = 0;
+    uint32_t next_to_pop = 0;
+    for (size_t round = 0; round < 4; ++round) // NOLINT: No need to unroll
+    {
+        uint32_t *slot = NULL;
+        while ((slot = (uint32_t *)provizio_spsc_queue_back(&queue)) != NULL) // NOLINT: No need to unroll
+        {
+            *slot = next_to_push++;
+            provizio_spsc_queue_push(&queue);
+        }
+        TEST_ASSERT_EQUAL_UINT64(test_num_slots, provizio_spsc_queue_size(&queue));
+
+        // Popping just a part of them, so that the positions in the ring keep shifting
+        for (size_t i = 0; i < round % test_num_slots + 1; ++i)
+        {
+            const uint32_t *item = (const uint32_t *)provizio_spsc_queue_front(&queue);
+            TEST_ASSERT_NOT_NULL(item);
+            TEST_ASSERT_EQUAL_UINT32(next_to_pop++, *item);
+            provizio_spsc_queue_pop(&queue);
+        }
+    }
+
+    const uint32_t *item = NULL;
+    while ((item = (const uint32_t *)provizio_spsc_queue_front(&queue)) != NULL) // NOLINT: No need to unroll
+    {
+        TEST_ASSERT_EQUAL_UINT32(next_to_pop++, *item);
+        provizio_spsc_queue_pop(&queue);
+    }
+    TEST_ASSERT_EQUAL_UINT32(next_to_push, next_to_pop);
+    TEST_ASSERT_EQUAL_UINT64(0, provizio_spsc_queue_size(&queue));
+}
+
+static void *test_provizio_spsc_queue_producer(void *arg)
+{
+    provizio_spsc_queue *queue = (provizio_spsc_queue *)arg;
+
+    for (uint32_t i = 0; i < test_num_items_transferred; ++i)
+    {
+        uint32_t *slot = NULL;
+        while ((slot = (uint32_t *)provizio_spsc_queue_back(queue)) == NULL) // NOLINT: No need to unroll
+        {
+            sched_yield();
+        }
+
+        *slot = i;
+        provizio_spsc_queue_push(queue);
+    }
+
+    return NULL;
+}
+
+static void test_provizio_spsc_queue_concurrent(void)
+{
+    uint32_t slots[test_num_slots];
+    provizio_spsc_queue queue;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_spsc_queue_init(slots, sizeof(uint32_t), test_num_slots, &queue));
+
+    pthread_t producer;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL, &test_provizio_spsc_queue_producer, &queue));
+
+    // All items are received exactly once and in order
+    uint32_t num_out_of_order = 0;
+    for (uint32_t i = 0; i < test_num_items_transferred; ++i)
+    {
+        const uint32_t *item = NULL;
+        while ((item = (const uint32_t *)provizio_spsc_queue_front(&queue)) == NULL) // NOLINT: No need to unroll
+        {
+            sched_yield();
+        }
+
+        num_out_of_order += *item != i ? 1 : 0;
+        provizio_spsc_queue_pop(&queue);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(producer, NULL));
+    TEST_ASSERT_EQUAL_UINT32(0, num_out_of_order);
+    TEST_ASSERT_NULL(provizio_spsc_queue_front(&queue));
+}
+
+int provizio_run_test_spsc_queue(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provizio_spsc_queue_init_fails_on_invalid_arguments);
+    RUN_TEST(test_provizio_spsc_queue_push_pop);
+    RUN_TEST(test_provizio_spsc_queue_concurrent);
+
+    return UNITY_END();
+}
@@ -178,6 +178,45 @@ static void test_provizio_get_protocol_field_float(void)
                       provizio_get_protocol_field_float((float *)&test_buffer_unaligned[1]));
 }
 
+static void test_provizio_get_protocol_fields_float(void)
+{
+    // An odd number of floats, so that both the vectorized part and the remainder are tested
+    enum
+    {
+        num_floats = 37
+    };
+    uint8_t test_buffer[sizeof(float) * num_floats + 1];
+    float expected[num_floats];
+    float values[num_floats + 1];
+
+    for (size_t i = 0; i < num_floats; ++i)
+    {
+        expected[i] = (float)i * 1.5F - 7.25F; // NOLINT
+        provizio_set_protocol_field_float((float *)&test_buffer[1 + i * sizeof(float)], expected[i]);
+    }
+
+    // Unaligned input and output
+    memset(values, 0, sizeof(values));
+    provizio_get_protocol_fields_float(&test_buffer[1], (uint8_t *)values + 1, num_floats);
+    for (size_t i = 0; i < num_floats; ++i)
+    {
+        TEST_ASSERT_EQUAL(expected[i], provizio_get_protocol_field_float((float *)&test_buffer[1 + i * sizeof(float)]));
+
+        float value; // NOLINT: initialized right below
+        memcpy(&value, (uint8_t *)values + 1 + i * sizeof(float), sizeof(value));
+        TEST_ASSERT_EQUAL(expected[i], value); // NOLINT
+    }
+
+    // In place
+    memcpy(values, &test_buffer[1], sizeof(float) * num_floats);
+    provizio_get_protocol_fields_float(values, values, num_floats);
+    TEST_ASSERT_EQUAL_MEMORY(expected, values, sizeof(expected));
+
+    // Nothing to convert
+    provizio_get_protocol_fields_float(values, values, 0);
+    TEST_ASSERT_EQUAL_MEMORY(expected, values, sizeof(expected));
+}
+
 static void test_provizio_gettimeofday(void)
 {
     struct timeval test_tv;
@@ -207,6 +246,32 @@ static void test_provizio_time_interval_ns(void)
     TEST_ASSERT_EQUAL_INT64(0, provizio_time_interval_ns(&tv_a, &tv_a));
 }
 
+static void test_provizio_sleep_ns(void)
+{
+    const uint64_t duration_ns = 20000000ULL; // 20ms
+
+    struct timeval tv_a;
+    struct timeval tv_b;
+    TEST_ASSERT_EQUAL_INT32(0, provizio_gettimeofday(&tv_a));
+    provizio_sleep_ns(duration_ns);
+    TEST_ASSERT_EQUAL_INT32(0, provizio_gettimeofday(&tv_b));
+
+    // Allowing for 1ms precision of provizio_gettimeofday in Windows
+    const int64_t precision_ns = 1000000LL;
+    TEST_ASSERT_GREATER_OR_EQUAL_INT64((int64_t)duration_ns - precision_ns, provizio_time_interval_ns(&tv_b, &tv_a));
+}
+
+static void test_provizio_monotonic_time_ns(void)
+{
+    const uint64_t duration_ns = 20000000ULL; // 20ms
+
+    const uint64_t time_a = provizio_monotonic_time_ns();
+    provizio_sleep_ns(duration_ns);
+    const uint64_t time_b = provizio_monotonic_time_ns();
+
+    TEST_ASSERT_TRUE(time_b - time_a >= duration_ns); // NOLINT: clang-tidy doesn't like TEST_ASSERT_TRUE
+}
+
 int provizio_run_test_util(void)
 {
     UNITY_BEGIN();
@@ -221,8 +286,11 @@ int provizio_run_test_util(void)
     RUN_TEST(test_provizio_get_protocol_field_uint32_t);
     RUN_TEST(test_provizio_get_protocol_field_uint64_t);
     RUN_TEST(test_provizio_get_protocol_field_float);
+    RUN_TEST(test_provizio_get_protocol_fields_float);
     RUN_TEST(test_provizio_gettimeofday);
     RUN_TEST(test_provizio_time_interval_ns);
+    RUN_TEST(test_provizio_sleep_ns);
+    RUN_TEST(test_provizio_monotonic_time_ns);
 
     return UNITY_END();
 }
@@ -15,7 +15,6 @@
 // The purpose of this C++ test is to make sure the API C headers can successfully be included in a C++ code and don't
 // crash when API functions are invoked. The logic is completely tested in the c_99 test.
 
-#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -27,9 +26,12 @@
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "provizio/radar_api/core.h"
+#include "provizio/radar_api/radar_point_cloud_queue.h"
 #include "provizio/radar_api/radar_points_accumulation.h"
+#include "provizio/radar_api/threaded_receiver.h"
 #include "provizio/socket.h"
 
 namespace
@@ -188,9 +190,8 @@ int main(int argc, char *argv[])
         try
         {
             constexpr std::size_t num_accumulated_point_clouds = 2;
-            std::array<provizio_accumulated_radar_point_cloud, // NOLINT: False positive: initialized next
-                       num_accumulated_point_clouds>
-                accumulated_point_clouds;
+            // Not on the stack, as every accumulated point cloud embeds a full-size point cloud
+            std::vector<provizio_accumulated_radar_point_cloud> accumulated_point_clouds(num_accumulated_point_clouds);
             provizio_accumulated_radar_point_clouds_init(accumulated_point_clouds.data(), num_accumulated_point_clouds);
 
             auto received_point_cloud = std::make_unique<provizio_radar_point_cloud>();
@@ -0,0 +1,168 @@
+// Copyright 2022 Provizio Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Emulates multiple radars sending point clouds over UDP (by default to the loopback interface), to load test the
+// receiving side. Runs until the requested number of frames is sent or until interrupted (Ctrl+C), then prints the
+// traffic stats.
+//
+// Usage: provizio_radar_simulator [option value]..., see provizio_radar_simulator_usage for the options
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "provizio/atomic.h"
+#include "provizio/radar_api/core.h"
+#include "provizio/radar_api/radar_simulator.h"
+
+static uint32_t provizio_radar_simulator_stop; // NOLINT: non-const global by design, set by the signal handler
+
+static void provizio_radar_simulator_on_signal(int signal_number)
+{
+    (void)signal_number;
+    PROVIZIO__ATOMIC_STORE_UINT32(&provizio_radar_simulator_stop, 1);
+}
+
+static void provizio_radar_simulator_usage(const char *program)
+{
+    printf("Usage: %s [option value]...\n"
+           "  --address IPV4        Address to send to (default: 127.0.0.1)\n"
+           "  --port PORT           UDP port to send to (default: %u)\n"
+           "  --radars N            Number of radars, up to %u (default: 1)\n"
+           "  --points N            Points per frame of every radar (default: %u)\n"
+           "  --frame-rate FPS      Frames per second of every radar, 0 for as fast as possible (default: %.0f)\n"
+           "  --load-factor K       Multiplier of the frame rate, e.g. 10 for 10x the normal load (default: 1)\n"
+           "  --reorder P           Probability of a packet to be reordered (default: 0)\n"
+           "  --duplicate P         Probability of a packet to be duplicated (default: 0)\n"
+           "  --loss P              Probability of a packet to be lost (default: 0)\n"
+           "  --frames N            Number of frames of every radar to send, 0 to send until interrupted (default: 0)\n"
+           "  --seed N              Seed of the pseudo-random generator\n",
+           program, (unsigned)PROVIZIO__RADAR_API_DEFAULT_PORT, (unsigned)PROVIZIO__RADAR_SIMULATOR_MAX_RADARS,
+           (unsigned)PROVIZIO__RADAR_SIMULATOR_DEFAULT_POINTS_PER_FRAME,
+           (double)PROVIZIO__RADAR_SIMULATOR_DEFAULT_FRAME_RATE);
+}
+
+int main(int argc, char *argv[])
+{
+    provizio_radar_simulator_options options;
+    provizio_radar_simulator_options_init(&options);
+    const char *address = NULL;
+    uint16_t port = PROVIZIO__RADAR_API_DEFAULT_PORT;
+    float load_factor = 1.0F;
+    uint64_t num_frames = 0;
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        const char *option = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (value == NULL)
+        {
+            provizio_radar_simulator_usage(argv[0]);
+            return 1;
+        }
+
+        if (strcmp(option, "--address") == 0)
+        {
+            address = value;
+        }
+        else if (strcmp(option, "--port") == 0)
+        {
+            port = (uint16_t)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(option, "--radars") == 0)
+        {
+            options.num_radars = (size_t)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(option, "--points") == 0)
+        {
+            options.num_points_per_frame = (uint16_t)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(option, "--frame-rate") == 0)
+        {
+            options.frame_rate = strtof(value, NULL);
+        }
+        else if (strcmp(option, "--load-factor") == 0)
+        {
+            load_factor = strtof(value, NULL);
+        }
+        else if (strcmp(option, "--reorder") == 0)
+        {
+            options.reorder_probability = strtof(value, NULL);
+        }
+        else if (strcmp(option, "--duplicate") == 0)
+        {
+            options.duplicate_probability = strtof(value, NULL);
+        }
+        else if (strcmp(option, "--loss") == 0)
+        {
+            options.loss_probability = strtof(value, NULL);
+        }
+        else if (strcmp(option, "--frames") == 0)
+        {
+            num_frames = strtoull(value, NULL, 10);
+        }
+        else if (strcmp(option, "--seed") == 0)
+        {
+            options.seed = (uint32_t)strtoul(value, NULL, 10);
+        }
+        else
+        {
+            provizio_radar_simulator_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Standard positions first, then custom ones
+    for (size_t i = 0; i < options.num_radars && i < PROVIZIO__RADAR_SIMULATOR_MAX_RADARS; ++i)
+    {
+        options.radar_position_ids[i] =
+            i <= provizio_radar_position_rear_center
+                ? (uint16_t)i
+                : (uint16_t)(provizio_radar_position_custom + i - provizio_radar_position_rear_center - 1);
+    }
+    options.frame_rate *= load_factor;
+
+    provizio_sockets_initialize();
+    provizio_radar_simulator simulator;
+    int32_t status = provizio_radar_simulator_open(&options, address, port, &simulator);
+    if (status != 0)
+    {
+        provizio_radar_simulator_usage(argv[0]);
+        provizio_sockets_deinitialize();
+        return 1;
+    }
+
+    signal(SIGINT, &provizio_radar_simulator_on_signal);
+    signal(SIGTERM, &provizio_radar_simulator_on_signal);
+
+    printf("Sending %u points per frame of %u radars at %.1f frames per second to %s:%u\n",
+           (unsigned)options.num_points_per_frame, (unsigned)options.num_radars, (double)options.frame_rate,
+           address != NULL ? address : "127.0.0.1", (unsigned)port);
+    const uint64_t start_time_ns = provizio_monotonic_time_ns();
+    status = provizio_radar_simulator_send_frames(&simulator, num_frames, &provizio_radar_simulator_stop);
+    const double duration_s = (double)(provizio_monotonic_time_ns() - start_time_ns) / 1e9;
+
+    const provizio_radar_simulator_stats *stats = &simulator.stats;
+    printf("Sent %llu radar frames, %llu packets (%llu reordered, %llu duplicated, %llu lost) in %.2f s: %.0f packets "
+           "per second\n",
+           (unsigned long long)stats->num_frames, (unsigned long long)stats->num_packets,
+           (unsigned long long)stats->num_packets_reordered, (unsigned long long)stats->num_packets_duplicated,
+           (unsigned long long)stats->num_packets_lost, duration_s,
+           duration_s > 0.0 ? (double)stats->num_packets / duration_s : 0.0);
+
+    provizio_radar_simulator_close(&simulator);
+    provizio_sockets_deinitialize();
+    return status == 0 ? 0 : 1;
+}